@@ -0,0 +1,300 @@
+/*
+ * Benchmark.cpp - timing harness for the benchmarks of the render path
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include "AudioDevice.h"
+#include "AudioEngine.h"
+#include "Engine.h"
+
+
+namespace
+{
+
+std::atomic<std::uint64_t> s_allocations{0};
+
+} // namespace
+
+
+// Count all allocations of the process. The array, nothrow and sized variants
+// of the standard library forward to these.
+void* operator new(std::size_t size)
+{
+	s_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) { return ptr; }
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+
+namespace lmms::benchmarks
+{
+
+
+namespace
+{
+
+double percentile(const std::vector<double>& sorted, double fraction)
+{
+	if (sorted.empty()) { return 0.; }
+	const auto index = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+	return sorted[std::clamp<std::size_t>(index, 1, sorted.size()) - 1];
+}
+
+} // namespace
+
+
+
+
+std::uint64_t allocationCount()
+{
+	return s_allocations.load(std::memory_order_relaxed);
+}
+
+
+
+
+Benchmark::Benchmark(int argc, char* argv[], const QString& suite, int defaultPeriods) :
+	m_suite(suite),
+	m_periods(defaultPeriods)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const QString name = argv[i];
+		if (!name.startsWith("--") || i + 1 == argc)
+		{
+			std::fprintf(stderr, "Ignoring argument \"%s\"\n", argv[i]);
+			continue;
+		}
+		m_options[name.mid(2)] = argv[++i];
+	}
+
+	m_periods = std::max(option("periods", m_periods), 1);
+	m_frames = std::clamp(option("frames", static_cast<int>(m_frames)), 1, static_cast<int>(DEFAULT_BUFFER_SIZE));
+	m_filter = m_options.value("filter");
+	m_output = m_options.value("output");
+	m_baseline = m_options.value("baseline");
+	m_tolerance = m_options.value("tolerance", QString::number(m_tolerance)).toDouble();
+}
+
+
+
+
+int Benchmark::option(const QString& name, int defaultValue) const
+{
+	bool ok = false;
+	const int value = m_options.value(name).toInt(&ok);
+	return ok ? value : defaultValue;
+}
+
+
+
+
+bool Benchmark::isSelected(const QString& name) const
+{
+	return m_filter.isEmpty() || name.contains(m_filter);
+}
+
+
+
+
+void Benchmark::record(const QString& name, fpp_t frames, std::vector<double> times, std::uint64_t allocations)
+{
+	std::sort(times.begin(), times.end());
+
+	const double mean = times.empty() ? 0. : std::accumulate(times.begin(), times.end(), 0.) / times.size();
+
+	m_results.append(QJsonObject{
+		{"name", name},
+		{"frames", static_cast<int>(frames)},
+		{"periods", static_cast<int>(times.size())},
+		{"meanUs", mean},
+		{"medianUs", percentile(times, 0.5)},
+		{"p99Us", percentile(times, 0.99)},
+		{"p999Us", percentile(times, 0.999)},
+		{"maxUs", times.empty() ? 0. : times.back()},
+		{"allocationsPerPeriod", times.empty() ? 0. : static_cast<double>(allocations) / times.size()}
+	});
+
+	std::fprintf(stderr, "%-40s mean %9.2f us  p99 %9.2f us  allocs/period %.2f\n",
+		qPrintable(name), mean, percentile(times, 0.99),
+		times.empty() ? 0. : static_cast<double>(allocations) / times.size());
+}
+
+
+
+
+int Benchmark::finish()
+{
+	const QJsonObject report{
+		{"suite", m_suite},
+		{"results", m_results}
+	};
+	const QByteArray json = QJsonDocument(report).toJson();
+
+	if (m_output.isEmpty())
+	{
+		QTextStream(stdout) << json;
+	}
+	else
+	{
+		QFile file(m_output);
+		if (!file.open(QFile::WriteOnly | QFile::Truncate))
+		{
+			std::fprintf(stderr, "Could not write \"%s\"\n", qPrintable(m_output));
+			return EXIT_FAILURE;
+		}
+		file.write(json);
+	}
+
+	if (m_baseline.isEmpty()) { return EXIT_SUCCESS; }
+
+	QFile file(m_baseline);
+	if (!file.open(QFile::ReadOnly))
+	{
+		std::fprintf(stderr, "Could not read baseline \"%s\"\n", qPrintable(m_baseline));
+		return EXIT_FAILURE;
+	}
+
+	return compare(QJsonDocument::fromJson(file.readAll()).object().value("results").toArray())
+		? EXIT_SUCCESS
+		: EXIT_FAILURE;
+}
+
+
+
+
+bool Benchmark::compare(const QJsonArray& baseline) const
+{
+	bool passed = true;
+
+	for (const auto& result : m_results)
+	{
+		const QJsonObject current = result.toObject();
+		const auto it = std::find_if(baseline.begin(), baseline.end(), [&](const QJsonValue& value) {
+			return value.toObject().value("name") == current.value("name");
+		});
+		if (it == baseline.end()) { continue; }
+
+		const QJsonObject previous = it->toObject();
+		for (const QString key : {"meanUs", "p99Us"})
+		{
+			const double limit = previous.value(key).toDouble() * (1. + m_tolerance);
+			if (current.value(key).toDouble() > limit)
+			{
+				std::fprintf(stderr, "Regression in %s: %s %.2f us, baseline %.2f us\n",
+					qPrintable(current.value("name").toString()), qPrintable(key),
+					current.value(key).toDouble(), previous.value(key).toDouble());
+				passed = false;
+			}
+		}
+
+		const double allocations = current.value("allocationsPerPeriod").toDouble();
+		const double previousAllocations = previous.value("allocationsPerPeriod").toDouble();
+		if (allocations > previousAllocations)
+		{
+			std::fprintf(stderr, "Regression in %s: %.2f allocations per period, baseline %.2f\n",
+				qPrintable(current.value("name").toString()), allocations, previousAllocations);
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+
+
+
+//! Takes the place of the audio device and drops the rendered frames
+class EngineScope::Device : public AudioDevice
+{
+public:
+	explicit Device(AudioEngine* audioEngine) :
+		AudioDevice(DEFAULT_CHANNELS, audioEngine)
+	{
+	}
+
+	bool render()
+	{
+		return getNextBuffer(m_frames.data()) > 0;
+	}
+
+private:
+	std::vector<SampleFrame> m_frames = std::vector<SampleFrame>(DEFAULT_BUFFER_SIZE);
+};
+
+
+
+
+EngineScope::EngineScope()
+{
+	Engine::init(true);
+
+	// Replace the dummy device and its threads, so nothing renders in the
+	// background while the benchmarks run
+	auto audioEngine = Engine::audioEngine();
+	audioEngine->storeAudioDevice();
+	m_device = new Device(audioEngine);
+	audioEngine->setAudioDevice(m_device, audioEngine->currentQualitySettings(), false, false);
+}
+
+
+
+
+EngineScope::~EngineScope()
+{
+	Engine::audioEngine()->restoreAudioDevice();
+	Engine::destroy();
+}
+
+
+
+
+bool EngineScope::renderPeriod()
+{
+	return m_device->render();
+}
+
+
+} // namespace lmms::benchmarks
@@ -0,0 +1,147 @@
+/*
+ * Benchmark.h - timing harness for the benchmarks of the render path
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_BENCHMARK_H
+#define LMMS_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <QJsonArray>
+#include <QMap>
+#include <QString>
+
+#include "lmms_basics.h"
+
+namespace lmms::benchmarks
+{
+
+
+//! Number of heap allocations made by all threads since the program started
+std::uint64_t allocationCount();
+
+
+/**
+	Runs the benchmarks of one suite and reports them as JSON.
+
+	Every benchmark repeatedly calls a function which processes one period
+	of audio. The time of each call is recorded, so the report contains the
+	mean, median, p99 and p999 period times as well as the heap allocations
+	per period, which should be zero for everything on the render path.
+
+	Command line options:
+	  --periods <n>        number of measured periods (after warm-up)
+	  --frames <n>         frames per period for the micro-benchmarks
+	  --filter <text>      only run benchmarks whose name contains text
+	  --output <file>      write the report to file instead of stdout
+	  --baseline <file>    compare against an earlier report and fail if
+	                       a benchmark got slower or allocates more
+	  --tolerance <x>      allowed slowdown against the baseline, as a
+	                       fraction (default 0.1)
+
+	Suites may read further options with option().
+*/
+class Benchmark
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	Benchmark(int argc, char* argv[], const QString& suite, int defaultPeriods = 10000);
+
+	//! Value of an integer option `--name <value>`, for options specific to a suite
+	int option(const QString& name, int defaultValue) const;
+
+	int periods() const { return m_periods; }
+	fpp_t frames() const { return m_frames; }
+
+	//! Whether the benchmark with the given name was selected with --filter
+	bool isSelected(const QString& name) const;
+
+	//! Call `period` for all warm-up and measured periods and record its timings
+	template<typename F>
+	void run(const QString& name, F&& period)
+	{
+		if (!isSelected(name)) { return; }
+
+		for (int i = 0; i < m_periods / 10; ++i)
+		{
+			period();
+		}
+
+		std::vector<double> times(m_periods);
+		const std::uint64_t allocations = allocationCount();
+		for (auto& time : times)
+		{
+			const auto begin = Clock::now();
+			period();
+			time = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+		}
+
+		record(name, m_frames, times, allocationCount() - allocations);
+	}
+
+	//! Add the timings (in microseconds) of a benchmark which drives its periods itself
+	void record(const QString& name, fpp_t frames, std::vector<double> times, std::uint64_t allocations);
+
+	//! Write the report and compare it against the baseline. Returns the exit code of the program.
+	int finish();
+
+private:
+	bool compare(const QJsonArray& baseline) const;
+
+	QString m_suite;
+	QMap<QString, QString> m_options;
+	int m_periods;
+	fpp_t m_frames = 256;
+	QString m_filter;
+	QString m_output;
+	QString m_baseline;
+	double m_tolerance = 0.1;
+
+	QJsonArray m_results;
+};
+
+
+//! Initializes the engine for rendering without an audio device, so benchmarks
+//! can drive the AudioEngine themselves from the main thread
+class EngineScope
+{
+public:
+	EngineScope();
+	~EngineScope();
+
+	EngineScope(const EngineScope&) = delete;
+	EngineScope& operator=(const EngineScope&) = delete;
+
+	//! Render the next period and return whether the device got any frames
+	bool renderPeriod();
+
+private:
+	class Device;
+	Device* m_device;
+};
+
+
+} // namespace lmms::benchmarks
+
+#endif // LMMS_BENCHMARK_H
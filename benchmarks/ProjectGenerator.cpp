@@ -0,0 +1,89 @@
+/*
+ * ProjectGenerator.cpp - creates synthetic projects for the render benchmarks
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ProjectGenerator.h"
+
+#include <cstdio>
+
+#include "AudioPort.h"
+#include "Effect.h"
+#include "EffectChain.h"
+#include "Engine.h"
+#include "InstrumentTrack.h"
+#include "MidiClip.h"
+#include "Note.h"
+#include "PluginFactory.h"
+#include "Song.h"
+
+namespace lmms::benchmarks
+{
+
+
+bool generateProject(const ProjectShape& shape)
+{
+	for (const auto& plugin : {shape.instrument, shape.effect})
+	{
+		if (getPluginFactory()->pluginInfo(plugin.toUtf8()).isNull())
+		{
+			std::fprintf(stderr, "Plugin \"%s\" not found\n", qPrintable(plugin));
+			return false;
+		}
+	}
+
+	Song* song = Engine::getSong();
+	song->clearProject();
+
+	constexpr int beatsPerBar = 4;
+	constexpr int ticksPerBeat = DefaultTicksPerBar / beatsPerBar;
+
+	for (int t = 0; t < shape.tracks; ++t)
+	{
+		auto track = dynamic_cast<InstrumentTrack*>(Track::create(Track::Type::Instrument, song));
+		track->loadInstrument(shape.instrument);
+
+		EffectChain* chain = track->audioPort()->effects();
+		for (int e = 0; e < shape.effects; ++e)
+		{
+			if (Effect* effect = Effect::instantiate(shape.effect, chain, nullptr))
+			{
+				chain->appendEffect(effect);
+			}
+		}
+
+		// Chords of stacked thirds, which differ between the tracks so that
+		// no two voices render the same signal
+		auto clip = dynamic_cast<MidiClip*>(track->createClip(TimePos(0)));
+		for (int beat = 0; beat < shape.bars * beatsPerBar; ++beat)
+		{
+			for (int v = 0; v < shape.voices; ++v)
+			{
+				const int key = DefaultKey - 12 + (t * 5 + v * 4) % 36;
+				clip->addNote(Note(TimePos(ticksPerBeat), TimePos(beat * ticksPerBeat), key), false);
+			}
+		}
+	}
+
+	return true;
+}
+
+
+} // namespace lmms::benchmarks
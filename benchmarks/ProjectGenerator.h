@@ -0,0 +1,53 @@
+/*
+ * ProjectGenerator.h - creates synthetic projects for the render benchmarks
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_PROJECT_GENERATOR_H
+#define LMMS_PROJECT_GENERATOR_H
+
+#include <QString>
+
+namespace lmms::benchmarks
+{
+
+
+//! Size of a generated project: `tracks` instrument tracks, each playing
+//! chords of `voices` notes on every beat through `effects` effects
+struct ProjectShape
+{
+	int tracks = 16;
+	int voices = 4;
+	int effects = 2;
+	int bars = 8;
+	QString instrument = "tripleoscillator";
+	QString effect = "amplifier";
+};
+
+
+//! Replace the current song with a generated project of the given shape.
+//! Returns false if the instrument or effect plugin couldn't be found; point
+//! LMMS_PLUGIN_DIR to the plugins of the build directory in that case.
+bool generateProject(const ProjectShape& shape);
+
+
+} // namespace lmms::benchmarks
+
+#endif // LMMS_PROJECT_GENERATOR_H
@@ -0,0 +1,103 @@
+/*
+ * BasicFiltersBenchmark.cpp - benchmarks for the filters of BasicFilters
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include "BasicFilters.h"
+#include "Benchmark.h"
+#include "SampleFrame.h"
+
+int main(int argc, char* argv[])
+{
+	using namespace lmms;
+	using FilterType = BasicFilters<>::FilterType;
+
+	QCoreApplication app(argc, argv);
+	benchmarks::Benchmark benchmark(argc, argv, "BasicFilters", 100000);
+
+	const fpp_t frames = benchmark.frames();
+	constexpr sample_rate_t sampleRate = 44100;
+
+	auto input = std::vector<SampleFrame>(frames);
+	for (fpp_t i = 0; i < frames; ++i)
+	{
+		input[i] = SampleFrame(std::sin(i * 0.05f) * 0.5f, std::sin(i * 0.07f) * 0.5f);
+	}
+	auto buffer = input;
+
+	// Sweeps for the modulated variants, as envelopes and LFOs deliver them
+	auto cutoff = std::vector<float>(frames);
+	auto resonance = std::vector<float>(frames);
+	for (fpp_t i = 0; i < frames; ++i)
+	{
+		cutoff[i] = 200.f + 8000.f * i / frames;
+		resonance[i] = 0.5f + 2.f * i / frames;
+	}
+
+	const std::pair<const char*, FilterType> types[] = {
+		{"LowPass", FilterType::LowPass},
+		{"Notch", FilterType::Notch},
+		{"Moog", FilterType::Moog},
+		{"DoubleLowPass", FilterType::DoubleLowPass},
+		{"Lowpass_RC24", FilterType::Lowpass_RC24},
+		{"Formantfilter", FilterType::Formantfilter},
+		{"Lowpass_SV", FilterType::Lowpass_SV},
+		{"Tripole", FilterType::Tripole}
+	};
+
+	for (const auto& [name, type] : types)
+	{
+		auto filter = BasicFilters<>(sampleRate);
+		filter.setFilterType(type);
+		filter.calcFilterCoeffs(1000.f, 1.f);
+
+		benchmark.run(QString("%1/perFrame").arg(name), [&] {
+			std::copy(input.begin(), input.end(), buffer.begin());
+			for (fpp_t f = 0; f < frames; ++f)
+			{
+				for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+				{
+					buffer[f][ch] = filter.update(buffer[f][ch], ch);
+				}
+			}
+		});
+
+		filter.clearHistory();
+		benchmark.run(QString("%1/block").arg(name), [&] {
+			std::copy(input.begin(), input.end(), buffer.begin());
+			filter.processBlock(buffer.data(), frames);
+		});
+
+		filter.clearHistory();
+		benchmark.run(QString("%1/modulated").arg(name), [&] {
+			std::copy(input.begin(), input.end(), buffer.begin());
+			filter.processBlock(buffer.data(), frames, cutoff.data(), 1, resonance.data(), 1);
+		});
+	}
+
+	return benchmark.finish();
+}
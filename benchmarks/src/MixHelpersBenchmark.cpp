@@ -0,0 +1,81 @@
+/*
+ * MixHelpersBenchmark.cpp - benchmarks for the mixing functions
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include "Benchmark.h"
+#include "MixHelpers.h"
+#include "SampleFrame.h"
+#include "ValueBuffer.h"
+
+int main(int argc, char* argv[])
+{
+	using namespace lmms;
+
+	QCoreApplication app(argc, argv);
+	benchmarks::Benchmark benchmark(argc, argv, "MixHelpers", 100000);
+
+	const int frames = static_cast<int>(benchmark.frames());
+
+	auto src = std::vector<SampleFrame>(frames);
+	auto dst = std::vector<SampleFrame>(frames);
+	for (int i = 0; i < frames; ++i)
+	{
+		src[i] = SampleFrame(std::sin(i * 0.01f), std::cos(i * 0.01f));
+	}
+
+	auto coeffs = ValueBuffer(frames);
+	coeffs.interpolate(0.f, 1.f);
+
+	benchmark.run("add", [&] {
+		MixHelpers::add(dst.data(), src.data(), frames);
+	});
+	benchmark.run("multiply", [&] {
+		MixHelpers::multiply(dst.data(), 0.5f, frames);
+	});
+	benchmark.run("addMultiplied", [&] {
+		MixHelpers::addMultiplied(dst.data(), src.data(), 0.5f, frames);
+	});
+	benchmark.run("addMultipliedByBuffer", [&] {
+		MixHelpers::addMultipliedByBuffer(dst.data(), src.data(), 0.5f, &coeffs, frames);
+	});
+	benchmark.run("addSanitizedMultiplied", [&] {
+		MixHelpers::addSanitizedMultiplied(dst.data(), src.data(), 0.5f, frames);
+	});
+	benchmark.run("addMultipliedStereo", [&] {
+		MixHelpers::addMultipliedStereo(dst.data(), src.data(), 0.5f, 0.25f, frames);
+	});
+	benchmark.run("multiplyAndAddMultiplied", [&] {
+		MixHelpers::multiplyAndAddMultiplied(dst.data(), src.data(), 0.5f, 0.5f, frames);
+	});
+	benchmark.run("sanitize", [&] {
+		MixHelpers::sanitize(dst.data(), frames);
+	});
+	benchmark.run("isSilent", [&] {
+		MixHelpers::isSilent(src.data(), frames);
+	});
+
+	return benchmark.finish();
+}
@@ -0,0 +1,105 @@
+/*
+ * OscillatorBenchmark.cpp - benchmarks for the oscillators
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include "AudioEngine.h"
+#include "AutomatableModel.h"
+#include "Benchmark.h"
+#include "Engine.h"
+#include "Oscillator.h"
+#include "SampleFrame.h"
+
+int main(int argc, char* argv[])
+{
+	using namespace lmms;
+	using WaveShape = Oscillator::WaveShape;
+	using ModulationAlgo = Oscillator::ModulationAlgo;
+
+	QCoreApplication app(argc, argv);
+	benchmarks::Benchmark benchmark(argc, argv, "Oscillator", 100000);
+	benchmarks::EngineScope engine;
+
+	const fpp_t frames = benchmark.frames();
+	auto buffer = std::vector<SampleFrame>(frames);
+
+	const float frequency = 440.f;
+	const float detuning = 1.f / Engine::audioEngine()->outputSampleRate();
+	const float phaseOffset = 0.f;
+	const float volume = 0.5f;
+
+	const std::pair<const char*, WaveShape> shapes[] = {
+		{"Sine", WaveShape::Sine},
+		{"Triangle", WaveShape::Triangle},
+		{"Saw", WaveShape::Saw},
+		{"Square", WaveShape::Square},
+		{"MoogSaw", WaveShape::MoogSaw},
+		{"Exponential", WaveShape::Exponential},
+		{"WhiteNoise", WaveShape::WhiteNoise}
+	};
+
+	for (const auto& [name, shape] : shapes)
+	{
+		auto shapeModel = IntModel(static_cast<int>(shape), 0, Oscillator::NumWaveShapes - 1);
+		auto algoModel = IntModel(0, 0, Oscillator::NumModulationAlgos - 1);
+
+		for (const bool waveTable : {false, true})
+		{
+			auto osc = Oscillator(&shapeModel, &algoModel, frequency, detuning, phaseOffset, volume);
+			osc.setUseWaveTable(waveTable);
+
+			benchmark.run(QString("%1/%2").arg(name, waveTable ? "wavetable" : "direct"), [&] {
+				osc.update(buffer.data(), frames, 0);
+				osc.update(buffer.data(), frames, 1);
+			});
+		}
+	}
+
+	const std::pair<const char*, ModulationAlgo> algos[] = {
+		{"PhaseModulation", ModulationAlgo::PhaseModulation},
+		{"AmplitudeModulation", ModulationAlgo::AmplitudeModulation},
+		{"SignalMix", ModulationAlgo::SignalMix},
+		{"SynchronizedBySubOsc", ModulationAlgo::SynchronizedBySubOsc},
+		{"FrequencyModulation", ModulationAlgo::FrequencyModulation}
+	};
+
+	// Two oscillators chained like those of TripleOscillator
+	for (const auto& [name, algo] : algos)
+	{
+		auto shapeModel = IntModel(static_cast<int>(WaveShape::Saw), 0, Oscillator::NumWaveShapes - 1);
+		auto algoModel = IntModel(static_cast<int>(algo), 0, Oscillator::NumModulationAlgos - 1);
+		const float subFrequency = frequency * 1.5f;
+
+		auto sub = Oscillator(&shapeModel, &algoModel, subFrequency, detuning, phaseOffset, volume);
+		auto osc = Oscillator(&shapeModel, &algoModel, frequency, detuning, phaseOffset, volume, &sub);
+
+		benchmark.run(QString("modulated/%1").arg(name), [&] {
+			osc.update(buffer.data(), frames, 0);
+			osc.update(buffer.data(), frames, 1);
+		});
+	}
+
+	return benchmark.finish();
+}
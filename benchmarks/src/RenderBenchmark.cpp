@@ -0,0 +1,111 @@
+/*
+ * RenderBenchmark.cpp - renders generated projects through the AudioEngine
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include "AudioEngine.h"
+#include "Benchmark.h"
+#include "Engine.h"
+#include "ProjectGenerator.h"
+#include "Song.h"
+
+namespace
+{
+
+//! Export the song once and return the time each period took, in microseconds
+std::vector<double> renderSong(lmms::benchmarks::EngineScope& engine, std::uint64_t& allocations)
+{
+	using namespace lmms;
+	using Clock = benchmarks::Benchmark::Clock;
+
+	Song* song = Engine::getSong();
+	song->startExport();
+
+	// The first buffer is empty, like in ProjectRenderer
+	engine.renderPeriod();
+
+	// Reserved up front, as growing the vector would count as allocations of the render path
+	const auto periods = (song->length() + 2) * DefaultTicksPerBar * Engine::framesPerTick()
+		/ Engine::audioEngine()->framesPerPeriod();
+	std::vector<double> times;
+	times.reserve(static_cast<std::size_t>(periods) + 1);
+	allocations = benchmarks::allocationCount();
+
+	while (!song->isExportDone())
+	{
+		const auto begin = Clock::now();
+		engine.renderPeriod();
+		const auto end = Clock::now();
+
+		if (times.size() < times.capacity())
+		{
+			times.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+		}
+	}
+
+	allocations = benchmarks::allocationCount() - allocations;
+	song->stopExport();
+
+	return times;
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+	using namespace lmms;
+
+	QCoreApplication app(argc, argv);
+	benchmarks::Benchmark benchmark(argc, argv, "Render");
+	benchmarks::EngineScope engine;
+
+	benchmarks::ProjectShape shape;
+	shape.tracks = benchmark.option("tracks", shape.tracks);
+	shape.voices = benchmark.option("voices", shape.voices);
+	shape.effects = benchmark.option("effects", shape.effects);
+	shape.bars = benchmark.option("bars", shape.bars);
+
+	if (!benchmarks::generateProject(shape))
+	{
+		return EXIT_FAILURE;
+	}
+
+	const QString name = QString("render/%1x%2x%3").arg(shape.tracks).arg(shape.voices).arg(shape.effects);
+	if (benchmark.isSelected(name))
+	{
+		std::uint64_t allocations = 0;
+
+		// The first pass warms up the caches and the pools of the instruments
+		renderSong(engine, allocations);
+		auto times = renderSong(engine, allocations);
+		benchmark.record(name, Engine::audioEngine()->framesPerPeriod(), std::move(times), allocations);
+	}
+
+	return benchmark.finish();
+}
@@ -0,0 +1,96 @@
+/*
+ * SampleBenchmark.cpp - benchmarks for sample playback and resampling
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <QCoreApplication>
+#include <samplerate.h>
+
+#include "AudioResampler.h"
+#include "Benchmark.h"
+#include "Sample.h"
+#include "SampleFrame.h"
+
+int main(int argc, char* argv[])
+{
+	using namespace lmms;
+
+	QCoreApplication app(argc, argv);
+	benchmarks::Benchmark benchmark(argc, argv, "Sample", 100000);
+	benchmarks::EngineScope engine;
+
+	const fpp_t frames = benchmark.frames();
+	auto buffer = std::vector<SampleFrame>(frames);
+
+	// Ten seconds of a decaying tone at 44.1 kHz, looped over its whole length
+	constexpr int sampleRate = 44100;
+	auto data = std::vector<SampleFrame>(sampleRate * 10);
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		const float value = std::sin(i * 0.0627f) * std::exp(-0.0001f * i);
+		data[i] = SampleFrame(value, value);
+	}
+	const auto sample = Sample(data.data(), data.size(), sampleRate);
+
+	const std::pair<const char*, int> modes[] = {
+		{"zeroOrderHold", SRC_ZERO_ORDER_HOLD},
+		{"linear", SRC_LINEAR},
+		{"sincFastest", SRC_SINC_FASTEST},
+		{"sincMedium", SRC_SINC_MEDIUM_QUALITY}
+	};
+
+	// Played at the base frequency, an octave up and a fifth down
+	const std::pair<const char*, float> pitches[] = {
+		{"base", DefaultBaseFreq},
+		{"octaveUp", DefaultBaseFreq * 2.f},
+		{"fifthDown", DefaultBaseFreq / 1.5f}
+	};
+
+	for (const auto& [modeName, mode] : modes)
+	{
+		for (const auto& [pitchName, frequency] : pitches)
+		{
+			auto state = Sample::PlaybackState(false, mode);
+			benchmark.run(QString("play/%1/%2").arg(modeName, pitchName), [&] {
+				sample.play(buffer.data(), &state, frames, frequency, Sample::Loop::On);
+			});
+		}
+	}
+
+	for (const auto& [modeName, mode] : modes)
+	{
+		auto resampler = AudioResampler(mode, DEFAULT_CHANNELS);
+		constexpr double ratio = 1.5;
+		const auto inputFrames = static_cast<long>(frames / ratio) + 1;
+		std::size_t position = 0;
+
+		benchmark.run(QString("resample/%1").arg(modeName), [&] {
+			if (position + inputFrames > data.size()) { position = 0; }
+			const auto result = resampler.resample(&data[position][0], inputFrames, &buffer[0][0], frames, ratio);
+			position += result.inputFramesUsed;
+		});
+	}
+
+	return benchmark.finish();
+}
@@ -38,6 +38,7 @@
 #include "LocklessList.h"
 #include "FifoBuffer.h"
 #include "AudioEngineProfiler.h"
+#include "AudioTap.h"
 #include "PlayHandle.h"
 
 
@@ -228,6 +229,12 @@ public:
 		return m_profiler.detailLoad(type);
 	}
 
+	//! Final output including master gain
+	AudioTap& masterTap()
+	{
+		return m_masterTap;
+	}
+
 	const qualitySettings & currentQualitySettings() const
 	{
 		return m_qualitySettings;
@@ -397,6 +404,8 @@ private:
 
 	AudioEngineProfiler m_profiler;
 
+	AudioTap m_masterTap;
+
 	bool m_clearSignal;
 
 	std::recursive_mutex m_changeMutex;
@@ -31,6 +31,7 @@
 
 #include "lmms_basics.h"
 #include "MicroTimer.h"
+#include "RealtimeChecker.h"
 
 namespace lmms
 {
@@ -55,6 +56,17 @@ public:
 
 	void setOutputFile( const QString& outputFile );
 
+	//! Allocations, deallocations and locks on the render threads during the
+	//! last period. Only counted in builds with WANT_DEBUG_REALTIME.
+	RealtimeChecker::Counts realtimeViolations() const
+	{
+		RealtimeChecker::Counts counts;
+		counts.allocations = m_allocations.load(std::memory_order_relaxed);
+		counts.deallocations = m_deallocations.load(std::memory_order_relaxed);
+		counts.locks = m_locks.load(std::memory_order_relaxed);
+		return counts;
+	}
+
 	enum class DetailType {
 		NoteSetup,
 		Instruments,
@@ -104,6 +116,10 @@ private:
 	std::array<MicroTimer, DetailCount> m_detailTimer;
 	std::array<int, DetailCount> m_detailTime{0};
 	std::array<std::atomic<float>, DetailCount> m_detailLoad{0};
+
+	std::atomic<std::uint64_t> m_allocations{0};
+	std::atomic<std::uint64_t> m_deallocations{0};
+	std::atomic<std::uint64_t> m_locks{0};
 };
 
 } // namespace lmms
@@ -28,6 +28,7 @@
 #include <QThread>
 
 #include <atomic>
+#include <cstddef>
 
 class QWaitCondition;
 
@@ -69,6 +70,10 @@ public:
 		void run();
 		void wait();
 
+		// process every job which is currently queued once, returns
+		// whether there was any
+		bool processPending();
+
 	private:
 		std::atomic<ThreadableJob*> m_items[JOB_QUEUE_SIZE];
 		std::atomic_size_t m_writeIndex;
@@ -108,6 +113,11 @@ public:
 
 	static void startAndWaitForJobs();
 
+	// process jobs which are spawned by a job of the running stage, e.g. parts of
+	// one instrument's period - sleeping worker threads are woken up to help, and
+	// the calling thread keeps processing queued jobs until all given jobs are done
+	static void processSubJobs( ThreadableJob * const * _jobs, std::size_t _count );
+
 
 private:
 	void run() override;
@@ -29,6 +29,7 @@
 #include <QString>
 #include <QMutex>
 
+#include "AudioTap.h"
 #include "PlayHandle.h"
 
 namespace lmms
@@ -83,6 +84,12 @@ public:
 		return m_effects.get();
 	}
 
+	//! Post-effect output of this port, as sent to the mixer
+	AudioTap& tap()
+	{
+		return m_tap;
+	}
+
 	void setNextMixerChannel( const mix_ch_t _chnl )
 	{
 		m_nextMixerChannel = _chnl;
@@ -113,6 +120,10 @@ private:
 	volatile bool m_bufferUsage;
 
 	SampleFrame* m_portBuffer;
+	// whether m_portBuffer is known to hold only zeros
+	bool m_portBufferSilent;
+	// whether m_portBuffer holds output for the mixer in this period
+	bool m_hasOutput;
 	QMutex m_portBufferLock;
 
 	bool m_extOutputEnabled;
@@ -122,6 +133,8 @@ private:
 
 	std::unique_ptr<EffectChain> m_effects;
 
+	AudioTap m_tap;
+
 	PlayHandleList m_playHandles;
 	QMutex m_playHandleLock;
 
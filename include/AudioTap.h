@@ -0,0 +1,201 @@
+/*
+ * AudioTap.h - lock-free analysis tap for meters, scopes and analyzers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_AUDIO_TAP_H
+#define LMMS_AUDIO_TAP_H
+
+#include <array>
+#include <atomic>
+
+#include "LocklessRingBuffer.h"
+#include "SampleFrame.h"
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+/**
+	A point in the signal flow (audio port, mixer channel, master output or an
+	analysis effect) that meters and visualizations can observe without locks.
+
+	The render thread calls write() once per period. The tap then
+	- feeds a single-producer/multi-consumer ring buffer, but only while at
+	  least one AudioTapReader is attached, and
+	- computes peak, RMS and momentary loudness (LUFS) once for any number of
+	  meters. The peaks are only computed while peak() is being read, RMS and
+	  loudness only while rms() or loudness() are.
+
+	Peak, RMS and loudness include the gain passed to write(), while the ring
+	buffer always receives the unscaled signal.
+*/
+class LMMS_EXPORT AudioTap
+{
+public:
+	//! Capacity in frames used by taps which are not given an explicit one
+	static constexpr std::size_t DefaultCapacity = 4096;
+
+	//! Loudness reported for silence
+	static constexpr float SilenceLufs = -70.f;
+
+	//! Readers blocking in waitForData() are only woken up if notifyReaders is set
+	explicit AudioTap(std::size_t capacity = DefaultCapacity, bool notifyReaders = false);
+	~AudioTap() = default;
+
+	AudioTap(const AudioTap&) = delete;
+	AudioTap& operator=(const AudioTap&) = delete;
+
+	//! Called from the render thread only; never blocks or allocates
+	void write(const SampleFrame* buffer, fpp_t frames, float gain = 1.0f);
+
+	//! Let the meters fall back to zero for a period without output; the ring buffer is not fed
+	void writeSilence(fpp_t frames);
+
+	//! Absolute peak of the given channel over roughly the last 20 to 40 ms.
+	//! Reading it makes the tap compute the peaks for the next second.
+	float peak(ch_cnt_t channel) const
+	{
+		m_peaksRead.store(true, std::memory_order_relaxed);
+		return std::max(m_peakCurrent[channel].load(std::memory_order_relaxed),
+			m_peakPrevious[channel].load(std::memory_order_relaxed));
+	}
+
+	//! RMS of the given channel, exponentially averaged over ~300 ms.
+	//! Reading it makes the tap compute RMS and loudness for the next second.
+	float rms(ch_cnt_t channel) const
+	{
+		m_loudnessRead.store(true, std::memory_order_relaxed);
+		return m_rms[channel].load(std::memory_order_relaxed);
+	}
+
+	//! Momentary loudness in LUFS (K-weighted, exponentially averaged over ~400 ms).
+	//! Reading it makes the tap compute RMS and loudness for the next second.
+	float loudness() const
+	{
+		m_loudnessRead.store(true, std::memory_order_relaxed);
+		return m_loudness.load(std::memory_order_relaxed);
+	}
+
+	std::size_t capacity() const { return m_ringBuffer.capacity(); }
+	void wakeAll() { m_ringBuffer.wakeAll(); }
+
+	bool hasReaders() const { return m_readers.load(std::memory_order_relaxed) > 0; }
+
+private:
+	enum class MeterState
+	{
+		Idle,
+		Active,
+		Expired //!< Active up to the previous period, but not read since
+	};
+
+	struct Biquad
+	{
+		float b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+		std::array<float, DEFAULT_CHANNELS> x1{}, x2{}, y1{}, y2{};
+
+		float process(float in, ch_cnt_t ch)
+		{
+			const float out = b0 * in + b1 * x1[ch] + b2 * x2[ch] - a1 * y1[ch] - a2 * y2[ch];
+			x2[ch] = x1[ch];
+			x1[ch] = in;
+			y2[ch] = y1[ch];
+			y1[ch] = out;
+			return out;
+		}
+
+		void reset()
+		{
+			x1 = x2 = y1 = y2 = {};
+		}
+	};
+
+	//! Whether a meter still reads the values, counting down the metering time
+	static MeterState meterPeriod(std::atomic<bool>& read, f_cnt_t& meterFrames, fpp_t frames);
+
+	void publishPeaks(const std::array<float, DEFAULT_CHANNELS>& peaks, fpp_t frames);
+	void updatePeaks(const SampleFrame* buffer, fpp_t frames, float gain);
+	void resetPeaks();
+
+	void updateCoefficients(sample_rate_t sampleRate);
+	void updateLoudness(const SampleFrame* buffer, fpp_t frames, float gain);
+	void decayLoudness(fpp_t frames);
+	void publishLoudness();
+	void resetLoudness();
+
+	LocklessRingBuffer<SampleFrame> m_ringBuffer;
+	const bool m_notifyReaders;
+	std::atomic<int> m_readers = 0;
+	mutable std::atomic<bool> m_peaksRead = false;
+	mutable std::atomic<bool> m_loudnessRead = false;
+
+	// published meter values
+	std::array<std::atomic<float>, DEFAULT_CHANNELS> m_peakCurrent{};
+	std::array<std::atomic<float>, DEFAULT_CHANNELS> m_peakPrevious{};
+	std::array<std::atomic<float>, DEFAULT_CHANNELS> m_rms{};
+	std::atomic<float> m_loudness = SilenceLufs;
+
+	// render thread state
+	f_cnt_t m_peakMeterFrames = 0;
+	f_cnt_t m_peakFrames = 0;
+	std::array<float, DEFAULT_CHANNELS> m_peakAccumulator{};
+
+	f_cnt_t m_loudnessMeterFrames = 0;
+	sample_rate_t m_sampleRate = 0;
+	std::array<float, DEFAULT_CHANNELS> m_meanSquare{};
+	float m_weightedMeanSquare = 0.f;
+	Biquad m_preFilter;
+	Biquad m_rlbFilter;
+
+	friend class AudioTapReader;
+};
+
+
+/**
+	Consumer side of an AudioTap. Attaching a reader enables the tap's ring
+	buffer; the reader only sees every n-th frame when created with a
+	decimation of n, which is usually enough for displays.
+*/
+class LMMS_EXPORT AudioTapReader : public LocklessRingBufferReader<SampleFrame>
+{
+public:
+	AudioTapReader(AudioTap& tap, unsigned int decimation = 1);
+	~AudioTapReader();
+
+	AudioTapReader(const AudioTapReader&) = delete;
+	AudioTapReader& operator=(const AudioTapReader&) = delete;
+
+	AudioTap& tap() { return *m_tap; }
+
+	//! Drain the ring buffer and keep the newest decimated frames in dest, which holds
+	//! `frames` frames and is shifted like a scrolling window. Returns true if new data arrived.
+	bool fetchLatest(SampleFrame* dest, std::size_t frames);
+
+private:
+	AudioTap* m_tap;
+	unsigned int m_decimation;
+	unsigned int m_phase = 0;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_AUDIO_TAP_H
@@ -27,6 +27,11 @@
 #ifndef LMMS_AUTOMATION_CLIP_H
 #define LMMS_AUTOMATION_CLIP_H
 
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
 #include <QMap>
 #include <QPointer>
 #if (QT_VERSION >= QT_VERSION_CHECK(5,14,0))
@@ -107,6 +112,10 @@ public:
 		const bool ignoreSurroundingPoints = true
 	);
 
+	//! Puts all given values like putValue() does, but generates the tangents,
+	//! updates the length and emits dataChanged() only once
+	void putValueBatch(const std::vector<std::pair<TimePos, float>>& values, const bool quantPos = true);
+
 	void removeNode(const TimePos & time);
 	void removeNodes(const int tick0, const int tick1);
 
@@ -207,7 +216,24 @@ private:
 	void cleanObjects();
 	void generateTangents();
 	void generateTangents(timeMap::iterator it, int numToGenerate);
-	float valueAt( timeMap::const_iterator v, int offset ) const;
+
+	//! A node together with the curve to the next node, with everything that
+	//! valueAt() needs to evaluate the curve without looking at the neighbours
+	struct Segment
+	{
+		int pos;
+		float inValue;
+		//! 1 / distance to the next node, 0 for the last node
+		float invLength;
+		//! The value at pos + offset is ((a * t + b) * t + c) * t + d,
+		//! with t = offset * invLength
+		float a, b, c, d;
+	};
+
+	const std::vector<Segment>& segments() const;
+	std::size_t segmentAt(int time) const;
+	static float valueAt(const Segment& segment, int offset);
+	void invalidateSegments() { m_segmentsValid = false; }
 
 	/**
 	 * @brief
@@ -231,6 +257,14 @@ private:
 	objectVector m_objects;
 	timeMap m_timeMap;	// actual values
 	timeMap m_oldTimeMap;	// old values for storing the values before setDragValue() is called.
+
+	// Flat copy of m_timeMap, rebuilt by valueAt() after the nodes changed
+	mutable std::vector<Segment> m_segments;
+	mutable std::atomic<bool> m_segmentsValid{false};
+	// Segment of the previous valueAt() call. Playback asks for the same or
+	// one of the following segments most of the time.
+	mutable std::size_t m_segmentCursor = 0;
+
 	float m_tension;
 	bool m_hasAutomation;
 	ProgressionType m_progressionType;
@@ -64,14 +64,13 @@ protected slots:
 protected:
 	void constructContextMenu( QMenu * ) override;
 	void mouseDoubleClickEvent(QMouseEvent * me ) override;
-	void paintEvent( QPaintEvent * pe ) override;
+	void paintClip(QPainter& p) override;
 	void dragEnterEvent( QDragEnterEvent * _dee ) override;
 	void dropEvent( QDropEvent * _de ) override;
 
 
 private:
 	AutomationClip * m_clip;
-	QPixmap m_paintPixmap;
 	
 	QStaticText m_staticTextName;
 	void scaleTimemapToFit( float oldMin, float oldMax );
@@ -37,10 +37,12 @@
 
 #include <cmath>
 #include <array>
+#include <limits>
 
 #include "lmms_basics.h"
 #include "lmms_constants.h"
 #include "interpolation.h"
+#include "SampleFrame.h"
 
 namespace lmms
 {
@@ -180,6 +182,55 @@ public:
 		m_z2[ch] = m_b2 * in - m_a2 * out;
 		return out;
 	}
+
+	//! a1, a2, b0, b1, b2
+	using Coeffs = std::array<float, 5>;
+
+	inline Coeffs coeffs() const
+	{
+		return { m_a1, m_a2, m_b0, m_b1, m_b2 };
+	}
+
+	//! Filter a block of frames in place, ramping linearly from the coefficients
+	//! `from` to the current ones. The history of all channels is kept in locals
+	//! and updated in lockstep, so that both stereo channels share one vector register.
+	inline void processBlock( SampleFrame* buf, fpp_t frames, const Coeffs& from )
+	{
+		static_assert( CHANNELS == DEFAULT_CHANNELS, "block processing requires stereo frames" );
+
+		const float step = frames > 0 ? 1.0f / frames : 0.0f;
+		float a1 = from[0], a2 = from[1], b0 = from[2], b1 = from[3], b2 = from[4];
+		const float da1 = ( m_a1 - a1 ) * step;
+		const float da2 = ( m_a2 - a2 ) * step;
+		const float db0 = ( m_b0 - b0 ) * step;
+		const float db1 = ( m_b1 - b1 ) * step;
+		const float db2 = ( m_b2 - b2 ) * step;
+
+		std::array<float, CHANNELS> z1, z2;
+		std::copy( m_z1, m_z1 + CHANNELS, z1.begin() );
+		std::copy( m_z2, m_z2 + CHANNELS, z2.begin() );
+
+		for( fpp_t f = 0; f < frames; ++f )
+		{
+			a1 += da1; a2 += da2; b0 += db0; b1 += db1; b2 += db2;
+			for( ch_cnt_t ch = 0; ch < CHANNELS; ++ch )
+			{
+				const float in = buf[f][ch];
+				const float out = z1[ch] + b0 * in;
+				z1[ch] = b1 * in + z2[ch] - a1 * out;
+				z2[ch] = b2 * in - a2 * out;
+				buf[f][ch] = out;
+			}
+		}
+
+		std::copy( z1.begin(), z1.end(), m_z1 );
+		std::copy( z2.begin(), z2.end(), m_z2 );
+	}
+
+	inline void processBlock( SampleFrame* buf, fpp_t frames )
+	{
+		processBlock( buf, frames, coeffs() );
+	}
 private:
 	float m_a1, m_a2, m_b0, m_b1, m_b2;
 	float m_z1 [CHANNELS], m_z2 [CHANNELS];
@@ -263,6 +314,13 @@ public:
 
 	inline void setFilterType( const FilterType _idx )
 	{
+		if( _idx != m_requestedType )
+		{
+			// coefficients of another filter type must neither be reused nor ramped from
+			m_requestedType = _idx;
+			invalidateCoeffs();
+		}
+
 		m_doubleFilter = _idx == FilterType::DoubleLowPass || _idx == FilterType::DoubleMoog;
 		if( !m_doubleFilter )
 		{
@@ -285,6 +343,8 @@ public:
 	}
 
 	inline BasicFilters( const sample_rate_t _sample_rate ) :
+		m_type( FilterType::LowPass ),
+		m_requestedType( FilterType::LowPass ),
 		m_doubleFilter( false ),
 		m_sampleRate( (float) _sample_rate ),
 		m_sampleRatio( 1.0f / m_sampleRate ),
@@ -333,6 +393,7 @@ public:
 	{
 		m_sampleRate = sampleRate;
 		m_sampleRatio = 1.f / m_sampleRate;
+		invalidateCoeffs();
 		if (m_subFilter != nullptr)
 		{
 			m_subFilter->setSampleRate(m_sampleRate);
@@ -341,362 +402,415 @@ public:
 
 	inline sample_t update( sample_t _in0, ch_cnt_t _chnl )
 	{
-		sample_t out = 0.0f;
-		switch( m_type )
+		return dispatch( [&]( auto type ) { return tick<decltype( type )::value>( _in0, _chnl ); } );
+	}
+
+	//! Number of frames between coefficient updates in processBlock() with modulated parameters
+	static constexpr fpp_t CoeffUpdateInterval = 16;
+
+	//! Filter a block of frames in place using the current coefficients.
+	//! The filter type is dispatched once per block instead of once per sample.
+	inline void processBlock( SampleFrame* buf, fpp_t frames )
+	{
+		dispatch( [&]( auto type ) { processFrames<decltype( type )::value>( buf, frames ); } );
+	}
+
+	//! Filter a block of frames in place with modulated cutoff and resonance.
+	//! Parameters are read through pointer/increment pairs (an increment of 0 means the
+	//! value is constant) and applied every CoeffUpdateInterval frames. Biquad-based types
+	//! interpolate their coefficients across each sub-block; the others step per sub-block.
+	inline void processBlock( SampleFrame* buf, fpp_t frames,
+					const float* cutoff, int cutoffInc,
+					const float* resonance, int resonanceInc )
+	{
+		dispatch( [&]( auto type )
 		{
-			case FilterType::Moog:
+			constexpr FilterType Type = decltype( type )::value;
+			for( fpp_t offset = 0; offset < frames; offset += CoeffUpdateInterval )
 			{
-				sample_t x = _in0 - m_r*m_y4[_chnl];
+				const fpp_t len = std::min<fpp_t>( CoeffUpdateInterval, frames - offset );
+				const float cut = cutoff[offset * cutoffInc];
+				const float res = resonance[offset * resonanceInc];
+
+				if( cut == m_lastCut && res == m_lastRes )
+				{
+					processFrames<Type>( buf + offset, len );
+					continue;
+				}
+
+				if constexpr( isBiQuadType( Type ) )
+				{
+					const bool ramp = !std::isnan( m_lastCut );
+					const auto from = m_biQuad.coeffs();
+					calcFilterCoeffs( cut, res );
+					m_biQuad.processBlock( buf + offset, len, ramp ? from : m_biQuad.coeffs() );
+					if( m_doubleFilter )
+					{
+						m_subFilter->m_biQuad.processBlock( buf + offset, len, ramp ? from : m_biQuad.coeffs() );
+					}
+				}
+				else
+				{
+					calcFilterCoeffs( cut, res );
+					processFrames<Type>( buf + offset, len );
+				}
+			}
+		} );
+	}
 
-				// four cascaded onepole filters
-				// (bilinear transform)
+	//! Process one sample of one channel; the filter type is resolved at compile time
+	template<FilterType Type>
+	inline sample_t tick( sample_t _in0, ch_cnt_t _chnl )
+	{
+		sample_t out = 0.0f;
+		if constexpr (Type == FilterType::Moog)
+		{
+			sample_t x = _in0 - m_r*m_y4[_chnl];
+
+			// four cascaded onepole filters
+			// (bilinear transform)
+			m_y1[_chnl] = std::clamp((x + m_oldx[_chnl]) * m_p
+						- m_k * m_y1[_chnl], -10.0f,
+							10.0f);
+			m_y2[_chnl] = std::clamp((m_y1[_chnl] + m_oldy1[_chnl]) * m_p
+						- m_k * m_y2[_chnl], -10.0f,
+							10.0f);
+			m_y3[_chnl] = std::clamp((m_y2[_chnl] + m_oldy2[_chnl]) * m_p
+						- m_k * m_y3[_chnl], -10.0f,
+							10.0f );
+			m_y4[_chnl] = std::clamp((m_y3[_chnl] + m_oldy3[_chnl]) * m_p
+						- m_k * m_y4[_chnl], -10.0f,
+							10.0f);
+
+			m_oldx[_chnl] = x;
+			m_oldy1[_chnl] = m_y1[_chnl];
+			m_oldy2[_chnl] = m_y2[_chnl];
+			m_oldy3[_chnl] = m_y3[_chnl];
+			out = m_y4[_chnl] - m_y4[_chnl] * m_y4[_chnl] *
+					m_y4[_chnl] * ( 1.0f / 6.0f );
+		}
+		
+		// 3x onepole filters with 4x oversampling and interpolation of oversampled signal:
+		// input signal is linear-interpolated after oversampling, output signal is averaged from oversampled outputs
+		else if constexpr (Type == FilterType::Tripole)
+		{
+			float ip = 0.0f;
+			for( int i = 0; i < 4; ++i )
+			{
+				ip += 0.25f;
+				sample_t x = linearInterpolate( m_last[_chnl], _in0, ip ) - m_r * m_y3[_chnl];
+				
 				m_y1[_chnl] = std::clamp((x + m_oldx[_chnl]) * m_p
-							- m_k * m_y1[_chnl], -10.0f,
-								10.0f);
+						- m_k * m_y1[_chnl], -10.0f,
+							10.0f);
 				m_y2[_chnl] = std::clamp((m_y1[_chnl] + m_oldy1[_chnl]) * m_p
 							- m_k * m_y2[_chnl], -10.0f,
 								10.0f);
 				m_y3[_chnl] = std::clamp((m_y2[_chnl] + m_oldy2[_chnl]) * m_p
 							- m_k * m_y3[_chnl], -10.0f,
-								10.0f );
-				m_y4[_chnl] = std::clamp((m_y3[_chnl] + m_oldy3[_chnl]) * m_p
-							- m_k * m_y4[_chnl], -10.0f,
 								10.0f);
-
 				m_oldx[_chnl] = x;
 				m_oldy1[_chnl] = m_y1[_chnl];
 				m_oldy2[_chnl] = m_y2[_chnl];
-				m_oldy3[_chnl] = m_y3[_chnl];
-				out = m_y4[_chnl] - m_y4[_chnl] * m_y4[_chnl] *
-						m_y4[_chnl] * ( 1.0f / 6.0f );
-				break;
-			}
-			
-			// 3x onepole filters with 4x oversampling and interpolation of oversampled signal:
-			// input signal is linear-interpolated after oversampling, output signal is averaged from oversampled outputs
-			case FilterType::Tripole:
-			{
-				float ip = 0.0f;
-				for( int i = 0; i < 4; ++i )
-				{
-					ip += 0.25f;
-					sample_t x = linearInterpolate( m_last[_chnl], _in0, ip ) - m_r * m_y3[_chnl];
-					
-					m_y1[_chnl] = std::clamp((x + m_oldx[_chnl]) * m_p
-							- m_k * m_y1[_chnl], -10.0f,
-								10.0f);
-					m_y2[_chnl] = std::clamp((m_y1[_chnl] + m_oldy1[_chnl]) * m_p
-								- m_k * m_y2[_chnl], -10.0f,
-									10.0f);
-					m_y3[_chnl] = std::clamp((m_y2[_chnl] + m_oldy2[_chnl]) * m_p
-								- m_k * m_y3[_chnl], -10.0f,
-									10.0f);
-					m_oldx[_chnl] = x;
-					m_oldy1[_chnl] = m_y1[_chnl];
-					m_oldy2[_chnl] = m_y2[_chnl];
-					
-					out += ( m_y3[_chnl] - m_y3[_chnl] * m_y3[_chnl] * m_y3[_chnl] * ( 1.0f / 6.0f ) );
-				}
-				out *= 0.25f;
-				m_last[_chnl] = _in0;
-				return out;
+				
+				out += ( m_y3[_chnl] - m_y3[_chnl] * m_y3[_chnl] * m_y3[_chnl] * ( 1.0f / 6.0f ) );
 			}
+			out *= 0.25f;
+			m_last[_chnl] = _in0;
+			return out;
+		}
+		
+		// 4-pole state-variant lowpass filter, adapted from Nekobee source code
+		// and extended to other SV filter types
+		// /* Hal Chamberlin's state variable filter */
+		
+		else if constexpr (Type == FilterType::Lowpass_SV || Type == FilterType::Bandpass_SV)
+		{
+			float highpass;
 			
-			// 4-pole state-variant lowpass filter, adapted from Nekobee source code
-			// and extended to other SV filter types
-			// /* Hal Chamberlin's state variable filter */
-			
-			case FilterType::Lowpass_SV:
-			case FilterType::Bandpass_SV:
+			for( int i = 0; i < 2; ++i ) // 2x oversample
 			{
-				float highpass;
-				
-				for( int i = 0; i < 2; ++i ) // 2x oversample
-				{
-					m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];				/* delay2/4 = lowpass output */
-					highpass = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
-					m_delay1[_chnl] = m_svf1 * highpass + m_delay1[_chnl];           			/* delay1/3 = bandpass output */
-
-					m_delay4[_chnl] = m_delay4[_chnl] + m_svf2 * m_delay3[_chnl];
-					highpass = m_delay2[_chnl] - m_delay4[_chnl] - m_svq * m_delay3[_chnl];
-					m_delay3[_chnl] = m_svf2 * highpass + m_delay3[_chnl];
-				}
+				m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];				/* delay2/4 = lowpass output */
+				highpass = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
+				m_delay1[_chnl] = m_svf1 * highpass + m_delay1[_chnl];           			/* delay1/3 = bandpass output */
 
-				/* mix filter output into output buffer */
-				return m_type == FilterType::Lowpass_SV 
-					? m_delay4[_chnl]
-					: m_delay3[_chnl];
+				m_delay4[_chnl] = m_delay4[_chnl] + m_svf2 * m_delay3[_chnl];
+				highpass = m_delay2[_chnl] - m_delay4[_chnl] - m_svq * m_delay3[_chnl];
+				m_delay3[_chnl] = m_svf2 * highpass + m_delay3[_chnl];
 			}
-			
-			case FilterType::Highpass_SV:
-			{
-				float hp;
-				for( int i = 0; i < 2; ++i ) // 2x oversample
-				{				
-					m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];
-					hp = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
-					m_delay1[_chnl] = m_svf1 * hp + m_delay1[_chnl];
-				}
-				
-				return hp;
+
+			/* mix filter output into output buffer */
+			return Type == FilterType::Lowpass_SV 
+				? m_delay4[_chnl]
+				: m_delay3[_chnl];
+		}
+		
+		else if constexpr (Type == FilterType::Highpass_SV)
+		{
+			float hp;
+			for( int i = 0; i < 2; ++i ) // 2x oversample
+			{				
+				m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];
+				hp = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
+				m_delay1[_chnl] = m_svf1 * hp + m_delay1[_chnl];
 			}
 			
-			case FilterType::Notch_SV:
+			return hp;
+		}
+		
+		else if constexpr (Type == FilterType::Notch_SV)
+		{
+			float hp1;
+			for( int i = 0; i < 2; ++i ) // 2x oversample
 			{
-				float hp1;
-				for( int i = 0; i < 2; ++i ) // 2x oversample
-				{
-					m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];				/* delay2/4 = lowpass output */
-					hp1 = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
-					m_delay1[_chnl] = m_svf1 * hp1 + m_delay1[_chnl];           			/* delay1/3 = bandpass output */
-
-					m_delay4[_chnl] = m_delay4[_chnl] + m_svf2 * m_delay3[_chnl];
-					float hp2 = m_delay2[_chnl] - m_delay4[_chnl] - m_svq * m_delay3[_chnl];
-					m_delay3[_chnl] = m_svf2 * hp2 + m_delay3[_chnl];
-				}
+				m_delay2[_chnl] = m_delay2[_chnl] + m_svf1 * m_delay1[_chnl];				/* delay2/4 = lowpass output */
+				hp1 = _in0 - m_delay2[_chnl] - m_svq * m_delay1[_chnl];
+				m_delay1[_chnl] = m_svf1 * hp1 + m_delay1[_chnl];           			/* delay1/3 = bandpass output */
 
-				/* mix filter output into output buffer */
-				return m_delay4[_chnl] + hp1;
+				m_delay4[_chnl] = m_delay4[_chnl] + m_svf2 * m_delay3[_chnl];
+				float hp2 = m_delay2[_chnl] - m_delay4[_chnl] - m_svq * m_delay3[_chnl];
+				m_delay3[_chnl] = m_svf2 * hp2 + m_delay3[_chnl];
 			}
 
+			/* mix filter output into output buffer */
+			return m_delay4[_chnl] + hp1;
+		}
+
 
-			// 4-times oversampled simulation of an active RC-Bandpass,-Lowpass,-Highpass-
-			// Filter-Network as it was used in nearly all modern analog synthesizers. This
-			// can be driven up to self-oscillation (BTW: do not remove the limits!!!).
-			// (C) 1998 ... 2009 S.Fendt. Released under the GPL v2.0  or any later version.
+		// 4-times oversampled simulation of an active RC-Bandpass,-Lowpass,-Highpass-
+		// Filter-Network as it was used in nearly all modern analog synthesizers. This
+		// can be driven up to self-oscillation (BTW: do not remove the limits!!!).
+		// (C) 1998 ... 2009 S.Fendt. Released under the GPL v2.0  or any later version.
 
-			case FilterType::Lowpass_RC12:
+		else if constexpr (Type == FilterType::Lowpass_RC12)
+		{
+			sample_t lp = 0.0f;
+			for( int n = 4; n != 0; --n )
 			{
-				sample_t lp = 0.0f;
-				for( int n = 4; n != 0; --n )
-				{
-					sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					lp = in * m_rcb + m_rclp0[_chnl] * m_rca;
-					lp = std::clamp(lp, -1.0f, 1.0f);
+				lp = in * m_rcb + m_rclp0[_chnl] * m_rca;
+				lp = std::clamp(lp, -1.0f, 1.0f);
 
-					sample_t hp = m_rcc * (m_rchp0[_chnl] + in - m_rclast0[_chnl]);
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				sample_t hp = m_rcc * (m_rchp0[_chnl] + in - m_rclast0[_chnl]);
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					sample_t bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				sample_t bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_rclast0[_chnl] = in;
-					m_rclp0[_chnl] = lp;
-					m_rchp0[_chnl] = hp;
-					m_rcbp0[_chnl] = bp;
-				}
-				return lp;
+				m_rclast0[_chnl] = in;
+				m_rclp0[_chnl] = lp;
+				m_rchp0[_chnl] = hp;
+				m_rcbp0[_chnl] = bp;
 			}
-			case FilterType::Highpass_RC12:
-			case FilterType::Bandpass_RC12:
+			return lp;
+		}
+		else if constexpr (Type == FilterType::Highpass_RC12 || Type == FilterType::Bandpass_RC12)
+		{
+			sample_t hp, bp;
+			for( int n = 4; n != 0; --n )
 			{
-				sample_t hp, bp;
-				for( int n = 4; n != 0; --n )
-				{
-					sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_rcc * ( m_rchp0[_chnl] + in - m_rclast0[_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_rcc * ( m_rchp0[_chnl] + in - m_rclast0[_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_rclast0[_chnl] = in;
-					m_rchp0[_chnl] = hp;
-					m_rcbp0[_chnl] = bp;
-				}
-				return m_type == FilterType::Highpass_RC12 ? hp : bp;
+				m_rclast0[_chnl] = in;
+				m_rchp0[_chnl] = hp;
+				m_rcbp0[_chnl] = bp;
 			}
+			return Type == FilterType::Highpass_RC12 ? hp : bp;
+		}
 
-			case FilterType::Lowpass_RC24:
+		else if constexpr (Type == FilterType::Lowpass_RC24)
+		{
+			sample_t lp;
+			for( int n = 4; n != 0; --n )
 			{
-				sample_t lp;
-				for( int n = 4; n != 0; --n )
-				{
-					// first stage is as for the 12dB case...
-					sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				// first stage is as for the 12dB case...
+				sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					lp = in * m_rcb + m_rclp0[_chnl] * m_rca;
-					lp = std::clamp(lp, -1.0f, 1.0f);
+				lp = in * m_rcb + m_rclp0[_chnl] * m_rca;
+				lp = std::clamp(lp, -1.0f, 1.0f);
 
-					sample_t hp = m_rcc * ( m_rchp0[_chnl] + in - m_rclast0[_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				sample_t hp = m_rcc * ( m_rchp0[_chnl] + in - m_rclast0[_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					sample_t bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				sample_t bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_rclast0[_chnl] = in;
-					m_rclp0[_chnl] = lp;
-					m_rcbp0[_chnl] = bp;
-					m_rchp0[_chnl] = hp;
+				m_rclast0[_chnl] = in;
+				m_rclp0[_chnl] = lp;
+				m_rcbp0[_chnl] = bp;
+				m_rchp0[_chnl] = hp;
 
-					// second stage gets the output of the first stage as input...
-					in = lp + m_rcbp1[_chnl] * m_rcq;
-					in = std::clamp(in, -1.0f, 1.0f );
+				// second stage gets the output of the first stage as input...
+				in = lp + m_rcbp1[_chnl] * m_rcq;
+				in = std::clamp(in, -1.0f, 1.0f );
 
-					lp = in * m_rcb + m_rclp1[_chnl] * m_rca;
-					lp = std::clamp(lp, -1.0f, 1.0f);
+				lp = in * m_rcb + m_rclp1[_chnl] * m_rca;
+				lp = std::clamp(lp, -1.0f, 1.0f);
 
-					hp = m_rcc * ( m_rchp1[_chnl] + in - m_rclast1[_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_rcc * ( m_rchp1[_chnl] + in - m_rclast1[_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_rcb + m_rcbp1[_chnl] * m_rca;
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_rcb + m_rcbp1[_chnl] * m_rca;
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_rclast1[_chnl] = in;
-					m_rclp1[_chnl] = lp;
-					m_rcbp1[_chnl] = bp;
-					m_rchp1[_chnl] = hp;
-				}
-				return lp;
+				m_rclast1[_chnl] = in;
+				m_rclp1[_chnl] = lp;
+				m_rcbp1[_chnl] = bp;
+				m_rchp1[_chnl] = hp;
 			}
-			case FilterType::Highpass_RC24:
-			case FilterType::Bandpass_RC24:
+			return lp;
+		}
+		else if constexpr (Type == FilterType::Highpass_RC24 || Type == FilterType::Bandpass_RC24)
+		{
+			sample_t hp, bp;
+			for( int n = 4; n != 0; --n )
 			{
-				sample_t hp, bp;
-				for( int n = 4; n != 0; --n )
-				{
-					// first stage is as for the 12dB case...
-					sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				// first stage is as for the 12dB case...
+				sample_t in = _in0 + m_rcbp0[_chnl] * m_rcq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_rcc * ( m_rchp0[_chnl] + in - m_rclast0[_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_rcc * ( m_rchp0[_chnl] + in - m_rclast0[_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_rcb + m_rcbp0[_chnl] * m_rca;
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_rclast0[_chnl] = in;
-					m_rchp0[_chnl] = hp;
-					m_rcbp0[_chnl] = bp;
+				m_rclast0[_chnl] = in;
+				m_rchp0[_chnl] = hp;
+				m_rcbp0[_chnl] = bp;
 
-					// second stage gets the output of the first stage as input...
-					in = m_type == FilterType::Highpass_RC24
-						? hp + m_rcbp1[_chnl] * m_rcq
-						: bp + m_rcbp1[_chnl] * m_rcq;
+				// second stage gets the output of the first stage as input...
+				in = Type == FilterType::Highpass_RC24
+					? hp + m_rcbp1[_chnl] * m_rcq
+					: bp + m_rcbp1[_chnl] * m_rcq;
 
-					in = std::clamp(in, -1.0f, 1.0f);
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_rcc * ( m_rchp1[_chnl] + in - m_rclast1[_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_rcc * ( m_rchp1[_chnl] + in - m_rclast1[_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_rcb + m_rcbp1[_chnl] * m_rca;
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_rcb + m_rcbp1[_chnl] * m_rca;
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_rclast1[_chnl] = in;
-					m_rchp1[_chnl] = hp;
-					m_rcbp1[_chnl] = bp;
-				}
-				return m_type == FilterType::Highpass_RC24 ? hp : bp;
+				m_rclast1[_chnl] = in;
+				m_rchp1[_chnl] = hp;
+				m_rcbp1[_chnl] = bp;
 			}
+			return Type == FilterType::Highpass_RC24 ? hp : bp;
+		}
 
-			case FilterType::Formantfilter:
-			case FilterType::FastFormant:
-			{
-				if (std::abs(_in0) < 1.0e-10f && std::abs(m_vflast[0][_chnl]) < 1.0e-10f) { return 0.0f; } // performance hack - skip processing when the numbers get too small
+		else if constexpr (Type == FilterType::Formantfilter || Type == FilterType::FastFormant)
+		{
+			if (std::abs(_in0) < 1.0e-10f && std::abs(m_vflast[0][_chnl]) < 1.0e-10f) { return 0.0f; } // performance hack - skip processing when the numbers get too small
 
-				const int os = m_type == FilterType::FastFormant ? 1 : 4; // no oversampling for fast formant
-				for( int o = 0; o < os; ++o )
-				{
-					// first formant
-					sample_t in = _in0 + m_vfbp[0][_chnl] * m_vfq;
-					in = std::clamp(in, -1.0f, 1.0f);
+			const int os = Type == FilterType::FastFormant ? 1 : 4; // no oversampling for fast formant
+			for( int o = 0; o < os; ++o )
+			{
+				// first formant
+				sample_t in = _in0 + m_vfbp[0][_chnl] * m_vfq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					sample_t hp = m_vfc[0] * ( m_vfhp[0][_chnl] + in - m_vflast[0][_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				sample_t hp = m_vfc[0] * ( m_vfhp[0][_chnl] + in - m_vflast[0][_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					sample_t bp = hp * m_vfb[0] + m_vfbp[0][_chnl] * m_vfa[0];
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				sample_t bp = hp * m_vfb[0] + m_vfbp[0][_chnl] * m_vfa[0];
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_vflast[0][_chnl] = in;
-					m_vfhp[0][_chnl] = hp;
-					m_vfbp[0][_chnl] = bp;
+				m_vflast[0][_chnl] = in;
+				m_vfhp[0][_chnl] = hp;
+				m_vfbp[0][_chnl] = bp;
 
-					in = bp + m_vfbp[2][_chnl] * m_vfq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				in = bp + m_vfbp[2][_chnl] * m_vfq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_vfc[0] * ( m_vfhp[2][_chnl] + in - m_vflast[2][_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_vfc[0] * ( m_vfhp[2][_chnl] + in - m_vflast[2][_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_vfb[0] + m_vfbp[2][_chnl] * m_vfa[0];
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_vfb[0] + m_vfbp[2][_chnl] * m_vfa[0];
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_vflast[2][_chnl] = in;
-					m_vfhp[2][_chnl] = hp;
-					m_vfbp[2][_chnl] = bp;
+				m_vflast[2][_chnl] = in;
+				m_vfhp[2][_chnl] = hp;
+				m_vfbp[2][_chnl] = bp;
 
-					in = bp + m_vfbp[4][_chnl] * m_vfq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				in = bp + m_vfbp[4][_chnl] * m_vfq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_vfc[0] * ( m_vfhp[4][_chnl] + in - m_vflast[4][_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_vfc[0] * ( m_vfhp[4][_chnl] + in - m_vflast[4][_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_vfb[0] + m_vfbp[4][_chnl] * m_vfa[0];
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_vfb[0] + m_vfbp[4][_chnl] * m_vfa[0];
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_vflast[4][_chnl] = in;
-					m_vfhp[4][_chnl] = hp;
-					m_vfbp[4][_chnl] = bp;
+				m_vflast[4][_chnl] = in;
+				m_vfhp[4][_chnl] = hp;
+				m_vfbp[4][_chnl] = bp;
 
-					out += bp;
+				out += bp;
 
-					// second formant
-					in = _in0 + m_vfbp[0][_chnl] * m_vfq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				// second formant
+				in = _in0 + m_vfbp[0][_chnl] * m_vfq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_vfc[1] * ( m_vfhp[1][_chnl] + in - m_vflast[1][_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_vfc[1] * ( m_vfhp[1][_chnl] + in - m_vflast[1][_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_vfb[1] + m_vfbp[1][_chnl] * m_vfa[1];
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_vfb[1] + m_vfbp[1][_chnl] * m_vfa[1];
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_vflast[1][_chnl] = in;
-					m_vfhp[1][_chnl] = hp;
-					m_vfbp[1][_chnl] = bp;
+				m_vflast[1][_chnl] = in;
+				m_vfhp[1][_chnl] = hp;
+				m_vfbp[1][_chnl] = bp;
 
-					in = bp + m_vfbp[3][_chnl] * m_vfq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				in = bp + m_vfbp[3][_chnl] * m_vfq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_vfc[1] * ( m_vfhp[3][_chnl] + in - m_vflast[3][_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_vfc[1] * ( m_vfhp[3][_chnl] + in - m_vflast[3][_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_vfb[1] + m_vfbp[3][_chnl] * m_vfa[1];
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_vfb[1] + m_vfbp[3][_chnl] * m_vfa[1];
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_vflast[3][_chnl] = in;
-					m_vfhp[3][_chnl] = hp;
-					m_vfbp[3][_chnl] = bp;
+				m_vflast[3][_chnl] = in;
+				m_vfhp[3][_chnl] = hp;
+				m_vfbp[3][_chnl] = bp;
 
-					in = bp + m_vfbp[5][_chnl] * m_vfq;
-					in = std::clamp(in, -1.0f, 1.0f);
+				in = bp + m_vfbp[5][_chnl] * m_vfq;
+				in = std::clamp(in, -1.0f, 1.0f);
 
-					hp = m_vfc[1] * ( m_vfhp[5][_chnl] + in - m_vflast[5][_chnl] );
-					hp = std::clamp(hp, -1.0f, 1.0f);
+				hp = m_vfc[1] * ( m_vfhp[5][_chnl] + in - m_vflast[5][_chnl] );
+				hp = std::clamp(hp, -1.0f, 1.0f);
 
-					bp = hp * m_vfb[1] + m_vfbp[5][_chnl] * m_vfa[1];
-					bp = std::clamp(bp, -1.0f, 1.0f);
+				bp = hp * m_vfb[1] + m_vfbp[5][_chnl] * m_vfa[1];
+				bp = std::clamp(bp, -1.0f, 1.0f);
 
-					m_vflast[5][_chnl] = in;
-					m_vfhp[5][_chnl] = hp;
-					m_vfbp[5][_chnl] = bp;
+				m_vflast[5][_chnl] = in;
+				m_vfhp[5][_chnl] = hp;
+				m_vfbp[5][_chnl] = bp;
 
-					out += bp;
-				}
-            	return m_type == FilterType::FastFormant ? out * 2.0f : out * 0.5f;
+				out += bp;
 			}
+			return Type == FilterType::FastFormant ? out * 2.0f : out * 0.5f;
+		}
 
-			default:
-				out = m_biQuad.update( _in0, _chnl );
-				break;
+		else
+		{
+			out = m_biQuad.update( _in0, _chnl );
 		}
 
 		if( m_doubleFilter )
 		{
-			return m_subFilter->update( out, _chnl );
+			return m_subFilter->template tick<Type>( out, _chnl );
 		}
 
 		// Clipper band limited sigmoid
@@ -706,6 +820,9 @@ public:
 
 	inline void calcFilterCoeffs( float _freq, float _q )
 	{
+		m_lastCut = _freq;
+		m_lastRes = _q;
+
 		// temp coef vars
 		_q = std::max(_q, minQ());
 
@@ -871,6 +988,68 @@ public:
 
 
 private:
+	static constexpr bool isBiQuadType( FilterType type )
+	{
+		return type == FilterType::LowPass || type == FilterType::HiPass
+			|| type == FilterType::BandPass_CSG || type == FilterType::BandPass_CZPG
+			|| type == FilterType::Notch || type == FilterType::AllPass;
+	}
+
+	//! Call `fn` with the filter type as std::integral_constant. All biquad-based
+	//! types share one kernel as they only differ in their coefficients.
+	template<typename Fn>
+	inline decltype( auto ) dispatch( Fn&& fn )
+	{
+		using Tag = FilterType;
+		switch( m_type )
+		{
+			case Tag::Moog: return fn( std::integral_constant<Tag, Tag::Moog>{} );
+			case Tag::Tripole: return fn( std::integral_constant<Tag, Tag::Tripole>{} );
+			case Tag::Lowpass_SV: return fn( std::integral_constant<Tag, Tag::Lowpass_SV>{} );
+			case Tag::Bandpass_SV: return fn( std::integral_constant<Tag, Tag::Bandpass_SV>{} );
+			case Tag::Highpass_SV: return fn( std::integral_constant<Tag, Tag::Highpass_SV>{} );
+			case Tag::Notch_SV: return fn( std::integral_constant<Tag, Tag::Notch_SV>{} );
+			case Tag::Lowpass_RC12: return fn( std::integral_constant<Tag, Tag::Lowpass_RC12>{} );
+			case Tag::Bandpass_RC12: return fn( std::integral_constant<Tag, Tag::Bandpass_RC12>{} );
+			case Tag::Highpass_RC12: return fn( std::integral_constant<Tag, Tag::Highpass_RC12>{} );
+			case Tag::Lowpass_RC24: return fn( std::integral_constant<Tag, Tag::Lowpass_RC24>{} );
+			case Tag::Bandpass_RC24: return fn( std::integral_constant<Tag, Tag::Bandpass_RC24>{} );
+			case Tag::Highpass_RC24: return fn( std::integral_constant<Tag, Tag::Highpass_RC24>{} );
+			case Tag::Formantfilter: return fn( std::integral_constant<Tag, Tag::Formantfilter>{} );
+			case Tag::FastFormant: return fn( std::integral_constant<Tag, Tag::FastFormant>{} );
+			default: return fn( std::integral_constant<Tag, Tag::LowPass>{} );
+		}
+	}
+
+	template<FilterType Type>
+	inline void processFrames( SampleFrame* buf, fpp_t frames )
+	{
+		if constexpr( isBiQuadType( Type ) )
+		{
+			m_biQuad.processBlock( buf, frames );
+			if( m_doubleFilter )
+			{
+				m_subFilter->m_biQuad.processBlock( buf, frames );
+			}
+		}
+		else
+		{
+			for( fpp_t f = 0; f < frames; ++f )
+			{
+				for( ch_cnt_t ch = 0; ch < CHANNELS; ++ch )
+				{
+					buf[f][ch] = tick<Type>( buf[f][ch], ch );
+				}
+			}
+		}
+	}
+
+	inline void invalidateCoeffs()
+	{
+		m_lastCut = std::numeric_limits<float>::quiet_NaN();
+		m_lastRes = std::numeric_limits<float>::quiet_NaN();
+	}
+
 	// biquad filter
 	BiQuad<CHANNELS> m_biQuad;
 
@@ -904,8 +1083,13 @@ private:
 	frame m_delay1, m_delay2, m_delay3, m_delay4;
 
 	FilterType m_type;
+	FilterType m_requestedType;
 	bool m_doubleFilter;
 
+	// cutoff and resonance the current coefficients were calculated for
+	float m_lastCut = std::numeric_limits<float>::quiet_NaN();
+	float m_lastRes = std::numeric_limits<float>::quiet_NaN();
+
 	float m_sampleRate;
 	float m_sampleRatio;
 	BasicFilters<CHANNELS> * m_subFilter;
@@ -27,6 +27,7 @@
 
 #include <optional>
 
+#include <QPixmap>
 #include <QVector>
 
 #include "ModelView.h"
@@ -108,6 +109,9 @@ public:
 	bool needsUpdate();
 	void setNeedsUpdate( bool b );
 
+	//! Returns the clip as drawn by paintClip(), drawing it again if it changed
+	const QPixmap & pixmap();
+
 	// Method to get a QVector of Clips to be affected by a context menu action
 	QVector<ClipView *> getClickedClips();
 
@@ -169,6 +173,7 @@ protected:
 	void mousePressEvent( QMouseEvent * me ) override;
 	void mouseMoveEvent( QMouseEvent * me ) override;
 	void mouseReleaseEvent( QMouseEvent * me ) override;
+	void paintEvent( QPaintEvent * pe ) override;
 	void resizeEvent( QResizeEvent * re ) override
 	{
 		m_needsUpdate = true;
@@ -183,6 +188,9 @@ protected:
 
 	DataFile createClipDataFiles(const QVector<ClipView *> & clips) const;
 
+	//! Draws the clip into the pixmap that is shown by this widget, or by the
+	//! TrackContentWidget while the clip isn't shown as a widget
+	virtual void paintClip(QPainter& p) = 0;
 	virtual void paintTextLabel(QString const & text, QPainter & painter);
 
 	auto hasCustomColor() const -> bool;
@@ -231,6 +239,7 @@ private:
 	bool m_cursorSetYet;
 
 	bool m_needsUpdate;
+	QPixmap m_paintPixmap;
 	inline void setInitialPos( QPoint pos )
 	{
 		m_initialMousePos = pos;
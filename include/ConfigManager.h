@@ -235,6 +235,9 @@ public:
 	static QStringList availableVstEmbedMethods();
 	QString vstEmbedMethod() const;
 
+	// FFTW wisdom is kept next to the configuration file
+	QString fftwWisdomFile() const;
+
 	// Returns true if the working dir (e.g. ~/lmms) exists on disk.
 	bool hasWorkingDir() const;
 
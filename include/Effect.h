@@ -30,6 +30,7 @@
 #include "Engine.h"
 #include "AudioEngine.h"
 #include "AutomatableModel.h"
+#include "LoadMeter.h"
 #include "TempoSyncKnobModel.h"
 
 namespace lmms
@@ -166,6 +167,11 @@ public:
 		return m_parent;
 	}
 
+	LoadMeter& loadMeter()
+	{
+		return m_loadMeter;
+	}
+
 	virtual EffectControls * controls() = 0;
 
 	static Effect * instantiate( const QString & _plugin_name,
@@ -232,6 +238,8 @@ private:
 	
 	bool m_autoQuitDisabled;
 
+	LoadMeter m_loadMeter;
+
 	SRC_DATA m_srcData[2];
 	SRC_STATE * m_srcState[2];
 
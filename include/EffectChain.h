@@ -65,9 +65,17 @@ public:
 	void moveUp( Effect * _effect );
 	bool processAudioBuffer( SampleFrame* _buf, const fpp_t _frames, bool hasInputNoise );
 	void startRunning();
+	// whether any effect still has to be processed without input,
+	// i.e. its output has not decayed yet
+	bool isRunning() const;
 
 	void clear();
 
+	const std::vector<Effect*>& effects() const
+	{
+		return m_effects;
+	}
+
 
 private:
 	using EffectList = std::vector<Effect*>;
@@ -42,6 +42,7 @@ namespace lmms::gui
 class EffectControlDialog;
 class Knob;
 class LedCheckBox;
+class LoadIndicator;
 class TempoSyncKnob;
 
 
@@ -93,6 +94,7 @@ private:
 	Knob * m_wetDry;
 	TempoSyncKnob * m_autoQuit;
 	Knob * m_gate;
+	LoadIndicator * m_loadIndicator;
 	QMdiSubWindow * m_subWindow;
 	EffectControlDialog * m_controlView;
 	
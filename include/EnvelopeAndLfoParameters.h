@@ -48,6 +48,9 @@ class LMMS_EXPORT EnvelopeAndLfoParameters : public Model, public JournallingObj
 {
 	Q_OBJECT
 public:
+	//! Global LFO clock shared by all instances. Each LFO keeps its own phase as
+	//! an offset to it and evaluates its shape at most once per period, so
+	//! advancing it does not need to visit (or lock) the individual LFOs.
 	class LfoInstances
 	{
 	public:
@@ -55,24 +58,42 @@ public:
 
 		~LfoInstances() = default;
 
-		inline bool isEmpty() const
+		void trigger();
+		void reset();
+
+		inline f_cnt_t frame() const
 		{
-			return m_lfos.isEmpty();
+			return m_frame;
 		}
 
-		void trigger();
-		void reset();
+		//! Changes whenever frame() does, including on reset()
+		inline long period() const
+		{
+			return m_period;
+		}
 
-		void add( EnvelopeAndLfoParameters * lfo );
-		void remove( EnvelopeAndLfoParameters * lfo );
+		//! Number of reset() calls, which restart the phase of all LFOs
+		inline long resets() const
+		{
+			return m_resets;
+		}
 
 	private:
-		QMutex m_lfoListMutex;
-		using LfoList = QList<EnvelopeAndLfoParameters*>;
-		LfoList m_lfos;
+		f_cnt_t m_frame = 0;
+		long m_period = 0;
+		long m_resets = 0;
 
 	};
 
+	//! One voice for fillLevels()
+	struct VoiceLevels
+	{
+		float * buffer;
+		f_cnt_t frame;
+		f_cnt_t releaseBegin;
+		fpp_t frames;
+	};
+
 	enum class LfoShape
 	{
 		SineWave,
@@ -95,13 +116,17 @@ public:
 
 	static LfoInstances * instances()
 	{
-		return s_lfoInstances;
+		return &s_lfoInstances;
 	}
 
 	void fillLevel( float * _buf, f_cnt_t _frame,
 				const f_cnt_t _release_begin,
 				const fpp_t _frames );
 
+	//! Fill the levels of several voices sharing these parameters in one pass.
+	//! The parameters are locked and the LFO shape is evaluated only once.
+	void fillLevels( const VoiceLevels * voices, std::size_t count );
+
 	inline bool isUsed() const
 	{
 		return m_used;
@@ -154,10 +179,13 @@ public slots:
 
 protected:
 	void fillLfoLevel( float * _buf, f_cnt_t _frame, const fpp_t _frames );
+	void fillEnvLevel( float * _buf, f_cnt_t _frame,
+				const f_cnt_t _release_begin,
+				const fpp_t _frames ) const;
 
 
 private:
-	static LfoInstances * s_lfoInstances;
+	static LfoInstances s_lfoInstances;
 	bool m_used;
 
 	QMutex m_paramMutex;
@@ -195,16 +223,21 @@ private:
 	f_cnt_t m_lfoPredelayFrames;
 	f_cnt_t m_lfoAttackFrames;
 	f_cnt_t m_lfoOscillationFrames;
-	f_cnt_t m_lfoFrame;
 	float m_lfoAmount;
 	bool m_lfoAmountIsZero;
 	sample_t * m_lfoShapeData;
 	sample_t m_random;
-	bool m_bad_lfoShapeData;
+	long m_lfoShapePeriod;
+	// clock frame and reset count at which the phase of this LFO started
+	f_cnt_t m_lfoFrameOrigin;
+	long m_lfoResets;
+	// scratch buffer for fillLevels(), guarded by m_paramMutex
+	sample_t * m_envLevelData;
 	std::shared_ptr<const SampleBuffer> m_userWave = SampleBuffer::emptyBuffer();
 
 	constexpr static auto NumLfoShapes = static_cast<std::size_t>(LfoShape::Count);
 
+	f_cnt_t lfoFrame();
 	sample_t lfoShapeSample( fpp_t _frame_offset );
 	void updateLfoShapeData();
 
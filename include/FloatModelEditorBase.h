@@ -88,14 +88,11 @@ protected:
 
 private slots:
 	virtual void enterValue();
-	void friendlyUpdate();
 	void toggleScale();
 
 private:
 	virtual QString displayValue() const;
 
-	void doConnections() override;
-
 	void showTextFloat(int msecBeforeDisplay, int msecDisplayTime);
 	void setPosition(const QPoint & p);
 
@@ -31,10 +31,14 @@
 #include "Flags.h"
 #include "lmms_export.h"
 #include "lmms_basics.h"
+#include "LoadMeter.h"
 #include "Plugin.h"
 #include "TimePos.h"
+#include "VoicePool.h"
 
 #include <cmath>
+#include <memory>
+#include <vector>
 
 
 namespace lmms
@@ -65,7 +69,7 @@ public:
 			const Descriptor * _descriptor,
 			const Descriptor::SubPluginFeatures::Key * key = nullptr,
 			Flags flags = Flag::NoFlags);
-	~Instrument() override = default;
+	~Instrument() override;
 
 	// --------------------------------------------------------------------
 	// functions that can/should be re-implemented:
@@ -86,7 +90,8 @@ public:
 
 	// needed for deleting plugin-specific-data of a note - plugin has to
 	// cast void-ptr so that the plugin-data is deleted properly
-	// (call of dtor if it's a class etc.)
+	// (call of dtor if it's a class etc.) - plugin-data acquired from a
+	// VoicePool has to be given back to the same pool
 	virtual void deleteNotePluginData( NotePlayHandle * _note_to_play );
 
 	// Get number of sample-frames that should be used when playing beat
@@ -158,6 +163,12 @@ public:
 		return m_instrumentTrack;
 	}
 
+	//! Processing time of the notes and of play() for single-streamed instruments
+	LoadMeter& loadMeter()
+	{
+		return m_loadMeter;
+	}
+
 
 protected:
 	// fade in to prevent clicks
@@ -170,10 +181,33 @@ protected:
 
 	float computeReleaseTimeMsByFrameCount(f_cnt_t frames) const;
 
+	// single-streamed instruments may call this from play() to render
+	// independent parts of the period (voice groups, MIDI channels etc.)
+	// concurrently on the worker threads of the audio engine - renderPart()
+	// is called once per part with a silent buffer and the parts are summed
+	// up in order, so the result does not depend on the thread scheduling
+	void renderParts( SampleFrame* _working_buffer, std::size_t _parts );
+
+	static constexpr std::size_t MaxParts = 16;
+
+	// number of voices instruments preallocate in their VoicePool members
+	// for the plugin-data of notes, unless a voice is very large
+	static constexpr std::size_t DefaultVoicePoolSize = 64;
+
+	// to be implemented by instruments calling renderParts() - must only
+	// touch state which belongs to the given part
+	virtual void renderPart( std::size_t /* _part */, SampleFrame* /* _buffer */ )
+	{
+	}
+
 
 private:
+	class PartJob;
+
 	InstrumentTrack * m_instrumentTrack;
 	Flags m_flags;
+	std::vector<std::unique_ptr<PartJob>> m_partJobs;
+	LoadMeter m_loadMeter;
 };
 
 
@@ -25,14 +25,18 @@
 #ifndef LMMS_INSTRUMENT_SOUND_SHAPING_H
 #define LMMS_INSTRUMENT_SOUND_SHAPING_H
 
+#include <QMutex>
+#include <array>
+#include <vector>
+
 #include "ComboBoxModel.h"
+#include "EnvelopeAndLfoParameters.h"
 
 namespace lmms
 {
 
 
 class InstrumentTrack;
-class EnvelopeAndLfoParameters;
 class NotePlayHandle;
 class SampleFrame;
 
@@ -76,6 +80,28 @@ public:
 
 
 private:
+	//! Position of a voice in its envelopes for the current period
+	struct VoiceEnvelope
+	{
+		const NotePlayHandle* note;
+		f_cnt_t frame;
+		f_cnt_t releaseBegin;
+		fpp_t frames;
+
+		bool operator==(const VoiceEnvelope& other) const
+		{
+			return note == other.note && frame == other.frame
+				&& releaseBegin == other.releaseBegin && frames == other.frames;
+		}
+	};
+
+	static VoiceEnvelope voiceEnvelope(const NotePlayHandle* n, fpp_t frames);
+
+	//! Levels of the given target for one voice, taken from the levels filled for
+	//! all voices of the track in this period where possible
+	void fillLevel(Target target, const VoiceEnvelope& voice, float* buffer);
+	void fillVoiceLevels(const VoiceEnvelope& current);
+
 	EnvelopeAndLfoParameters * m_envLfoParameters[NumTargets];
 	InstrumentTrack * m_instrumentTrack;
 
@@ -86,6 +112,15 @@ private:
 
 	static const char *const targetNames[NumTargets][3];
 
+	// levels of all voices for the current period, guarded by m_voiceLevelsMutex
+	QMutex m_voiceLevelsMutex;
+	long m_voiceLevelsPeriod = -1;
+	std::vector<VoiceEnvelope> m_voices;
+	std::vector<EnvelopeAndLfoParameters::VoiceLevels> m_voiceLevelRequests;
+	std::vector<float> m_voiceLevelData;
+	fpp_t m_voiceLevelStride = 0;
+	std::array<bool, NumTargets> m_voiceLevelTargets{};
+
 
 	friend class gui::InstrumentSoundShapingView;
 
@@ -26,8 +26,12 @@
 #ifndef LMMS_INSTRUMENT_TRACK_H
 #define LMMS_INSTRUMENT_TRACK_H
 
+#include <atomic>
 #include <limits>
 
+#include <QDomDocument>
+#include <QElapsedTimer>
+
 #include "AudioPort.h"
 #include "InstrumentFunctions.h"
 #include "InstrumentSoundShaping.h"
@@ -47,6 +51,7 @@ namespace lmms
 
 class Instrument;
 class DataFile;
+class ProjectLoader;
 
 namespace gui
 {
@@ -103,6 +108,20 @@ public:
 
 	void deleteNotePluginData( NotePlayHandle * _n );
 
+	//! Whether the instrument is only kept as serialized state until it's needed,
+	//! see the "lazyinstruments" setting. A silent DummyInstrument stands in for it meanwhile.
+	bool isInstrumentDeferred() const
+	{
+		return m_instrumentDeferred;
+	}
+
+	//! Replace the instrument by its serialized state to free its resources.
+	//! Returns false if the instrument can't be restored later without losing links to it.
+	bool deferInstrument();
+
+	//! Milliseconds since the track has been muted, 0 if it isn't muted
+	qint64 mutedFor() const;
+
 	// name-stuff
 	void setName( const QString & _new_name ) override;
 
@@ -240,6 +259,10 @@ public:
 
 	void autoAssignMidiDevice( bool );
 
+public slots:
+	//! Create the deferred instrument, does nothing if the instrument isn't deferred
+	void instantiateDeferredInstrument();
+
 signals:
 	void instrumentChanged();
 	void midiNoteOn( const lmms::Note& );
@@ -262,11 +285,22 @@ protected slots:
 	void updatePitch();
 	void updatePitchRange();
 	void updateMixerChannel();
+	void updateMuted();
 
 
 private:
 	void processCCEvent(int controller);
 
+	void saveInstrument(QDomDocument& doc, QDomElement& parent);
+
+	bool shouldDeferInstrument(const QDomElement& thisElement) const;
+	//! Whether an instrument can be saved as is, i.e. no automation or controller refers to its models.
+	//! Without a loader, every model with an id is assumed to be referred to.
+	static bool canDeferInstrument(const QDomElement& element, const ProjectLoader* loader);
+	//! Called from the audio threads when a deferred instrument is asked to play
+	void requestDeferredInstrument();
+	void clearDeferredInstrument();
+
 	MidiPort m_midiPort;
 
 	NotePlayHandle* m_notes[NumKeys];
@@ -301,6 +335,12 @@ private:
 	BoolModel m_useMasterPitchModel;
 
 	Instrument * m_instrument;
+	//! Holds the <instrument> element while the instrument is deferred
+	QDomDocument m_deferredInstrument;
+	std::atomic<bool> m_instrumentDeferred;
+	std::atomic<bool> m_instrumentRequested;
+	QElapsedTimer m_mutedTimer;
+
 	InstrumentSoundShaping m_soundShaping;
 	InstrumentFunctionArpeggio m_arpeggio;
 	InstrumentFunctionNoteStacking m_noteStacking;
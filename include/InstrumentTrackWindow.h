@@ -54,6 +54,7 @@ class InstrumentTrackView;
 class Knob;
 class LcdSpinBox;
 class LeftRightNav;
+class LoadIndicator;
 class PianoView;
 class PluginView;
 class TabWidget;
@@ -143,6 +144,7 @@ private:
 	LcdSpinBox* m_pitchRangeSpinBox;
 	QLabel * m_pitchRangeLabel;
 	MixerChannelLcdSpinBox * m_mixerChannelNumber;
+	LoadIndicator * m_loadIndicator;
 
 
 
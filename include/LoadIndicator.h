@@ -0,0 +1,65 @@
+/*
+ * LoadIndicator.h - shows the CPU load of a mixer channel, effect or instrument
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_GUI_LOAD_INDICATOR_H
+#define LMMS_GUI_LOAD_INDICATOR_H
+
+#include "lmms_export.h"
+
+#include <QLabel>
+
+namespace lmms
+{
+
+class LoadMeter;
+
+namespace gui
+{
+
+//! Shows the average load of a LoadMeter, with the worst load in the tool
+//! tip. Clicking it resets the worst load.
+class LMMS_EXPORT LoadIndicator : public QLabel
+{
+	Q_OBJECT
+public:
+	LoadIndicator(LoadMeter* meter, QWidget* parent);
+
+	void setMeter(LoadMeter* meter);
+
+protected:
+	void mousePressEvent(QMouseEvent* e) override;
+
+private slots:
+	void updateLoad();
+
+private:
+	LoadMeter* m_meter;
+	// in tenths of a percent, to only update the label on visible changes
+	int m_averageLoad = -1;
+	int m_worstLoad = -1;
+};
+
+} // namespace gui
+
+} // namespace lmms
+
+#endif // LMMS_GUI_LOAD_INDICATOR_H
@@ -0,0 +1,141 @@
+/*
+ * LoadMeter.h - CPU load of single mixer channels, effects and instruments
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_LOAD_METER_H
+#define LMMS_LOAD_METER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+
+/**
+	Measures the share of each period an object of the render path takes.
+
+	Probes add the time they live to the meter, from any thread. After each
+	period, the AudioEngineProfiler calls finishPeriod(), which turns the
+	time of all meters into loads: a rolling average, the worst period and
+	the mean since the last reset. All loads are in percent of the time
+	available for a period.
+*/
+class LMMS_EXPORT LoadMeter
+{
+	using Clock = std::chrono::steady_clock;
+
+public:
+	LoadMeter();
+	~LoadMeter();
+
+	LoadMeter(const LoadMeter&) = delete;
+	LoadMeter& operator=(const LoadMeter&) = delete;
+
+	float averageLoad() const
+	{
+		return m_averageLoad.load(std::memory_order_relaxed);
+	}
+
+	float worstLoad() const
+	{
+		return m_worstLoad.load(std::memory_order_relaxed);
+	}
+
+	//! The mean load of the periods since the last reset()
+	float meanLoad() const;
+
+	//! Restart the worst and mean load
+	void reset();
+
+	//! Restart the worst and mean load of all meters, e.g. when a render starts
+	static void resetAll();
+
+	//! Adds the time of its lifetime to a meter
+	class Probe
+	{
+	public:
+		explicit Probe(LoadMeter& meter) :
+			m_meter(meter),
+			m_start(Clock::now())
+		{
+		}
+
+		~Probe()
+		{
+			m_meter.addTime(Clock::now() - m_start);
+		}
+
+		Probe(const Probe&) = delete;
+		Probe& operator=(const Probe&) = delete;
+
+	private:
+		LoadMeter& m_meter;
+		const Clock::time_point m_start;
+	};
+
+	//! The probe of ThreadableJob::process(). Jobs processed while another
+	//! job waits for them on the same thread (see
+	//! AudioEngineWorkerThread::processSubJobs()) don't count for the outer
+	//! job. The meter may be null.
+	class JobProbe
+	{
+	public:
+		explicit JobProbe(LoadMeter* meter);
+		~JobProbe();
+
+		JobProbe(const JobProbe&) = delete;
+		JobProbe& operator=(const JobProbe&) = delete;
+
+	private:
+		LoadMeter* const m_meter;
+		JobProbe* const m_parent;
+		Clock::time_point m_start;
+	};
+
+	//! Compute the loads of all meters from the time of the finished period
+	static void finishPeriod(std::uint64_t periodMicroseconds);
+
+private:
+	void addTime(Clock::duration time)
+	{
+		m_periodTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+			std::memory_order_relaxed);
+	}
+
+	std::atomic<std::int64_t> m_periodTime{0};
+	std::atomic<float> m_averageLoad{0.f};
+	std::atomic<float> m_worstLoad{0.f};
+	std::atomic<double> m_loadSum{0.};
+	std::atomic<std::uint64_t> m_periods{0};
+
+	// all meters, see finishPeriod()
+	LoadMeter* m_previous = nullptr;
+	LoadMeter* m_next = nullptr;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_LOAD_METER_H
@@ -36,16 +36,25 @@ namespace lmms
 class LocklessAllocator
 {
 public:
-	LocklessAllocator( size_t nmemb, size_t size );
+	LocklessAllocator( size_t nmemb, size_t size,
+				size_t alignment = alignof( std::max_align_t ) );
 	virtual ~LocklessAllocator();
 	void * alloc();
+	//! Like alloc(), but doesn't complain if the pool is exhausted
+	void * tryAlloc();
 	void free( void * ptr );
 
+	bool contains( const void * ptr ) const
+	{
+		return ptr >= m_pool && ptr < m_pool + m_capacity * m_elementSize;
+	}
+
 
 private:
 	char * m_pool;
 	size_t m_capacity;
 	size_t m_elementSize;
+	size_t m_alignment;
 
 	std::atomic_int * m_freeState;
 	size_t m_freeStateSets;
@@ -63,7 +72,7 @@ class LocklessAllocatorT : private LocklessAllocator
 {
 public:
 	LocklessAllocatorT( size_t nmemb ) :
-		LocklessAllocator( nmemb, sizeof( T ) )
+		LocklessAllocator( nmemb, sizeof( T ), alignof( T ) )
 	{
 	}
 
@@ -74,11 +83,18 @@ public:
 		return (T *)LocklessAllocator::alloc();
 	}
 
+	T * tryAlloc()
+	{
+		return (T *)LocklessAllocator::tryAlloc();
+	}
+
 	void free( T * ptr )
 	{
 		LocklessAllocator::free( ptr );
 	}
 
+	using LocklessAllocator::contains;
+
 } ;
 
 
@@ -62,9 +62,13 @@ public:
 
 	// note management
 	Note * addNote( const Note & _new_note, const bool _quant_pos = true );
+	//! Adds copies of all given notes, sorting them in and updating the clip only once
+	NoteVector addNotes(const std::vector<Note>& newNotes, bool quantPos = true);
 
 	NoteVector::const_iterator removeNote(NoteVector::const_iterator it);
 	NoteVector::const_iterator removeNote(Note* note);
+	//! Removes and deletes all given notes, updating the clip only once
+	void removeNotes(const NoteVector& notes);
 
 	Note * noteAtStep( int _step );
 
@@ -82,7 +82,7 @@ protected:
 	void constructContextMenu( QMenu * ) override;
 	void mousePressEvent( QMouseEvent * _me ) override;
 	void mouseDoubleClickEvent( QMouseEvent * _me ) override;
-	void paintEvent( QPaintEvent * pe ) override;
+	void paintClip(QPainter& p) override;
 	void wheelEvent( QWheelEvent * _we ) override;
 
 
@@ -93,7 +93,6 @@ private:
 	QPixmap m_stepBtnOffLight = embed::getIconPixmap("step_btn_off_light");
 
 	MidiClip* m_clip;
-	QPixmap m_paintPixmap;
 
 	QColor m_noteFillColor;
 	QColor m_noteBorderColor;
@@ -26,12 +26,15 @@
 #define LMMS_MIXER_H
 
 #include "Model.h"
+#include "AudioTap.h"
 #include "EffectChain.h"
 #include "JournallingObject.h"
+#include "LoadMeter.h"
 #include "ThreadableJob.h"
 
 #include <atomic>
 #include <optional>
+#include <vector>
 #include <QColor>
 
 namespace lmms
@@ -51,18 +54,25 @@ class MixerChannel : public ThreadableJob
 
 		// set to true when input fed from mixToChannel or child channel
 		bool m_hasInput;
+		// buffers given to mixToChannel in this period, mixed by the channel
+		// itself in that order, so that the sum doesn't depend on the threads
+		std::vector<const SampleFrame*> m_inputs;
 		// set to true if any effect in the channel is enabled and running
 		bool m_stillRunning;
-
-		float m_peakLeft;
-		float m_peakRight;
+		// whether m_buffer is known to hold only zeros - idle channels
+		// neither clear nor mix their buffer then
+		bool m_bufferSilent;
+
+		// post-effect output; meter levels include the channel volume
+		AudioTap m_tap;
+		// processing time of the channel including its effects
+		LoadMeter m_loadMeter;
 		SampleFrame* m_buffer;
 		bool m_muteBeforeSolo;
 		BoolModel m_muteModel;
 		BoolModel m_soloModel;
 		FloatModel m_volumeModel;
 		QString m_name;
-		QMutex m_lock;
 		int m_channelIndex; // what channel index are we
 		bool m_queued; // are we queued up for rendering yet?
 		bool m_muted; // are we muted? updated per period so we don't have to call m_muteModel.value() twice
@@ -74,6 +84,7 @@ class MixerChannel : public ThreadableJob
 		MixerRouteVector m_receives;
 
 		bool requiresProcessing() const override { return true; }
+		LoadMeter* loadMeter() override { return &m_loadMeter; }
 		void unmuteForSolo();
 
 		auto color() const -> const std::optional<QColor>& { return m_color; }
@@ -137,6 +148,9 @@ public:
 	Mixer();
 	~Mixer() override;
 
+	//! Adds a buffer to the input of a channel for the current period. The
+	//! buffer must stay valid until masterMix() returns; the channel mixes
+	//! its inputs in the order of the calls when it is processed.
 	void mixToChannel( const SampleFrame* _buf, mix_ch_t _ch );
 
 	void prepareMasterMix();
@@ -207,6 +221,12 @@ public:
 		return m_mixerChannels.size();
 	}
 
+	//! All channels in the order masterMix() processes them
+	const std::vector<MixerChannel*>& executionOrder() const
+	{
+		return m_executionOrder;
+	}
+
 	MixerRouteVector m_mixerRoutes;
 
 private:
@@ -216,6 +236,14 @@ private:
 	// make sure we have at least num channels
 	void allocateChannelsTo(int num);
 
+	//! Sort the channels topologically into m_executionOrder. Called with the
+	//! audio engine locked whenever channels or routes are added or removed.
+	void updateExecutionPlan();
+
+	//! All channels, each after the channels sending to it, so that masterMix()
+	//! can dispatch the whole graph at once without searching for ready channels
+	std::vector<MixerChannel*> m_executionOrder;
+
 	int m_lastSoloed;
 } ;
 
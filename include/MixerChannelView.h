@@ -45,6 +45,7 @@ namespace lmms
 
 namespace lmms::gui
 {
+    class LoadIndicator;
     class PeakIndicator;
 
     constexpr int MIXER_CHANNEL_INNER_BORDER_SIZE = 3;
@@ -124,6 +125,7 @@ namespace lmms::gui
         PixmapButton* m_muteButton;
         PixmapButton* m_soloButton;
         PeakIndicator* m_peakIndicator = nullptr;
+        LoadIndicator* m_loadIndicator = nullptr;
         Fader* m_fader;
         EffectRackView* m_effectRackView;
         MixerView* m_mixerView;
@@ -25,6 +25,8 @@
 #ifndef LMMS_MODEL_H
 #define LMMS_MODEL_H
 
+#include <atomic>
+
 #include <QString>
 #include <QObject>
 
@@ -52,10 +54,32 @@ public:
 
 	virtual QString fullDisplayName() const;
 
+	//! Records a change made outside of the GUI thread. Views poll for these
+	//! instead of receiving queued signals, see ModelView::updateChangedViews().
+	void markChanged()
+	{
+		m_changeCount.fetch_add(1, std::memory_order_relaxed);
+		s_totalChangeCount.fetch_add(1, std::memory_order_release);
+	}
+
+	unsigned changeCount() const
+	{
+		return m_changeCount.load(std::memory_order_relaxed);
+	}
+
+	//! Number of changes recorded by markChanged() for all models
+	static unsigned totalChangeCount()
+	{
+		return s_totalChangeCount.load(std::memory_order_acquire);
+	}
+
 
 private:
 	QString m_displayName;
 	bool m_defaultConstructed;
+	std::atomic<unsigned> m_changeCount = 0;
+
+	static std::atomic<unsigned> s_totalChangeCount;
 
 
 signals:
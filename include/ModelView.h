@@ -25,6 +25,7 @@
 #ifndef LMMS_GUI_MODEL_VIEW_H
 #define LMMS_GUI_MODEL_VIEW_H
 
+#include <functional>
 #include <QPointer>
 #include "Model.h"
 
@@ -40,6 +41,16 @@ public:
 	virtual void setModel( Model* model, bool isOldModelValid = true );
 	virtual void unsetModel();
 
+	//! Repaints the views whose models were changed outside of the GUI thread
+	//! since the last call. MainWindow calls this at display rate.
+	static void updateChangedViews();
+
+	//! Call slot when the model changes, for as long as receiver lives and the
+	//! model isn't disconnected from it. Unlike an automatic connection to
+	//! Model::dataChanged(), changes made outside of the GUI thread don't queue
+	//! a call each, updateChangedViews() makes one call for all of them.
+	static void connectChanges( Model* model, QObject* receiver, std::function<void()> slot );
+
 	Model* model()
 	{
 		return m_model;
@@ -80,6 +91,7 @@ protected:
 private:
 	QWidget* m_widget;
 	QPointer<Model> m_model;
+	unsigned m_changeCount = 0;
 
 } ;
 
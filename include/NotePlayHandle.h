@@ -127,6 +127,9 @@ public:
 	/*! Returns whether the play handle plays on a certain track */
 	bool isFromTrack( const Track* _track ) const override;
 
+	/*! Notes count for the load of their instrument */
+	LoadMeter* loadMeter() override;
+
 	/*! Releases the note (and plays release frames) */
 	void noteOff( const f_cnt_t offset = 0 );
 
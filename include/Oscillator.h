@@ -37,6 +37,7 @@
 #include "lmmsconfig.h"
 #include "AudioEngine.h"
 #include "OscillatorConstants.h"
+#include "RandomStream.h"
 #include "SampleBuffer.h"
 
 namespace lmms
@@ -78,6 +79,10 @@ public:
 	} ;
 	constexpr static auto NumModulationAlgos = static_cast<std::size_t>(ModulationAlgo::Count);
 
+	//! The sub-oscillator is not owned and has to outlive this oscillator.
+	//! Oscillators used to delete their sub-oscillator; code that creates a
+	//! chain with new has to delete each oscillator of it now. Not owning it
+	//! lets instruments keep the whole chain of a note in one VoicePool voice.
 	Oscillator( const IntModel *wave_shape_model,
 			const IntModel *mod_algo_model,
 			const float &freq,
@@ -85,10 +90,7 @@ public:
 			const float &phase_offset,
 			const float &volume,
 			Oscillator *m_subOsc = nullptr);
-	virtual ~Oscillator()
-	{
-		delete m_subOsc;
-	}
+	virtual ~Oscillator() = default;
 
 	static void waveTableInit();
 	static void destroyFFTPlans();
@@ -163,7 +165,7 @@ public:
 
 	static inline sample_t noiseSample( const float )
 	{
-		return 1.0f - rand() * 2.0f / RAND_MAX;
+		return 1.0f - RandomStream::current().nextFloat() * 2.0f;
 	}
 
 	static sample_t userWaveSample(const SampleBuffer* buffer, const float sample)
@@ -25,6 +25,7 @@
 #ifndef LMMS_GUI_OSCILLOSCOPE_H
 #define LMMS_GUI_OSCILLOSCOPE_H
 
+#include <memory>
 #include <QWidget>
 #include <QPixmap>
 
@@ -33,6 +34,7 @@
 namespace lmms
 {
 
+class AudioTapReader;
 class SampleFrame;
 
 }
@@ -74,7 +76,7 @@ protected:
 
 
 protected slots:
-	void updateAudioBuffer(const lmms::SampleFrame* buffer);
+	void updateAudioBuffer();
 
 private:
 	bool clips(float level) const;
@@ -84,6 +86,7 @@ private:
 	QPointF * m_points;
 
 	SampleFrame* m_buffer;
+	std::unique_ptr<AudioTapReader> m_tapReader;
 	bool m_active;
 
 	QColor m_leftChannelColor;
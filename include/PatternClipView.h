@@ -55,14 +55,13 @@ protected slots:
 
 
 protected:
-	void paintEvent( QPaintEvent * pe ) override;
+	void paintClip(QPainter& p) override;
 	void mouseDoubleClickEvent( QMouseEvent * _me ) override;
 	void constructContextMenu( QMenu * ) override;
 
 
 private:
 	PatternClip* m_patternClip;
-	QPixmap m_paintPixmap;
 	
 	QStaticText m_staticTextName;
 } ;
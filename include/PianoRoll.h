@@ -29,6 +29,8 @@
 
 #include <QWidget>
 
+#include <bitset>
+#include <map>
 #include <vector>
 
 #include "Editor.h"
@@ -443,6 +445,52 @@ private:
 	void copyToClipboard(const NoteVector & notes ) const;
 
 	void drawDetuningInfo( QPainter & _p, const Note * _n, int _x, int _y ) const;
+	void drawKeys(QPainter& p, int topKey, bool drawNoteNames);
+	void drawGrid(QPainter& p, int position, int left, int right, int topKey, int q);
+
+	//! Everything that the piano keys in m_keysCache depend on
+	struct KeysState
+	{
+		int height = 0;
+		int topKey = 0;
+		int startKey = 0;
+		int keysVisible = 0;
+		int notesEditHeight = 0;
+		int keyLineHeight = 0;
+		qreal pixelRatio = 0;
+		bool noteNames = false;
+		std::bitset<NumKeys> mappedKeys;
+		std::bitset<NumKeys> pressedKeys;
+
+		bool operator==(const KeysState& other) const;
+	};
+
+	//! Everything that the tiles in m_gridTiles depend on, except for the scroll position
+	struct GridState
+	{
+		int height = 0;
+		//! The position the tiles are drawn for, see paintEvent()
+		int origin = 0;
+		int topKey = 0;
+		int startKey = 0;
+		int keysVisible = 0;
+		int notesEditHeight = 0;
+		int ppb = 0;
+		int keyLineHeight = 0;
+		int quantization = 0;
+		int timeSigNumerator = 0;
+		int timeSigDenominator = 0;
+		qreal pixelRatio = 0;
+		QList<int> markedSemiTones;
+
+		bool operator==(const GridState& other) const;
+	};
+
+	QPixmap m_keysCache;
+	KeysState m_keysState;
+	//! The grid in tiles of GRID_TILE_WIDTH pixels, by their index counted from GridState::origin
+	std::map<int, QPixmap> m_gridTiles;
+	GridState m_gridState;
 	bool mouseOverNote();
 	Note * noteUnderMouse();
 
@@ -450,6 +498,10 @@ private:
 	void computeSelectedNotes( bool shift );
 	void clearSelectedNotes();
 
+	// end moving or resizing notes and sort them again, as the playback
+	// of the clip and the drawing of the editor rely on their order
+	void finishNoteDrag();
+
 	// did we start a mouseclick with shift pressed
 	bool m_startedWithShift;
 
@@ -0,0 +1,113 @@
+/*
+ * ProjectLoader.h - decodes the resources of a project in the background
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_PROJECT_LOADER_H
+#define LMMS_PROJECT_LOADER_H
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <set>
+
+#include <QDomElement>
+#include <QString>
+
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+class SampleBuffer;
+
+
+/**
+	Lives while Song::loadProject() restores a project. On construction it
+	walks the parsed project once, collects all audio files referenced by
+	clips, instruments, envelopes and controllers and starts decoding them
+	concurrently on the ThreadPool.
+
+	Restoring tracks, plugins and models still happens in order on the main
+	thread, since it creates QObjects; SampleLoader picks up the decoded
+	buffers from here instead of decoding them again, so decoding overlaps
+	with the rest of the loading process.
+
+	Banks which plugins share between their instances (SoundFonts, GIG
+	files) are opened into the cache of their plugin the same way, see
+	registerBankLoader(). The loader keeps them cached until it is done, so
+	the instruments find them there.
+*/
+class LMMS_EXPORT ProjectLoader
+{
+public:
+	//! Opens a bank into the cache of its plugin and returns a reference which
+	//! keeps it there. Called on the ThreadPool, may throw.
+	using BankLoader = std::function<std::shared_ptr<void>(const QString& absolutePath)>;
+
+	explicit ProjectLoader(const QDomElement& content);
+	~ProjectLoader();
+
+	ProjectLoader(const ProjectLoader&) = delete;
+	ProjectLoader& operator=(const ProjectLoader&) = delete;
+
+	//! The loader of the project currently being loaded, or nullptr
+	static ProjectLoader* current() { return s_current; }
+
+	//! Return the prefetched buffer for the given file, waiting for its task if it is still running.
+	//! Returns nullptr for files which weren't prefetched or couldn't be decoded.
+	std::shared_ptr<const SampleBuffer> sample(const QString& audioFile) const;
+
+	//! Whether an automation clip of the project refers to the model with the given (saved) id
+	bool isAutomated(const QString& id) const { return m_automatedIds.count(id) > 0; }
+
+	std::size_t taskCount() const { return m_samples.size() + m_banks.size(); }
+	std::size_t finishedTaskCount() const { return m_finishedTasks->load(std::memory_order_relaxed); }
+
+	//! Let projects prefetch the files with the given extension (lower case)
+	//! through loader. Plugins call this when their library is loaded.
+	static void registerBankLoader(const QString& extension, BankLoader loader);
+
+private:
+	void scan(const QDomElement& element);
+	void prefetchSample(const QString& audioFile);
+	void prefetchBank(const QString& absolutePath, const BankLoader& loader);
+
+	//! Extensions of the files which can be decoded in parallel
+	std::set<QString> m_extensions;
+
+	//! Decoding tasks, keyed by absolute path
+	std::map<QString, std::shared_future<std::shared_ptr<const SampleBuffer>>> m_samples;
+	//! Bank loading tasks and the references they return, keyed by absolute path
+	std::map<QString, std::shared_future<std::shared_ptr<void>>> m_banks;
+	std::shared_ptr<std::atomic<std::size_t>> m_finishedTasks;
+
+	//! Ids of all models referenced by automation clips
+	std::set<QString> m_automatedIds;
+
+	static ProjectLoader* s_current;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_PROJECT_LOADER_H
@@ -0,0 +1,135 @@
+/*
+ * RandomStream.h - seeded random number streams of the render jobs
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_RANDOM_STREAM_H
+#define LMMS_RANDOM_STREAM_H
+
+#include <cstdint>
+
+#include "lmms_export.h"
+#include "lmmsconfig.h"
+
+namespace lmms
+{
+
+
+/**
+	A stream of pseudo random numbers (SplitMix64).
+
+	Every ThreadableJob owns a stream, seeded from the stream that was current
+	when the job was created, and makes it the current stream of the thread
+	while it is processed. Noise sources draw from RandomStream::current(), so
+	the numbers a job gets don't depend on which worker thread processes it or
+	on what the other jobs draw in the meantime. Outside of jobs, each thread
+	has a default stream seeded from the global seed.
+
+	With a fixed global seed (see setSeed()), rendering a project twice gives
+	the same output.
+*/
+class LMMS_EXPORT RandomStream
+{
+public:
+	explicit RandomStream(std::uint64_t seed) :
+		m_seed(seed),
+		m_state(seed)
+	{
+	}
+
+	//! The seed the stream started with
+	std::uint64_t seed() const
+	{
+		return m_seed;
+	}
+
+	std::uint64_t next()
+	{
+		m_state += 0x9e3779b97f4a7c15;
+		std::uint64_t z = m_state;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+
+	//! Return a number in [0, 1)
+	float nextFloat()
+	{
+		return static_cast<float>(next() >> 40) * (1.f / (1 << 24));
+	}
+
+	//! Makes a stream the current one of the thread for its lifetime
+	class Scope
+	{
+	public:
+		explicit Scope(RandomStream& stream) :
+			m_previous(currentStream())
+		{
+			currentStream() = &stream;
+		}
+
+		~Scope()
+		{
+			currentStream() = m_previous;
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		RandomStream* m_previous;
+	};
+
+	//! The stream of the job being processed, or the default stream of the
+	//! thread. Inline, as noise sources call it for every sample.
+	static RandomStream& current()
+	{
+		RandomStream* stream = currentStream();
+		return stream ? *stream : defaultStream();
+	}
+
+	//! Seed the default streams of all threads, and with them the streams of
+	//! the jobs created afterwards. Without a call, the seed is random.
+	static void setSeed(std::uint64_t seed);
+
+private:
+	//! The stream of the job being processed on this thread, if any
+#ifdef LMMS_BUILD_WIN32
+	// each DLL gets its own copy of the variables of inline functions, so
+	// the core library keeps the one all plugins use
+	static RandomStream*& currentStream();
+#else
+	static RandomStream*& currentStream()
+	{
+		thread_local RandomStream* stream = nullptr;
+		return stream;
+	}
+#endif
+
+	static RandomStream& defaultStream();
+
+	std::uint64_t m_seed;
+	std::uint64_t m_state;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_RANDOM_STREAM_H
@@ -0,0 +1,92 @@
+/*
+ * RealtimeChecker.h - detects allocations and locks on the render threads
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_REALTIME_CHECKER_H
+#define LMMS_REALTIME_CHECKER_H
+
+#include <cstdint>
+
+#include "lmms_export.h"
+#include "lmmsconfig.h"
+
+namespace lmms
+{
+
+
+/**
+	Finds real-time violations in builds configured with WANT_DEBUG_REALTIME.
+
+	While a thread renders (inside AudioEngine::renderNextBuffer() and while
+	the worker threads process jobs), calls of malloc(), realloc(), free()
+	and friends as well as mutex acquisitions through pthread_mutex_lock()
+	and QMutex::lock() are counted. The AudioEngineProfiler takes the counts
+	after each period. The stack trace of every distinct violation is
+	recorded once and written to stderr when LMMS exits.
+
+	In other builds, all of this compiles to nothing.
+*/
+class LMMS_EXPORT RealtimeChecker
+{
+public:
+	struct Counts
+	{
+		std::uint64_t allocations = 0;
+		std::uint64_t deallocations = 0;
+		std::uint64_t locks = 0;
+	};
+
+	//! Marks the current thread as rendering for its lifetime
+	class Scope
+	{
+	public:
+#ifdef LMMS_DEBUG_REALTIME
+		Scope();
+		~Scope();
+#else
+		Scope() = default;
+#endif
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+#ifdef LMMS_DEBUG_REALTIME
+		bool m_wasRendering;
+#endif
+	};
+
+	static constexpr bool isEnabled()
+	{
+#ifdef LMMS_DEBUG_REALTIME
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	//! Return the counts since the previous call and reset them
+	static Counts takeCounts();
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_REALTIME_CHECKER_H
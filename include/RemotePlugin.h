@@ -25,6 +25,9 @@
 #ifndef LMMS_REMOTE_PLUGIN_H
 #define LMMS_REMOTE_PLUGIN_H
 
+#include <atomic>
+
+#include "RemotePluginAudioSync.h"
 #include "RemotePluginBase.h"
 #include "SharedMemory.h"
 
@@ -131,11 +134,31 @@ public:
 		return m_failed;
 	}
 
+	//! In pipelined mode, process() hands the current period to the remote
+	//! process and returns the output of the previous one without waiting,
+	//! which adds one period of latency. Only takes effect where the remote
+	//! process supports the shared sync block (see RemotePluginAudioSync).
+	//! Follows the "pipelinedremoteplugins" setting unless called.
+	void setPipelined(bool pipelined)
+	{
+		m_pipelined = pipelined;
+	}
+
+	bool isPipelined() const
+	{
+		return m_pipelined && m_audioSyncEnabled;
+	}
+
 	inline void lock()
 	{
 		m_commMutex.lock();
 	}
 
+	inline bool tryLock()
+	{
+		return m_commMutex.tryLock();
+	}
+
 	inline void unlock()
 	{
 		m_commMutex.unlock();
@@ -146,15 +169,13 @@ public slots:
 	virtual void hideUI();
 
 protected:
-	inline void setSplittedChannels( bool _on )
-	{
-		m_splitChannels = _on;
-	}
-
+	void messageSent() override;
 
 	bool m_failed;
 private:
 	void resizeSharedProcessingMemory();
+	void setupAudioSync();
+	bool waitForProcessingDone();
 
 
 	QProcess m_process;
@@ -168,11 +189,22 @@ private:
 #else
 	QMutex m_commMutex;
 #endif
-	bool m_splitChannels;
 
 	SharedMemory<float[]> m_audioBuffer;
+	//! Size of the buffers for one period in bytes; there are two of them,
+	//! so that pipelining can be switched on at any time
 	std::size_t m_audioBufferSize;
 
+	SharedMemory<RemotePluginAudioSync> m_audioSync;
+	//! Set once the remote process acknowledged m_audioSync
+	bool m_audioSyncEnabled;
+	std::atomic<bool> m_pipelined;
+	//! Only used by process()
+	bool m_wasPipelined;
+	//! The period in which pipelining was switched on
+	std::uint32_t m_pipelineStart;
+	std::uint32_t m_periodsRequested;
+
 	int m_inputCount;
 	int m_outputCount;
 
@@ -0,0 +1,170 @@
+/*
+ * RemotePluginAudioSync.h - shared completion counter for remote plugins
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_REMOTE_PLUGIN_AUDIO_SYNC_H
+#define LMMS_REMOTE_PLUGIN_AUDIO_SYNC_H
+
+#include <cstdint>
+
+// The Wine bridges are built with winegcc, which makes them Linux processes
+// that define _WIN32, so they can use futexes just like native plugins
+#if defined(__linux__)
+#	define LMMS_HAVE_REMOTE_AUDIO_SYNC
+#	include <cerrno>
+#	include <climits>
+#	include <ctime>
+#	include <linux/futex.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+namespace lmms
+{
+
+
+/**
+	Lives in its own shared memory segment next to the audio buffer of a
+	RemotePlugin and replaces the messages exchanged for every period.
+
+	The host starts a period by incrementing the number of started periods
+	and ringing the doorbell, a futex the remote process waits on. The remote
+	process increments the number of completed periods when it's done and
+	wakes up the host through a futex on that counter. This saves both
+	messages on the render thread and lets the host check for finished
+	periods without blocking at all.
+
+	Messages still go through the regular channel. So that the remote process
+	sees them in order with the periods, the host counts the messages it
+	sends and rings the doorbell for them as well, and records for each
+	period how many messages came before it. The remote process in turn sets
+	a flag after each message it sends, so that the host only looks into the
+	message queue when there is something in it.
+*/
+struct RemotePluginAudioSync
+{
+	std::uint32_t completed;
+	std::uint32_t messagesSent;
+	std::uint32_t doorbell;
+	std::uint32_t hostMessages;
+	std::uint32_t started;
+	//! hostMessages at the start of each of the last two periods
+	std::uint32_t messagesBefore[2];
+
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+	static std::uint32_t load(const std::uint32_t& value)
+	{
+		return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+	}
+
+	//! Wait until `value` differs from `expected`, a wake-up or the timeout
+	static void wait(const std::uint32_t& value, std::uint32_t expected, int timeoutMs)
+	{
+		const timespec timeout = { timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+		syscall(SYS_futex, &value, FUTEX_WAIT, expected, &timeout, nullptr, 0);
+	}
+
+	static void wake(std::uint32_t& value)
+	{
+		syscall(SYS_futex, &value, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	std::uint32_t completedPeriods() const
+	{
+		return load(completed);
+	}
+
+	//! Called by the host after it sent a message
+	void signalHostMessage()
+	{
+		__atomic_fetch_add(&hostMessages, 1, __ATOMIC_RELEASE);
+		ringDoorbell();
+	}
+
+	//! Called by the host once the input of the next period is written
+	void startPeriod()
+	{
+		const std::uint32_t period = load(started);
+		__atomic_store_n(&messagesBefore[period % 2], load(hostMessages), __ATOMIC_RELAXED);
+		__atomic_store_n(&started, period + 1, __ATOMIC_RELEASE);
+		ringDoorbell();
+	}
+
+	//! Called by the remote process once the output of a period is written
+	void signalCompleted()
+	{
+		__atomic_fetch_add(&completed, 1, __ATOMIC_RELEASE);
+		wake(completed);
+	}
+
+	//! Called by the remote process after it sent a message
+	void signalMessageSent()
+	{
+		__atomic_store_n(&messagesSent, 1, __ATOMIC_RELEASE);
+	}
+
+	//! Whether messages were sent since the last call
+	bool takeMessagesSent()
+	{
+		return __atomic_exchange_n(&messagesSent, 0, __ATOMIC_ACQUIRE) != 0;
+	}
+
+	//! Wait until at least `periods` periods are completed; returns false on timeout
+	bool waitForCompleted(std::uint32_t periods, int timeoutMs) const
+	{
+		const timespec timeout = { timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+		while (true)
+		{
+			const std::uint32_t current = completedPeriods();
+			// the counter is allowed to wrap around
+			if (static_cast<std::int32_t>(current - periods) >= 0) { return true; }
+
+			if (syscall(SYS_futex, &completed, FUTEX_WAIT, current, &timeout, nullptr, 0) == -1
+				&& errno == ETIMEDOUT)
+			{
+				return false;
+			}
+		}
+	}
+
+	void ringDoorbell()
+	{
+		__atomic_fetch_add(&doorbell, 1, __ATOMIC_RELEASE);
+		wake(doorbell);
+	}
+#else
+	// never acknowledged by the remote process here, so nothing relies on it
+	std::uint32_t completedPeriods() const
+	{
+		return completed;
+	}
+
+	bool takeMessagesSent()
+	{
+		return true;
+	}
+#endif
+} ;
+
+
+} // namespace lmms
+
+#endif // LMMS_REMOTE_PLUGIN_AUDIO_SYNC_H
@@ -365,6 +365,7 @@ enum RemoteMessageIDs
 	IdLoadPresetFile,
 	IdDebugMessage,
 	IdIdle,
+	IdChangeAudioSyncKey,
 	IdUserBase = 64
 } ;
 
@@ -467,6 +468,14 @@ public:
 	int sendMessage( const message & _m );
 	message receiveMessage();
 
+	//! Number of floats one period takes in the shared audio buffer. Input
+	//! and output each hold the stereo frames of the host, so that it only
+	//! has to copy them; remote processes split the channels themselves.
+	static std::size_t audioSlotSize( int _inputs, int _outputs, fpp_t _frames )
+	{
+		return ( ( _inputs > 0 ) + ( _outputs > 0 ) ) * DEFAULT_CHANNELS * static_cast<std::size_t>( _frames );
+	}
+
 	inline bool isInvalid() const
 	{
 #ifdef SYNC_WITH_SHM_FIFO
@@ -559,6 +568,17 @@ public:
 
 
 protected:
+	//! Called after each message sendMessage() wrote, before other threads
+	//! can send theirs, so messages are counted in the order they are sent
+	virtual void messageSent()
+	{
+	}
+
+	//! Called after each message receiveMessage() read, likewise
+	virtual void messageReceived()
+	{
+	}
+
 #ifdef SYNC_WITH_SHM_FIFO
 	inline const shmFifo * in() const
 	{
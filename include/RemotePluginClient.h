@@ -38,6 +38,7 @@
 #	include <unistd.h>
 #endif
 
+#include "RemotePluginAudioSync.h"
 #include "SharedMemory.h"
 #include "VstSyncData.h"
 
@@ -58,6 +59,11 @@ public:
 
 	const VstSyncData* getVstSyncData();
 
+	//! Like receiveMessage(), but once the host uses the shared sync block,
+	//! the periods it starts there come back as IdStartProcessing messages,
+	//! in order with the messages sent around them
+	message receiveMessageOrPeriod();
+
 	bool processMessage( const message & _m ) override;
 
 	virtual void process( const SampleFrame* _in_buf,
@@ -122,11 +128,33 @@ public:
 	}
 
 
+protected:
+	void messageSent() override
+	{
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+		if (m_audioSync)
+		{
+			m_audioSync->signalMessageSent();
+		}
+#endif
+	}
+
+	void messageReceived() override
+	{
+		// only counted from the message carrying the key of m_audioSync on
+		++m_messagesReceived;
+	}
+
 private:
 	void setShmKey(const std::string& key);
-	void doProcessing();
+	void setAudioSyncKey(const std::string& key);
+	void doProcessing(int slot);
 
 	SharedMemory<float[]> m_audioBuffer;
+	SharedMemory<RemotePluginAudioSync> m_audioSync;
+	//! Messages received and periods handled since m_audioSync was attached
+	std::uint32_t m_messagesReceived;
+	std::uint32_t m_periodsHandled;
 	SharedMemory<const VstSyncData> m_vstSyncData;
 
 	int m_inputCount;
@@ -184,6 +212,8 @@ RemotePluginClient::RemotePluginClient( const std::string& _shm_in, const std::s
 RemotePluginClient::RemotePluginClient( const char * socketPath ) :
 	RemotePluginBase(),
 #endif
+	m_messagesReceived( 0 ),
+	m_periodsHandled( 0 ),
 	m_inputCount( 0 ),
 	m_outputCount( 0 ),
 	m_sampleRate( 44100 ),
@@ -240,6 +270,43 @@ const VstSyncData* RemotePluginClient::getVstSyncData()
 
 
 
+RemotePluginClient::message RemotePluginClient::receiveMessageOrPeriod()
+{
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+	while (m_audioSync)
+	{
+		const std::uint32_t doorbell = RemotePluginAudioSync::load(m_audioSync->doorbell);
+		// The host starts a period before it counts the messages sent after
+		// it, so a period started after these messages is seen as well
+		const std::uint32_t messages = RemotePluginAudioSync::load(m_audioSync->hostMessages);
+		const std::uint32_t periods = RemotePluginAudioSync::load(m_audioSync->started);
+
+		// Messages are counted once they are written, so we may have read
+		// more than were counted yet. The counters are allowed to wrap around.
+		if (m_periodsHandled != periods && static_cast<std::int32_t>(
+			m_messagesReceived - m_audioSync->messagesBefore[m_periodsHandled % 2]) >= 0)
+		{
+			// everything sent before the period is handled, so process it
+			const int slot = m_periodsHandled++ % 2;
+			return message(IdStartProcessing).addInt(slot).addInt(1);
+		}
+
+		if (static_cast<std::int32_t>(messages - m_messagesReceived) > 0)
+		{
+			// the message is written already, so this doesn't block
+			return receiveMessage();
+		}
+
+		// the parent poller ends us if the host went away without IdQuit
+		RemotePluginAudioSync::wait(m_audioSync->doorbell, doorbell, 100);
+	}
+#endif
+	return receiveMessage();
+}
+
+
+
+
 bool RemotePluginClient::processMessage( const message & _m )
 {
 	message reply_message( _m.id );
@@ -294,7 +361,15 @@ bool RemotePluginClient::processMessage( const message & _m )
 			break;
 
 		case IdStartProcessing:
-			doProcessing();
+			doProcessing(_m.getInt(0));
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+			// the host waits on the shared counter instead of a reply
+			if (_m.getInt(1) && m_audioSync)
+			{
+				m_audioSync->signalCompleted();
+				break;
+			}
+#endif
 			reply_message.id = IdProcessingDone;
 			reply = true;
 			break;
@@ -303,6 +378,14 @@ bool RemotePluginClient::processMessage( const message & _m )
 			setShmKey(_m.getString(0));
 			break;
 
+		case IdChangeAudioSyncKey:
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+			// acknowledge, so the host starts using the sync block
+			setAudioSyncKey(_m.getString(0));
+			reply = static_cast<bool>(m_audioSync);
+#endif
+			break;
+
 		case IdInitDone:
 			break;
 
@@ -340,13 +423,38 @@ void RemotePluginClient::setShmKey(const std::string& key)
 
 
 
-void RemotePluginClient::doProcessing()
+void RemotePluginClient::setAudioSyncKey(const std::string& key)
+{
+	try
+	{
+		m_audioSync.attach(key);
+		// the host counts the messages from the one carrying the key on
+		m_messagesReceived = 1;
+		m_periodsHandled = 0;
+	}
+	catch (const std::runtime_error& error)
+	{
+		debugMessage(std::string{"failed getting audio sync memory: "} + error.what() + '\n');
+	}
+}
+
+
+
+
+void RemotePluginClient::doProcessing(int slot)
 {
 	if (m_audioBuffer)
 	{
-		process( (SampleFrame*)( m_inputCount > 0 ? m_audioBuffer.get() : nullptr ),
-				(SampleFrame*)( m_audioBuffer.get() +
-					( m_inputCount*m_bufferSize ) ) );
+		// in pipelined mode the host alternates between two buffers
+		float* buffer = m_audioBuffer.get() + slot * audioSlotSize(m_inputCount, m_outputCount, m_bufferSize);
+		float* output = m_inputCount > 0 ? buffer + DEFAULT_CHANNELS * m_bufferSize : buffer;
+		if (m_outputCount > 0)
+		{
+			// stays silent if the plugin skips the period
+			memset(output, 0, DEFAULT_CHANNELS * m_bufferSize * sizeof(float));
+		}
+		process( (SampleFrame*)( m_inputCount > 0 ? buffer : nullptr ),
+				(SampleFrame*)output );
 	}
 	else
 	{
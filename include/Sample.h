@@ -27,6 +27,7 @@
 
 #include <cmath>
 #include <memory>
+#include <optional>
 
 #include "AudioResampler.h"
 #include "Note.h"
@@ -54,25 +55,39 @@ public:
 	{
 	public:
 		PlaybackState(bool varyingPitch = false, int interpolationMode = SRC_LINEAR)
-			: m_resampler(interpolationMode, DEFAULT_CHANNELS)
+			: m_interpolationMode(interpolationMode)
 			, m_varyingPitch(varyingPitch)
 		{
+			// Sample interpolates without libsamplerate in these modes
+			if (interpolationMode != SRC_ZERO_ORDER_HOLD && interpolationMode != SRC_LINEAR)
+			{
+				m_resampler.emplace(interpolationMode, DEFAULT_CHANNELS);
+			}
 		}
 
-		auto resampler() -> AudioResampler& { return m_resampler; }
+		auto interpolationMode() const -> int { return m_interpolationMode; }
 		auto frameIndex() const -> int { return m_frameIndex; }
 		auto varyingPitch() const -> bool { return m_varyingPitch; }
 		auto backwards() const -> bool { return m_backwards; }
 
-		void setFrameIndex(int frameIndex) { m_frameIndex = frameIndex; }
+		void setFrameIndex(int frameIndex)
+		{
+			m_frameIndex = frameIndex;
+			m_fraction = 0.0;
+		}
 		void setVaryingPitch(bool varyingPitch) { m_varyingPitch = varyingPitch; }
 		void setBackwards(bool backwards) { m_backwards = backwards; }
 
 	private:
-		AudioResampler m_resampler;
+		std::optional<AudioResampler> m_resampler;
+		int m_interpolationMode = SRC_LINEAR;
 		int m_frameIndex = 0;
+		//! Position between m_frameIndex and the next frame, when Sample interpolates itself
+		double m_fraction = 0.0;
 		bool m_varyingPitch = false;
 		bool m_backwards = false;
+		//! Whether m_resampler has been fed, after which it keeps the playback position
+		bool m_resamplerActive = false;
 		friend class Sample;
 	};
 
@@ -117,8 +132,12 @@ public:
 	void setReversed(bool reversed) { m_reversed.store(reversed, std::memory_order_relaxed); }
 
 private:
-	void playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const;
-	void advance(PlaybackState* state, size_t advanceAmount, Loop loopMode) const;
+	struct Cursor;
+
+	void playNative(SampleFrame* dst, PlaybackState* state, Cursor& cursor, size_t numFrames, double step) const;
+	void playResampled(SampleFrame* dst, PlaybackState* state, Cursor& cursor, size_t numFrames,
+		double resampleRatio) const;
+	void playRaw(SampleFrame* dst, size_t numFrames, Cursor cursor) const;
 
 private:
 	std::shared_ptr<const SampleBuffer> m_buffer = SampleBuffer::emptyBuffer();
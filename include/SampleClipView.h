@@ -58,12 +58,11 @@ protected:
 	void dragEnterEvent( QDragEnterEvent * _dee ) override;
 	void dropEvent( QDropEvent * _de ) override;
 	void mouseDoubleClickEvent( QMouseEvent * ) override;
-	void paintEvent( QPaintEvent * ) override;
+	void paintClip(QPainter& p) override;
 
 
 private:
 	SampleClip * m_clip;
-	QPixmap m_paintPixmap;
 	bool splitClip( const TimePos pos ) override;
 } ;
 
@@ -30,6 +30,7 @@
 
 #include <QHash>
 #include <QString>
+#include <QTimer>
 
 #include "AudioEngine.h"
 #include "Controller.h"
@@ -413,6 +414,10 @@ private slots:
 
 	void updateFramesPerTick();
 
+	//! Instantiate deferred instruments the song is about to play, and defer idle ones
+	//! if we're using too much memory
+	void updateDeferredInstruments();
+
 
 
 private:
@@ -517,6 +522,8 @@ private:
 
 	AutomatedValueMap m_oldAutomatedValues;
 
+	QTimer m_deferredInstrumentsTimer;
+
 	Metronome m_metronome;
 
 	friend class Engine;
@@ -26,13 +26,18 @@
 #define LMMS_THREADABLE_JOB_H
 
 #include "lmms_basics.h"
+#include "lmms_export.h"
+#include "LoadMeter.h"
+#include "RandomStream.h"
 
 #include <atomic>
+#include <cstdint>
+#include <utility>
 
 namespace lmms
 {
 
-class ThreadableJob
+class LMMS_EXPORT ThreadableJob
 {
 public:
 
@@ -44,8 +49,13 @@ public:
 		Done
 	};
 
+	//! The random stream of the job is seeded from the current one, so that a
+	//! job created by another job (e.g. the notes of an arpeggio) gets the same
+	//! seed in every render
 	ThreadableJob() :
-		m_state(ProcessingState::Unstarted)
+		m_state(ProcessingState::Unstarted),
+		m_random(RandomStream::current().next()),
+		m_creationIndex(nextCreationIndex())
 	{
 	}
 
@@ -74,6 +84,8 @@ public:
 		auto expected = ProcessingState::Queued;
 		if (m_state.compare_exchange_strong(expected, ProcessingState::InProgress))
 		{
+			RandomStream::Scope scope(m_random);
+			LoadMeter::JobProbe probe(loadMeter());
 			doProcessing();
 			m_state = ProcessingState::Done;
 		}
@@ -81,11 +93,31 @@ public:
 
 	virtual bool requiresProcessing() const = 0;
 
+	//! The meter the processing time of the job counts for, if any
+	virtual LoadMeter* loadMeter()
+	{
+		return nullptr;
+	}
+
+	//! A key that orders jobs the same way in every render with the same seed.
+	//! Jobs created outside of jobs on different threads draw their seeds
+	//! from equally seeded streams, so equal seeds are ordered by creation.
+	std::pair<std::uint64_t, std::uint64_t> orderKey() const
+	{
+		return {m_random.seed(), m_creationIndex};
+	}
+
 
 protected:
 	virtual void doProcessing() = 0;
 
 	std::atomic<ProcessingState> m_state;
+
+private:
+	static std::uint64_t nextCreationIndex();
+
+	RandomStream m_random;
+	std::uint64_t m_creationIndex;
 } ;
 
 } // namespace lmms
@@ -28,6 +28,7 @@
 #include <QWidget>
 
 #include "JournallingObject.h"
+#include "lmms_basics.h"
 #include "TimePos.h"
 
 
@@ -84,6 +85,11 @@ public:
 
 	TimePos endPosition( const TimePos & posStart );
 
+	//! Has to be called when a clip moves or its length changes
+	void invalidateClipIndex();
+	//! Repaints a clip view that is drawn by this widget, see paintEvent()
+	void updateClipView( ClipView * clipv );
+
 	// qproperty access methods
 
 	QBrush darkerColor() const;
@@ -129,8 +135,10 @@ protected:
 	void contextMenuEvent( QContextMenuEvent * cme ) override;
 	void contextMenuAction( QContextMenuEvent * cme, ContextMenuAction action );
 	void dragEnterEvent( QDragEnterEvent * dee ) override;
+	void dragMoveEvent( QDragMoveEvent * dme ) override;
 	void dropEvent( QDropEvent * de ) override;
 	void mousePressEvent( QMouseEvent * me ) override;
+	void mouseMoveEvent( QMouseEvent * me ) override;
 	void mouseReleaseEvent( QMouseEvent * me ) override;
 	void paintEvent( QPaintEvent * pe ) override;
 	void resizeEvent( QResizeEvent * re ) override;
@@ -156,11 +164,28 @@ private:
 	Track * getTrack();
 	TimePos getPosition( int mouseX );
 
+	void updateClipIndex();
+	ClipView * clipViewAt( const QPoint & pos ) const;
+	void setActiveClipView( ClipView * clipv );
+	void updateActiveClipView();
+
 	TrackView * m_trackView;
 
 	using clipViewVector = QVector<ClipView*>;
 	clipViewVector m_clipViews;
 
+	//! The clip views sorted by the start of their clips
+	clipViewVector m_clipIndex;
+	//! The length of the longest clip, how far changePosition() looks back
+	tick_t m_longestClip;
+	bool m_clipIndexValid;
+
+	//! The clip views in the visible range of the Song Editor
+	clipViewVector m_visibleClipViews;
+	//! The clip view under the mouse, the only one shown as a widget in
+	//! the Song Editor. This widget draws the others.
+	ClipView * m_activeClipView;
+
 	QPixmap m_background;
 
 	// qproperty fields
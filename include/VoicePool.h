@@ -0,0 +1,107 @@
+/*
+ * VoicePool.h - preallocated storage for per-note instrument state
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_VOICE_POOL_H
+#define LMMS_VOICE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "LocklessAllocator.h"
+
+namespace lmms
+{
+
+
+/**
+	Storage for the per-note state instruments keep in
+	NotePlayHandle::m_pluginData. The memory for `capacity` voices is
+	allocated up front, so playNote() and deleteNotePluginData() don't touch
+	the heap as long as no more voices are playing at once. Voices beyond
+	that limit are allocated with new as before.
+
+	acquire() and release() are lock-free and may be called concurrently from
+	the worker threads of the audio engine.
+*/
+template<typename T>
+class VoicePool
+{
+public:
+	explicit VoicePool(std::size_t capacity) :
+		m_allocator(capacity)
+	{
+	}
+
+	VoicePool(const VoicePool&) = delete;
+	VoicePool& operator=(const VoicePool&) = delete;
+
+	template<typename... Args>
+	T* acquire(Args&&... args)
+	{
+		T* voice = m_allocator.tryAlloc();
+		if (!voice)
+		{
+			return new T(std::forward<Args>(args)...);
+		}
+
+		try
+		{
+			return new (voice) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			m_allocator.free(voice);
+			throw;
+		}
+	}
+
+	//! Destroys a voice returned by acquire(); nullptr is ignored
+	void release(T* voice)
+	{
+		if (!voice) { return; }
+
+		if (m_allocator.contains(voice))
+		{
+			voice->~T();
+			m_allocator.free(voice);
+		}
+		else
+		{
+			delete voice;
+		}
+	}
+
+	//! Whether a voice lives in the preallocated storage
+	bool owns(const T* voice) const
+	{
+		return m_allocator.contains(voice);
+	}
+
+private:
+	LocklessAllocatorT<T> m_allocator;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_VOICE_POOL_H
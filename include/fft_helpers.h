@@ -86,6 +86,28 @@ int LMMS_EXPORT notEmpty(const std::vector<float> &spectrum);
 int LMMS_EXPORT precomputeWindow(float *window, unsigned int length, FFTWindow type, bool normalized = true);
 
 
+/**	Get a real-to-complex plan for `channels` transforms of `size` samples each.
+ *	Channel n starts at in + n * size and out + n * (size / 2 + 1); in and out
+ *	must not overlap.
+ *
+ *	Plans are cached and shared, so each shape is only measured once. The
+ *	FFTW wisdom collected while measuring is saved in the config directory and
+ *	restored in later sessions. The plan must not be destroyed by the caller.
+ *
+ *	The plan is created on internal buffers with the same alignment as in and
+ *	out. Run it with fftwf_execute_dft_r2c() on in and out, or on any other
+ *	buffers with the same alignment. This function is thread-safe.
+ */
+fftwf_plan LMMS_EXPORT fftPlanR2C(unsigned int size, const float* in, const fftwf_complex* out, unsigned int channels = 1);
+
+
+/**	Get a complex-to-real plan for `channels` transforms of `size` samples each.
+ *	Same rules as for fftPlanR2C(); run it with fftwf_execute_dft_c2r().
+ *	Like every complex-to-real transform, it overwrites its input.
+ */
+fftwf_plan LMMS_EXPORT fftPlanC2R(unsigned int size, const fftwf_complex* in, const float* out, unsigned int channels = 1);
+
+
 /**	Compute absolute values of complex_buffer, save to absspec_buffer.
  *	Take care that - compl_len is not bigger than complex_buffer!
  *				   - absspec buffer is big enough!
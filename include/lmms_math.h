@@ -32,6 +32,7 @@
 
 #include "lmms_constants.h"
 #include "lmmsconfig.h"
+#include "RandomStream.h"
 #include <cassert>
 
 namespace lmms
@@ -73,11 +74,10 @@ inline float absFraction(const float x)
 
 
 constexpr float FAST_RAND_RATIO = 1.0f / 32767;
+//! Return a number in [0, 32767] from the RandomStream of the current job
 inline int fast_rand()
 {
-	static unsigned long next = 1;
-	next = next * 1103515245 + 12345;
-	return( (unsigned)( next / 65536 ) % 32768 );
+	return static_cast<int>(RandomStream::current().next() >> 49);
 }
 
 inline float fastRandf(float range)
@@ -294,10 +294,10 @@ CompressorControlDialog::CompressorControlDialog(CompressorControls* controls) :
 
 	connect(getGUI()->mainWindow(), SIGNAL(periodicUpdate()), this, SLOT(updateDisplay()));
 
-	connect(&m_controls->m_peakmodeModel, SIGNAL(dataChanged()), this, SLOT(peakmodeChanged()));
-	connect(&m_controls->m_stereoLinkModel, SIGNAL(dataChanged()), this, SLOT(stereoLinkChanged()));
-	connect(&m_controls->m_lookaheadModel, SIGNAL(dataChanged()), this, SLOT(lookaheadChanged()));
-	connect(&m_controls->m_limiterModel, SIGNAL(dataChanged()), this, SLOT(limiterChanged()));
+	connectChanges(&m_controls->m_peakmodeModel, this, [this] { peakmodeChanged(); });
+	connectChanges(&m_controls->m_stereoLinkModel, this, [this] { stereoLinkChanged(); });
+	connectChanges(&m_controls->m_lookaheadModel, this, [this] { lookaheadChanged(); });
+	connectChanges(&m_controls->m_limiterModel, this, [this] { limiterChanged(); });
 
 	m_timeElapsed.start();
 
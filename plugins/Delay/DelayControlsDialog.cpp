@@ -93,8 +93,8 @@ XyPad::XyPad(QWidget *parent, FloatModel *xModel, FloatModel *yModel) :
 	m_yModel( yModel ),
 	m_acceptInput( false )
 {
-	connect( m_xModel, SIGNAL( dataChanged() ) , this, SLOT( update() ) );
-	connect( m_yModel, SIGNAL( dataChanged() ) , this, SLOT( update() ) );
+	ModelView::connectChanges( m_xModel, this, [this] { update(); } );
+	ModelView::connectChanges( m_yModel, this, [this] { update(); } );
 }
 
 
@@ -25,6 +25,8 @@
 
 #include "DualFilter.h"
 
+#include <cassert>
+
 #include "embed.h"
 #include "BasicFilters.h"
 #include "plugin_export.h"
@@ -55,7 +57,8 @@ Plugin::Descriptor PLUGIN_EXPORT dualfilter_plugin_descriptor =
 
 DualFilterEffect::DualFilterEffect( Model* parent, const Descriptor::SubPluginFeatures::Key* key ) :
 	Effect( &dualfilter_plugin_descriptor, parent, key ),
-	m_dfControls( this )
+	m_dfControls( this ),
+	m_resizeBuffers( false )
 {
 	m_filter1 = new BasicFilters<2>( Engine::audioEngine()->outputSampleRate() );
 	m_filter2 = new BasicFilters<2>( Engine::audioEngine()->outputSampleRate() );
@@ -63,6 +66,8 @@ DualFilterEffect::DualFilterEffect( Model* parent, const Descriptor::SubPluginFe
 	// ensure filters get updated
 	m_filter1changed = true;
 	m_filter2changed = true;
+
+	resizeFilterBuffers();
 }
 
 
@@ -84,6 +89,12 @@ bool DualFilterEffect::processAudioBuffer( SampleFrame* buf, const fpp_t frames
 		return( false );
 	}
 
+	// the buffers are in use here, so they can only be resized here
+	if( m_resizeBuffers.exchange( false ) )
+	{
+		resizeFilterBuffers();
+	}
+
 	double outSum = 0.0;
 	const float d = dryLevel();
 	const float w = wetLevel();
@@ -91,12 +102,12 @@ bool DualFilterEffect::processAudioBuffer( SampleFrame* buf, const fpp_t frames
     if( m_dfControls.m_filter1Model.isValueChanged() || m_filter1changed )
 	{
 		m_filter1->setFilterType( static_cast<BasicFilters<2>::FilterType>(m_dfControls.m_filter1Model.value()) );
-		m_filter1changed = true;
+		m_filter1changed = false;
 	}
     if( m_dfControls.m_filter2Model.isValueChanged() || m_filter2changed )
 	{
 		m_filter2->setFilterType( static_cast<BasicFilters<2>::FilterType>(m_dfControls.m_filter2Model.value()) );
-		m_filter2changed = true;
+		m_filter2changed = false;
 	}
 
 	float cut1 = m_dfControls.m_cut1Model.value();
@@ -134,8 +145,19 @@ bool DualFilterEffect::processAudioBuffer( SampleFrame* buf, const fpp_t frames
 	const bool enabled1 = m_dfControls.m_enabled1Model.value();
 	const bool enabled2 = m_dfControls.m_enabled2Model.value();
 
-
-
+	// run both filters over the whole period first, so that the filter type is
+	// only dispatched once per block and coefficients are updated in sub-blocks
+	assert( static_cast<std::size_t>( frames ) <= m_filterBuffer1.size() );
+	if( enabled1 )
+	{
+		std::copy( buf, buf + frames, m_filterBuffer1.begin() );
+		m_filter1->processBlock( m_filterBuffer1.data(), frames, cut1Ptr, cut1Inc, res1Ptr, res1Inc );
+	}
+	if( enabled2 )
+	{
+		std::copy( buf, buf + frames, m_filterBuffer2.begin() );
+		m_filter2->processBlock( m_filterBuffer2.data(), frames, cut2Ptr, cut2Inc, res2Ptr, res2Inc );
+	}
 
 	// buffer processing loop
 	for( fpp_t f = 0; f < frames; ++f )
@@ -146,56 +168,19 @@ bool DualFilterEffect::processAudioBuffer( SampleFrame* buf, const fpp_t frames
 		const float gain1 = *gain1Ptr * 0.01f;
 		const float gain2 = *gain2Ptr * 0.01f;
 		auto s = std::array{0.0f, 0.0f};	// mix
-		auto s1 = std::array{buf[f][0], buf[f][1]};	// filter 1
-		auto s2 = std::array{buf[f][0], buf[f][1]};	// filter 2
 
-		// update filter 1
+		// apply gain and mix of filter 1
 		if( enabled1 )
 		{
-			//update filter 1 params here
-			// recalculate only when necessary: either cut/res is changed, or the changed-flag is set (filter type or samplerate changed)
-			if( ( ( *cut1Ptr != m_currentCut1 ||
-				*res1Ptr != m_currentRes1 ) ) || m_filter1changed )
-			{
-				m_filter1->calcFilterCoeffs( *cut1Ptr, *res1Ptr );
-				m_filter1changed = false;
-				m_currentCut1 = *cut1Ptr;
-				m_currentRes1 = *res1Ptr;
-			}
-			s1[0] = m_filter1->update( s1[0], 0 );
-			s1[1] = m_filter1->update( s1[1], 1 );
-
-			// apply gain
-			s1[0] *= gain1;
-			s1[1] *= gain1;
-
-			// apply mix
-			s[0] += ( s1[0] * mix1 );
-			s[1] += ( s1[1] * mix1 );
+			s[0] += m_filterBuffer1[f][0] * gain1 * mix1;
+			s[1] += m_filterBuffer1[f][1] * gain1 * mix1;
 		}
 
-		// update filter 2
+		// apply gain and mix of filter 2
 		if( enabled2 )
 		{
-			//update filter 2 params here
-			if( ( ( *cut2Ptr != m_currentCut2 ||
-								*res2Ptr != m_currentRes2 ) ) || m_filter2changed )
-			{
-				m_filter2->calcFilterCoeffs( *cut2Ptr, *res2Ptr );
-				m_filter2changed = false;
-				m_currentCut2 = *cut2Ptr;
-				m_currentRes2 = *res2Ptr;
-			}
-			s2[0] = m_filter2->update( s2[0], 0 );
-			s2[1] = m_filter2->update( s2[1], 1 );
-
-			//apply gain
-			s2[0] *= gain2;
-			s2[1] *= gain2;
-
-			// apply mix
-			s[0] += ( s2[0] * mix2 );
-			s[1] += ( s2[1] * mix2 );
+			s[0] += m_filterBuffer2[f][0] * gain2 * mix2;
+			s[1] += m_filterBuffer2[f][1] * gain2 * mix2;
 		}
 
 		// do another mix with dry signal
@@ -204,11 +189,7 @@ bool DualFilterEffect::processAudioBuffer( SampleFrame* buf, const fpp_t frames
 		outSum += buf[f][0] * buf[f][0] + buf[f][1] * buf[f][1];
 
 		//increment pointers
-		cut1Ptr += cut1Inc;
-		res1Ptr += res1Inc;
 		gain1Ptr += gain1Inc;
-		cut2Ptr += cut2Inc;
-		res2Ptr += res2Inc;
 		gain2Ptr += gain2Inc;
 		mixPtr += mixInc;
 	}
@@ -218,6 +199,16 @@ bool DualFilterEffect::processAudioBuffer( SampleFrame* buf, const fpp_t frames
 	return isRunning();
 }
 
+void DualFilterEffect::resizeFilterBuffers()
+{
+	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+	m_filterBuffer1.resize( frames );
+	m_filterBuffer2.resize( frames );
+}
+
+
+
+
 void DualFilterEffect::onEnabledChanged()
 {
 	m_filter1->clearHistory();
@@ -27,6 +27,9 @@
 #ifndef DUALFILTER_H
 #define DUALFILTER_H
 
+#include <atomic>
+#include <vector>
+
 #include "Effect.h"
 #include "DualFilterControls.h"
 #include "BasicFilters.h"
@@ -51,6 +54,10 @@ protected:
 	void onEnabledChanged() override;
 
 private:
+	//! Size the filter buffers for the period, outside of processing or
+	//! at the start of it on the audio thread
+	void resizeFilterBuffers();
+
 	DualFilterControls m_dfControls;
 
 	BasicFilters<2> * m_filter1;
@@ -58,11 +65,11 @@ private:
 	
 	bool m_filter1changed;
 	bool m_filter2changed;
+	//! Set by the GUI thread when the period may have changed
+	std::atomic<bool> m_resizeBuffers;
 
-	float m_currentCut1;
-	float m_currentRes1;
-	float m_currentCut2;
-	float m_currentRes2;
+	std::vector<SampleFrame> m_filterBuffer1;
+	std::vector<SampleFrame> m_filterBuffer2;
 
 	friend class DualFilterControls;
 
@@ -118,6 +118,8 @@ void DualFilterControls::updateFilters()
 	
 	m_effect->m_filter1changed = true;
 	m_effect->m_filter2changed = true;
+
+	m_effect->m_resizeBuffers = true;
 }
 
 
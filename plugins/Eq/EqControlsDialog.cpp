@@ -131,10 +131,10 @@ EqControlsDialog::EqControlsDialog( EqControls *controls ) :
 		activeButton->setModel( m_parameterWidget->getBandModels( i )->active );
 
 		// Connects the knobs, Faders and buttons with the curve graphic
-		QObject::connect( m_parameterWidget->getBandModels( i )->freq , SIGNAL( dataChanged() ), m_parameterWidget, SLOT ( updateHandle() ) );
-		if ( m_parameterWidget->getBandModels( i )->gain ) QObject::connect( m_parameterWidget->getBandModels( i )->gain, SIGNAL( dataChanged() ), m_parameterWidget, SLOT ( updateHandle() ));
-		QObject::connect( m_parameterWidget->getBandModels( i )->res, SIGNAL( dataChanged() ), m_parameterWidget , SLOT ( updateHandle() ) );
-		QObject::connect( m_parameterWidget->getBandModels( i )->active, SIGNAL( dataChanged() ), m_parameterWidget , SLOT ( updateHandle() ) );
+		ModelView::connectChanges( m_parameterWidget->getBandModels( i )->freq, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+		if ( m_parameterWidget->getBandModels( i )->gain ) ModelView::connectChanges( m_parameterWidget->getBandModels( i )->gain, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+		ModelView::connectChanges( m_parameterWidget->getBandModels( i )->res, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+		ModelView::connectChanges( m_parameterWidget->getBandModels( i )->active, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
 
 		m_parameterWidget->changeHandle( i );
 		distance += 44;
@@ -190,13 +190,13 @@ EqControlsDialog::EqControlsDialog( EqControls *controls ) :
 
 	lp48Button->move( 387, 358 );
 	// the curve has to change its appearance
-	QObject::connect( m_parameterWidget->getBandModels( 0 )->hp12 , SIGNAL ( dataChanged() ), m_parameterWidget, SLOT( updateHandle()));
-	QObject::connect( m_parameterWidget->getBandModels( 0 )->hp24 , SIGNAL ( dataChanged() ), m_parameterWidget, SLOT( updateHandle()));
-	QObject::connect( m_parameterWidget->getBandModels( 0 )->hp48 , SIGNAL ( dataChanged() ), m_parameterWidget, SLOT( updateHandle()));
+	ModelView::connectChanges( m_parameterWidget->getBandModels( 0 )->hp12, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+	ModelView::connectChanges( m_parameterWidget->getBandModels( 0 )->hp24, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+	ModelView::connectChanges( m_parameterWidget->getBandModels( 0 )->hp48, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
 
-	QObject::connect( m_parameterWidget->getBandModels( 7 )->lp12 , SIGNAL ( dataChanged() ), m_parameterWidget, SLOT( updateHandle()));
-	QObject::connect( m_parameterWidget->getBandModels( 7 )->lp24 , SIGNAL ( dataChanged() ), m_parameterWidget, SLOT( updateHandle()));
-	QObject::connect( m_parameterWidget->getBandModels( 7 )->lp48 , SIGNAL ( dataChanged() ), m_parameterWidget, SLOT( updateHandle()));
+	ModelView::connectChanges( m_parameterWidget->getBandModels( 7 )->lp12, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+	ModelView::connectChanges( m_parameterWidget->getBandModels( 7 )->lp24, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
+	ModelView::connectChanges( m_parameterWidget->getBandModels( 7 )->lp48, m_parameterWidget, [this] { m_parameterWidget->updateHandle(); } );
 
 	auto lpBtnGrp = new automatableButtonGroup(this, tr("LP group"));
 	lpBtnGrp->addButton( lp12Button );
@@ -84,6 +84,8 @@ public:
 
 	EqBand* getBandModels( int i );
 	void changeHandle( int i );
+	//! Moves the handles to the values of the band models
+	void updateHandle();
 
 private:
 	float m_pixelsPerUnitWidth;
@@ -99,7 +101,6 @@ private:
 
 private slots:
 	void updateModels();
-	void updateHandle();
 };
 
 
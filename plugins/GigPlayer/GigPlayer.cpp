@@ -30,15 +30,17 @@
 
 #include "GigPlayer.h"
 
+#include <chrono>
 #include <cstring>
+#include <utility>
 #include <QDebug>
 #include <QLayout>
 #include <QLabel>
 #include <QDomDocument>
+#include <QFileInfo>
 
 #include "AudioEngine.h"
 #include "ConfigManager.h"
-#include "endian_handling.h"
 #include "Engine.h"
 #include "FileDialog.h"
 #include "InstrumentTrack.h"
@@ -46,6 +48,7 @@
 #include "Knob.h"
 #include "NotePlayHandle.h"
 #include "PathUtil.h"
+#include "ProjectLoader.h"
 #include "Sample.h"
 #include "Song.h"
 
@@ -80,6 +83,93 @@ Plugin::Descriptor PLUGIN_EXPORT gigplayer_plugin_descriptor =
 
 
 
+std::map<QString, std::shared_future<std::weak_ptr<GigInstance>>> GigInstance::s_instances;
+QMutex GigInstance::s_instancesMutex;
+
+namespace
+{
+
+// Let projects open their GIG files while the rest of them is restored
+[[maybe_unused]] const bool instancePrefetchRegistered = []
+{
+	ProjectLoader::registerBankLoader( "gig", []( const QString & absolutePath ) -> std::shared_ptr<void>
+	{
+		return GigInstance::open( absolutePath );
+	} );
+	return true;
+}();
+
+} // namespace
+
+
+
+
+std::shared_ptr<GigInstance> GigInstance::open( const QString & filename )
+{
+	const QString key = QFileInfo( filename ).canonicalFilePath();
+	if( key.isEmpty() )
+	{
+		// doesn't exist, let the constructor throw
+		return std::make_shared<GigInstance>( filename );
+	}
+
+	QMutexLocker locker( &s_instancesMutex );
+
+	for( auto it = s_instances.find( key ); it != s_instances.end(); it = s_instances.find( key ) )
+	{
+		const auto opened = it->second;
+		if( opened.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready
+			&& opened.get().expired() )
+		{
+			// nobody uses it anymore, open it again
+			break;
+		}
+
+		// another thread may still be opening it, wait for that without
+		// blocking the other files. Rethrows if opening failed.
+		locker.unlock();
+		if( auto instance = opened.get().lock() )
+		{
+			return instance;
+		}
+		locker.relock();
+	}
+
+	// forget about the files nobody uses anymore
+	for( auto i = s_instances.begin(); i != s_instances.end(); )
+	{
+		const bool unused = i->second.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready
+			&& i->second.get().expired();
+		i = unused ? s_instances.erase( i ) : std::next( i );
+	}
+
+	// others opening the same file wait for us from now on
+	std::promise<std::weak_ptr<GigInstance>> opening;
+	s_instances[key] = opening.get_future().share();
+	locker.unlock();
+
+	std::shared_ptr<GigInstance> instance;
+	try
+	{
+		instance = std::make_shared<GigInstance>( filename );
+	}
+	catch( ... )
+	{
+		locker.relock();
+		s_instances.erase( key );
+		locker.unlock();
+
+		opening.set_exception( std::current_exception() );
+		throw;
+	}
+
+	opening.set_value( instance );
+	return instance;
+}
+
+
+
+
 GigInstrument::GigInstrument( InstrumentTrack * _instrument_track ) :
 	Instrument(_instrument_track, &gigplayer_plugin_descriptor, nullptr, Flag::IsSingleStreamed | Flag::IsNotBendable),
 	m_instance( nullptr ),
@@ -189,14 +279,16 @@ void GigInstrument::freeInstance()
 
 	if( m_instance != nullptr )
 	{
-		delete m_instance;
-		m_instance = nullptr;
-
 		// If we're changing instruments, we got to make sure that we
 		// remove all pointers to the old samples and don't try accessing
-		// that instrument again
-		m_instrument = nullptr;
+		// that instrument again. The samples of the notes release their
+		// streams, so they have to go before the instance which owns the
+		// streamer, if this is its last user.
 		m_notes.clear();
+		m_regions.clear();
+		m_instrument = nullptr;
+
+		m_instance.reset();
 	}
 }
 
@@ -215,7 +307,7 @@ void GigInstrument::openFile( const QString & _gigFile, bool updateTrackName )
 
 		try
 		{
-			m_instance = new GigInstance( PathUtil::toAbsolute( _gigFile ) );
+			m_instance = GigInstance::open( PathUtil::toAbsolute( _gigFile ) );
 			m_filename = PathUtil::toShortestRelative( _gigFile );
 		}
 		catch( ... )
@@ -323,7 +415,6 @@ void GigInstrument::playNote( NotePlayHandle * _n, SampleFrame* )
 void GigInstrument::play( SampleFrame* _working_buffer )
 {
 	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
-	const auto rate = Engine::audioEngine()->outputSampleRate();
 
 	// Initialize to zeros
 	std::memset( &_working_buffer[0][0], 0, DEFAULT_CHANNELS * frames * sizeof( float ) );
@@ -404,87 +495,22 @@ void GigInstrument::play( SampleFrame* _working_buffer )
 		}
 	}
 
-	// Fill buffer with portions of the note samples
-	for (auto& note : m_notes)
+	// Count the samples to render, so that they can be split into parts
+	// which are rendered concurrently
+	std::size_t renderSamples = 0;
+	for (const auto& note : std::as_const(m_notes))
 	{
-		// Only process the notes if we're in a playing state
-		if (!(note.state == GigState::PlayingKeyDown || note.state == GigState::PlayingKeyUp ))
-		{
-			continue;
-		}
+		if (!isRendered(note)) { continue; }
 
-		for (auto& sample : note.samples)
+		for (const auto& sample : note.samples)
 		{
-			if (sample.sample == nullptr || sample.region == nullptr) { continue; }
-
-			// Will change if resampling
-			bool resample = false;
-			f_cnt_t samples = frames; // How many to grab
-			f_cnt_t used = frames; // How many we used
-			float freq_factor = 1.0; // How to resample
-
-			// Resample to be the correct pitch when the sample provided isn't
-			// solely for this one note (e.g. one or two samples per octave) or
-			// we are processing at a different sample rate
-			if (sample.region->PitchTrack == true || rate != sample.sample->SamplesPerSecond)
-			{
-				resample = true;
-
-				// Factor just for resampling
-				freq_factor = 1.0 * rate / sample.sample->SamplesPerSecond;
-
-				// Factor for pitch shifting as well as resampling
-				if (sample.region->PitchTrack == true) { freq_factor *= sample.freqFactor; }
-
-				// We need a bit of margin so we don't get glitching
-				samples = frames / freq_factor + Sample::s_interpolationMargins[m_interpolation];
-			}
-
-			// Load this note's data
-			SampleFrame sampleData[samples];
-			loadSample(sample, sampleData, samples);
-
-			// Apply ADSR using a copy so if we don't use these samples when
-			// resampling, the ADSR doesn't get messed up
-			ADSR copy = sample.adsr;
-
-			for( f_cnt_t i = 0; i < samples; ++i )
-			{
-				float amplitude = copy.value();
-				sampleData[i][0] *= amplitude;
-				sampleData[i][1] *= amplitude;
-			}
-
-			// Output the data resampling if needed
-			if( resample == true )
-			{
-				SampleFrame convertBuf[frames];
-
-				// Only output if resampling is successful (note that "used" is output)
-				if (sample.convertSampleRate(*sampleData, *convertBuf, samples, frames, freq_factor, used))
-				{
-					for( f_cnt_t i = 0; i < frames; ++i )
-					{
-						_working_buffer[i][0] += convertBuf[i][0];
-						_working_buffer[i][1] += convertBuf[i][1];
-					}
-				}
-			}
-			else
-			{
-				for( f_cnt_t i = 0; i < frames; ++i )
-				{
-					_working_buffer[i][0] += sampleData[i][0];
-					_working_buffer[i][1] += sampleData[i][1];
-				}
-			}
-
-			// Update note position with how many samples we actually used
-			sample.pos += used;
-			sample.adsr.inc(used);
+			if (isRendered(sample)) { ++renderSamples; }
 		}
 	}
 
+	m_renderPartCount = std::max<std::size_t>(1, renderSamples / SamplesPerPart);
+	renderParts(_working_buffer, m_renderPartCount);
+
 	m_notesMutex.unlock();
 	m_synthMutex.unlock();
 
@@ -499,169 +525,149 @@ void GigInstrument::play( SampleFrame* _working_buffer )
 
 
 
-void GigInstrument::loadSample( GigSample& sample, SampleFrame* sampleData, f_cnt_t samples )
+void GigInstrument::renderPart( std::size_t _part, SampleFrame* _buffer )
 {
-	if( sampleData == nullptr || samples < 1 )
+	// Every part renders an interleaved subset of the samples, so that
+	// notes with many layers are spread over several parts. The parts walk
+	// the notes instead of a list built by play(), so rendering never
+	// allocates.
+	std::size_t index = 0;
+	for( auto& note : m_notes )
 	{
-		return;
-	}
+		if( !isRendered( note ) ) { continue; }
 
-	// Determine if we need to loop part of this sample
-	bool loop = false;
-	gig::loop_type_t loopType = gig::loop_type_normal;
-	f_cnt_t loopStart = 0;
-	f_cnt_t loopLength = 0;
-
-	if( sample.region->pSampleLoops != nullptr )
-	{
-		for( uint32_t i = 0; i < sample.region->SampleLoops; ++i )
+		for( auto& sample : note.samples )
 		{
-			loop = true;
-			loopType = static_cast<gig::loop_type_t>( sample.region->pSampleLoops[i].LoopType );
-			loopStart = sample.region->pSampleLoops[i].LoopStart;
-			loopLength = sample.region->pSampleLoops[i].LoopLength;
+			if( !isRendered( sample ) ) { continue; }
 
-			// Currently only support at max one loop
-			break;
+			if( index++ % m_renderPartCount == _part )
+			{
+				renderSample( sample, _buffer );
+			}
 		}
 	}
+}
 
-	unsigned long allocationsize = samples * sample.sample->FrameSize;
-	int8_t buffer[allocationsize];
 
-	// Load the sample in different ways depending on if we're looping or not
-	if( loop == true && ( sample.pos >= loopStart || sample.pos + samples > loopStart ) )
-	{
-		// Calculate the new position based on the type of loop
-		if( loopType == gig::loop_type_bidirectional )
-		{
-			sample.pos = getPingPongIndex( sample.pos, loopStart, loopStart + loopLength );
-		}
-		else
-		{
-			sample.pos = getLoopedIndex( sample.pos, loopStart, loopStart + loopLength );
-			// TODO: also implement loop_type_backward support
-		}
 
-		sample.sample->SetPos( sample.pos );
 
-		// Load the samples (based on gig::Sample::ReadAndLoop) even around the end
-		// of a loop boundary wrapping to the beginning of the loop region
-		long samplestoread = samples;
-		long samplestoloopend = 0;
-		long readsamples = 0;
-		long totalreadsamples = 0;
-		long loopEnd = loopStart + loopLength;
+void GigInstrument::renderSample( GigSample& sample, SampleFrame* _buffer )
+{
+	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+	const auto rate = Engine::audioEngine()->outputSampleRate();
 
-		do
-		{
-			samplestoloopend = loopEnd - sample.sample->GetPos();
-			readsamples = sample.sample->Read( &buffer[totalreadsamples * sample.sample->FrameSize],
-					std::min( samplestoread, samplestoloopend ) );
-			samplestoread -= readsamples;
-			totalreadsamples += readsamples;
+	// Will change if resampling
+	bool resample = false;
+	f_cnt_t samples = frames; // How many to grab
+	f_cnt_t used = frames; // How many we used
+	float freq_factor = 1.0; // How to resample
 
-			if( readsamples >= samplestoloopend )
-			{
-				sample.sample->SetPos( loopStart );
-			}
-		}
-		while( samplestoread > 0 && readsamples > 0 );
-	}
-	else
+	// Resample to be the correct pitch when the sample provided isn't
+	// solely for this one note (e.g. one or two samples per octave) or
+	// we are processing at a different sample rate
+	if (sample.region->PitchTrack == true || rate != sample.sample->SamplesPerSecond)
 	{
-		sample.sample->SetPos( sample.pos );
+		resample = true;
+
+		// Factor just for resampling
+		freq_factor = 1.0 * rate / sample.sample->SamplesPerSecond;
+
+		// Factor for pitch shifting as well as resampling
+		if (sample.region->PitchTrack == true) { freq_factor *= sample.freqFactor; }
 
-		unsigned long size = sample.sample->Read( &buffer, samples ) * sample.sample->FrameSize;
-		std::memset( (int8_t*) &buffer + size, 0, allocationsize - size );
+		// We need a bit of margin so we don't get glitching
+		samples = frames / freq_factor + Sample::s_interpolationMargins[m_interpolation];
 	}
 
-	// Convert from 16 or 24 bit into 32-bit float
-	if( sample.sample->BitDepth == 24 ) // 24 bit
+	// Load this note's data
+	SampleFrame sampleData[samples];
+	loadSample(sample, sampleData, samples);
+
+	// Apply ADSR using a copy so if we don't use these samples when
+	// resampling, the ADSR doesn't get messed up
+	ADSR copy = sample.adsr;
+
+	for( f_cnt_t i = 0; i < samples; ++i )
+	{
+		float amplitude = copy.value();
+		sampleData[i][0] *= amplitude;
+		sampleData[i][1] *= amplitude;
+	}
+
+	// Output the data resampling if needed
+	if( resample == true )
 	{
-		auto pInt = reinterpret_cast<uint8_t*>(&buffer);
+		SampleFrame convertBuf[frames];
 
-		for( f_cnt_t i = 0; i < samples; ++i )
+		// Only output if resampling is successful (note that "used" is output)
+		if (sample.convertSampleRate(*sampleData, *convertBuf, samples, frames, freq_factor, used))
 		{
-			// libgig gives 24-bit data as little endian, so we must
-			// convert if on a big endian system
-			int32_t valueLeft = swap32IfBE(
-						( pInt[ 3 * sample.sample->Channels * i ] << 8 ) |
-						( pInt[ 3 * sample.sample->Channels * i + 1 ] << 16 ) |
-						( pInt[ 3 * sample.sample->Channels * i + 2 ] << 24 ) );
-
-			// Store the notes to this buffer before saving to output
-			// so we can fade them out as needed
-			sampleData[i][0] = 1.0 / 0x100000000 * sample.attenuation * valueLeft;
-
-			if( sample.sample->Channels == 1 )
+			for( f_cnt_t i = 0; i < frames; ++i )
 			{
-				sampleData[i][1] = sampleData[i][0];
-			}
-			else
-			{
-				int32_t valueRight = swap32IfBE(
-							( pInt[ 3 * sample.sample->Channels * i + 3 ] << 8 ) |
-							( pInt[ 3 * sample.sample->Channels * i + 4 ] << 16 ) |
-							( pInt[ 3 * sample.sample->Channels * i + 5 ] << 24 ) );
-
-				sampleData[i][1] = 1.0 / 0x100000000 * sample.attenuation * valueRight;
+				_buffer[i][0] += convertBuf[i][0];
+				_buffer[i][1] += convertBuf[i][1];
 			}
 		}
 	}
-	else // 16 bit
+	else
 	{
-		auto pInt = reinterpret_cast<int16_t*>(&buffer);
-
-		for( f_cnt_t i = 0; i < samples; ++i )
+		for( f_cnt_t i = 0; i < frames; ++i )
 		{
-			sampleData[i][0] = 1.0 / 0x10000 *
-				pInt[ sample.sample->Channels * i ] * sample.attenuation;
-
-			if( sample.sample->Channels == 1 )
-			{
-				sampleData[i][1] = sampleData[i][0];
-			}
-			else
-			{
-				sampleData[i][1] = 1.0 / 0x10000 *
-					pInt[ sample.sample->Channels * i + 1 ] * sample.attenuation;
-			}
+			_buffer[i][0] += sampleData[i][0];
+			_buffer[i][1] += sampleData[i][1];
 		}
 	}
-}
-
-
 
+	// Update note position with how many samples we actually used
+	sample.pos += used;
+	sample.adsr.inc(used);
 
-// These two loop index functions taken from SampleBuffer.cpp
-f_cnt_t GigInstrument::getLoopedIndex( f_cnt_t index, f_cnt_t startf, f_cnt_t endf ) const
-{
-	if( index < endf )
+	if( sample.stream != nullptr )
 	{
-		return index;
+		sample.stream->consume( sample.pos );
 	}
-
-	return startf + ( index - startf )
-				% ( endf - startf );
 }
 
 
 
 
-f_cnt_t GigInstrument::getPingPongIndex( f_cnt_t index, f_cnt_t startf, f_cnt_t endf ) const
+void GigInstrument::loadSample( GigSample& sample, SampleFrame* sampleData, f_cnt_t samples )
 {
-	if( index < endf )
+	if( sampleData == nullptr || samples < 1 )
+	{
+		return;
+	}
+
+	// The start of the sample is in RAM, the position of the stream only
+	// begins after that. If the whole sample fits into the head, we don't
+	// need a stream at all.
+	const f_cnt_t headFrames = sample.head != nullptr ? sample.head->frames.size() : 0;
+	const bool headOnly = headFrames >= sample.sample->SamplesTotal;
+
+	f_cnt_t done = 0;
+	for( ; done < samples && ( headOnly || sample.pos + done < headFrames ); ++done )
 	{
-		return index;
+		const f_cnt_t index = sample.loop.physical( sample.pos + done );
+		sampleData[done] = index < headFrames ? sample.head->frames[index] : SampleFrame();
 	}
 
-	const f_cnt_t looplen = endf - startf;
-	const f_cnt_t looppos = ( index - endf ) % ( looplen * 2 );
+	if( done < samples )
+	{
+		if( sample.stream == nullptr )
+		{
+			// No stream was free when the note started
+			zeroSampleFrames( sampleData + done, samples - done );
+		}
+		else if( !sample.stream->read( sample.pos + done, sampleData + done, samples - done ) )
+		{
+			m_instance->streamer.reportUnderrun();
+		}
+	}
 
-	return ( looppos < looplen )
-		? endf - looppos
-		: startf + ( looppos - looplen );
+	for( f_cnt_t i = 0; i < samples; ++i )
+	{
+		sampleData[i] *= sample.attenuation;
+	}
 }
 
 
@@ -719,9 +725,7 @@ void GigInstrument::addSamples( GigNote & gignote, bool wantReleaseSample )
 					m_instrument->DimensionKeyRange.low + 1 );
 	}
 
-	gig::Region* pRegion = m_instrument->GetFirstRegion();
-
-	while( pRegion != nullptr )
+	for( gig::Region * pRegion : m_regions )
 	{
 		Dimension dim = getDimensions( pRegion, gignote.velocity, wantReleaseSample );
 		gig::DimensionRegion * pDimRegion = pRegion->GetDimensionRegionByValue( dim.DimValues );
@@ -762,10 +766,17 @@ void GigInstrument::addSamples( GigNote & gignote, bool wantReleaseSample )
 
 				gignote.samples.push_back( GigSample( pSample, pDimRegion,
 							attenuation, m_interpolation, gignote.frequency ) );
+
+				// Start streaming whatever comes after the preloaded head
+				GigSample & sample = gignote.samples.back();
+				sample.head = m_instance->streamer.head( pSample );
+				const f_cnt_t headFrames = sample.head != nullptr ? sample.head->frames.size() : 0;
+				if( headFrames < pSample->SamplesTotal )
+				{
+					sample.stream = m_instance->streamer.acquire( pSample, sample.loop, headFrames );
+				}
 			}
 		}
-
-		pRegion = m_instrument->GetNextRegion();
 	}
 }
 
@@ -859,11 +870,25 @@ void GigInstrument::getInstrument()
 	int iBankSelected = m_bankNum.value();
 	int iProgSelected = m_patchNum.value();
 
-	QMutexLocker locker( &m_synthMutex );
+	std::shared_ptr<GigInstance> instance;
+	{
+		QMutexLocker locker( &m_synthMutex );
+		instance = m_instance;
+	}
 
-	if( m_instance != nullptr )
+	if( instance == nullptr )
 	{
-		gig::Instrument * pInstrument = m_instance->gig.GetFirstInstrument();
+		return;
+	}
+
+	gig::Instrument * pInstrument = nullptr;
+	std::vector<gig::Region*> regions;
+	{
+		// libgig loads the instruments from the file while iterating, which
+		// must not interfere with the streamer reading samples
+		QMutexLocker locker( &instance->sampleReadMutex );
+
+		pInstrument = instance->gig.GetFirstInstrument();
 
 		while( pInstrument != nullptr )
 		{
@@ -875,10 +900,28 @@ void GigInstrument::getInstrument()
 				break;
 			}
 
-			pInstrument = m_instance->gig.GetNextInstrument();
+			pInstrument = instance->gig.GetNextInstrument();
 		}
 
+		if( pInstrument != nullptr )
+		{
+			for( gig::Region * pRegion = pInstrument->GetFirstRegion(); pRegion != nullptr;
+				pRegion = pInstrument->GetNextRegion() )
+			{
+				regions.push_back( pRegion );
+			}
+		}
+	}
+
+	// Decode the beginnings of the samples before any note can use them
+	instance->streamer.preload( regions );
+
+	QMutexLocker locker( &m_synthMutex );
+
+	if( m_instance == instance )
+	{
 		m_instrument = pInstrument;
+		m_regions = std::move( regions );
 	}
 }
 
@@ -918,8 +961,8 @@ GigInstrumentView::GigInstrumentView( Instrument * _instrument, QWidget * _paren
 {
 	auto k = castModel<GigInstrument>();
 
-	connect( &k->m_bankNum, SIGNAL( dataChanged() ), this, SLOT( updatePatchName() ) );
-	connect( &k->m_patchNum, SIGNAL( dataChanged() ), this, SLOT( updatePatchName() ) );
+	connectChanges( &k->m_bankNum, this, [this] { updatePatchName(); } );
+	connectChanges( &k->m_patchNum, this, [this] { updatePatchName(); } );
 
 	// File Button
 	m_fileDialogButton = new PixmapButton( this );
@@ -1074,7 +1117,7 @@ void GigInstrumentView::showPatchDialog()
 {
 	auto k = castModel<GigInstrument>();
 	PatchesDialog pd( this );
-	pd.setup( k->m_instance, 1, k->instrumentTrack()->name(), &k->m_bankNum, &k->m_patchNum, m_patchLabel );
+	pd.setup( k->m_instance.get(), 1, k->instrumentTrack()->name(), &k->m_bankNum, &k->m_patchNum, m_patchLabel );
 	pd.exec();
 }
 
@@ -1086,11 +1129,13 @@ void GigInstrumentView::showPatchDialog()
 GigSample::GigSample( gig::Sample * pSample, gig::DimensionRegion * pDimRegion,
 		float attenuation, int interpolation, float desiredFreq )
 	: sample( pSample ), region( pDimRegion ), attenuation( attenuation ),
-	  pos( 0 ), interpolation( interpolation ), srcState( nullptr ),
-	  sampleFreq( 0 ), freqFactor( 1 )
+	  pos( 0 ), head( nullptr ), stream( nullptr ), interpolation( interpolation ),
+	  srcState( nullptr ), sampleFreq( 0 ), freqFactor( 1 )
 {
 	if( sample != nullptr && region != nullptr )
 	{
+		loop = GigLoop( region, sample );
+
 		// Note: we don't create the libsamplerate object here since we always
 		// also call the copy constructor when appending to the end of the
 		// QList. We'll create it only in the copy constructor so we only have
@@ -1123,6 +1168,11 @@ GigSample::~GigSample()
 	{
 		src_delete( srcState );
 	}
+
+	if( stream != nullptr )
+	{
+		stream->unref();
+	}
 }
 
 
@@ -1130,9 +1180,16 @@ GigSample::~GigSample()
 
 GigSample::GigSample( const GigSample& g )
 	: sample( g.sample ), region( g.region ), attenuation( g.attenuation ),
-	  adsr( g.adsr ), pos( g.pos ), interpolation( g.interpolation ),
-	  srcState( nullptr ), sampleFreq( g.sampleFreq ), freqFactor( g.freqFactor )
+	  adsr( g.adsr ), pos( g.pos ), loop( g.loop ), head( g.head ), stream( g.stream ),
+	  interpolation( g.interpolation ), srcState( nullptr ),
+	  sampleFreq( g.sampleFreq ), freqFactor( g.freqFactor )
 {
+	// Copies share the stream
+	if( stream != nullptr )
+	{
+		stream->ref();
+	}
+
 	// On the copy, we want to create the object
 	updateSampleRate();
 }
@@ -1147,6 +1204,19 @@ GigSample& GigSample::operator=( const GigSample& g )
 	attenuation = g.attenuation;
 	adsr = g.adsr;
 	pos = g.pos;
+	loop = g.loop;
+	head = g.head;
+
+	if( g.stream != nullptr )
+	{
+		g.stream->ref();
+	}
+	if( stream != nullptr )
+	{
+		stream->unref();
+	}
+	stream = g.stream;
+
 	interpolation = g.interpolation;
 	srcState = nullptr;
 	sampleFreq = g.sampleFreq;
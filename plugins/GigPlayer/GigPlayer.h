@@ -27,6 +27,10 @@
 #ifndef GIG_PLAYER_H
 #define GIG_PLAYER_H
 
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
 #include <QList>
 #include <QMutex>
 #include <QMutexLocker>
@@ -38,6 +42,7 @@
 #include "Knob.h"
 #include "LcdSpinBox.h"
 #include "LedCheckBox.h"
+#include "GigStreamer.h"
 #include "gig.h"
 
 
@@ -73,14 +78,33 @@ class GigInstance
 public:
 	GigInstance( QString filename ) :
 		riff( filename.toUtf8().constData() ),
-		gig( &riff )
+		gig( &riff ),
+		streamer( sampleReadMutex )
 	{}
 
+	// Return the instance of the given file if another GigInstrument has
+	// already opened it, otherwise open it. If another thread is opening it
+	// right now, wait for that. Throws if it can't be opened.
+	static std::shared_ptr<GigInstance> open( const QString & filename );
+
 private:
 	RIFF::File riff;
 
 public:
 	gig::File gig;
+
+	// The read position is stored in the gig::Sample, so reading must not
+	// happen concurrently
+	QMutex sampleReadMutex;
+
+	// Reads the samples for all instruments using this file
+	GigStreamer streamer;
+
+private:
+	// Opened files by canonical path. The future becomes ready once the file
+	// is opened, so files are opened outside of s_instancesMutex.
+	static std::map<QString, std::shared_future<std::weak_ptr<GigInstance>>> s_instances;
+	static QMutex s_instancesMutex;
 } ;
 
 
@@ -165,8 +189,14 @@ public:
 	float attenuation;
 	ADSR adsr;
 
-	// The position in sample
+	// The position in sample, which keeps growing when looping (see GigLoop)
 	f_cnt_t pos;
+	GigLoop loop;
+
+	// Where the frames come from: the preloaded start of the sample, then
+	// the stream filled by the GigStreamer (both may be nullptr)
+	const GigSampleHead * head;
+	GigStream * stream;
 
 	// Whether to change the pitch of the samples, e.g. if there's only one
 	// sample per octave and you want that sample pitch shifted for the rest of
@@ -275,9 +305,14 @@ public slots:
 
 private:
 	// The GIG file and instrument we're using
-	GigInstance * m_instance;
+	std::shared_ptr<GigInstance> m_instance;
 	gig::Instrument * m_instrument;
 
+	// The regions of m_instrument. The region iterator of gig::Instrument
+	// is shared by all instruments using the same file, so it is only used
+	// when selecting the instrument.
+	std::vector<gig::Region*> m_regions;
+
 	// Part of the UI
 	QString m_filename;
 
@@ -296,6 +331,13 @@ private:
 	// List of all the currently playing notes
 	QList<GigNote> m_notes;
 
+	// Number of parts the samples of the current period are split into
+	// (see renderPart())
+	std::size_t m_renderPartCount = 1;
+
+	// Minimum number of samples which are worth rendering in a separate part
+	static constexpr std::size_t SamplesPerPart = 8;
+
 	// Used when determining which samples to use
 	uint32_t m_RandomSeed;
 	float m_currentKeyDimension;
@@ -311,10 +353,24 @@ private:
 	// parameters such as velocity
 	Dimension getDimensions( gig::Region * pRegion, int velocity, bool release );
 
-	// Load sample data from the Gig file, looping the sample where needed
+	// Get the sample data from the preloaded head or the stream of the
+	// sample, looping the sample where needed
 	void loadSample( GigSample& sample, SampleFrame* sampleData, f_cnt_t samples );
-	f_cnt_t getLoopedIndex( f_cnt_t index, f_cnt_t startf, f_cnt_t endf ) const;
-	f_cnt_t getPingPongIndex( f_cnt_t index, f_cnt_t startf, f_cnt_t endf ) const;
+
+	// Only notes in a playing state and samples with data are rendered
+	static bool isRendered( const GigNote& note )
+	{
+		return note.state == GigState::PlayingKeyDown || note.state == GigState::PlayingKeyUp;
+	}
+
+	static bool isRendered( const GigSample& sample )
+	{
+		return sample.sample != nullptr && sample.region != nullptr;
+	}
+
+	// Render every m_renderPartCount-th sample of the period, starting at _part
+	void renderPart( std::size_t _part, SampleFrame* _buffer ) override;
+	void renderSample( GigSample& sample, SampleFrame* _buffer );
 
 	// Add the desired samples to the note, either normal samples or release
 	// samples
@@ -0,0 +1,434 @@
+/*
+ * GigStreamer.cpp - streams the samples of GIG files from disk in the background
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "GigStreamer.h"
+
+#include <algorithm>
+#include <QDebug>
+
+#include "ConfigManager.h"
+#include "endian_handling.h"
+
+
+namespace lmms
+{
+
+
+namespace
+{
+
+// Most frames decoded at once, so that a single voice can't keep the other
+// ones waiting for too long
+constexpr f_cnt_t ChunkFrames = 4096;
+
+// How long the streamer sleeps when all streams are full, and when no voice
+// is playing at all
+constexpr unsigned long PollInterval = 2;
+constexpr unsigned long IdleInterval = 100;
+
+
+// Convert 16 or 24 bit frames as given by libgig to float
+void convertFrames( const gig::Sample * sample, const std::int8_t * raw, SampleFrame * out, f_cnt_t frames )
+{
+	const int channels = sample->Channels;
+
+	if( sample->BitDepth == 24 )
+	{
+		auto pInt = reinterpret_cast<const std::uint8_t*>( raw );
+
+		for( f_cnt_t i = 0; i < frames; ++i )
+		{
+			// libgig gives 24-bit data as little endian, so we must
+			// convert if on a big endian system
+			int32_t valueLeft = swap32IfBE(
+						( pInt[ 3 * channels * i ] << 8 ) |
+						( pInt[ 3 * channels * i + 1 ] << 16 ) |
+						( pInt[ 3 * channels * i + 2 ] << 24 ) );
+
+			out[i][0] = 1.0 / 0x100000000 * valueLeft;
+
+			if( channels == 1 )
+			{
+				out[i][1] = out[i][0];
+			}
+			else
+			{
+				int32_t valueRight = swap32IfBE(
+							( pInt[ 3 * channels * i + 3 ] << 8 ) |
+							( pInt[ 3 * channels * i + 4 ] << 16 ) |
+							( pInt[ 3 * channels * i + 5 ] << 24 ) );
+
+				out[i][1] = 1.0 / 0x100000000 * valueRight;
+			}
+		}
+	}
+	else // 16 bit
+	{
+		auto pInt = reinterpret_cast<const int16_t*>( raw );
+
+		for( f_cnt_t i = 0; i < frames; ++i )
+		{
+			out[i][0] = 1.0 / 0x10000 * pInt[ channels * i ];
+			out[i][1] = channels == 1 ? out[i][0] : 1.0 / 0x10000 * pInt[ channels * i + 1 ];
+		}
+	}
+}
+
+} // namespace
+
+
+
+
+GigLoop::GigLoop( gig::DimensionRegion * region, gig::Sample * sample )
+{
+	// Currently only support at max one loop
+	if( region->pSampleLoops == nullptr || region->SampleLoops == 0 )
+	{
+		return;
+	}
+
+	const auto & loop = region->pSampleLoops[0];
+	start = loop.LoopStart;
+	end = std::min<f_cnt_t>( start + loop.LoopLength, sample->SamplesTotal );
+	pingPong = loop.LoopType == gig::loop_type_bidirectional;
+	// TODO: also implement loop_type_backward support
+	enabled = end > start;
+}
+
+
+
+
+f_cnt_t GigLoop::physical( f_cnt_t pos ) const
+{
+	if( !enabled || pos < end )
+	{
+		return pos;
+	}
+
+	const f_cnt_t length = end - start;
+	if( !pingPong )
+	{
+		return start + ( pos - start ) % length;
+	}
+
+	// Go back from the end to the start, then forward again
+	const f_cnt_t looppos = ( pos - end ) % ( length * 2 );
+	return looppos < length
+		? end - 1 - looppos
+		: start + ( looppos - length );
+}
+
+
+
+
+f_cnt_t GigLoop::run( f_cnt_t pos, f_cnt_t maxFrames, bool & backwards ) const
+{
+	backwards = false;
+
+	if( !enabled )
+	{
+		return maxFrames;
+	}
+
+	if( pos < end )
+	{
+		return std::min( maxFrames, end - pos );
+	}
+
+	const f_cnt_t length = end - start;
+	if( !pingPong )
+	{
+		return std::min( maxFrames, end - physical( pos ) );
+	}
+
+	const f_cnt_t looppos = ( pos - end ) % ( length * 2 );
+	backwards = looppos < length;
+	return std::min( maxFrames, backwards ? length - looppos : length * 2 - looppos );
+}
+
+
+
+
+GigStream::GigStream( f_cnt_t capacity ) :
+	m_buffer( capacity )
+{
+}
+
+
+
+
+bool GigStream::read( f_cnt_t pos, SampleFrame * out, f_cnt_t frames ) const
+{
+	const f_cnt_t available = m_writePos.load( std::memory_order_acquire );
+	const f_cnt_t capacity = m_buffer.size();
+
+	// The streamer never writes to [m_readPos, m_readPos + capacity) while
+	// frames there are available, and we're reading at m_readPos or later
+	const f_cnt_t streamed = pos < available ? std::min( frames, std::min( available - pos, capacity ) ) : 0;
+
+	f_cnt_t done = 0;
+	while( done < streamed )
+	{
+		const f_cnt_t index = ( pos + done ) % capacity;
+		const f_cnt_t count = std::min( streamed - done, capacity - index );
+		std::copy_n( m_buffer.data() + index, count, out + done );
+		done += count;
+	}
+
+	zeroSampleFrames( out + streamed, frames - streamed );
+
+	return streamed == frames;
+}
+
+
+
+
+void GigStream::unref()
+{
+	if( m_users.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+	{
+		m_state.store( State::Released, std::memory_order_release );
+	}
+}
+
+
+
+
+GigStreamer::GigStreamer( QMutex & readMutex ) :
+	m_readMutex( readMutex ),
+	m_decodeBuffer( ChunkFrames ),
+	m_preloadFrames( ConfigManager::inst()->value( "gigplayer", "preloadframes", "8192" ).toUInt() ),
+	m_readAheadFrames( std::max( ConfigManager::inst()->value( "gigplayer", "readaheadframes", "16384" ).toUInt(),
+		static_cast<unsigned>( ChunkFrames ) ) )
+{
+	m_streams.reserve( StreamCount );
+	for( std::size_t i = 0; i < StreamCount; ++i )
+	{
+		m_streams.push_back( std::make_unique<GigStream>( m_readAheadFrames ) );
+	}
+
+	start();
+}
+
+
+
+
+GigStreamer::~GigStreamer()
+{
+	m_quit = true;
+	m_wake.wakeAll();
+	wait();
+
+	if( underruns() > 0 || exhaustions() > 0 )
+	{
+		qWarning() << "GigPlayer:" << underruns() << "stream underruns,"
+			<< exhaustions() << "notes without a free stream";
+	}
+}
+
+
+
+
+void GigStreamer::preload( const std::vector<gig::Region*> & regions )
+{
+	if( m_preloadFrames == 0 )
+	{
+		return;
+	}
+
+	std::vector<std::int8_t> readBuffer;
+
+	for( gig::Region * region : regions )
+	{
+		for( uint32_t i = 0; i < region->DimensionRegions; ++i )
+		{
+			gig::Sample * sample = region->pDimensionRegions[i]->pSample;
+			if( sample == nullptr || sample->SamplesTotal == 0 || this->head( sample ) != nullptr )
+			{
+				continue;
+			}
+
+			auto head = std::make_unique<GigSampleHead>();
+			head->frames.resize( std::min<f_cnt_t>( m_preloadFrames, sample->SamplesTotal ) );
+			decode( sample, nullptr, 0, head->frames.size(), head->frames.data(), readBuffer );
+
+			QMutexLocker locker( &m_headsMutex );
+			m_heads.emplace( sample, std::move( head ) );
+		}
+	}
+}
+
+
+
+
+const GigSampleHead * GigStreamer::head( gig::Sample * sample ) const
+{
+	QMutexLocker locker( &m_headsMutex );
+
+	const auto it = m_heads.find( sample );
+	return it != m_heads.end() ? it->second.get() : nullptr;
+}
+
+
+
+
+GigStream * GigStreamer::acquire( gig::Sample * sample, const GigLoop & loop, f_cnt_t headFrames )
+{
+	for( const auto & stream : m_streams )
+	{
+		auto expected = GigStream::State::Free;
+		if( stream->m_state.compare_exchange_strong( expected, GigStream::State::Claimed,
+			std::memory_order_acquire ) )
+		{
+			stream->m_sample = sample;
+			stream->m_loop = loop;
+			stream->m_readPos.store( 0, std::memory_order_relaxed );
+			stream->m_writePos.store( headFrames, std::memory_order_relaxed );
+			stream->m_users.store( 1, std::memory_order_relaxed );
+			stream->m_state.store( GigStream::State::Active, std::memory_order_release );
+
+			m_wake.wakeOne();
+			return stream.get();
+		}
+	}
+
+	m_exhaustions.fetch_add( 1, std::memory_order_relaxed );
+	return nullptr;
+}
+
+
+
+
+void GigStreamer::run()
+{
+	while( !m_quit )
+	{
+		bool active = false;
+		bool busy = false;
+
+		for( const auto & stream : m_streams )
+		{
+			switch( stream->m_state.load( std::memory_order_acquire ) )
+			{
+				case GigStream::State::Active:
+					active = true;
+					busy |= refill( *stream );
+					break;
+				case GigStream::State::Released:
+					stream->m_state.store( GigStream::State::Free, std::memory_order_release );
+					break;
+				default:
+					break;
+			}
+		}
+
+		if( !busy )
+		{
+			// Notes starting in between are picked up after the interval at
+			// the latest, their heads cover that
+			QMutexLocker locker( &m_wakeMutex );
+			if( !m_quit )
+			{
+				m_wake.wait( &m_wakeMutex, active ? PollInterval : IdleInterval );
+			}
+		}
+	}
+}
+
+
+
+
+bool GigStreamer::refill( GigStream & stream )
+{
+	const f_cnt_t capacity = stream.m_buffer.size();
+	const f_cnt_t readPos = stream.m_readPos.load( std::memory_order_acquire );
+
+	// If the voice overtook us, continue where it is
+	f_cnt_t writePos = std::max( stream.m_writePos.load( std::memory_order_relaxed ), readPos );
+	if( writePos >= readPos + capacity )
+	{
+		return false;
+	}
+
+	const GigSampleHead * head = this->head( stream.m_sample );
+
+	f_cnt_t frames = std::min( readPos + capacity - writePos, ChunkFrames );
+	f_cnt_t pos = writePos;
+	while( frames > 0 )
+	{
+		bool backwards = false;
+		const f_cnt_t count = stream.m_loop.run( pos, frames, backwards );
+		const f_cnt_t physical = stream.m_loop.physical( pos );
+		const f_cnt_t first = backwards ? physical + 1 - count : physical;
+
+		decode( stream.m_sample, head, first, count, m_decodeBuffer.data(), m_readBuffer );
+
+		for( f_cnt_t i = 0; i < count; ++i )
+		{
+			stream.m_buffer[( pos + i ) % capacity] = m_decodeBuffer[backwards ? count - 1 - i : i];
+		}
+
+		pos += count;
+		frames -= count;
+	}
+
+	stream.m_writePos.store( pos, std::memory_order_release );
+
+	return true;
+}
+
+
+
+
+void GigStreamer::decode( gig::Sample * sample, const GigSampleHead * head, f_cnt_t first, f_cnt_t frames,
+	SampleFrame * out, std::vector<std::int8_t> & readBuffer )
+{
+	f_cnt_t done = 0;
+
+	if( head != nullptr && first < head->frames.size() )
+	{
+		done = std::min( frames, head->frames.size() - first );
+		std::copy_n( head->frames.data() + first, done, out );
+	}
+
+	const f_cnt_t total = sample->SamplesTotal;
+	if( done < frames && first + done < total )
+	{
+		const f_cnt_t count = std::min( frames - done, total - first - done );
+		readBuffer.resize( count * sample->FrameSize );
+
+		// The read position is stored in the gig::Sample, which is shared by
+		// all users of the file
+		m_readMutex.lock();
+		sample->SetPos( first + done );
+		const f_cnt_t read = sample->Read( readBuffer.data(), count );
+		m_readMutex.unlock();
+
+		convertFrames( sample, readBuffer.data(), out + done, read );
+		done += read;
+	}
+
+	zeroSampleFrames( out + done, frames - done );
+}
+
+
+} // namespace lmms
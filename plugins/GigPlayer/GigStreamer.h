@@ -0,0 +1,205 @@
+/*
+ * GigStreamer.h - streams the samples of GIG files from disk in the background
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_GIG_STREAMER_H
+#define LMMS_GIG_STREAMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "SampleFrame.h"
+#include "lmms_basics.h"
+#include "gig.h"
+
+
+namespace lmms
+{
+
+
+// How a voice walks through its sample. The position of a voice only ever
+// grows, physical() maps it to a frame of the sample, wrapping around the loop
+// of the dimension region if it has one.
+struct GigLoop
+{
+	GigLoop() = default;
+	GigLoop( gig::DimensionRegion * region, gig::Sample * sample );
+
+	f_cnt_t physical( f_cnt_t pos ) const;
+
+	// Number of frames starting at pos (at most maxFrames) which map to
+	// consecutive frames of the sample, going backwards if `backwards` is set
+	f_cnt_t run( f_cnt_t pos, f_cnt_t maxFrames, bool & backwards ) const;
+
+	bool enabled = false;
+	bool pingPong = false;
+	f_cnt_t start = 0;
+	f_cnt_t end = 0;
+} ;
+
+
+
+
+// The beginning of a sample, decoded when the instrument is selected so that
+// notes can start before the stream of the voice has been filled
+struct GigSampleHead
+{
+	std::vector<SampleFrame> frames;
+} ;
+
+
+
+
+// Ring buffer of a single voice. The GigStreamer thread writes the frames
+// ahead of the position of the voice, the audio thread reads them.
+class GigStream
+{
+public:
+	explicit GigStream( f_cnt_t capacity );
+
+	// Copy the frames [pos, pos + frames) to out. Frames which haven't been
+	// streamed yet are zeroed, and false is returned.
+	bool read( f_cnt_t pos, SampleFrame * out, f_cnt_t frames ) const;
+
+	// The voice won't read frames before pos anymore
+	void consume( f_cnt_t pos )
+	{
+		m_readPos.store( pos, std::memory_order_release );
+	}
+
+	// Reference counting for the copies of GigSample
+	void ref()
+	{
+		m_users.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	void unref();
+
+private:
+	enum class State
+	{
+		Free,
+		Claimed,
+		Active,
+		// Only the streamer thread moves streams from Released to Free, so
+		// it never writes to a stream which has been given to another voice
+		Released
+	} ;
+
+	std::atomic<State> m_state{ State::Free };
+	std::atomic<int> m_users{ 0 };
+
+	gig::Sample * m_sample = nullptr;
+	GigLoop m_loop;
+
+	std::atomic<f_cnt_t> m_readPos{ 0 };
+	std::atomic<f_cnt_t> m_writePos{ 0 };
+	std::vector<SampleFrame> m_buffer;
+
+	friend class GigStreamer;
+} ;
+
+
+
+
+// Owned by a GigInstance. Preloads the heads of the samples and keeps the
+// streams of all playing voices filled, so the audio threads never touch the
+// disk. The sizes can be set with the "preloadframes" and "readaheadframes"
+// values of the "gigplayer" section in the configuration file.
+class GigStreamer : public QThread
+{
+public:
+	// Number of voices which can stream at once, per GIG file
+	static constexpr std::size_t StreamCount = 128;
+
+	explicit GigStreamer( QMutex & readMutex );
+	~GigStreamer() override;
+
+	// Decode the heads of all samples of the given regions
+	void preload( const std::vector<gig::Region*> & regions );
+
+	// The preloaded head of the sample, or nullptr
+	const GigSampleHead * head( gig::Sample * sample ) const;
+
+	// Start streaming a sample from the end of its head on. Returns nullptr
+	// if all streams are in use.
+	GigStream * acquire( gig::Sample * sample, const GigLoop & loop, f_cnt_t headFrames );
+
+	void reportUnderrun()
+	{
+		m_underruns.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	// Number of periods in which a voice ran out of streamed frames
+	std::uint64_t underruns() const
+	{
+		return m_underruns.load( std::memory_order_relaxed );
+	}
+
+	// Number of voices which didn't get a stream and stopped after their head
+	std::uint64_t exhaustions() const
+	{
+		return m_exhaustions.load( std::memory_order_relaxed );
+	}
+
+protected:
+	void run() override;
+
+private:
+	bool refill( GigStream & stream );
+
+	// Decode the frames [first, first + frames) of the sample to out, zeroing
+	// frames past its end. Frames within head are copied from there.
+	void decode( gig::Sample * sample, const GigSampleHead * head, f_cnt_t first, f_cnt_t frames,
+		SampleFrame * out, std::vector<std::int8_t> & readBuffer );
+
+	QMutex & m_readMutex;
+
+	// Only used by the streamer thread
+	std::vector<std::int8_t> m_readBuffer;
+	std::vector<SampleFrame> m_decodeBuffer;
+
+	f_cnt_t m_preloadFrames;
+	f_cnt_t m_readAheadFrames;
+
+	std::map<gig::Sample*, std::unique_ptr<GigSampleHead>> m_heads;
+	mutable QMutex m_headsMutex;
+
+	std::vector<std::unique_ptr<GigStream>> m_streams;
+
+	std::atomic<bool> m_quit{ false };
+	QMutex m_wakeMutex;
+	QWaitCondition m_wake;
+
+	std::atomic<std::uint64_t> m_underruns{ 0 };
+	std::atomic<std::uint64_t> m_exhaustions{ 0 };
+} ;
+
+
+} // namespace lmms
+
+#endif // LMMS_GIG_STREAMER_H
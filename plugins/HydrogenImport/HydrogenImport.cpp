@@ -1,3 +1,6 @@
+#include <map>
+#include <vector>
+
 #include <QDomDocument>
 
 #include "LocalFileMng.h"
@@ -263,6 +266,8 @@ bool HydrogenImport::readSong()
 		nSize = LocalFileMng::readXmlInt( patternNode, "size", nSize, false, false );
 		pattern_length[sName] = nSize;
 		QDomNode pNoteListNode = patternNode.firstChildElement( "noteList" );
+		// The notes of the pattern, added to the clips of the instruments at once
+		std::map<MidiClip*, std::vector<Note>> patternNotes;
 		if ( ! pNoteListNode.isNull() ) {
 			QDomNode noteNode = pNoteListNode.firstChildElement( "note" );
 			while ( ! noteNode.isNull()  ) {
@@ -290,11 +295,15 @@ bool HydrogenImport::readSong()
 				n.setVolume( fVelocity * 100 );
 				n.setPanning( ( fPan_R - fPan_L ) * 100 );
 				n.setKey( NoteKey::stringToNoteKey( sKey ) );
-				p->addNote( n,false );
+				patternNotes[p].push_back( n );
 				pn = pn + 1;
 				noteNode = ( QDomNode ) noteNode.nextSiblingElement( "note" );
 			}        
 		}
+		for ( const auto& [clip, notes] : patternNotes )
+		{
+			clip->addNotes( notes, false );
+		}
 		patternNode = ( QDomNode ) patternNode.nextSiblingElement( "pattern" );
 	}
 	// MidiClip sequence
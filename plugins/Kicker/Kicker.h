@@ -29,6 +29,7 @@
 #include "AutomatableModel.h"
 #include "Instrument.h"
 #include "InstrumentView.h"
+#include "KickerOsc.h"
 #include "TempoSyncKnobModel.h"
 
 
@@ -48,6 +49,10 @@ class KickerInstrumentView;
 }
 
 
+using DistFX = DspEffectLibrary::Distortion;
+using SweepOsc = KickerOsc<DspEffectLibrary::MonoToStereoAdaptor<DistFX>>;
+
+
 class KickerInstrument : public Instrument
 {
 	Q_OBJECT
@@ -89,6 +94,8 @@ private:
 
 	IntModel m_versionModel;
 
+	VoicePool<SweepOsc> m_voices{ DefaultVoicePoolSize };
+
 	friend class gui::KickerInstrumentView;
 
 } ;
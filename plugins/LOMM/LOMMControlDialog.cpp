@@ -111,8 +111,8 @@ LOMMControlDialog::LOMMControlDialog(LOMMControls* controls) :
 	PixmapButton* initButton = createPixmapButton(tr("Clear all parameters"), this, 84, 237, nullptr, "init_active", "init_inactive", tr("Clear all parameters"));
 	
 	connect(initButton, SIGNAL(clicked()), m_controls, SLOT(resetAllParameters()));
-	connect(&controls->m_lookaheadEnableModel, SIGNAL(dataChanged()), this, SLOT(updateFeedbackVisibility()));
-	connect(&controls->m_midsideModel, SIGNAL(dataChanged()), this, SLOT(updateLowSideUpwardSuppressVisibility()));
+	connectChanges(&controls->m_lookaheadEnableModel, this, [this] { updateFeedbackVisibility(); });
+	connectChanges(&controls->m_midsideModel, this, [this] { updateLowSideUpwardSuppressVisibility(); });
 	connect(getGUI()->mainWindow(), SIGNAL(periodicUpdate()), this, SLOT(updateDisplay()));
 	
 	emit updateFeedbackVisibility();
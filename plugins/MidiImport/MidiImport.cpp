@@ -29,8 +29,11 @@
 #include <QMessageBox>
 #include <QProgressDialog>
 
+#include <algorithm>
 #include <sstream>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "MidiImport.h"
 #include "TrackContainer.h"
@@ -156,6 +159,8 @@ public:
 	AutomationTrack * at;
 	AutomationClip * ap;
 	TimePos lastPos;
+	// Values for ap, which are put all at once by flush()
+	std::vector<std::pair<TimePos, float>> values;
 
 	smfMidiCC & create( TrackContainer* tc, QString tn )
 	{
@@ -176,6 +181,7 @@ public:
 
 	void clear()
 	{
+		flush();
 		at = nullptr;
 		ap = nullptr;
 		lastPos = 0;
@@ -186,6 +192,7 @@ public:
 	{
 		if( !ap || time > lastPos + DefaultTicksPerBar )
 		{
+			flush();
 			TimePos pPos = TimePos( time.getBar(), 0 );
 			ap = dynamic_cast<AutomationClip*>(
 				at->createClip(pPos));
@@ -193,12 +200,23 @@ public:
 		}
 
 		lastPos = time;
-		time = time - ap->startPosition();
-		ap->putValue( time, value, false );
-		ap->changeLength( TimePos( time.getBar() + 1, 0 ) );
+		values.emplace_back( time - ap->startPosition(), value );
 
 		return *this;
 	}
+
+
+	void flush()
+	{
+		if( !ap || values.empty() )
+		{
+			return;
+		}
+
+		ap->putValueBatch( values, false );
+		ap->changeLength( TimePos( values.back().first.getBar() + 1, 0 ) );
+		values.clear();
+	}
 };
 
 
@@ -221,6 +239,8 @@ public:
 	bool isSF2;
 	bool hasNotes;
 	QString trackName;
+	// Notes of the channel, which are split into clips at the end
+	std::vector<Note> notes;
 
 	smfMidiChannel * create( TrackContainer* tc, QString tn )
 	{
@@ -262,33 +282,35 @@ public:
 
 	void addNote( Note & n )
 	{
-		if (!p)
-		{
-			p = dynamic_cast<MidiClip*>(it->createClip(0));
-		}
-		p->addNote(n, false);
+		notes.push_back(n);
 		hasNotes = true;
 	}
 
 	void splitMidiClips()
 	{
 		MidiClip * newMidiClip = nullptr;
+		std::vector<Note> clipNotes;
 		TimePos lastEnd(0);
 
-		p->rearrangeAllNotes();
-		for (auto n : p->notes())
+		std::stable_sort(notes.begin(), notes.end(),
+			[](const Note& lhs, const Note& rhs) { return Note::lessThan(&lhs, &rhs); });
+		for (auto& n : notes)
 		{
-			if (!newMidiClip || n->pos() > lastEnd + DefaultTicksPerBar)
+			if (!newMidiClip || n.pos() > lastEnd + DefaultTicksPerBar)
 			{
-				TimePos pPos = TimePos(n->pos().getBar(), 0);
+				if (newMidiClip) { newMidiClip->addNotes(clipNotes, false); }
+				clipNotes.clear();
+
+				TimePos pPos = TimePos(n.pos().getBar(), 0);
 				newMidiClip = dynamic_cast<MidiClip*>(it->createClip(pPos));
 			}
-			lastEnd = n->pos() + n->length();
+			lastEnd = n.pos() + n.length();
 
-			Note newNote(*n);
-			newNote.setPos(n->pos(newMidiClip->startPosition()));
-			newMidiClip->addNote(newNote, false);
+			n.setPos(n.pos(newMidiClip->startPosition()));
+			clipNotes.push_back(n);
 		}
+		if (newMidiClip) { newMidiClip->addNotes(clipNotes, false); }
+		notes.clear();
 
 		delete p;
 		p = nullptr;
@@ -345,12 +367,16 @@ bool MidiImport::readSMF( TrackContainer* tc )
 
 	// Time-sig changes
 	Alg_time_sigs * timeSigs = &seq->time_sig;
+	std::vector<std::pair<TimePos, float>> numerators;
+	std::vector<std::pair<TimePos, float>> denominators;
 	for( int s = 0; s < timeSigs->length(); ++s )
 	{
 		Alg_time_sig timeSig = (*timeSigs)[s];
-		timeSigNumeratorPat->putValue(timeSig.beat * ticksPerBeat, timeSig.num);
-		timeSigDenominatorPat->putValue(timeSig.beat * ticksPerBeat, timeSig.den);
+		numerators.emplace_back(timeSig.beat * ticksPerBeat, timeSig.num);
+		denominators.emplace_back(timeSig.beat * ticksPerBeat, timeSig.den);
 	}
+	timeSigNumeratorPat->putValueBatch(numerators);
+	timeSigDenominatorPat->putValueBatch(denominators);
 	// manually call otherwise the pattern shows being 1 bar
 	timeSigNumeratorPat->updateLength();
 	timeSigDenominatorPat->updateLength();
@@ -368,18 +394,20 @@ bool MidiImport::readSMF( TrackContainer* tc )
 		tap->clear();
 		Alg_time_map * timeMap = seq->get_time_map();
 		Alg_beats & beats = timeMap->beats;
+		std::vector<std::pair<TimePos, float>> tempos;
 		for( int i = 0; i < beats.len - 1; i++ )
 		{
 			Alg_beat_ptr b = &(beats[i]);
 			double tempo = ( beats[i + 1].beat - b->beat ) /
 						   ( beats[i + 1].time - beats[i].time );
-			tap->putValue( b->beat * ticksPerBeat, tempo * 60.0 );
+			tempos.emplace_back( b->beat * ticksPerBeat, tempo * 60.0 );
 		}
 		if( timeMap->last_tempo_flag )
 		{
 			Alg_beat_ptr b = &( beats[beats.len - 1] );
-			tap->putValue( b->beat * ticksPerBeat, timeMap->last_tempo * 60.0 );
+			tempos.emplace_back( b->beat * ticksPerBeat, timeMap->last_tempo * 60.0 );
 		}
+		tap->putValueBatch( tempos );
 	}
 
 	// Update the tempo to avoid crash when playing a project imported
@@ -560,6 +588,16 @@ bool MidiImport::readSMF( TrackContainer* tc )
 		}
 	}
 
+	// Put the automation of the last track and the program changes
+	for (auto& cc : ccs)
+	{
+		cc.flush();
+	}
+	for (auto& pc : pcs)
+	{
+		pc.second.flush();
+	}
+
 	delete seq;
 
 
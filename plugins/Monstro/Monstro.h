@@ -576,6 +576,8 @@ private:
 	FloatModel	m_sub3lfo1;
 	FloatModel	m_sub3lfo2;
 
+	VoicePool<MonstroSynth> m_voices{ DefaultVoicePoolSize };
+
 	friend class MonstroSynth;
 	friend class gui::MonstroView;
 
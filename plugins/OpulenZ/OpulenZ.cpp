@@ -844,17 +844,17 @@ void OpulenzInstrumentView::modelChanged()
 
 
 	// All knobs needing a user friendly unit
-	connect( &m->op1_a_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
-	connect( &m->op2_a_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
+	connectChanges( &m->op1_a_mdl, this, [this] { updateKnobHints(); } );
+	connectChanges( &m->op2_a_mdl, this, [this] { updateKnobHints(); } );
 
-	connect( &m->op1_d_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
-	connect( &m->op2_d_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
+	connectChanges( &m->op1_d_mdl, this, [this] { updateKnobHints(); } );
+	connectChanges( &m->op2_d_mdl, this, [this] { updateKnobHints(); } );
 
-	connect( &m->op1_r_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
-	connect( &m->op2_r_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
+	connectChanges( &m->op1_r_mdl, this, [this] { updateKnobHints(); } );
+	connectChanges( &m->op2_r_mdl, this, [this] { updateKnobHints(); } );
 
-	connect( &m->op1_mul_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
-	connect( &m->op2_mul_mdl, SIGNAL( dataChanged() ), this, SLOT( updateKnobHints() ) );
+	connectChanges( &m->op1_mul_mdl, this, [this] { updateKnobHints(); } );
+	connectChanges( &m->op2_mul_mdl, this, [this] { updateKnobHints(); } );
 
 	updateKnobHints();
 
@@ -228,70 +228,40 @@ void OrganicInstrument::playNote( NotePlayHandle * _n,
 
 	if (!_n->m_pluginData)
 	{
-		auto oscs_l = std::array<Oscillator*, NUM_OSCILLATORS>{};
-		auto oscs_r = std::array<Oscillator*, NUM_OSCILLATORS>{};
-
-		_n->m_pluginData = new oscPtr;
+		auto voice = m_voices.acquire();
+		_n->m_pluginData = voice;
 
 		for( int i = m_numOscillators - 1; i >= 0; --i )
 		{
-			static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetLeft[i]
-				= rand() / ( RAND_MAX + 1.0f );
-			static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetRight[i]
-				= rand() / ( RAND_MAX + 1.0f );
-
-			// initialise ocillators
-
-			if( i == m_numOscillators - 1 )
-			{
-				// create left oscillator
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetLeft[i],
-						m_osc[i]->m_volumeLeft );
-				// create right oscillator
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetRight[i],
-						m_osc[i]->m_volumeRight );
-			}
-			else
-			{
-				// create left oscillator
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetLeft[i],
-						m_osc[i]->m_volumeLeft,
-						oscs_l[i + 1] );
-				// create right oscillator
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShape,
-						&m_modulationAlgo,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						static_cast<oscPtr *>( _n->m_pluginData )->phaseOffsetRight[i],
-						m_osc[i]->m_volumeRight,
-						oscs_r[i + 1] );
-			}
-
-
+			voice->phaseOffsetLeft[i] = rand() / ( RAND_MAX + 1.0f );
+			voice->phaseOffsetRight[i] = rand() / ( RAND_MAX + 1.0f );
+
+			// initialise ocillators - the last one has no sub-oscillator
+			const bool last = i == m_numOscillators - 1;
+
+			// create left oscillator
+			voice->oscLeft[i].emplace(
+					&m_osc[i]->m_waveShape,
+					&m_modulationAlgo,
+					_n->frequency(),
+					m_osc[i]->m_detuningLeft,
+					voice->phaseOffsetLeft[i],
+					m_osc[i]->m_volumeLeft,
+					last ? nullptr : &*voice->oscLeft[i + 1] );
+			// create right oscillator
+			voice->oscRight[i].emplace(
+					&m_osc[i]->m_waveShape,
+					&m_modulationAlgo,
+					_n->frequency(),
+					m_osc[i]->m_detuningRight,
+					voice->phaseOffsetRight[i],
+					m_osc[i]->m_volumeRight,
+					last ? nullptr : &*voice->oscRight[i + 1] );
 		}
-
-		static_cast<oscPtr *>( _n->m_pluginData )->oscLeft = oscs_l[0];
-		static_cast<oscPtr *>( _n->m_pluginData )->oscRight = oscs_r[0];
 	}
 
-	Oscillator * osc_l = static_cast<oscPtr *>( _n->m_pluginData )->oscLeft;
-	Oscillator * osc_r = static_cast<oscPtr *>( _n->m_pluginData)->oscRight;
+	Oscillator * osc_l = &*static_cast<oscPtr *>( _n->m_pluginData )->oscLeft[0];
+	Oscillator * osc_r = &*static_cast<oscPtr *>( _n->m_pluginData )->oscRight[0];
 
 	osc_l->update( _working_buffer + offset, frames, 0 );
 	osc_r->update( _working_buffer + offset, frames, 1 );
@@ -318,12 +288,7 @@ void OrganicInstrument::playNote( NotePlayHandle * _n,
 
 void OrganicInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscLeft );
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscRight );
-
-	delete static_cast<oscPtr *>( _n->m_pluginData );
+	m_voices.release( static_cast<oscPtr *>( _n->m_pluginData ) );
 }
 
 /*float inline OrganicInstrument::foldback(float in, float threshold)
@@ -487,14 +452,12 @@ void OrganicInstrumentView::modelChanged()
 		Knob * harmKnob = new OrganicKnob( this );
 		harmKnob->move( x + i * colWidth, y - rowHeight );
 		harmKnob->setObjectName( "harmKnob" );
-		connect( &oi->m_osc[i]->m_harmModel, SIGNAL( dataChanged() ),
-			this, SLOT( updateKnobHint() ) );
+		connectChanges( &oi->m_osc[i]->m_harmModel, this, [this] { updateKnobHint(); } );
 
 		// setup waveform-knob
 		Knob * oscKnob = new OrganicKnob( this );
 		oscKnob->move( x + i * colWidth, y );
-		connect( &oi->m_osc[i]->m_oscModel, SIGNAL( dataChanged() ),
-			this, SLOT( updateKnobHint() ) );
+		connectChanges( &oi->m_osc[i]->m_oscModel, this, [this] { updateKnobHint(); } );
 
 		oscKnob->setHintText( tr( "Osc %1 waveform:" ).arg( i + 1 ), QString() );
 
@@ -25,11 +25,14 @@
 #ifndef LMMS_ORGANIC_H
 #define LMMS_ORGANIC_H
 
+#include <array>
+#include <optional>
 #include <QString>
 
 #include "Instrument.h"
 #include "InstrumentView.h"
 #include "AutomatableModel.h"
+#include "Oscillator.h"
 
 class QPixmap;
 
@@ -38,7 +41,6 @@ namespace lmms
 
 
 class NotePlayHandle;
-class Oscillator;
 
 namespace gui
 {
@@ -156,14 +158,17 @@ private:
 
 	OscillatorObject ** m_osc;
 
+	// all oscillators of a note, each one modulated by the next
 	struct oscPtr
 	{
-		Oscillator * oscLeft;
-		Oscillator * oscRight;
+		std::array<std::optional<Oscillator>, NUM_OSCILLATORS> oscLeft;
+		std::array<std::optional<Oscillator>, NUM_OSCILLATORS> oscRight;
 		float phaseOffsetLeft[NUM_OSCILLATORS];
-		float phaseOffsetRight[NUM_OSCILLATORS];		
+		float phaseOffsetRight[NUM_OSCILLATORS];
 	} ;
 
+	VoicePool<oscPtr> m_voices{ DefaultVoicePoolSize };
+
 	const IntModel m_modulationAlgo;
 
 	FloatModel  m_fx1Model;
@@ -153,7 +153,7 @@ void PatmanInstrument::playNote( NotePlayHandle * _n,
 	float play_freq = hdata->tuned ? _n->frequency() :
 						hdata->sample->frequency();
 
-	if (hdata->sample->play(_working_buffer + offset, hdata->state, frames,
+	if (hdata->sample->play(_working_buffer + offset, &hdata->state, frames,
 					play_freq, m_loopedModel.value() ? Sample::Loop::On : Sample::Loop::Off))
 	{
 		applyRelease( _working_buffer, _n );
@@ -169,9 +169,7 @@ void PatmanInstrument::playNote( NotePlayHandle * _n,
 
 void PatmanInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	auto hdata = (handle_data*)_n->m_pluginData;
-	delete hdata->state;
-	delete hdata;
+	m_voices.release( static_cast<handle_data *>( _n->m_pluginData ) );
 }
 
 
@@ -404,10 +402,9 @@ void PatmanInstrument::selectSample( NotePlayHandle * _n )
 		}
 	}
 
-	auto hdata = new handle_data;
+	auto hdata = m_voices.acquire( _n->hasDetuningInfo() );
 	hdata->tuned = m_tunedModel.value();
 	hdata->sample = sample ? sample : std::make_shared<Sample>();
-	hdata->state = new Sample::PlaybackState(_n->hasDetuningInfo());
 
 	_n->m_pluginData = hdata;
 }
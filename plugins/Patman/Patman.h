@@ -86,7 +86,12 @@ public slots:
 private:
 	struct handle_data
 	{
-		Sample::PlaybackState* state;
+		handle_data( bool varyingPitch ) :
+			state( varyingPitch )
+		{
+		}
+
+		Sample::PlaybackState state;
 		bool tuned;
 		std::shared_ptr<Sample> sample;
 	};
@@ -96,6 +101,8 @@ private:
 	BoolModel m_loopedModel;
 	BoolModel m_tunedModel;
 
+	VoicePool<handle_data> m_voices{ DefaultVoicePoolSize };
+
 
 	enum class LoadError
 	{
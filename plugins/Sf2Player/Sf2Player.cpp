@@ -28,6 +28,7 @@
 #include <fluidsynth.h>
 #include <QDebug>
 #include <QDomElement>
+#include <QFileInfo>
 #include <QLabel>
 
 #include "ArrayVector.h"
@@ -41,6 +42,7 @@
 #include "NotePlayHandle.h"
 #include "PathUtil.h"
 #include "PixmapButton.h"
+#include "ProjectLoader.h"
 #include "Song.h"
 #include "fluidsynthshims.h"
 
@@ -104,6 +106,22 @@ private:
 	float m_coarseTune;
 };
 
+std::map<QString, std::shared_future<void>> Sf2Instrument::s_prefetches;
+QMutex Sf2Instrument::s_prefetchesMutex;
+
+namespace
+{
+
+// Let projects load their soundfonts while the rest of them is restored
+[[maybe_unused]] const bool fontPrefetchRegistered = []
+{
+	ProjectLoader::registerBankLoader( "sf2", &Sf2Instrument::prefetchFont );
+	ProjectLoader::registerBankLoader( "sf3", &Sf2Instrument::prefetchFont );
+	return true;
+}();
+
+} // namespace
+
 struct Sf2PluginData
 {
 	int midiNote;
@@ -328,8 +346,10 @@ void Sf2Instrument::loadFile( const QString & _file )
 				iBank += iBankOff;
 #endif
 
+				m_synthMutex.lock();
 				::fluid_synth_bank_select( m_synth, 1, iBank );
 				::fluid_synth_program_change( m_synth, 1, iProg );
+				m_synthMutex.unlock();
 				m_bankNum.setValue( iBank );
 				m_patchNum.setValue ( iProg );
 				break;
@@ -380,6 +400,69 @@ void Sf2Instrument::freeFont()
 
 
 
+std::shared_ptr<void> Sf2Instrument::prefetchFont(const QString& absolutePath)
+{
+#if FLUIDSYNTH_VERSION_MAJOR >= 2
+	const QString fontKey = QFileInfo(absolutePath).canonicalFilePath();
+	const QByteArray sf2File = absolutePath.toLocal8Bit();
+	if (fontKey.isEmpty() || !fluid_is_soundfont(sf2File.constData()))
+	{
+		return nullptr;
+	}
+
+	// instruments opening the file meanwhile wait for us, see openFile()
+	std::promise<void> loading;
+	s_prefetchesMutex.lock();
+	const bool prefetching = s_prefetches.find(fontKey) != s_prefetches.end();
+	if (!prefetching)
+	{
+		s_prefetches[fontKey] = loading.get_future().share();
+	}
+	s_prefetchesMutex.unlock();
+	if (prefetching)
+	{
+		return nullptr;
+	}
+
+	const auto forget = [fontKey]
+	{
+		s_prefetchesMutex.lock();
+		s_prefetches.erase(fontKey);
+		s_prefetchesMutex.unlock();
+	};
+
+	// FluidSynth only loads soundfonts into synths. A synth of our own keeps
+	// the samples in FluidSynth's sample cache until the reference is dropped,
+	// so the instruments restored meanwhile find them there.
+	fluid_settings_t* settings = new_fluid_settings();
+	fluid_synth_t* synth = new_fluid_synth(settings);
+	const bool loaded = fluid_synth_sfload(synth, sf2File.constData(), false) >= 0;
+	loading.set_value();
+
+	if (!loaded)
+	{
+		forget();
+		delete_fluid_synth(synth);
+		delete_fluid_settings(settings);
+		return nullptr;
+	}
+
+	return std::shared_ptr<fluid_synth_t>(synth, [settings, forget](fluid_synth_t* synth)
+	{
+		forget();
+		delete_fluid_synth(synth);
+		delete_fluid_settings(settings);
+	});
+#else
+	// without a sample cache every synth loads the samples again anyway
+	Q_UNUSED(absolutePath)
+	return nullptr;
+#endif
+}
+
+
+
+
 void Sf2Instrument::openFile( const QString & _sf2File, bool updateTrackName )
 {
 	emit fileLoading();
@@ -387,12 +470,27 @@ void Sf2Instrument::openFile( const QString & _sf2File, bool updateTrackName )
 	// Used for loading file
 	char * sf2Ascii = qstrdup( qPrintable( PathUtil::toAbsolute( _sf2File ) ) );
 	QString relativePath = PathUtil::toShortestRelative( _sf2File );
+	const QString fontKey = QFileInfo( PathUtil::toAbsolute( _sf2File ) ).canonicalFilePath();
 
 	// free the soundfont if one is selected
 	freeFont();
 
+	// If the project loader is prefetching this file, wait until its samples
+	// are in the sample cache instead of loading them a second time
+	s_prefetchesMutex.lock();
+	const auto prefetch = s_prefetches.find( fontKey );
+	const std::shared_future<void> prefetched = prefetch != s_prefetches.end() ? prefetch->second : std::shared_future<void>();
+	s_prefetchesMutex.unlock();
+	if( prefetched.valid() )
+	{
+		prefetched.wait();
+	}
+
 	m_synthMutex.lock();
 
+	// Each synth gets a soundfont of its own, FluidSynth can't share one.
+	// Since FluidSynth 2 they share the sample data instead: its sample cache
+	// holds the samples of a file once for all synths which loaded it.
 	bool loaded = false;
 	if (fluid_is_soundfont(sf2Ascii))
 	{
@@ -441,8 +539,10 @@ void Sf2Instrument::updatePatch()
 {
 	if( m_bankNum.value() >= 0 && m_patchNum.value() >= 0 )
 	{
+		m_synthMutex.lock();
 		fluid_synth_program_select( m_synth, m_channel, m_fontId,
 				m_bankNum.value(), m_patchNum.value() );
+		m_synthMutex.unlock();
 	}
 }
 
@@ -882,6 +982,9 @@ void Sf2Instrument::play( SampleFrame* _working_buffer )
 }
 
 
+// Unlike GigInstrument, the synth renders the whole period as one part.
+// Splitting the voices across several synths would load the presets of the
+// soundfont once per synth, and reverb and chorus would run once per synth.
 void Sf2Instrument::renderFrames( f_cnt_t frames, SampleFrame* buf )
 {
 	m_synthMutex.lock();
@@ -979,8 +1082,8 @@ Sf2InstrumentView::Sf2InstrumentView( Instrument * _instrument, QWidget * _paren
 
 	auto k = castModel<Sf2Instrument>();
 
-	connect(&k->m_bankNum, SIGNAL(dataChanged()), this, SLOT(updatePatchName()));
-	connect(&k->m_patchNum, SIGNAL(dataChanged()), this, SLOT(updatePatchName()));
+	connectChanges(&k->m_bankNum, this, [this] { updatePatchName(); });
+	connectChanges(&k->m_patchNum, this, [this] { updatePatchName(); });
 
 	// File Button
 	m_fileDialogButton = new PixmapButton(this);
@@ -28,6 +28,9 @@
 #define SF2_PLAYER_H
 
 #include <array>
+#include <future>
+#include <map>
+#include <memory>
 #include <fluidsynth/types.h>
 #include <QMutex>
 #include <samplerate.h>
@@ -42,7 +45,6 @@ namespace lmms
 {
 
 
-class Sf2Font;
 struct Sf2PluginData;
 class NotePlayHandle;
 
@@ -65,6 +67,11 @@ public:
 	Sf2Instrument( InstrumentTrack * _instrument_track );
 	~Sf2Instrument() override;
 
+	//! Load the samples of a soundfont into FluidSynth's sample cache and
+	//! return a reference which keeps them there, see
+	//! ProjectLoader::registerBankLoader()
+	static std::shared_ptr<void> prefetchFont( const QString & absolutePath );
+
 	void play( SampleFrame* _working_buffer ) override;
 
 	void playNote( NotePlayHandle * _n,
@@ -109,6 +116,12 @@ private:
 	fluid_settings_t* m_settings;
 	fluid_synth_t* m_synth;
 
+	//! Soundfonts being prefetched or kept in the sample cache for the project
+	//! loader, by canonical path. The future becomes ready once the samples
+	//! are loaded, so the load itself doesn't hold s_prefetchesMutex.
+	static std::map<QString, std::shared_future<void>> s_prefetches;
+	static QMutex s_prefetchesMutex;
+
 	fluid_sfont_t* m_font;
 
 	int m_fontId;
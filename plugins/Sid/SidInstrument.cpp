@@ -293,7 +293,7 @@ void SidInstrument::playNote( NotePlayHandle * _n,
 
 	if (!_n->m_pluginData)
 	{
-		auto sid = new reSID::SID();
+		auto sid = m_voices.acquire();
 		sid->set_sampling_parameters(clockrate, reSID::SAMPLE_FAST, samplerate);
 		sid->set_chip_model(reSID::MOS8580);
 		sid->enable_filter( true );
@@ -431,7 +431,7 @@ void SidInstrument::playNote( NotePlayHandle * _n,
 
 void SidInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<reSID::SID*>(_n->m_pluginData);
+	m_voices.release(static_cast<reSID::SID*>(_n->m_pluginData));
 }
 
 
@@ -742,20 +742,17 @@ void SidInstrumentView::modelChanged()
 
 	for (const auto& voice : k->m_voice)
 	{
-		connect(&voice->m_attackModel, SIGNAL(dataChanged()), this, SLOT(updateKnobHint()));
-		connect(&voice->m_decayModel, SIGNAL(dataChanged()), this, SLOT(updateKnobHint()));
-		connect(&voice->m_releaseModel, SIGNAL(dataChanged()), this, SLOT(updateKnobHint()));
-		connect(&voice->m_pulseWidthModel, SIGNAL(dataChanged()), this, SLOT(updateKnobHint()));
-		connect(&voice->m_sustainModel, SIGNAL(dataChanged()), this, SLOT(updateKnobToolTip()));
-		connect(&voice->m_coarseModel, SIGNAL(dataChanged()), this, SLOT(updateKnobToolTip()));
+		connectChanges(&voice->m_attackModel, this, [this] { updateKnobHint(); });
+		connectChanges(&voice->m_decayModel, this, [this] { updateKnobHint(); });
+		connectChanges(&voice->m_releaseModel, this, [this] { updateKnobHint(); });
+		connectChanges(&voice->m_pulseWidthModel, this, [this] { updateKnobHint(); });
+		connectChanges(&voice->m_sustainModel, this, [this] { updateKnobToolTip(); });
+		connectChanges(&voice->m_coarseModel, this, [this] { updateKnobToolTip(); });
 	}
 
-	connect( &k->m_volumeModel, SIGNAL( dataChanged() ),
-		this, SLOT( updateKnobToolTip() ) );
-	connect( &k->m_filterResonanceModel, SIGNAL( dataChanged() ),
-		this, SLOT( updateKnobToolTip() ) );
-	connect( &k->m_filterFCModel, SIGNAL( dataChanged() ),
-		this, SLOT( updateKnobHint() ) );
+	connectChanges( &k->m_volumeModel, this, [this] { updateKnobToolTip(); } );
+	connectChanges( &k->m_filterResonanceModel, this, [this] { updateKnobToolTip(); } );
+	connectChanges( &k->m_filterFCModel, this, [this] { updateKnobHint(); } );
 
 	updateKnobHint();
 	updateKnobToolTip();
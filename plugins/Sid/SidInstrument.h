@@ -31,6 +31,11 @@
 #include "Instrument.h"
 #include "InstrumentView.h"
 
+namespace reSID
+{
+class SID;
+}
+
 namespace lmms
 {
 
@@ -135,6 +140,8 @@ private:
 
 	IntModel m_chipModel;
 
+	VoicePool<reSID::SID> m_voices{ DefaultVoicePoolSize };
+
 	friend class gui::SidInstrumentView;
 
 } ;
@@ -30,6 +30,7 @@
 
 #include "Engine.h"
 #include "InstrumentTrack.h"
+#include "fft_helpers.h"
 #include "PathUtil.h"
 #include "SampleLoader.h"
 #include "Song.h"
@@ -193,7 +194,7 @@ void SlicerT::findSlices()
 	std::vector<float> fftIn(windowSize, 0);
 	std::array<fftwf_complex, windowSize> fftOut;
 
-	fftwf_plan fftPlan = fftwf_plan_dft_r2c_1d(windowSize, fftIn.data(), fftOut.data(), FFTW_MEASURE);
+	const fftwf_plan fftPlan = fftPlanR2C(windowSize, fftIn.data(), fftOut.data());
 
 	int lastPoint = -minDist - 1; // to always store 0 first
 	float spectralFlux = 0;
@@ -203,7 +204,7 @@ void SlicerT::findSlices()
 	{
 		// fft
 		std::copy_n(singleChannel.data() + i, windowSize, fftIn.data());
-		fftwf_execute(fftPlan);
+		fftwf_execute_dft_r2c(fftPlan, fftIn.data(), fftOut.data());
 
 		// calculate spectral flux in regard to last window
 		for (int j = 0; j < windowSize / 2; j++) // only use niquistic frequencies
@@ -26,6 +26,7 @@
 
 #include <QBitmap>
 
+#include "ModelView.h"
 #include "SampleWaveform.h"
 #include "SlicerT.h"
 #include "SlicerTView.h"
@@ -74,7 +75,7 @@ SlicerTWaveform::SlicerTWaveform(int totalWidth, int totalHeight, SlicerT* instr
 	m_editorWaveform.fill(s_waveformBgColor);
 
 	connect(instrument, &SlicerT::isPlaying, this, &SlicerTWaveform::isPlaying);
-	connect(instrument, &SlicerT::dataChanged, this, &SlicerTWaveform::updateUI);
+	ModelView::connectChanges(instrument, this, [this] { updateUI(); });
 
 	m_emptySampleIcon = m_emptySampleIcon.createMaskFromColor(QColor(255, 255, 255), Qt::MaskMode::MaskOutColor);
 
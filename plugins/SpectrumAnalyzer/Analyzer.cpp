@@ -60,10 +60,10 @@ Analyzer::Analyzer(Model *parent, const Plugin::Descriptor::SubPluginFeatures::K
 	Effect(&analyzer_plugin_descriptor, parent, key),
 	m_processor(&m_controls),
 	m_controls(this),
-	m_processorThread(m_processor, m_inputBuffer),
+	m_processorThread(m_processor, m_tap),
 	// Buffer is sized to cover 4* the current maximum LMMS audio buffer size,
 	// so that it has some reserve space in case data processor is busy.
-	m_inputBuffer(4 * m_maxBufferSize)
+	m_tap(4 * m_maxBufferSize, true)
 {
 	m_processorThread.start();
 }
@@ -72,7 +72,7 @@ Analyzer::Analyzer(Model *parent, const Plugin::Descriptor::SubPluginFeatures::K
 Analyzer::~Analyzer()
 {
 	m_processor.terminate();
-	m_inputBuffer.wakeAll();
+	m_tap.wakeAll();
 	m_processorThread.wait();
 }
 
@@ -97,8 +97,8 @@ bool Analyzer::processAudioBuffer(SampleFrame* buffer, const fpp_t frame_count)
 	if (m_controls.isViewVisible())
 	{
 		// To avoid processing spikes on audio thread, data are stored in
-		// a lockless ringbuffer and processed in a separate thread.
-		m_inputBuffer.write(buffer, frame_count, true);
+		// a lockless audio tap and processed in a separate thread.
+		m_tap.write(buffer, frame_count);
 	}
 	#ifdef SA_DEBUG
 		audio_time = std::chrono::high_resolution_clock::now().time_since_epoch().count() - audio_time;
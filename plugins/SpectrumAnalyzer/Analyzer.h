@@ -28,9 +28,9 @@
 #define ANALYZER_H
 
 
+#include "AudioTap.h"
 #include "DataprocLauncher.h"
 #include "Effect.h"
-#include "LocklessRingBuffer.h"
 #include "SaControls.h"
 #include "SaProcessor.h"
 
@@ -60,10 +60,10 @@ private:
 	// QThread::create() workaround
 	// Replace DataprocLauncher by QThread and replace initializer in constructor
 	// with the following commented line when LMMS CI starts using Qt > 5.9
-	//m_processorThread = QThread::create([=]{m_processor.analyze(m_inputBuffer);});
+	//m_processorThread = QThread::create([=]{m_processor.analyze(m_tap);});
 	DataprocLauncher m_processorThread;
 
-	LocklessRingBuffer<SampleFrame> m_inputBuffer;
+	AudioTap m_tap;
 
 	#ifdef SA_DEBUG
 		int m_last_dump_time;
@@ -28,7 +28,7 @@
 #include <QThread>
 
 #include "SaProcessor.h"
-#include "LocklessRingBuffer.h"
+#include "AudioTap.h"
 
 namespace lmms
 {
@@ -37,20 +37,20 @@ namespace lmms
 class DataprocLauncher : public QThread
 {
 public:
-	explicit DataprocLauncher(SaProcessor &proc, LocklessRingBuffer<SampleFrame> &buffer)
+	explicit DataprocLauncher(SaProcessor &proc, AudioTap &tap)
 		: m_processor(&proc),
-		m_inputBuffer(&buffer)
+		m_tap(&tap)
 	{
 	}
 
 private:
 	void run() override
 	{
-		m_processor->analyze(*m_inputBuffer);
+		m_processor->analyze(*m_tap);
 	}
 
 	SaProcessor *m_processor;
-	LocklessRingBuffer<SampleFrame> *m_inputBuffer;
+	AudioTap *m_tap;
 };
 
 
@@ -202,7 +202,7 @@ SaControlsDialog::SaControlsDialog(SaControls *controls, SaProcessor *processor)
 	blockSizeCombo->setModel(&controls->m_blockSizeModel);
 	config_layout->addWidget(blockSizeCombo, 0, 5, 2, 1);
 	processor->reallocateBuffers();
-	connect(&controls->m_blockSizeModel, &ComboBoxModel::dataChanged, [=] {processor->reallocateBuffers();});
+	connectChanges(&controls->m_blockSizeModel, this, [=] {processor->reallocateBuffers();});
 
 	// FFT: window type: icon and selector
 	auto windowLabel = new QLabel("", this);
@@ -218,7 +218,7 @@ SaControlsDialog::SaControlsDialog(SaControls *controls, SaProcessor *processor)
 	windowCombo->setModel(&controls->m_windowModel);
 	config_layout->addWidget(windowCombo, 2, 5, 2, 1);
 	processor->rebuildWindow();
-	connect(&controls->m_windowModel, &ComboBoxModel::dataChanged, [=] {processor->rebuildWindow();});
+	connectChanges(&controls->m_windowModel, this, [=] {processor->rebuildWindow();});
 
 	// set stretch factors so that combo boxes expand first
 	config_layout->setColumnStretch(3, 2);
@@ -275,7 +275,7 @@ SaControlsDialog::SaControlsDialog(SaControls *controls, SaProcessor *processor)
 	waterfallHeightKnob->setHintText(tr("Number of lines to keep:"), "");
 	advanced_layout->addWidget(waterfallHeightKnob, 0, 2, 1, 1, Qt::AlignCenter);
 	processor->reallocateBuffers();
-	connect(&controls->m_waterfallHeightModel, &FloatModel::dataChanged, [=] {processor->reallocateBuffers();});
+	connectChanges(&controls->m_waterfallHeightModel, this, [=] {processor->reallocateBuffers();});
 
 	// Waterfall gamma correction
 	auto waterfallGammaKnob = new Knob(KnobType::Small17, this);
@@ -301,7 +301,7 @@ SaControlsDialog::SaControlsDialog(SaControls *controls, SaProcessor *processor)
 	zeroPaddingKnob->setHintText(tr("Processing buffer is"), tr(" steps larger than input block"));
 	advanced_layout->addWidget(zeroPaddingKnob, 1, 3, 1, 1, Qt::AlignCenter);
 	processor->reallocateBuffers();
-	connect(&controls->m_zeroPaddingModel, &FloatModel::dataChanged, [=] {processor->reallocateBuffers();});
+	connectChanges(&controls->m_zeroPaddingModel, this, [=] {processor->reallocateBuffers();});
 
 
 	// Advanced settings button
@@ -341,7 +341,7 @@ SaControlsDialog::SaControlsDialog(SaControls *controls, SaProcessor *processor)
 	m_waterfall = new SaWaterfallView(controls, processor, this);
 	display_splitter->addWidget(m_waterfall);
 	m_waterfall->setVisible(m_controls->m_waterfallModel.value());
-	connect(&controls->m_waterfallModel, &BoolModel::dataChanged, [=] {m_waterfall->updateVisibility();});
+	connectChanges(&controls->m_waterfallModel, this, [=] {m_waterfall->updateVisibility();});
 }
 
 
@@ -39,9 +39,7 @@
 namespace lmms
 {
 
-template<class T>
-class LocklessRingBuffer;
-
+class AudioTap;
 class SaControls;
 class SampleFrame;
 
@@ -54,7 +52,7 @@ public:
 	virtual ~SaProcessor();
 
 	// analysis thread and a method to terminate it
-	void analyze(LocklessRingBuffer<SampleFrame> &ring_buffer);
+	void analyze(AudioTap &tap);
 	void terminate() {m_terminate = true;}
 
 	// inform processor if any processing is actually required
@@ -450,8 +450,7 @@ MalletsInstrumentView::MalletsInstrumentView( MalletsInstrument * _instrument,
 	m_presetsCombo = new ComboBox( this, tr( "Instrument" ) );
 	m_presetsCombo->setGeometry( 140, 50, 99, ComboBox::DEFAULT_HEIGHT );
 	
-	connect( &_instrument->m_presetsModel, SIGNAL( dataChanged() ),
-		 this, SLOT( changePreset() ) );
+	connectChanges( &_instrument->m_presetsModel, this, [this] { changePreset(); } );
 	
 	m_spreadKnob = new Knob( KnobType::Vintage32, this );
 	m_spreadKnob->setLabel( tr( "Spread" ) );
@@ -311,68 +311,43 @@ void TripleOscillator::playNote( NotePlayHandle * _n,
 {
 	if (!_n->m_pluginData)
 	{
-		auto oscs_l = std::array<Oscillator*, NUM_OF_OSCILLATORS>{};
-		auto oscs_r = std::array<Oscillator*, NUM_OF_OSCILLATORS>{};
+		auto voice = m_voices.acquire();
 
 		for( int i = NUM_OF_OSCILLATORS - 1; i >= 0; --i )
 		{
-
 			// the last oscs needs no sub-oscs...
-			if( i == NUM_OF_OSCILLATORS - 1 )
-			{
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						m_osc[i]->m_phaseOffsetLeft,
-						m_osc[i]->m_volumeLeft );
-				oscs_l[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						m_osc[i]->m_phaseOffsetRight,
-						m_osc[i]->m_volumeRight );
-				oscs_r[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-			}
-			else
-			{
-				oscs_l[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningLeft,
-						m_osc[i]->m_phaseOffsetLeft,
-						m_osc[i]->m_volumeLeft,
-						oscs_l[i + 1] );
-				oscs_l[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-				oscs_r[i] = new Oscillator(
-						&m_osc[i]->m_waveShapeModel,
-						&m_osc[i]->m_modulationAlgoModel,
-						_n->frequency(),
-						m_osc[i]->m_detuningRight,
-						m_osc[i]->m_phaseOffsetRight,
-						m_osc[i]->m_volumeRight,
-						oscs_r[i + 1] );
-				oscs_r[i]->setUseWaveTable(m_osc[i]->m_useWaveTable);
-			}
-
-			oscs_l[i]->setUserWave( m_osc[i]->m_sampleBuffer );
-			oscs_r[i]->setUserWave( m_osc[i]->m_sampleBuffer );
-			oscs_l[i]->setUserAntiAliasWaveTable(m_osc[i]->m_userAntiAliasWaveTable);
-			oscs_r[i]->setUserAntiAliasWaveTable(m_osc[i]->m_userAntiAliasWaveTable);
+			const bool last = i == NUM_OF_OSCILLATORS - 1;
+
+			Oscillator & osc_l = voice->oscLeft[i].emplace(
+					&m_osc[i]->m_waveShapeModel,
+					&m_osc[i]->m_modulationAlgoModel,
+					_n->frequency(),
+					m_osc[i]->m_detuningLeft,
+					m_osc[i]->m_phaseOffsetLeft,
+					m_osc[i]->m_volumeLeft,
+					last ? nullptr : &*voice->oscLeft[i + 1] );
+			Oscillator & osc_r = voice->oscRight[i].emplace(
+					&m_osc[i]->m_waveShapeModel,
+					&m_osc[i]->m_modulationAlgoModel,
+					_n->frequency(),
+					m_osc[i]->m_detuningRight,
+					m_osc[i]->m_phaseOffsetRight,
+					m_osc[i]->m_volumeRight,
+					last ? nullptr : &*voice->oscRight[i + 1] );
+
+			osc_l.setUseWaveTable(m_osc[i]->m_useWaveTable);
+			osc_r.setUseWaveTable(m_osc[i]->m_useWaveTable);
+			osc_l.setUserWave( m_osc[i]->m_sampleBuffer );
+			osc_r.setUserWave( m_osc[i]->m_sampleBuffer );
+			osc_l.setUserAntiAliasWaveTable(m_osc[i]->m_userAntiAliasWaveTable);
+			osc_r.setUserAntiAliasWaveTable(m_osc[i]->m_userAntiAliasWaveTable);
 		}
 
-		_n->m_pluginData = new oscPtr;
-		static_cast<oscPtr *>( _n->m_pluginData )->oscLeft = oscs_l[0];
-		static_cast< oscPtr *>( _n->m_pluginData )->oscRight =
-								oscs_r[0];
+		_n->m_pluginData = voice;
 	}
 
-	Oscillator * osc_l = static_cast<oscPtr *>( _n->m_pluginData )->oscLeft;
-	Oscillator * osc_r = static_cast<oscPtr *>( _n->m_pluginData )->oscRight;
+	Oscillator * osc_l = &*static_cast<oscPtr *>( _n->m_pluginData )->oscLeft[0];
+	Oscillator * osc_r = &*static_cast<oscPtr *>( _n->m_pluginData )->oscRight[0];
 
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
@@ -389,11 +364,7 @@ void TripleOscillator::playNote( NotePlayHandle * _n,
 
 void TripleOscillator::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscLeft );
-	delete static_cast<Oscillator *>( static_cast<oscPtr *>(
-						_n->m_pluginData )->oscRight );
-	delete static_cast<oscPtr *>( _n->m_pluginData );
+	m_voices.release( static_cast<oscPtr *>( _n->m_pluginData ) );
 }
 
 
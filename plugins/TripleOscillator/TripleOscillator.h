@@ -26,11 +26,14 @@
 #ifndef _TRIPLE_OSCILLATOR_H
 #define _TRIPLE_OSCILLATOR_H
 
+#include <array>
 #include <memory>
+#include <optional>
 
 #include "Instrument.h"
 #include "InstrumentView.h"
 #include "AutomatableModel.h"
+#include "Oscillator.h"
 #include "OscillatorConstants.h"
 #include "SampleBuffer.h"
 
@@ -40,7 +43,6 @@ namespace lmms
 
 class NotePlayHandle;
 class SampleBuffer;
-class Oscillator;
 
 
 namespace gui
@@ -136,12 +138,15 @@ protected slots:
 private:
 	OscillatorObject * m_osc[NUM_OF_OSCILLATORS];
 
+	// all oscillators of a note, each one modulated by the next
 	struct oscPtr
 	{
-		Oscillator * oscLeft;
-		Oscillator * oscRight;
+		std::array<std::optional<Oscillator>, NUM_OF_OSCILLATORS> oscLeft;
+		std::array<std::optional<Oscillator>, NUM_OF_OSCILLATORS> oscRight;
 	} ;
 
+	VoicePool<oscPtr> m_voices{ DefaultVoicePoolSize };
+
 
 	friend class gui::TripleOscillatorView;
 
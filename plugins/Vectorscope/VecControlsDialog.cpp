@@ -49,7 +49,7 @@ VecControlsDialog::VecControlsDialog(VecControls *controls) :
 
 	// Visualizer widget
 	// The size of 768 pixels seems to offer a good balance of speed, accuracy and trace thickness.
-	auto display = new VectorView(controls, m_controls->m_effect->getBuffer(), 768, this);
+	auto display = new VectorView(controls, m_controls->m_effect->getTap(), 768, this);
 	master_layout->addWidget(display);
 
 	// Config area located inside visualizer
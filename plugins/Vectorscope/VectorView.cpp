@@ -37,11 +37,10 @@ namespace lmms::gui
 {
 
 
-VectorView::VectorView(VecControls *controls, LocklessRingBuffer<SampleFrame> *inputBuffer, unsigned short displaySize, QWidget *parent) :
+VectorView::VectorView(VecControls *controls, AudioTap *tap, unsigned short displaySize, QWidget *parent) :
 	QWidget(parent),
 	m_controls(controls),
-	m_inputBuffer(inputBuffer),
-	m_bufferReader(*inputBuffer),
+	m_tapReader(*tap),
 	m_displaySize(displaySize),
 	m_zoom(1.f),
 	m_persistTimestamp(0),
@@ -134,7 +133,7 @@ void VectorView::paintEvent(QPaintEvent *event)
 	}
 
 	// Get new samples from the lockless input FIFO buffer
-	auto inBuffer = m_bufferReader.read_max(m_inputBuffer->capacity());
+	auto inBuffer = m_tapReader.read_max(m_tapReader.tap().capacity());
 	std::size_t frameCount = inBuffer.size();
 
 	// Draw new points on top
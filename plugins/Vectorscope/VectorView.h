@@ -25,7 +25,7 @@
 
 #include <QWidget>
 
-#include "LocklessRingBuffer.h"
+#include "AudioTap.h"
 
 namespace lmms
 {
@@ -44,7 +44,7 @@ class VectorView : public QWidget
 {
 	Q_OBJECT
 public:
-	explicit VectorView(VecControls *controls, LocklessRingBuffer<SampleFrame> *inputBuffer, unsigned short displaySize, QWidget *parent = 0);
+	explicit VectorView(VecControls *controls, AudioTap *tap, unsigned short displaySize, QWidget *parent = 0);
 	~VectorView() override = default;
 
 	QSize sizeHint() const override {return QSize(300, 300);}
@@ -60,8 +60,7 @@ private slots:
 private:
 	VecControls *m_controls;
 
-	LocklessRingBuffer<SampleFrame> *m_inputBuffer;
-	LocklessRingBufferReader<SampleFrame> m_bufferReader;
+	AudioTapReader m_tapReader;
 
 	std::vector<uchar> m_displayBuffer;
 	const unsigned short m_displaySize;
@@ -52,7 +52,7 @@ Vectorscope::Vectorscope(Model *parent, const Plugin::Descriptor::SubPluginFeatu
 	m_controls(this),
 	// Buffer is sized to cover 4* the current maximum LMMS audio buffer size,
 	// so that it has some reserve space in case GUI thresd is busy.
-	m_inputBuffer(4 * m_maxBufferSize)
+	m_tap(4 * m_maxBufferSize)
 {
 }
 
@@ -65,9 +65,9 @@ bool Vectorscope::processAudioBuffer(SampleFrame* buffer, const fpp_t frame_coun
 	// Skip processing if the controls dialog isn't visible, it would only waste CPU cycles.
 	if (m_controls.isViewVisible())
 	{
-		// To avoid processing spikes on audio thread, data are stored in
-		// a lockless ringbuffer and processed in a separate thread.
-		m_inputBuffer.write(buffer, frame_count);
+		// To avoid processing spikes on audio thread, data are passed through
+		// a lockless audio tap and processed in the GUI thread.
+		m_tap.write(buffer, frame_count);
 	}
 	return isRunning();
 }
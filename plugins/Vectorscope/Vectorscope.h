@@ -24,8 +24,8 @@
 #ifndef VECTORSCOPE_H
 #define VECTORSCOPE_H
 
+#include "AudioTap.h"
 #include "Effect.h"
-#include "LocklessRingBuffer.h"
 #include "VecControls.h"
 
 namespace lmms
@@ -41,14 +41,14 @@ public:
 
 	bool processAudioBuffer(SampleFrame* buffer, const fpp_t frame_count) override;
 	EffectControls *controls() override {return &m_controls;}
-	LocklessRingBuffer<SampleFrame> *getBuffer() {return &m_inputBuffer;}
+	AudioTap *getTap() {return &m_tap;}
 
 private:
 	VecControls m_controls;
 
 	// Maximum LMMS buffer size (hard coded, the actual constant is hard to get)
 	const unsigned int m_maxBufferSize = 4096;
-	LocklessRingBuffer<SampleFrame> m_inputBuffer;
+	AudioTap m_tap;
 };
 
 
@@ -205,8 +205,8 @@ void Vibed::playNote(NotePlayHandle* n, SampleFrame* workingBuffer)
 {
 	if (!n->m_pluginData)
 	{
-		const auto newContainer = new StringContainer{n->frequency(),
-			Engine::audioEngine()->outputSampleRate(), s_sampleLength};
+		const auto newContainer = m_voices.acquire(n->frequency(),
+			Engine::audioEngine()->outputSampleRate(), s_sampleLength);
 
 		n->m_pluginData = newContainer;
 
@@ -253,7 +253,7 @@ void Vibed::playNote(NotePlayHandle* n, SampleFrame* workingBuffer)
 
 void Vibed::deleteNotePluginData(NotePlayHandle* n)
 {
-	delete static_cast<StringContainer*>(n->m_pluginData);
+	m_voices.release(static_cast<StringContainer*>(n->m_pluginData));
 }
 
 gui::PluginView* Vibed::instantiateView(QWidget* parent)
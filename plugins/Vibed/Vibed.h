@@ -86,6 +86,8 @@ private:
 	std::array<std::unique_ptr<BoolModel>, s_stringCount> m_impulseModels;
 	std::array<std::unique_ptr<NineButtonSelectorModel>, s_stringCount> m_harmonicModels;
 
+	VoicePool<StringContainer> m_voices{DefaultVoicePoolSize};
+
 	friend class gui::VibedView;
 };
 
@@ -467,6 +467,8 @@ private:
 
 	float * * m_inputs;
 	float * * m_outputs;
+	std::vector<float> m_inputBuffer;
+	std::vector<float> m_outputBuffer;
 
 	std::mutex m_shmLock;
 	bool m_shmValid;
@@ -1071,15 +1073,31 @@ void RemoteVstPlugin::process( const SampleFrame* _in, SampleFrame* _out )
 		return;
 	}
 
+	// the shared buffer holds the stereo frames of the host, so split
+	// them into one buffer per channel of the plugin here
+	const int frames = bufferSize();
+	m_inputBuffer.resize( inputCount() * frames );
+	m_outputBuffer.resize( outputCount() * frames );
+
+	const auto in = (const float *) _in;
 	for( int i = 0; i < inputCount(); ++i )
 	{
-		m_inputs[i] = &((float *) _in)[i * bufferSize()];
+		m_inputs[i] = &m_inputBuffer[i * frames];
+		if( in == nullptr || i >= DEFAULT_CHANNELS )
+		{
+			memset( m_inputs[i], 0, frames * sizeof( float ) );
+			continue;
+		}
+		for( int frame = 0; frame < frames; ++frame )
+		{
+			m_inputs[i][frame] = in[frame * DEFAULT_CHANNELS + i];
+		}
 	}
 
 	for( int i = 0; i < outputCount(); ++i )
 	{
-		m_outputs[i] = &((float *) _out)[i * bufferSize()];
-		memset( m_outputs[i], 0, bufferSize() * sizeof( float ) );
+		m_outputs[i] = &m_outputBuffer[i * frames];
+		memset( m_outputs[i], 0, frames * sizeof( float ) );
 	}
 
 #ifdef OLD_VST_SDK
@@ -1097,6 +1115,15 @@ void RemoteVstPlugin::process( const SampleFrame* _in, SampleFrame* _out )
 	m_plugin->processReplacing(m_plugin, m_inputs, m_outputs, bufferSize());
 #endif
 
+	const auto out = (float *) _out;
+	for( int i = 0; i < std::min<int>( outputCount(), DEFAULT_CHANNELS ); ++i )
+	{
+		for( int frame = 0; frame < frames; ++frame )
+		{
+			out[frame * DEFAULT_CHANNELS + i] = m_outputs[i][frame];
+		}
+	}
+
 	unlockShm();
 
 	m_currentSamplePos += bufferSize();
@@ -2206,10 +2233,11 @@ void * RemoteVstPlugin::processingThread(void * _param)
 	RemoteVstPlugin * _this = static_cast<RemoteVstPlugin *>( _param );
 
 	RemotePluginClient::message m;
-	while( ( m = _this->receiveMessage() ).id != IdQuit )
+	while( ( m = _this->receiveMessageOrPeriod() ).id != IdQuit )
 	{
 		
 		if( m.id == IdStartProcessing
+			|| m.id == IdChangeAudioSyncKey
 			|| m.id == IdMidiEvent
 			|| m.id == IdVstSetParameter
 			|| m.id == IdVstSetTempo)
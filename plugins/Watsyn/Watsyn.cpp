@@ -22,6 +22,7 @@
  *
  */
 
+#include <algorithm>
 #include <QDomElement>
 
 #include "Watsyn.h"
@@ -65,18 +66,14 @@ Plugin::Descriptor PLUGIN_EXPORT watsyn_plugin_descriptor =
 
 WatsynObject::WatsynObject( float * _A1wave, float * _A2wave,
 					float * _B1wave, float * _B2wave,
-					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph, fpp_t _frames,
+					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph,
 					WatsynInstrument * _w ) :
 				m_amod( _amod ),
 				m_bmod( _bmod ),
 				m_samplerate( _samplerate ),
 				m_nph( _nph ),
-				m_fpp( _frames ),
 				m_parent( _w )
 {
-	m_abuf = new SampleFrame[_frames];
-	m_bbuf = new SampleFrame[_frames];
-
 	m_lphase[A1_OSC] = 0.0f;
 	m_lphase[A2_OSC] = 0.0f;
 	m_lphase[B1_OSC] = 0.0f;
@@ -97,20 +94,8 @@ WatsynObject::WatsynObject( float * _A1wave, float * _A2wave,
 
 
 
-WatsynObject::~WatsynObject()
-{
-	delete[] m_abuf;
-	delete[] m_bbuf;
-}
-
-
-void WatsynObject::renderOutput( fpp_t _frames )
+void WatsynObject::renderOutput( SampleFrame* _abuf, SampleFrame* _bbuf, fpp_t _frames )
 {
-	if( m_abuf == nullptr )
-		m_abuf = new SampleFrame[m_fpp];
-	if( m_bbuf == nullptr )
-		m_bbuf = new SampleFrame[m_fpp];
-
 	for( fpp_t frame = 0; frame < _frames; frame++ )
 	{
 		// put phases of 1-series oscs into variables because phase modulation might happen
@@ -196,8 +181,8 @@ void WatsynObject::renderOutput( fpp_t _frames )
 				A1_R *= A2_R;
 				break;
 		}
-		m_abuf[frame][0] = A1_L;
-		m_abuf[frame][1] = A1_R;
+		_abuf[frame][0] = A1_L;
+		_abuf[frame][1] = A1_R;
 
 		// B-series modulation (other than phase mod)
 		switch( m_bmod )
@@ -215,8 +200,8 @@ void WatsynObject::renderOutput( fpp_t _frames )
 				B1_R *= B2_R;
 				break;
 		}
-		m_bbuf[frame][0] = B1_L;
-		m_bbuf[frame][1] = B1_R;
+		_bbuf[frame][0] = B1_L;
+		_bbuf[frame][1] = B1_R;
 
 		// update phases
 		for( int i = 0; i < NUM_OSCS; i++ )
@@ -331,8 +316,8 @@ void WatsynInstrument::playNote( NotePlayHandle * _n,
 {
 	if (!_n->m_pluginData)
 	{
-		auto w = new WatsynObject(&A1_wave[0], &A2_wave[0], &B1_wave[0], &B2_wave[0], m_amod.value(), m_bmod.value(),
-			Engine::audioEngine()->outputSampleRate(), _n, Engine::audioEngine()->framesPerPeriod(), this);
+		auto w = m_voices.acquire(&A1_wave[0], &A2_wave[0], &B1_wave[0], &B2_wave[0], m_amod.value(), m_bmod.value(),
+			Engine::audioEngine()->outputSampleRate(), _n, this);
 
 		_n->m_pluginData = w;
 	}
@@ -343,11 +328,6 @@ void WatsynInstrument::playNote( NotePlayHandle * _n,
 
 	auto w = static_cast<WatsynObject*>(_n->m_pluginData);
 
-	SampleFrame* abuf = w->abuf();
-	SampleFrame* bbuf = w->bbuf();
-
-	w-> renderOutput( frames );
-
 	// envelope parameters
 	const float envAmt = m_envAmt.value();
 	const float envAtt = ( m_envAtt.value() * w->samplerate() ) / 1000.0f;
@@ -393,54 +373,66 @@ void WatsynInstrument::playNote( NotePlayHandle * _n,
 	}
 	else*/ 
 	
-	// if sample-exact is not enabled, use simpler calculations:
-	// if mix envelope is active, and we haven't gone past the envelope end, use envelope-aware calculation...
-	if( envAmt != 0.0f && tfp_ < envLen )
+	// render the a/b streams in blocks, so the buffers fit on the stack
+	for( fpp_t start = 0; start < frames; start += WatsynObject::BlockSize )
 	{
-		const float mixvalue_ = m_abmix.value();
-		for( fpp_t f=0; f < frames; f++ )
+		const fpp_t blockFrames = std::min<fpp_t>( frames - start, WatsynObject::BlockSize );
+		SampleFrame abuf[WatsynObject::BlockSize];
+		SampleFrame bbuf[WatsynObject::BlockSize];
+		w->renderOutput( abuf, bbuf, blockFrames );
+
+		SampleFrame* blockBuffer = buffer + start;
+		const float blockTfp = tfp_ + start;
+
+		// if sample-exact is not enabled, use simpler calculations:
+		// if mix envelope is active, and we haven't gone past the envelope end, use envelope-aware calculation...
+		if( envAmt != 0.0f && blockTfp < envLen )
 		{
-			float mixvalue = mixvalue_;
-			const float tfp = tfp_ + f;
-			// handle mixing envelope
-			if( tfp < envAtt )
-			{
-				mixvalue = qBound( -100.0f, mixvalue + ( tfp / envAtt * envAmt ), 100.0f );
-			}
-			else if ( tfp >= envAtt && tfp < envAtt + envHold )
+			const float mixvalue_ = m_abmix.value();
+			for( fpp_t f=0; f < blockFrames; f++ )
 			{
-				mixvalue = qBound( -100.0f, mixvalue + envAmt, 100.0f );
-			}
-			else
-			{
-				mixvalue = qBound( -100.0f, mixvalue + envAmt - ( ( tfp - ( envAtt + envHold ) ) / envDec * envAmt ), 100.0f );
-			}
+				float mixvalue = mixvalue_;
+				const float tfp = blockTfp + f;
+				// handle mixing envelope
+				if( tfp < envAtt )
+				{
+					mixvalue = qBound( -100.0f, mixvalue + ( tfp / envAtt * envAmt ), 100.0f );
+				}
+				else if ( tfp >= envAtt && tfp < envAtt + envHold )
+				{
+					mixvalue = qBound( -100.0f, mixvalue + envAmt, 100.0f );
+				}
+				else
+				{
+					mixvalue = qBound( -100.0f, mixvalue + envAmt - ( ( tfp - ( envAtt + envHold ) ) / envDec * envAmt ), 100.0f );
+				}
 
-			// get knob values
-			const float bmix = ( ( mixvalue + 100.0 ) / 200.0 );
-			const float amix = 1.0 - bmix;
+				// get knob values
+				const float bmix = ( ( mixvalue + 100.0 ) / 200.0 );
+				const float amix = 1.0 - bmix;
 
-			// mix a/b streams according to mixing knob
-			buffer[f][0] = ( abuf[f][0] * amix ) +
-									( bbuf[f][0] * bmix );
-			buffer[f][1] = ( abuf[f][1] * amix ) +
-									( bbuf[f][1] * bmix );
+				// mix a/b streams according to mixing knob
+				blockBuffer[f][0] = ( abuf[f][0] * amix ) +
+										( bbuf[f][0] * bmix );
+				blockBuffer[f][1] = ( abuf[f][1] * amix ) +
+										( bbuf[f][1] * bmix );
+			}
 		}
-	}
 
-	// ... mix envelope is inactive or we've past the end of envelope, so use a faster calculation to save cpu
-	else
-	{
-		// get knob values
-		const float bmix = ( ( m_abmix.value() + 100.0 ) / 200.0 );
-		const float amix = 1.0 - bmix;
-		for( fpp_t f=0; f < frames; f++ )
+		// ... mix envelope is inactive or we've past the end of envelope, so use a faster calculation to save cpu
+		else
 		{
-			// mix a/b streams according to mixing knob
-			buffer[f][0] = ( abuf[f][0] * amix ) +
-									( bbuf[f][0] * bmix );
-			buffer[f][1] = ( abuf[f][1] * amix ) +
-									( bbuf[f][1] * bmix );
+			// get knob values
+			const float bmix = ( ( m_abmix.value() + 100.0 ) / 200.0 );
+			const float amix = 1.0 - bmix;
+			for( fpp_t f=0; f < blockFrames; f++ )
+			{
+				// mix a/b streams according to mixing knob
+				blockBuffer[f][0] = ( abuf[f][0] * amix ) +
+										( bbuf[f][0] * bmix );
+				blockBuffer[f][1] = ( abuf[f][1] * amix ) +
+										( bbuf[f][1] * bmix );
+			}
 		}
 	}
 
@@ -450,7 +442,7 @@ void WatsynInstrument::playNote( NotePlayHandle * _n,
 
 void WatsynInstrument::deleteNotePluginData( NotePlayHandle * _n )
 {
-	delete static_cast<WatsynObject *>( _n->m_pluginData );
+	m_voices.release( static_cast<WatsynObject *>( _n->m_pluginData ) );
 }
 
 
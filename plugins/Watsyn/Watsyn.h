@@ -90,20 +90,16 @@ class WatsynObject
 public:
 	WatsynObject( 	float * _A1wave, float * _A2wave,
 					float * _B1wave, float * _B2wave,
-					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph, fpp_t _frames,
+					int _amod, int _bmod, const sample_rate_t _samplerate, NotePlayHandle * _nph,
 					WatsynInstrument * _w );
-	virtual ~WatsynObject();
+	virtual ~WatsynObject() = default;
 
-	void renderOutput( fpp_t _frames );
+	//! maximum number of frames renderOutput() can render at once
+	static constexpr fpp_t BlockSize = 64;
+
+	//! render the a- and b-streams of the next `_frames` <= BlockSize frames
+	void renderOutput( SampleFrame* _abuf, SampleFrame* _bbuf, fpp_t _frames );
 
-	inline SampleFrame* abuf() const
-	{
-		return m_abuf;
-	}
-	inline SampleFrame* bbuf() const
-	{
-		return m_bbuf;
-	}
 	inline sample_rate_t samplerate() const
 	{
 		return m_samplerate;
@@ -116,13 +112,8 @@ private:
 	const sample_rate_t m_samplerate;
 	NotePlayHandle * m_nph;
 
-	fpp_t m_fpp;
-
 	WatsynInstrument * m_parent;
 
-	SampleFrame* m_abuf;
-	SampleFrame* m_bbuf;
-
 	float m_lphase [NUM_OSCS];
 	float m_rphase [NUM_OSCS];
 
@@ -293,6 +284,9 @@ private:
 	float B1_wave [WAVELEN];
 	float B2_wave [WAVELEN];
 
+	// a voice holds copies of all four waves, so don't preallocate too many
+	VoicePool<WatsynObject> m_voices{ 16 };
+
 	friend class WatsynObject;
 	friend class gui::WatsynView;
 };
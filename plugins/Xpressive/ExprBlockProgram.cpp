@@ -0,0 +1,559 @@
+/*
+ * ExprBlockProgram.cpp - block-wise evaluation of Xpressive expressions
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ExprBlockProgram.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <locale>
+#include <sstream>
+
+namespace lmms
+{
+
+namespace
+{
+
+// keeps the scratch memory of pathological expressions in check
+constexpr int MaxSlots = 256;
+
+std::string toLower(std::string name)
+{
+	std::transform(name.begin(), name.end(), name.begin(),
+		[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return name;
+}
+
+} // namespace
+
+
+
+
+void ExprBlockProgram::addConstant(const std::string& name, float value)
+{
+	Symbol symbol{Symbol::Type::Constant};
+	symbol.value = value;
+	m_symbols[toLower(name)] = symbol;
+}
+
+
+
+
+void ExprBlockProgram::addVariable(const std::string& name, const float* value)
+{
+	Symbol symbol{Symbol::Type::Variable};
+	symbol.source = value;
+	m_symbols[toLower(name)] = symbol;
+}
+
+
+
+
+void ExprBlockProgram::addVector(const std::string& name, const float* values)
+{
+	Symbol symbol{Symbol::Type::Vector};
+	symbol.source = values;
+	m_symbols[toLower(name)] = symbol;
+}
+
+
+
+
+void ExprBlockProgram::addFunction(const std::string& name, Function1 function, void* data)
+{
+	Symbol symbol{Symbol::Type::Function1};
+	symbol.function1 = function;
+	symbol.data = data;
+	m_symbols[toLower(name)] = symbol;
+}
+
+
+
+
+void ExprBlockProgram::addFunction(const std::string& name, Function2 function)
+{
+	Symbol symbol{Symbol::Type::Function2};
+	symbol.function2 = function;
+	m_symbols[toLower(name)] = symbol;
+}
+
+
+
+
+bool ExprBlockProgram::compile(const std::string& expression)
+{
+	m_program.clear();
+	m_storage.clear();
+	m_slots.clear();
+	m_symbolSlots.clear();
+	m_position = 0;
+	m_valid = false;
+
+	Value result;
+	if (!tokenize(expression) || !parseComparison(result)
+		|| current().type != Token::Type::End || m_slots.size() > MaxSlots)
+	{
+		m_tokens.clear();
+		return false;
+	}
+	m_tokens.clear();
+	m_result = result;
+
+	// all slots are allocated now, so pointers into the storage stay valid
+	for (std::size_t slot = 0; slot < m_slots.size(); ++slot)
+	{
+		if (m_slots[slot] == nullptr) { m_slots[slot] = m_storage.data() + slot * BlockSize; }
+	}
+
+	m_valid = true;
+	return true;
+}
+
+
+
+
+void ExprBlockProgram::evaluate(float* out, std::size_t frames)
+{
+	for (const auto& inst : m_program)
+	{
+		float* const dst = m_storage.data() + inst.dst * BlockSize;
+		const float* const a = inst.a >= 0 ? m_slots[inst.a] : nullptr;
+		const float* const b = inst.b >= 0 ? m_slots[inst.b] : nullptr;
+
+		switch (inst.op)
+		{
+			case OpCode::Load:
+				std::fill_n(dst, frames, *inst.scalar);
+				break;
+			case OpCode::Add:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] + b[i]; }
+				break;
+			case OpCode::Sub:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] - b[i]; }
+				break;
+			case OpCode::Mul:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] * b[i]; }
+				break;
+			case OpCode::Div:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] / b[i]; }
+				break;
+			case OpCode::Mod:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = std::fmod(a[i], b[i]); }
+				break;
+			case OpCode::Pow:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = std::pow(a[i], b[i]); }
+				break;
+			case OpCode::Neg:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = -a[i]; }
+				break;
+			case OpCode::Less:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] < b[i] ? 1.f : 0.f; }
+				break;
+			case OpCode::LessEqual:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] <= b[i] ? 1.f : 0.f; }
+				break;
+			case OpCode::Greater:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] > b[i] ? 1.f : 0.f; }
+				break;
+			case OpCode::GreaterEqual:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = a[i] >= b[i] ? 1.f : 0.f; }
+				break;
+			case OpCode::Call1:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = inst.function1(inst.data, a[i]); }
+				break;
+			case OpCode::Call2:
+				for (std::size_t i = 0; i < frames; ++i) { dst[i] = inst.function2(a[i], b[i]); }
+				break;
+		}
+	}
+
+	if (m_result.constant)
+	{
+		std::fill_n(out, frames, m_result.value);
+	}
+	else
+	{
+		std::copy_n(m_slots[m_result.slot], frames, out);
+	}
+}
+
+
+
+
+bool ExprBlockProgram::tokenize(const std::string& expression)
+{
+	m_tokens.clear();
+	std::size_t pos = 0;
+	const std::size_t length = expression.length();
+	while (pos < length)
+	{
+		const auto c = static_cast<unsigned char>(expression[pos]);
+		const auto next = pos + 1 < length ? static_cast<unsigned char>(expression[pos + 1]) : '\0';
+		if (std::isspace(c))
+		{
+			++pos;
+		}
+		else if (std::isdigit(c) || (c == '.' && std::isdigit(next)))
+		{
+			const std::size_t begin = pos;
+			while (pos < length && std::isdigit(static_cast<unsigned char>(expression[pos]))) { ++pos; }
+			if (pos < length && expression[pos] == '.')
+			{
+				++pos;
+				while (pos < length && std::isdigit(static_cast<unsigned char>(expression[pos]))) { ++pos; }
+			}
+			if (pos < length && (expression[pos] == 'e' || expression[pos] == 'E'))
+			{
+				std::size_t exponent = pos + 1;
+				if (exponent < length && (expression[exponent] == '+' || expression[exponent] == '-')) { ++exponent; }
+				if (exponent >= length || !std::isdigit(static_cast<unsigned char>(expression[exponent])))
+				{
+					return false;
+				}
+				pos = exponent;
+				while (pos < length && std::isdigit(static_cast<unsigned char>(expression[pos]))) { ++pos; }
+			}
+
+			// don't depend on the decimal separator of the current locale
+			std::istringstream stream(expression.substr(begin, pos - begin));
+			stream.imbue(std::locale::classic());
+			double number = 0;
+			if (!(stream >> number)) { return false; }
+			m_tokens.push_back({Token::Type::Number, {}, static_cast<float>(number)});
+		}
+		else if (std::isalpha(c) || c == '_')
+		{
+			const std::size_t begin = pos;
+			while (pos < length && (std::isalnum(static_cast<unsigned char>(expression[pos])) || expression[pos] == '_'))
+			{
+				++pos;
+			}
+			m_tokens.push_back({Token::Type::Symbol, toLower(expression.substr(begin, pos - begin)), 0});
+		}
+		else if ((c == '<' || c == '>') && next == '=')
+		{
+			m_tokens.push_back({Token::Type::Operator, expression.substr(pos, 2), 0});
+			pos += 2;
+		}
+		else if (std::strchr("+-*/%^(),<>", c) != nullptr && c != '\0')
+		{
+			m_tokens.push_back({Token::Type::Operator, std::string(1, static_cast<char>(c)), 0});
+			++pos;
+		}
+		else
+		{
+			// assignments, logic, strings, brackets etc. are left to ExprTk
+			return false;
+		}
+	}
+	m_tokens.push_back({Token::Type::End, {}, 0});
+	return true;
+}
+
+
+
+
+bool ExprBlockProgram::isOperator(const char* op) const
+{
+	return current().type == Token::Type::Operator && current().text == op;
+}
+
+
+
+
+bool ExprBlockProgram::parseComparison(Value& result)
+{
+	if (!parseAdditive(result)) { return false; }
+
+	static const std::pair<const char*, OpCode> comparisons[] = {
+		{"<", OpCode::Less}, {"<=", OpCode::LessEqual},
+		{">", OpCode::Greater}, {">=", OpCode::GreaterEqual}
+	};
+	for (const auto& [op, code] : comparisons)
+	{
+		if (!isOperator(op)) { continue; }
+
+		++m_position;
+		Value rhs;
+		if (!parseAdditive(rhs)) { return false; }
+		result = emit(code, result, rhs);
+
+		// chained comparisons are rare enough to leave them to ExprTk
+		return !isOperator("<") && !isOperator("<=") && !isOperator(">") && !isOperator(">=");
+	}
+	return true;
+}
+
+
+
+
+bool ExprBlockProgram::parseAdditive(Value& result)
+{
+	if (!parseMultiplicative(result)) { return false; }
+
+	while (isOperator("+") || isOperator("-"))
+	{
+		const OpCode op = isOperator("+") ? OpCode::Add : OpCode::Sub;
+		++m_position;
+		Value rhs;
+		if (!parseMultiplicative(rhs)) { return false; }
+		result = emit(op, result, rhs);
+	}
+	return true;
+}
+
+
+
+
+bool ExprBlockProgram::parseMultiplicative(Value& result)
+{
+	if (!parseUnary(result)) { return false; }
+
+	while (isOperator("*") || isOperator("/") || isOperator("%"))
+	{
+		const OpCode op = isOperator("*") ? OpCode::Mul : isOperator("/") ? OpCode::Div : OpCode::Mod;
+		++m_position;
+		Value rhs;
+		if (!parseUnary(rhs)) { return false; }
+		result = emit(op, result, rhs);
+	}
+	return true;
+}
+
+
+
+
+bool ExprBlockProgram::parseUnary(Value& result)
+{
+	if (!isOperator("-") && !isOperator("+")) { return parsePower(result); }
+
+	const bool negate = isOperator("-");
+	++m_position;
+	// how a sign binds to powers and further signs is left to ExprTk
+	if (isOperator("-") || isOperator("+") || !parsePrimary(result) || isOperator("^"))
+	{
+		return false;
+	}
+	if (negate) { result = emit(OpCode::Neg, result); }
+	return true;
+}
+
+
+
+
+bool ExprBlockProgram::parsePower(Value& result)
+{
+	if (!parsePrimary(result)) { return false; }
+	if (!isOperator("^")) { return true; }
+
+	++m_position;
+	Value exponent;
+	if (isOperator("-") || isOperator("+") || !parsePrimary(exponent) || isOperator("^"))
+	{
+		return false;
+	}
+	result = emit(OpCode::Pow, result, exponent);
+	return true;
+}
+
+
+
+
+bool ExprBlockProgram::parsePrimary(Value& result)
+{
+	const Token token = current();
+	if (token.type == Token::Type::End) { return false; }
+	++m_position;
+
+	if (token.type == Token::Type::Number)
+	{
+		result = {true, token.number, -1};
+	}
+	else if (token.type == Token::Type::Symbol)
+	{
+		const auto it = m_symbols.find(token.text);
+		if (it == m_symbols.end()) { return false; }
+
+		const Symbol& symbol = it->second;
+		switch (symbol.type)
+		{
+			case Symbol::Type::Constant:
+				result = {true, symbol.value, -1};
+				break;
+			case Symbol::Type::Variable:
+			case Symbol::Type::Vector:
+			{
+				// every symbol gets a single slot, loaded before its first use
+				const auto slot = m_symbolSlots.find(token.text);
+				if (slot != m_symbolSlots.end())
+				{
+					result = {false, 0, slot->second};
+					break;
+				}
+				const int newSlot = allocateSlot();
+				if (symbol.type == Symbol::Type::Vector)
+				{
+					m_slots[newSlot] = symbol.source;
+				}
+				else
+				{
+					m_program.push_back({OpCode::Load, newSlot, -1, -1, symbol.source, nullptr, nullptr, nullptr});
+				}
+				m_symbolSlots[token.text] = newSlot;
+				result = {false, 0, newSlot};
+				break;
+			}
+			case Symbol::Type::Function1:
+			case Symbol::Type::Function2:
+				if (!parseCall(symbol, result)) { return false; }
+				break;
+		}
+	}
+	else if (token.type == Token::Type::Operator && token.text == "(")
+	{
+		if (!parseComparison(result) || !isOperator(")")) { return false; }
+		++m_position;
+	}
+	else
+	{
+		return false;
+	}
+
+	// implicit multiplication like "2t" is left to ExprTk
+	return current().type != Token::Type::Number && current().type != Token::Type::Symbol && !isOperator("(");
+}
+
+
+
+
+bool ExprBlockProgram::parseCall(const Symbol& symbol, Value& result)
+{
+	if (!isOperator("(")) { return false; }
+	++m_position;
+
+	Value a;
+	if (!parseComparison(a)) { return false; }
+
+	if (symbol.type == Symbol::Type::Function1)
+	{
+		if (!isOperator(")")) { return false; }
+		++m_position;
+		result = emitCall(symbol, a);
+		return true;
+	}
+
+	Value b;
+	if (!isOperator(",")) { return false; }
+	++m_position;
+	if (!parseComparison(b) || !isOperator(")")) { return false; }
+	++m_position;
+	result = emitCall(symbol, a, b);
+	return true;
+}
+
+
+
+
+ExprBlockProgram::Value ExprBlockProgram::emit(OpCode op, Value a, Value b)
+{
+	if (a.constant && b.constant)
+	{
+		return {true, apply(op, a.value, b.value), -1};
+	}
+
+	const int slotA = toSlot(a);
+	const int slotB = op == OpCode::Neg ? -1 : toSlot(b);
+	const int dst = allocateSlot();
+	m_program.push_back({op, dst, slotA, slotB, nullptr, nullptr, nullptr, nullptr});
+	return {false, 0, dst};
+}
+
+
+
+
+ExprBlockProgram::Value ExprBlockProgram::emitCall(const Symbol& symbol, Value a, Value b)
+{
+	const bool unary = symbol.type == Symbol::Type::Function1;
+
+	// all registered functions are pure, so constant arguments can be folded
+	if (a.constant && (unary || b.constant))
+	{
+		const float value = unary ? symbol.function1(symbol.data, a.value) : symbol.function2(a.value, b.value);
+		return {true, value, -1};
+	}
+
+	const int slotA = toSlot(a);
+	const int slotB = unary ? -1 : toSlot(b);
+	const int dst = allocateSlot();
+	m_program.push_back({unary ? OpCode::Call1 : OpCode::Call2, dst, slotA, slotB,
+		nullptr, symbol.function1, symbol.function2, symbol.data});
+	return {false, 0, dst};
+}
+
+
+
+
+int ExprBlockProgram::toSlot(Value value)
+{
+	if (!value.constant) { return value.slot; }
+
+	const int slot = allocateSlot();
+	std::fill_n(m_storage.begin() + slot * BlockSize, BlockSize, value.value);
+	return slot;
+}
+
+
+
+
+int ExprBlockProgram::allocateSlot()
+{
+	m_slots.push_back(nullptr);
+	m_storage.resize(m_slots.size() * BlockSize);
+	return static_cast<int>(m_slots.size()) - 1;
+}
+
+
+
+
+float ExprBlockProgram::apply(OpCode op, float a, float b)
+{
+	switch (op)
+	{
+		case OpCode::Add: return a + b;
+		case OpCode::Sub: return a - b;
+		case OpCode::Mul: return a * b;
+		case OpCode::Div: return a / b;
+		case OpCode::Mod: return std::fmod(a, b);
+		case OpCode::Pow: return std::pow(a, b);
+		case OpCode::Neg: return -a;
+		case OpCode::Less: return a < b ? 1.f : 0.f;
+		case OpCode::LessEqual: return a <= b ? 1.f : 0.f;
+		case OpCode::Greater: return a > b ? 1.f : 0.f;
+		case OpCode::GreaterEqual: return a >= b ? 1.f : 0.f;
+		default: return 0.f;
+	}
+}
+
+
+} // namespace lmms
@@ -0,0 +1,156 @@
+/*
+ * ExprBlockProgram.h - block-wise evaluation of Xpressive expressions
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_EXPR_BLOCK_PROGRAM_H
+#define LMMS_EXPR_BLOCK_PROGRAM_H
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lmms
+{
+
+
+/**
+	Compiles the stateless subset of the Xpressive expression language into a
+	flat list of instructions, each of which processes a whole block of
+	samples. Variables that change per sample (like t or f) are passed in as
+	arrays, so the expression tree is walked once per block instead of once
+	per sample.
+
+	compile() fails for everything outside of that subset, e.g. stateful
+	functions like last(), integrate() or rand(), logic operators or implicit
+	multiplication. Callers are expected to fall back to ExprTk then.
+*/
+class ExprBlockProgram
+{
+public:
+	static constexpr std::size_t BlockSize = 64;
+
+	using Function1 = float (*)(void*, float);
+	using Function2 = float (*)(float, float);
+
+	ExprBlockProgram() = default;
+	ExprBlockProgram(const ExprBlockProgram&) = delete;
+	ExprBlockProgram& operator=(const ExprBlockProgram&) = delete;
+
+	//! Symbol names are case insensitive, like in ExprTk
+	void addConstant(const std::string& name, float value);
+	//! `value` is read once at the beginning of each block
+	void addVariable(const std::string& name, const float* value);
+	//! `values` holds the values for all samples of the block being evaluated
+	void addVector(const std::string& name, const float* values);
+	void addFunction(const std::string& name, Function1 function, void* data = nullptr);
+	void addFunction(const std::string& name, Function2 function);
+
+	bool compile(const std::string& expression);
+	bool isValid() const { return m_valid; }
+
+	//! Evaluate the expression for `frames` <= BlockSize samples
+	void evaluate(float* out, std::size_t frames);
+
+private:
+	enum class OpCode
+	{
+		Load, Add, Sub, Mul, Div, Mod, Pow, Neg,
+		Less, LessEqual, Greater, GreaterEqual,
+		Call1, Call2
+	};
+
+	struct Symbol
+	{
+		enum class Type { Constant, Variable, Vector, Function1, Function2 } type;
+		float value = 0;
+		const float* source = nullptr;
+		Function1 function1 = nullptr;
+		Function2 function2 = nullptr;
+		void* data = nullptr;
+	};
+
+	//! Operand of an instruction, either known at compile time or a slot
+	struct Value
+	{
+		bool constant;
+		float value;
+		int slot;
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		int dst;
+		int a;
+		int b;
+		const float* scalar;
+		Function1 function1;
+		Function2 function2;
+		void* data;
+	};
+
+	struct Token
+	{
+		enum class Type { End, Number, Symbol, Operator } type;
+		std::string text;
+		float number;
+	};
+
+	// recursive descent parser, returns false on anything unsupported
+	bool tokenize(const std::string& expression);
+	bool parseComparison(Value& result);
+	bool parseAdditive(Value& result);
+	bool parseMultiplicative(Value& result);
+	bool parseUnary(Value& result);
+	bool parsePower(Value& result);
+	bool parsePrimary(Value& result);
+	bool parseCall(const Symbol& symbol, Value& result);
+
+	const Token& current() const { return m_tokens[m_position]; }
+	bool isOperator(const char* op) const;
+
+	Value emit(OpCode op, Value a, Value b = {true, 0, -1});
+	Value emitCall(const Symbol& symbol, Value a, Value b = {true, 0, -1});
+	int toSlot(Value value);
+	int allocateSlot();
+
+	static float apply(OpCode op, float a, float b);
+
+	std::unordered_map<std::string, Symbol> m_symbols;
+
+	std::vector<Token> m_tokens;
+	std::size_t m_position = 0;
+
+	std::vector<Instruction> m_program;
+	//! Values of all slots, BlockSize floats each
+	std::vector<float> m_storage;
+	//! Where each slot reads from; vectors point to external memory
+	std::vector<const float*> m_slots;
+	std::unordered_map<std::string, int> m_symbolSlots;
+	Value m_result = {true, 0, -1};
+	bool m_valid = false;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_EXPR_BLOCK_PROGRAM_H
@@ -25,6 +25,7 @@
 
 #include "ExprSynth.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <cmath>
@@ -389,6 +390,7 @@ public:
 	RandomVectorFunction m_rand_vec;
 	IntegrateFunction<float> *m_integ_func;
 	LastSampleFunction<float> m_last_func;
+	ExprBlockProgram m_block_program;
 
 };
 
@@ -509,6 +511,50 @@ struct harmonic_semitone
 };
 static freefunc1<float,harmonic_semitone,true> harmonic_semitone_func;
 
+// adapters for the block evaluator
+template <typename Functor>
+float block_func1(void*, float x)
+{
+	return Functor::process(x);
+}
+template <typename Function>
+float block_func_object(void* function, float x)
+{
+	return (*static_cast<Function*>(function))(x);
+}
+
+// the ExprTk built-in functions supported by the block evaluator
+static void add_block_builtins(ExprBlockProgram& program)
+{
+	program.addFunction("sin", [](void*, float x) { return std::sin(x); });
+	program.addFunction("cos", [](void*, float x) { return std::cos(x); });
+	program.addFunction("tan", [](void*, float x) { return std::tan(x); });
+	program.addFunction("asin", [](void*, float x) { return std::asin(x); });
+	program.addFunction("acos", [](void*, float x) { return std::acos(x); });
+	program.addFunction("atan", [](void*, float x) { return std::atan(x); });
+	program.addFunction("sinh", [](void*, float x) { return std::sinh(x); });
+	program.addFunction("cosh", [](void*, float x) { return std::cosh(x); });
+	program.addFunction("tanh", [](void*, float x) { return std::tanh(x); });
+	program.addFunction("exp", [](void*, float x) { return std::exp(x); });
+	program.addFunction("log", [](void*, float x) { return std::log(x); });
+	program.addFunction("log2", [](void*, float x) { return std::log2(x); });
+	program.addFunction("log10", [](void*, float x) { return std::log10(x); });
+	program.addFunction("sqrt", [](void*, float x) { return std::sqrt(x); });
+	program.addFunction("abs", [](void*, float x) { return std::abs(x); });
+	program.addFunction("floor", [](void*, float x) { return std::floor(x); });
+	program.addFunction("ceil", [](void*, float x) { return std::ceil(x); });
+	program.addFunction("round", [](void*, float x) { return std::round(x); });
+	program.addFunction("trunc", [](void*, float x) { return std::trunc(x); });
+	program.addFunction("frac", [](void*, float x) { return x - std::trunc(x); });
+	program.addFunction("sgn", [](void*, float x) { return x > 0 ? 1.0f : x < 0 ? -1.0f : 0.0f; });
+	program.addFunction("pow", [](float x, float y) { return std::pow(x, y); });
+	program.addFunction("mod", [](float x, float y) { return std::fmod(x, y); });
+	program.addFunction("atan2", [](float x, float y) { return std::atan2(x, y); });
+	// ExprTk accepts any number of arguments here, the block evaluator only two
+	program.addFunction("min", [](float x, float y) { return std::min(x, y); });
+	program.addFunction("max", [](float x, float y) { return std::max(x, y); });
+}
+
 
 ExprFront::ExprFront(const char * expr, int last_func_samples)
 {
@@ -522,7 +568,8 @@ ExprFront::ExprFront(const char * expr, int last_func_samples)
 
 		m_data->m_symbol_table.add_constant("e", F_E);
 
-		m_data->m_symbol_table.add_constant("seed", SimpleRandom::generator() & max_float_integer_mask);
+		const float seed = SimpleRandom::generator() & max_float_integer_mask;
+		m_data->m_symbol_table.add_constant("seed", seed);
 
 		m_data->m_symbol_table.add_function("sinew", sin_wave_func);
 		m_data->m_symbol_table.add_function("squarew", square_wave_func);
@@ -538,6 +585,26 @@ ExprFront::ExprFront(const char * expr, int last_func_samples)
 		m_data->m_symbol_table.add_function("randv", m_data->m_rand_vec);
 		m_data->m_symbol_table.add_function("randsv", randsv_func);
 		m_data->m_symbol_table.add_function("last", m_data->m_last_func);
+
+		// everything stateless is mirrored for the block evaluator; rand,
+		// last and integrate are left out, so they fall back to ExprTk
+		ExprBlockProgram& block = m_data->m_block_program;
+		add_block_builtins(block);
+		block.addConstant("pi", F_PI);
+		block.addConstant("e", F_E);
+		block.addConstant("seed", seed);
+		block.addFunction("sinew", block_func1<sin_wave>);
+		block.addFunction("squarew", block_func1<square_wave>);
+		block.addFunction("trianglew", block_func1<triangle_wave>);
+		block.addFunction("saww", block_func1<saw_wave>);
+		block.addFunction("moogsaww", block_func1<moogsaw_wave>);
+		block.addFunction("moogw", block_func1<moog_wave>);
+		block.addFunction("expw", block_func1<exp_wave>);
+		block.addFunction("expnw", block_func1<exp2_wave>);
+		block.addFunction("cent", block_func1<harmonic_cent>);
+		block.addFunction("semitone", block_func1<harmonic_semitone>);
+		block.addFunction("randv", block_func_object<RandomVectorFunction>, &m_data->m_rand_vec);
+		block.addFunction("randsv", [](float index, float rseed) { return randsv_func(index, rseed); });
 	}
 	catch(...)
 	{
@@ -569,6 +636,10 @@ bool ExprFront::compile()
 		parser_t parser(sstore);
 
 		m_valid=parser.compile(m_data->m_expression_string, m_data->m_expression);
+		if (m_valid)
+		{
+			m_data->m_block_program.compile(m_data->m_expression_string);
+		}
 	}
 	catch(...)
 	{
@@ -592,10 +663,33 @@ float ExprFront::evaluate()
 	return 0;
 
 }
+bool ExprFront::canEvaluateBlock() const
+{
+	return m_valid && m_data->m_block_program.isValid();
+}
+void ExprFront::evaluateBlock(float* out, std::size_t frames)
+{
+	m_data->m_block_program.evaluate(out, frames);
+}
 bool ExprFront::add_variable(const char* name, float& ref)
 {
 	try
 	{
+		m_data->m_block_program.addVariable(name, &ref);
+		return m_data->m_symbol_table.add_variable(name, ref);
+	}
+	catch(...)
+	{
+		WARN_EXPRTK;
+	}
+	return false;
+}
+
+bool ExprFront::add_vector_variable(const char* name, float& ref, const float* block)
+{
+	try
+	{
+		m_data->m_block_program.addVector(name, block);
 		return m_data->m_symbol_table.add_variable(name, ref);
 	}
 	catch(...)
@@ -609,6 +703,7 @@ bool ExprFront::add_constant(const char* name, float ref)
 {
 	try
 	{
+		m_data->m_block_program.addConstant(name, ref);
 		return m_data->m_symbol_table.add_constant(name, ref);
 	}
 	catch(...)
@@ -626,12 +721,14 @@ bool ExprFront::add_cyclic_vector(const char* name, const float* data, size_t le
 		{
 			auto wvf = new WaveValueFunctionInterpolate<float>(data, length);
 			m_data->m_cyclics_interp.push_back(wvf);
+			m_data->m_block_program.addFunction(name, block_func_object<WaveValueFunctionInterpolate<float>>, wvf);
 			return m_data->m_symbol_table.add_function(name, *wvf);
 		}
 		else
 		{
 			auto wvf = new WaveValueFunction<float>(data, length);
 			m_data->m_cyclics.push_back(wvf);
+			m_data->m_block_program.addFunction(name, block_func_object<WaveValueFunction<float>>, wvf);
 			return m_data->m_symbol_table.add_function(name, *wvf);
 		}
 	}
@@ -707,10 +804,10 @@ ExprSynth::ExprSynth(const WaveSample *gW1, const WaveSample *gW2, const WaveSam
 		e->add_cyclic_vector("W1", m_W1->m_samples,m_W1->m_length, m_W1->m_interpolate);
 		e->add_cyclic_vector("W2", m_W2->m_samples,m_W2->m_length, m_W2->m_interpolate);
 		e->add_cyclic_vector("W3", m_W3->m_samples,m_W3->m_length, m_W3->m_interpolate);
-		e->add_variable("t", m_note_sample_sec);
-		e->add_variable("f", m_frequency);
-		e->add_variable("rel",m_released);
-		e->add_variable("trel",m_note_rel_sec);
+		e->add_vector_variable("t", m_note_sample_sec, m_note_sample_sec_block.data());
+		e->add_vector_variable("f", m_frequency, m_frequency_block.data());
+		e->add_vector_variable("rel", m_released, m_released_block.data());
+		e->add_vector_variable("trel", m_note_rel_sec, m_note_rel_sec_block.data());
 		e->setIntegrate(&m_note_sample,m_sample_rate);
 		e->compile();
 	};
@@ -756,7 +853,43 @@ void ExprSynth::renderOutput(fpp_t frames, SampleFrame* buf)
 		{
 			m_note_rel_sample = m_note_sample;
 		}
-		if (o1_valid && o2_valid)
+		if ((!o1_valid || m_exprO1->canEvaluateBlock()) && (!o2_valid || m_exprO2->canEvaluateBlock()))
+		{
+			for (fpp_t start = 0; start < frames; start += ExprBlockProgram::BlockSize)
+			{
+				const fpp_t block_frames = std::min<fpp_t>(frames - start, ExprBlockProgram::BlockSize);
+				// same per sample updates as below, only collected into arrays
+				for (fpp_t frame = 0; frame < block_frames; ++frame)
+				{
+					if (is_released && m_released < 1)
+					{
+						m_released = fmin(m_released+m_rel_inc, 1);
+					}
+					m_note_sample_sec_block[frame] = m_note_sample_sec;
+					m_frequency_block[frame] = m_frequency;
+					m_released_block[frame] = m_released;
+					m_note_rel_sec_block[frame] = m_note_rel_sec;
+					m_note_sample++;
+					m_note_sample_sec = m_note_sample / (float)m_sample_rate;
+					if (is_released)
+					{
+						m_note_rel_sec = (m_note_sample - m_note_rel_sample) / (float)m_sample_rate;
+					}
+					m_frequency += freq_inc;
+				}
+
+				if (o1_valid) { m_exprO1->evaluateBlock(m_o1_block.data(), block_frames); }
+				if (o2_valid) { m_exprO2->evaluateBlock(m_o2_block.data(), block_frames); }
+				for (fpp_t frame = 0; frame < block_frames; ++frame)
+				{
+					o1 = o1_valid ? m_o1_block[frame] : 0;
+					o2 = o2_valid ? m_o2_block[frame] : 0;
+					buf[start + frame][0] = (-pn1 + 0.5) * o1 + (-pn2 + 0.5) * o2;
+					buf[start + frame][1] = ( pn1 + 0.5) * o1 + ( pn2 + 0.5) * o2;
+				}
+			}
+		}
+		else if (o1_valid && o2_valid)
 		{
 			for (fpp_t frame = 0; frame < frames ; ++frame)
 			{
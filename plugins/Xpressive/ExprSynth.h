@@ -25,10 +25,12 @@
 #ifndef EXPRSYNTH_H
 #define EXPRSYNTH_H
 
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <limits>
 #include "AutomatableModel.h"
+#include "ExprBlockProgram.h"
 #include "Graph.h"
 
 namespace lmms
@@ -58,9 +60,15 @@ public:
 	inline bool isValid() { return m_valid; }
 	float evaluate();
 	bool add_variable(const char* name, float & ref);
+	//! Like add_variable, but block evaluation reads the values from `block` instead
+	bool add_vector_variable(const char* name, float & ref, const float* block);
 	bool add_constant(const char* name, float  ref);
 	bool add_cyclic_vector(const char* name, const float* data, size_t length, bool interp = false);
 	void setIntegrate(const unsigned int* frameCounter, unsigned int sample_rate);
+	//! Whether the expression can be evaluated a block at a time
+	bool canEvaluateBlock() const;
+	//! Evaluate up to ExprBlockProgram::BlockSize samples at once
+	void evaluateBlock(float* out, std::size_t frames);
 	ExprFrontData* getData() { return m_data; }
 private:
 	ExprFrontData *m_data;
@@ -125,6 +133,15 @@ private:
 	float m_rel_transition;
 	float m_rel_inc;
 
+	// per sample values of t, f, rel and trel for block evaluation
+	using Block = std::array<float, ExprBlockProgram::BlockSize>;
+	Block m_note_sample_sec_block;
+	Block m_frequency_block;
+	Block m_released_block;
+	Block m_note_rel_sec_block;
+	Block m_o1_block;
+	Block m_o2_block;
+
 } ;
 
 
@@ -84,7 +84,7 @@ public:
 	void messageLoop()
 	{
 		message m;
-		while( ( m = receiveMessage() ).id != IdQuit )
+		while( ( m = receiveMessageOrPeriod() ).id != IdQuit )
 		{
 			const auto lock = std::lock_guard{m_master->mutex};
 			processMessage( m );
@@ -83,6 +83,7 @@ int RemotePluginBase::sendMessage(const message & _m)
 		m_out->writeString(_m.data[i]);
 		j += 4 + _m.data[i].size();
 	}
+	messageSent();
 	m_out->unlock();
 	m_out->messageSent();
 #else
@@ -95,6 +96,7 @@ int RemotePluginBase::sendMessage(const message & _m)
 		writeString(str);
 		j += 4 + str.size();
 	}
+	messageSent();
 	pthread_mutex_unlock(&m_sendMutex);
 #endif
 
@@ -116,6 +118,7 @@ RemotePluginBase::message RemotePluginBase::receiveMessage()
 	{
 		m.data.push_back(m_in->readString());
 	}
+	messageReceived();
 	m_in->unlock();
 #else
 	pthread_mutex_lock(&m_receiveMutex);
@@ -126,6 +129,7 @@ RemotePluginBase::message RemotePluginBase::receiveMessage()
 	{
 		m.data.push_back(readString());
 	}
+	messageReceived();
 	pthread_mutex_unlock(&m_receiveMutex);
 #endif
 	return m;
@@ -37,6 +37,7 @@
 #include "NotePlayHandle.h"
 #include "ConfigManager.h"
 #include "SamplePlayHandle.h"
+#include "RealtimeChecker.h"
 
 // platform-specific audio-interface-classes
 #include "AudioAlsa.h"
@@ -87,6 +88,7 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	m_oldAudioDev( nullptr ),
 	m_audioDevStartFailed( false ),
 	m_profiler(),
+	m_masterTap(),
 	m_clearSignal(false)
 {
 	for( int i = 0; i < 2; ++i )
@@ -377,6 +379,18 @@ void AudioEngine::renderStageEffects()
 	AudioEngineWorkerThread::fillJobQueue(m_audioPorts);
 	AudioEngineWorkerThread::startAndWaitForJobs();
 
+	// Hand the output of the ports to the mixer here instead of from the
+	// worker threads, so that every channel gets its inputs in the same order
+	// in every period, no matter which thread finished first
+	Mixer* mixer = Engine::mixer();
+	for (AudioPort* port : m_audioPorts)
+	{
+		if (port->m_hasOutput)
+		{
+			mixer->mixToChannel(port->m_portBuffer, port->m_nextMixerChannel);
+		}
+	}
+
 	// removed all play handles which are done
 	for( PlayHandleList::Iterator it = m_playHandles.begin();
 						it != m_playHandles.end(); )
@@ -414,6 +428,7 @@ void AudioEngine::renderStageMix()
 	mixer->masterMix(m_outputBufferWrite.get());
 
 	MixHelpers::multiply(m_outputBufferWrite.get(), m_masterGain, m_framesPerPeriod);
+	m_masterTap.write(m_outputBufferWrite.get(), m_framesPerPeriod);
 
 	emit nextAudioBuffer(m_outputBufferRead.get());
 
@@ -432,10 +447,14 @@ const SampleFrame* AudioEngine::renderNextBuffer()
 	m_profiler.startPeriod();
 	s_renderingThread = true;
 
-	renderStageNoteSetup();     // STAGE 0: clear old play handles and buffers, setup new play handles
-	renderStageInstruments();   // STAGE 1: run and render all play handles
-	renderStageEffects();       // STAGE 2: process effects of all instrument- and sampletracks
-	renderStageMix();           // STAGE 3: do master mix in mixer
+	{
+		RealtimeChecker::Scope realtimeScope;
+
+		renderStageNoteSetup();     // STAGE 0: clear old play handles and buffers, setup new play handles
+		renderStageInstruments();   // STAGE 1: run and render all play handles
+		renderStageEffects();       // STAGE 2: process effects of all instrument- and sampletracks
+		renderStageMix();           // STAGE 3: do master mix in mixer
+	}
 
 	s_renderingThread = false;
 	m_profiler.finishPeriod(outputSampleRate(), m_framesPerPeriod);
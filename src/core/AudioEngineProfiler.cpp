@@ -26,6 +26,8 @@
 
 #include <cstdint>
 
+#include "LoadMeter.h"
+
 namespace lmms
 {
 
@@ -59,9 +61,30 @@ void AudioEngineProfiler::finishPeriod( sample_rate_t sampleRate, fpp_t framesPe
 		m_detailLoad[i].store(newLoad * 0.05f + oldLoad * 0.95f, std::memory_order_relaxed);
 	}
 
+	// Loads of the single mixer channels, effects and instruments
+	LoadMeter::finishPeriod(timeLimit);
+
+	if constexpr (RealtimeChecker::isEnabled())
+	{
+		const auto violations = RealtimeChecker::takeCounts();
+		m_allocations.store(violations.allocations, std::memory_order_relaxed);
+		m_deallocations.store(violations.deallocations, std::memory_order_relaxed);
+		m_locks.store(violations.locks, std::memory_order_relaxed);
+	}
+
 	if( m_outputFile.isOpen() )
 	{
-		m_outputFile.write( QString( "%1\n" ).arg( periodElapsed ).toLatin1() );
+		if constexpr (RealtimeChecker::isEnabled())
+		{
+			// period time, allocations, deallocations, locks
+			const auto violations = realtimeViolations();
+			m_outputFile.write( QString( "%1 %2 %3 %4\n" ).arg( periodElapsed )
+				.arg( violations.allocations ).arg( violations.deallocations ).arg( violations.locks ).toLatin1() );
+		}
+		else
+		{
+			m_outputFile.write( QString( "%1\n" ).arg( periodElapsed ).toLatin1() );
+		}
 	}
 }
 
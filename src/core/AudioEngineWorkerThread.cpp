@@ -24,12 +24,14 @@
 
 #include "AudioEngineWorkerThread.h"
 
+#include <algorithm>
 #include <QDebug>
 #include <QMutex>
 #include <QWaitCondition>
 
 #include "denormals.h"
 #include "AudioEngine.h"
+#include "RealtimeChecker.h"
 #include "ThreadableJob.h"
 
 #if __SSE__
@@ -73,22 +75,31 @@ void AudioEngineWorkerThread::JobQueue::addJob( ThreadableJob * _job )
 
 
 
+bool AudioEngineWorkerThread::JobQueue::processPending()
+{
+	bool processedJob = false;
+	for (auto i = std::size_t{0}; i < m_writeIndex && i < JOB_QUEUE_SIZE; ++i)
+	{
+		ThreadableJob * job = m_items[i].exchange(nullptr);
+		if( job )
+		{
+			job->process();
+			processedJob = true;
+			++m_itemsDone;
+		}
+	}
+	return processedJob;
+}
+
+
+
+
 void AudioEngineWorkerThread::JobQueue::run()
 {
 	bool processedJob = true;
 	while (processedJob && m_itemsDone < m_writeIndex)
 	{
-		processedJob = false;
-		for (auto i = std::size_t{0}; i < m_writeIndex && i < JOB_QUEUE_SIZE; ++i)
-		{
-			ThreadableJob * job = m_items[i].exchange(nullptr);
-			if( job )
-			{
-				job->process();
-				processedJob = true;
-				++m_itemsDone;
-			}
-		}
+		processedJob = processPending();
 		// always exit loop if we're not in dynamic mode
 		processedJob = processedJob && ( m_opMode == OperationMode::Dynamic );
 	}
@@ -164,6 +175,40 @@ void AudioEngineWorkerThread::startAndWaitForJobs()
 
 
 
+void AudioEngineWorkerThread::processSubJobs( ThreadableJob * const * _jobs, std::size_t _count )
+{
+	for( std::size_t i = 0; i < _count; ++i )
+	{
+		globalJobQueue.addJob( _jobs[i] );
+	}
+	queueReadyWaitCond->wakeAll();
+
+	const auto pending = [_jobs, _count]
+	{
+		return std::any_of( _jobs, _jobs + _count, []( const ThreadableJob * job )
+		{
+			const auto state = job->state();
+			return state == ThreadableJob::ProcessingState::Queued ||
+				state == ThreadableJob::ProcessingState::InProgress;
+		} );
+	};
+
+	// help instead of waiting - our own jobs may still be queued, and other
+	// jobs of this stage have to be finished anyway
+	while( pending() )
+	{
+		if( !globalJobQueue.processPending() )
+		{
+#ifdef __SSE__
+			_mm_pause();
+#endif
+		}
+	}
+}
+
+
+
+
 void AudioEngineWorkerThread::run()
 {
 	disable_denormals();
@@ -173,7 +218,10 @@ void AudioEngineWorkerThread::run()
 	{
 		m.lock();
 		queueReadyWaitCond->wait( &m );
-		globalJobQueue.run();
+		{
+			RealtimeChecker::Scope realtimeScope;
+			globalJobQueue.run();
+		}
 		m.unlock();
 	}
 }
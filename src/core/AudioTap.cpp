@@ -0,0 +1,346 @@
+/*
+ * AudioTap.cpp - lock-free analysis tap for meters, scopes and analyzers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "AudioTap.h"
+
+#include <cmath>
+
+#include "AudioEngine.h"
+#include "Engine.h"
+#include "lmms_constants.h"
+
+namespace lmms
+{
+
+
+AudioTap::AudioTap(std::size_t capacity, bool notifyReaders) :
+	m_ringBuffer(capacity),
+	m_notifyReaders(notifyReaders)
+{
+}
+
+
+
+
+void AudioTap::write(const SampleFrame* buffer, fpp_t frames, float gain)
+{
+	switch (meterPeriod(m_peaksRead, m_peakMeterFrames, frames))
+	{
+	case MeterState::Active: updatePeaks(buffer, frames, gain); break;
+	case MeterState::Expired: resetPeaks(); break;
+	case MeterState::Idle: break;
+	}
+
+	switch (meterPeriod(m_loudnessRead, m_loudnessMeterFrames, frames))
+	{
+	case MeterState::Active: updateLoudness(buffer, frames, gain); break;
+	case MeterState::Expired: resetLoudness(); break;
+	case MeterState::Idle: break;
+	}
+
+	if (m_readers.load(std::memory_order_relaxed) > 0)
+	{
+		// drops the data if the slowest reader cannot keep up
+		m_ringBuffer.write(buffer, frames, m_notifyReaders);
+	}
+}
+
+
+
+
+void AudioTap::writeSilence(fpp_t frames)
+{
+	switch (meterPeriod(m_peaksRead, m_peakMeterFrames, frames))
+	{
+	case MeterState::Active: publishPeaks({}, frames); break;
+	case MeterState::Expired: resetPeaks(); break;
+	case MeterState::Idle: break;
+	}
+
+	switch (meterPeriod(m_loudnessRead, m_loudnessMeterFrames, frames))
+	{
+	case MeterState::Active: decayLoudness(frames); break;
+	case MeterState::Expired: resetLoudness(); break;
+	case MeterState::Idle: break;
+	}
+}
+
+
+
+
+AudioTap::MeterState AudioTap::meterPeriod(std::atomic<bool>& read, f_cnt_t& meterFrames, fpp_t frames)
+{
+	if (read.exchange(false, std::memory_order_relaxed))
+	{
+		// meters poll at a much lower rate than periods are processed
+		meterFrames = Engine::audioEngine()->outputSampleRate();
+	}
+	else if (meterFrames == 0)
+	{
+		return MeterState::Idle;
+	}
+
+	meterFrames -= std::min<f_cnt_t>(meterFrames, frames);
+	return meterFrames > 0 ? MeterState::Active : MeterState::Expired;
+}
+
+
+
+
+void AudioTap::updatePeaks(const SampleFrame* buffer, fpp_t frames, float gain)
+{
+	std::array<float, DEFAULT_CHANNELS> peaks{};
+	for (f_cnt_t f = 0; f < frames; ++f)
+	{
+		for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			peaks[ch] = std::max(peaks[ch], std::abs(buffer[f][ch]));
+		}
+	}
+
+	for (auto& peak : peaks) { peak *= std::abs(gain); }
+	publishPeaks(peaks, frames);
+}
+
+
+
+
+void AudioTap::publishPeaks(const std::array<float, DEFAULT_CHANNELS>& peaks, fpp_t frames)
+{
+	m_peakFrames += frames;
+	// publish a new peak value roughly every 20 ms
+	const bool windowDone = m_peakFrames >= Engine::audioEngine()->outputSampleRate() / 50;
+
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		m_peakAccumulator[ch] = std::max(m_peakAccumulator[ch], peaks[ch]);
+		if (windowDone)
+		{
+			m_peakPrevious[ch].store(m_peakAccumulator[ch], std::memory_order_relaxed);
+			m_peakCurrent[ch].store(0.f, std::memory_order_relaxed);
+			m_peakAccumulator[ch] = 0.f;
+		}
+		else
+		{
+			m_peakCurrent[ch].store(m_peakAccumulator[ch], std::memory_order_relaxed);
+		}
+	}
+
+	if (windowDone) { m_peakFrames = 0; }
+}
+
+
+
+
+void AudioTap::resetPeaks()
+{
+	// nobody reads the peaks anymore; don't show stale ones to the next meter
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		m_peakCurrent[ch].store(0.f, std::memory_order_relaxed);
+		m_peakPrevious[ch].store(0.f, std::memory_order_relaxed);
+		m_peakAccumulator[ch] = 0.f;
+	}
+	m_peakFrames = 0;
+}
+
+
+
+
+void AudioTap::updateCoefficients(sample_rate_t sampleRate)
+{
+	m_sampleRate = sampleRate;
+
+	// K-weighting filter from ITU-R BS.1770, derived for arbitrary sample rates
+	const double fs = sampleRate;
+
+	// stage 1: high shelf modelling the acoustic effect of the head
+	{
+		const double f0 = 1681.974450955533;
+		const double gainDb = 3.999843853973347;
+		const double q = 0.7071752369554196;
+
+		const double k = std::tan(D_PI * f0 / fs);
+		const double vh = std::pow(10.0, gainDb / 20.0);
+		const double vb = std::pow(vh, 0.4996667741545416);
+		const double a0 = 1.0 + k / q + k * k;
+
+		m_preFilter.b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+		m_preFilter.b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+		m_preFilter.b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+		m_preFilter.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+		m_preFilter.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+	}
+
+	// stage 2: RLB high pass
+	{
+		const double f0 = 38.13547087602444;
+		const double q = 0.5003270373238773;
+
+		const double k = std::tan(D_PI * f0 / fs);
+		const double a0 = 1.0 + k / q + k * k;
+
+		m_rlbFilter.b0 = 1.f;
+		m_rlbFilter.b1 = -2.f;
+		m_rlbFilter.b2 = 1.f;
+		m_rlbFilter.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+		m_rlbFilter.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+	}
+}
+
+
+
+
+void AudioTap::updateLoudness(const SampleFrame* buffer, fpp_t frames, float gain)
+{
+	const sample_rate_t sampleRate = Engine::audioEngine()->outputSampleRate();
+	if (sampleRate != m_sampleRate)
+	{
+		updateCoefficients(sampleRate);
+	}
+
+	std::array<float, DEFAULT_CHANNELS> sum{};
+	std::array<float, DEFAULT_CHANNELS> weightedSum{};
+	for (f_cnt_t f = 0; f < frames; ++f)
+	{
+		for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			const float in = buffer[f][ch];
+			const float weighted = m_rlbFilter.process(m_preFilter.process(in, ch), ch);
+			sum[ch] += in * in;
+			weightedSum[ch] += weighted * weighted;
+		}
+	}
+
+	const float gainSquared = gain * gain / frames;
+	const auto blockDuration = static_cast<float>(frames) / m_sampleRate;
+	const float rmsCoeff = 1.f - std::exp(-blockDuration / 0.3f);
+	const float loudnessCoeff = 1.f - std::exp(-blockDuration / 0.4f);
+
+	float weighted = 0.f;
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		m_meanSquare[ch] += rmsCoeff * (sum[ch] * gainSquared - m_meanSquare[ch]);
+		m_rms[ch].store(std::sqrt(m_meanSquare[ch]), std::memory_order_relaxed);
+		weighted += weightedSum[ch] * gainSquared;
+	}
+	m_weightedMeanSquare += loudnessCoeff * (weighted - m_weightedMeanSquare);
+	publishLoudness();
+}
+
+
+
+
+void AudioTap::decayLoudness(fpp_t frames)
+{
+	if (m_sampleRate == 0) { return; }
+
+	const auto blockDuration = static_cast<float>(frames) / m_sampleRate;
+	const float rmsDecay = std::exp(-blockDuration / 0.3f);
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		m_meanSquare[ch] *= rmsDecay;
+		m_rms[ch].store(std::sqrt(m_meanSquare[ch]), std::memory_order_relaxed);
+	}
+	m_weightedMeanSquare *= std::exp(-blockDuration / 0.4f);
+	publishLoudness();
+}
+
+
+
+
+void AudioTap::publishLoudness()
+{
+	// -0.691 dB compensates the gain of the K-weighting filter at 1 kHz
+	const float lufs = m_weightedMeanSquare > 0.f
+		? -0.691f + 10.f * std::log10(m_weightedMeanSquare)
+		: SilenceLufs;
+	m_loudness.store(std::max(lufs, SilenceLufs), std::memory_order_relaxed);
+}
+
+
+
+
+void AudioTap::resetLoudness()
+{
+	// the filters would otherwise ring out the signal of a second ago into the next meter
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		m_rms[ch].store(0.f, std::memory_order_relaxed);
+		m_meanSquare[ch] = 0.f;
+	}
+	m_weightedMeanSquare = 0.f;
+	m_loudness.store(SilenceLufs, std::memory_order_relaxed);
+	m_preFilter.reset();
+	m_rlbFilter.reset();
+}
+
+
+
+
+AudioTapReader::AudioTapReader(AudioTap& tap, unsigned int decimation) :
+	LocklessRingBufferReader<SampleFrame>(tap.m_ringBuffer),
+	m_tap(&tap),
+	m_decimation(std::max(decimation, 1u))
+{
+	m_tap->m_readers.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+
+
+AudioTapReader::~AudioTapReader()
+{
+	m_tap->m_readers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+
+
+
+bool AudioTapReader::fetchLatest(SampleFrame* dest, std::size_t frames)
+{
+	auto input = read_max(m_tap->capacity());
+	const std::size_t inputFrames = input.size();
+	if (inputFrames == 0) { return false; }
+
+	// decimated frames available in this batch, counting from the current phase
+	const std::size_t first = (m_decimation - m_phase) % m_decimation;
+	const std::size_t newFrames = first < inputFrames ? (inputFrames - first - 1) / m_decimation + 1 : 0;
+	const std::size_t keep = newFrames < frames ? frames - newFrames : 0;
+	std::copy(dest + frames - keep, dest + frames, dest);
+
+	std::size_t written = keep;
+	std::size_t skip = newFrames > frames ? newFrames - frames : 0;
+	for (std::size_t f = 0; f < inputFrames; ++f)
+	{
+		if (m_phase == 0)
+		{
+			if (skip > 0) { --skip; }
+			else if (written < frames) { dest[written++] = input[f]; }
+		}
+		m_phase = (m_phase + 1) % m_decimation;
+	}
+	return true;
+}
+
+
+} // namespace lmms
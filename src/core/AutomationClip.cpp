@@ -35,7 +35,7 @@
 #include "ProjectJournal.h"
 #include "Song.h"
 
-#include <cmath>
+#include <algorithm>
 
 namespace lmms
 {
@@ -156,6 +156,7 @@ void AutomationClip::setProgressionType(
 		_new_progression_type == ProgressionType::CubicHermite )
 	{
 		m_progressionType = _new_progression_type;
+		invalidateSegments();
 		emit dataChanged();
 	}
 }
@@ -173,6 +174,7 @@ void AutomationClip::setTension( QString _new_tension )
 	if( ok && nt > -0.01 && nt < 1.01 )
 	{
 		m_tension = nt;
+		invalidateSegments();
 	}
 }
 
@@ -339,6 +341,30 @@ TimePos AutomationClip::putValues(
 
 
 
+void AutomationClip::putValueBatch(const std::vector<std::pair<TimePos, float>>& values, const bool quantPos)
+{
+	if (values.empty()) { return; }
+
+	QMutexLocker m(&m_clipMutex);
+
+	cleanObjects();
+
+	for (const auto& [time, value] : values)
+	{
+		const TimePos newTime = quantPos ? Note::quantized(time, quantization()) : time;
+		m_timeMap[newTime] = AutomationNode(this, value, newTime);
+	}
+
+	generateTangents();
+
+	updateLength();
+
+	emit dataChanged();
+}
+
+
+
+
 void AutomationClip::removeNode(const TimePos & time)
 {
 	QMutexLocker m(&m_clipMutex);
@@ -377,20 +403,25 @@ void AutomationClip::removeNodes(const int tick0, const int tick1)
 	auto start = TimePos(std::min(tick0, tick1));
 	auto end = TimePos(std::max(tick0, tick1));
 
-	// Make a list of TimePos with nodes to be removed
-	// because we can't simply remove the nodes from
-	// the timeMap while we are iterating it.
-	std::vector<TimePos> nodesToRemove;
+	QMutexLocker m(&m_clipMutex);
 
-	for (auto it = m_timeMap.lowerBound(start), endIt = m_timeMap.upperBound(end); it != endIt; ++it)
-	{
-		nodesToRemove.push_back(POS(it));
-	}
+	cleanObjects();
 
-	for (auto node: nodesToRemove)
+	// Remove the whole range before generating the tangents and emitting
+	// dataChanged(), instead of once for every node
+	auto it = m_timeMap.lowerBound(start);
+	while (it != m_timeMap.end() && POS(it) <= end)
 	{
-		removeNode(node);
+		it = m_timeMap.erase(it);
 	}
+
+	// The nodes on both sides of the gap need new tangents
+	if (it != m_timeMap.begin()) { --it; }
+	generateTangents(it, 2);
+
+	updateLength();
+
+	emit dataChanged();
 }
 
 
@@ -525,10 +556,11 @@ TimePos AutomationClip::setDragValue(
 		m_dragging = true;
 	}
 
-	//Restore to the state before it the point were being dragged
+	// Restore to the state before it the point were being dragged. Its tangents
+	// are still those of that state, putValue() updates the ones around the
+	// dragged node.
 	m_timeMap = m_oldTimeMap;
-
-	generateTangents();
+	invalidateSegments();
 
 	TimePos returnedPos;
 
@@ -577,107 +609,156 @@ float AutomationClip::valueAt( const TimePos & _time ) const
 {
 	QMutexLocker m(&m_clipMutex);
 
-	if( m_timeMap.isEmpty() )
+	const auto& segs = segments();
+	if (segs.empty() || _time < segs.front().pos)
 	{
 		return 0;
 	}
 
-	// If we have a node at that time, just return its value
-	if (m_timeMap.contains(_time))
-	{
-		// When the time is exactly the node's time, we want the inValue
-		return m_timeMap[_time].getInValue();
-	}
+	const Segment& segment = segs[segmentAt(_time)];
+	return valueAt(segment, _time - segment.pos);
+}
+
 
-	// lowerBound returns next value with equal or greater key. Since we already
-	// checked if the key contains a node, we know the returned node has a greater
-	// key than _time. Therefore we take the previous element to calculate the current value
-	timeMap::const_iterator v = m_timeMap.lowerBound(_time);
 
-	if( v == m_timeMap.begin() )
-	{
-		return 0;
-	}
-	if( v == m_timeMap.end() )
-	{
-		// When the time is after the last node, we want the outValue of it
-		return OUTVAL(v - 1);
-	}
 
-	return valueAt(v - 1, _time - POS(v - 1));
+// This method will get the value at an offset from a node, so we use the outValue of
+// that node and the inValue of the next node for the calculations. After the last node,
+// the curve stays at its outValue.
+float AutomationClip::valueAt(const Segment& segment, int offset)
+{
+	// When the time is exactly the node's time, we want the inValue
+	if (offset == 0) { return segment.inValue; }
+
+	const float t = offset * segment.invLength;
+	return ((segment.a * t + segment.b) * t + segment.c) * t + segment.d;
 }
 
 
 
 
-// This method will get the value at an offset from a node, so we use the outValue of
-// that node and the inValue of the next node for the calculations.
-float AutomationClip::valueAt( timeMap::const_iterator v, int offset ) const
+float *AutomationClip::valuesAfter( const TimePos & _time ) const
 {
 	QMutexLocker m(&m_clipMutex);
 
-	// We never use it with offset 0, but doesn't hurt to return a correct
-	// value if we do
-	if (offset == 0) { return INVAL(v); }
-
-	if (m_progressionType == ProgressionType::Discrete)
+	const auto& segs = segments();
+	const auto first = std::lower_bound(segs.begin(), segs.end(), static_cast<int>(_time),
+		[](const Segment& segment, int time) { return segment.pos < time; });
+	if (first == segs.end() || first + 1 == segs.end())
 	{
-		return OUTVAL(v);
+		return nullptr;
 	}
-	else if( m_progressionType == ProgressionType::Linear )
-	{
-		float slope =
-			(INVAL(v + 1) - OUTVAL(v))
-			/ (POS(v + 1) - POS(v));
 
-		return OUTVAL(v) + offset * slope;
-	}
-	else /* ProgressionType::CubicHermite */
+	int numValues = (first + 1)->pos - first->pos;
+	auto ret = new float[numValues];
+
+	for( int i = 0; i < numValues; i++ )
 	{
-		// Implements a Cubic Hermite spline as explained at:
-		// http://en.wikipedia.org/wiki/Cubic_Hermite_spline#Unit_interval_.280.2C_1.29
-		//
-		// Note that we are not interpolating a 2 dimensional point over
-		// time as the article describes.  We are interpolating a single
-		// value: y.  To make this work we map the values of x that this
-		// segment spans to values of t for t = 0.0 -> 1.0 and scale the
-		// tangents _m1 and _m2
-		int numValues = (POS(v + 1) - POS(v));
-		float t = (float) offset / (float) numValues;
-		float m1 = OUTTAN(v) * numValues * m_tension;
-		float m2 = INTAN(v + 1) * numValues * m_tension;
-
-		auto t2 = pow(t, 2);
-		auto t3 = pow(t, 3);
-		return (2 * t3 - 3 * t2 + 1) * OUTVAL(v)
-			+ (t3 - 2 * t2 + t) * m1
-			+ (-2 * t3 + 3 * t2) * INVAL(v + 1)
-			+ (t3 - t2) * m2;
+		ret[i] = valueAt(*first, i);
 	}
+
+	return ret;
 }
 
 
 
 
-float *AutomationClip::valuesAfter( const TimePos & _time ) const
+/**
+ * @brief Returns the nodes of m_timeMap as segments, rebuilding them if
+ *        the nodes, the progression type or the tension changed since
+ *        the last call. Must be called with m_clipMutex locked.
+ */
+const std::vector<AutomationClip::Segment>& AutomationClip::segments() const
 {
-	QMutexLocker m(&m_clipMutex);
+	if (m_segmentsValid.exchange(true)) { return m_segments; }
 
-	timeMap::const_iterator v = m_timeMap.lowerBound(_time);
-	if( v == m_timeMap.end() || (v+1) == m_timeMap.end() )
+	// Keeps the capacity, so that only growing clips allocate here
+	m_segments.clear();
+	m_segments.reserve(m_timeMap.size());
+
+	for (auto it = m_timeMap.begin(); it != m_timeMap.end(); ++it)
 	{
-		return nullptr;
+		Segment segment{POS(it), INVAL(it), 0.f, 0.f, 0.f, 0.f, OUTVAL(it)};
+
+		if (it + 1 != m_timeMap.end())
+		{
+			const int length = POS(it + 1) - POS(it);
+			segment.invLength = 1.f / length;
+
+			if (m_progressionType == ProgressionType::Linear)
+			{
+				segment.c = INVAL(it + 1) - OUTVAL(it);
+			}
+			else if (m_progressionType == ProgressionType::CubicHermite)
+			{
+				// Implements a Cubic Hermite spline as explained at:
+				// http://en.wikipedia.org/wiki/Cubic_Hermite_spline#Unit_interval_.280.2C_1.29
+				//
+				// Note that we are not interpolating a 2 dimensional point over
+				// time as the article describes.  We are interpolating a single
+				// value: y.  To make this work we map the values of x that this
+				// segment spans to values of t for t = 0.0 -> 1.0 and scale the
+				// tangents m1 and m2. The basis functions are multiplied out, so
+				// that evaluating the segment is a polynomial in t.
+				const float p1 = OUTVAL(it);
+				const float p2 = INVAL(it + 1);
+				const float m1 = OUTTAN(it) * length * m_tension;
+				const float m2 = INTAN(it + 1) * length * m_tension;
+
+				segment.a = 2 * p1 - 2 * p2 + m1 + m2;
+				segment.b = -3 * p1 + 3 * p2 - 2 * m1 - m2;
+				segment.c = m1;
+			}
+		}
+
+		m_segments.push_back(segment);
 	}
 
-	int numValues = POS(v + 1) - POS(v);
-	auto ret = new float[numValues];
+	m_segmentCursor = 0;
 
-	for( int i = 0; i < numValues; i++ )
+	return m_segments;
+}
+
+
+
+
+/**
+ * @brief Returns the index of the last segment that starts at or before the
+ *        given time, which must not be before the first node. Starts at the
+ *        segment of the previous call, so that playback usually finds the
+ *        segment in a step or two instead of a search.
+ */
+std::size_t AutomationClip::segmentAt(int time) const
+{
+	constexpr std::size_t MaxSteps = 4;
+
+	const auto startsAfter = [](int time, const Segment& segment) { return time < segment.pos; };
+
+	auto cursor = std::min(m_segmentCursor, m_segments.size() - 1);
+	if (m_segments[cursor].pos > time)
 	{
-		ret[i] = valueAt( v, i );
+		// Jumped backwards, e.g. because of a loop or the user moving the play position
+		cursor = std::upper_bound(m_segments.begin(), m_segments.begin() + cursor, time, startsAfter)
+			- m_segments.begin() - 1;
 	}
+	else
+	{
+		std::size_t steps = 0;
+		while (cursor + 1 < m_segments.size() && m_segments[cursor + 1].pos <= time && steps < MaxSteps)
+		{
+			++cursor;
+			++steps;
+		}
 
-	return ret;
+		if (steps == MaxSteps)
+		{
+			cursor = std::upper_bound(m_segments.begin() + cursor, m_segments.end(), time, startsAfter)
+				- m_segments.begin() - 1;
+		}
+	}
+
+	m_segmentCursor = cursor;
+	return cursor;
 }
 
 
@@ -936,6 +1017,7 @@ void AutomationClip::loadSettings( const QDomElement & _this )
 	}
 
 	if (shouldGenerateTangents) { generateTangents(); }
+	invalidateSegments();
 }
 
 
@@ -1120,6 +1202,7 @@ void AutomationClip::clear()
 	QMutexLocker m(&m_clipMutex);
 
 	m_timeMap.clear();
+	invalidateSegments();
 
 	emit dataChanged();
 }
@@ -1190,6 +1273,9 @@ void AutomationClip::generateTangents(timeMap::iterator it, int numToGenerate)
 {
 	QMutexLocker m(&m_clipMutex);
 
+	// Every change of the nodes ends up here
+	invalidateSegments();
+
 	for (int i = 0; i < numToGenerate && it != m_timeMap.end(); ++i, ++it)
 	{
 		// Skip the node if it has locked tangents (were manually edited)
@@ -104,6 +104,18 @@ void AutomationNode::setOutValue(float value)
 	m_clip->generateTangents(it, 3);
 }
 
+void AutomationNode::setInTangent(float tangent)
+{
+	m_inTangent = tangent;
+	if (m_clip) { m_clip->invalidateSegments(); }
+}
+
+void AutomationNode::setOutTangent(float tangent)
+{
+	m_outTangent = tangent;
+	if (m_clip) { m_clip->invalidateSegments(); }
+}
+
 /**
  * @brief Resets the outValue so it matches inValue
 */
@@ -25,6 +25,7 @@
 
 #include <QDomElement>
 #include <QDir>
+#include <QFileInfo>
 #include <QMessageBox>
 #include <QApplication>
 #include <QStandardPaths>
@@ -220,6 +221,11 @@ QString ConfigManager::vstEmbedMethod() const
 	return methods.contains(currentMethod) ? currentMethod : defaultMethod;
 }
 
+QString ConfigManager::fftwWisdomFile() const
+{
+	return QFileInfo(m_lmmsRcFile).absolutePath() + "/.lmms-fftw-wisdom";
+}
+
 bool ConfigManager::hasWorkingDir() const
 {
 	return QDir(m_workingDir).exists();
@@ -377,6 +383,7 @@ void ConfigManager::setValue(const QString & cls,
 	}
 	// not in map yet, so we have to add it...
 	m_settings[cls].push_back(qMakePair(attribute, value));
+	emit valueChanged(cls, attribute, value);
 }
 
 
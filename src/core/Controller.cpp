@@ -158,11 +158,14 @@ void Controller::triggerFrameCounter()
 {
 	for (Controller * controller : s_controllers)
 	{
-		// This signal is for updating values for both stubborn knobs and for
-		// painting.  If we ever get all the widgets to use or at least check
-		// currentValue() then we can throttle the signal and only use it for
-		// GUI.
-		emit controller->valueChanged();
+		// Only LFO and peak controllers change with every period, MIDI
+		// controllers emit the signal themselves when a value arrives. It
+		// reaches the controlled models, whose views poll for changes made on
+		// the render thread, see ModelView::connectChanges().
+		if (controller->frequentUpdates() && controller->connectionCount() > 0)
+		{
+			emit controller->valueChanged();
+		}
 	}
 
 	s_periods ++;
@@ -25,6 +25,7 @@
 
 
 #include <QDomElement>
+#include <algorithm>
 #include <cassert>
 
 #include "EffectChain.h"
@@ -198,6 +199,7 @@ bool EffectChain::processAudioBuffer( SampleFrame* _buf, const fpp_t _frames, bo
 	{
 		if (hasInputNoise || effect->isRunning())
 		{
+			LoadMeter::Probe probe(effect->loadMeter());
 			moreEffects |= effect->processAudioBuffer(_buf, _frames);
 			MixHelpers::sanitize(_buf, _frames);
 		}
@@ -225,6 +227,20 @@ void EffectChain::startRunning()
 
 
 
+bool EffectChain::isRunning() const
+{
+	if( m_enabledModel.value() == false )
+	{
+		return false;
+	}
+
+	return std::any_of( m_effects.begin(), m_effects.end(),
+				[]( const Effect* effect ) { return effect->isRunning(); } );
+}
+
+
+
+
 void EffectChain::clear()
 {
 	emit aboutToClear();
@@ -24,6 +24,7 @@
 
 #include "EnvelopeAndLfoParameters.h"
 
+#include <algorithm>
 #include <QDomElement>
 #include <QFileInfo>
 
@@ -45,17 +46,13 @@ extern const float SECS_PER_LFO_OSCILLATION = 20.0f;
 const f_cnt_t minimumFrames = 1;
 
 
-EnvelopeAndLfoParameters::LfoInstances * EnvelopeAndLfoParameters::s_lfoInstances = nullptr;
+EnvelopeAndLfoParameters::LfoInstances EnvelopeAndLfoParameters::s_lfoInstances;
 
 
 void EnvelopeAndLfoParameters::LfoInstances::trigger()
 {
-	QMutexLocker m( &m_lfoListMutex );
-	for (const auto& lfo : m_lfos)
-	{
-		lfo->m_lfoFrame += Engine::audioEngine()->framesPerPeriod();
-		lfo->m_bad_lfoShapeData = true;
-	}
+	m_frame += Engine::audioEngine()->framesPerPeriod();
+	++m_period;
 }
 
 
@@ -63,30 +60,9 @@ void EnvelopeAndLfoParameters::LfoInstances::trigger()
 
 void EnvelopeAndLfoParameters::LfoInstances::reset()
 {
-	QMutexLocker m( &m_lfoListMutex );
-	for (const auto& lfo : m_lfos)
-	{
-		lfo->m_lfoFrame = 0;
-		lfo->m_bad_lfoShapeData = true;
-	}
-}
-
-
-
-
-void EnvelopeAndLfoParameters::LfoInstances::add( EnvelopeAndLfoParameters * lfo )
-{
-	QMutexLocker m( &m_lfoListMutex );
-	m_lfos.append( lfo );
-}
-
-
-
-
-void EnvelopeAndLfoParameters::LfoInstances::remove( EnvelopeAndLfoParameters * lfo )
-{
-	QMutexLocker m( &m_lfoListMutex );
-	m_lfos.removeAll( lfo );
+	m_frame = 0;
+	++m_period;
+	++m_resets;
 }
 
 
@@ -120,20 +96,16 @@ EnvelopeAndLfoParameters::EnvelopeAndLfoParameters(
 	m_lfoWaveModel( static_cast<int>(LfoShape::SineWave), 0, NumLfoShapes, this, tr( "LFO wave shape" ) ),
 	m_x100Model( false, this, tr( "LFO frequency x 100" ) ),
 	m_controlEnvAmountModel( false, this, tr( "Modulate env amount" ) ),
-	m_lfoFrame( 0 ),
 	m_lfoAmountIsZero( false ),
-	m_lfoShapeData(nullptr)
+	m_lfoShapeData(nullptr),
+	m_lfoShapePeriod( -1 ),
+	m_lfoFrameOrigin( instances()->frame() ),
+	m_lfoResets( instances()->resets() ),
+	m_envLevelData(nullptr)
 {
 	m_amountModel.setCenterValue( 0 );
 	m_lfoAmountModel.setCenterValue( 0 );
 
-	if( s_lfoInstances == nullptr )
-	{
-		s_lfoInstances = new LfoInstances();
-	}
-
-	instances()->add( this );
-
 	connect( &m_predelayModel, SIGNAL(dataChanged()),
 			this, SLOT(updateSampleVars()), Qt::DirectConnection );
 	connect( &m_attackModel, SIGNAL(dataChanged()),
@@ -168,6 +140,8 @@ EnvelopeAndLfoParameters::EnvelopeAndLfoParameters(
 
 	m_lfoShapeData =
 		new sample_t[Engine::audioEngine()->framesPerPeriod()];
+	m_envLevelData =
+		new sample_t[Engine::audioEngine()->framesPerPeriod()];
 
 	updateSampleVars();
 }
@@ -194,14 +168,21 @@ EnvelopeAndLfoParameters::~EnvelopeAndLfoParameters()
 	delete[] m_pahdEnv;
 	delete[] m_rEnv;
 	delete[] m_lfoShapeData;
+	delete[] m_envLevelData;
+}
 
-	instances()->remove( this );
 
-	if( instances()->isEmpty() )
+
+
+inline f_cnt_t EnvelopeAndLfoParameters::lfoFrame()
+{
+	// each LFO starts its phase when it is created, a reset restarts all of them
+	if( m_lfoResets != instances()->resets() )
 	{
-		delete instances();
-		s_lfoInstances = nullptr;
+		m_lfoResets = instances()->resets();
+		m_lfoFrameOrigin = 0;
 	}
+	return instances()->frame() - m_lfoFrameOrigin;
 }
 
 
@@ -209,7 +190,7 @@ EnvelopeAndLfoParameters::~EnvelopeAndLfoParameters()
 
 inline sample_t EnvelopeAndLfoParameters::lfoShapeSample( fpp_t _frame_offset )
 {
-	f_cnt_t frame = ( m_lfoFrame + _frame_offset ) % m_lfoOscillationFrames;
+	f_cnt_t frame = ( lfoFrame() + _frame_offset ) % m_lfoOscillationFrames;
 	const float phase = frame / static_cast<float>(
 						m_lfoOscillationFrames );
 	sample_t shape_sample;
@@ -252,7 +233,7 @@ void EnvelopeAndLfoParameters::updateLfoShapeData()
 	{
 		m_lfoShapeData[offset] = lfoShapeSample( offset );
 	}
-	m_bad_lfoShapeData = false;
+	m_lfoShapePeriod = instances()->period();
 }
 
 
@@ -272,7 +253,8 @@ inline void EnvelopeAndLfoParameters::fillLfoLevel( float * _buf,
 	}
 	_frame -= m_lfoPredelayFrames;
 
-	if( m_bad_lfoShapeData )
+	// the shape only depends on the phase of this LFO, so all voices share it
+	if( m_lfoShapePeriod != instances()->period() )
 	{
 		updateLfoShapeData();
 	}
@@ -293,43 +275,87 @@ inline void EnvelopeAndLfoParameters::fillLfoLevel( float * _buf,
 
 
 
+inline void EnvelopeAndLfoParameters::fillEnvLevel( float * _buf,
+							f_cnt_t _frame,
+							const f_cnt_t _release_begin,
+							const fpp_t _frames ) const
+{
+	// fill segment by segment instead of deciding per frame, so that
+	// each of the loops below is a plain copy, fill or scale
+	fpp_t offset = 0;
+
+	if( _frame < _release_begin && _frame < m_pahdFrames )
+	{
+		const fpp_t n = std::min<f_cnt_t>( { _frames, m_pahdFrames - _frame, _release_begin - _frame } );
+		std::copy( m_pahdEnv + _frame, m_pahdEnv + _frame + n, _buf );
+		offset += n;
+	}
+	if( offset < _frames && _frame + offset < _release_begin )
+	{
+		const fpp_t n = std::min<f_cnt_t>( _frames - offset, _release_begin - _frame - offset );
+		std::fill( _buf + offset, _buf + offset + n, m_sustainLevel );
+		offset += n;
+	}
+	if( offset < _frames && _frame + offset - _release_begin < m_rFrames )
+	{
+		const float releaseLevel = _release_begin < m_pahdFrames
+			? m_pahdEnv[_release_begin] : m_sustainLevel;
+		const sample_t * rEnv = m_rEnv + ( _frame + offset - _release_begin );
+		const fpp_t n = std::min<f_cnt_t>( _frames - offset, m_rFrames - ( _frame + offset - _release_begin ) );
+		for( fpp_t i = 0; i < n; ++i )
+		{
+			_buf[offset + i] = rEnv[i] * releaseLevel;
+		}
+		offset += n;
+	}
+	std::fill( _buf + offset, _buf + _frames, 0.0f );
+}
+
+
+
+
 void EnvelopeAndLfoParameters::fillLevel( float * _buf, f_cnt_t _frame,
 						const f_cnt_t _release_begin,
 						const fpp_t _frames )
+{
+	const VoiceLevels voice = { _buf, _frame, _release_begin, _frames };
+	fillLevels( &voice, 1 );
+}
+
+
+
+
+void EnvelopeAndLfoParameters::fillLevels( const VoiceLevels * voices,
+						std::size_t count )
 {
 	QMutexLocker m(&m_paramMutex);
 
-	fillLfoLevel( _buf, _frame, _frames );
+	const bool controlEnvAmount = m_controlEnvAmountModel.value();
 
-	for( fpp_t offset = 0; offset < _frames; ++offset, ++_buf, ++_frame )
+	for( std::size_t v = 0; v < count; ++v )
 	{
-		float env_level;
-		if( _frame < _release_begin )
+		float * buf = voices[v].buffer;
+		const float * envLevel = m_envLevelData;
+		const fpp_t frames = voices[v].frames;
+
+		fillLfoLevel( buf, voices[v].frame, frames );
+		fillEnvLevel( m_envLevelData, voices[v].frame, voices[v].releaseBegin, frames );
+
+		// at this point, buf holds the LFO level
+		if( controlEnvAmount )
 		{
-			if( _frame < m_pahdFrames )
+			for( fpp_t offset = 0; offset < frames; ++offset )
 			{
-				env_level = m_pahdEnv[_frame];
+				buf[offset] = envLevel[offset] * ( 0.5f + buf[offset] );
 			}
-			else
-			{
-				env_level = m_sustainLevel;
-			}
-		}
-		else if( ( _frame - _release_begin ) < m_rFrames )
-		{
-			env_level = m_rEnv[_frame - _release_begin] *
-				( ( _release_begin < m_pahdFrames ) ?
-				m_pahdEnv[_release_begin] : m_sustainLevel );
 		}
 		else
 		{
-			env_level = 0.0f;
+			for( fpp_t offset = 0; offset < frames; ++offset )
+			{
+				buf[offset] += envLevel[offset];
+			}
 		}
-
-		// at this point, *_buf is LFO level
-		*_buf = m_controlEnvAmountModel.value() ?
-			env_level * ( 0.5f + *_buf ) :
-			env_level + *_buf;
 	}
 }
 
@@ -532,7 +558,7 @@ void EnvelopeAndLfoParameters::updateSampleVars()
 		m_lfoAmountIsZero = false;
 	}
 
-	m_bad_lfoShapeData = true;
+	m_lfoShapePeriod = -1;
 
 	emit dataChanged();
 
@@ -24,10 +24,16 @@
 
 #include "Instrument.h"
 
+#include <algorithm>
 #include <cmath>
 
+#include "AudioEngine.h"
+#include "AudioEngineWorkerThread.h"
 #include "DummyInstrument.h"
+#include "Engine.h"
 #include "InstrumentTrack.h"
+#include "MixHelpers.h"
+#include "ThreadableJob.h"
 #include "lmms_basics.h"
 #include "lmms_constants.h"
 
@@ -36,6 +42,47 @@ namespace lmms
 {
 
 
+class Instrument::PartJob : public ThreadableJob
+{
+public:
+	PartJob( Instrument* instrument, std::size_t part ) :
+		m_instrument( instrument ),
+		m_part( part )
+	{
+	}
+
+	bool requiresProcessing() const override
+	{
+		return true;
+	}
+
+	const SampleFrame* buffer() const
+	{
+		return m_buffer.data();
+	}
+
+	LoadMeter* loadMeter() override
+	{
+		return &m_instrument->loadMeter();
+	}
+
+protected:
+	void doProcessing() override
+	{
+		const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+		// only allocates if the period size grew
+		m_buffer.resize( frames );
+		zeroSampleFrames( m_buffer.data(), frames );
+		m_instrument->renderPart( m_part, m_buffer.data() );
+	}
+
+private:
+	Instrument* m_instrument;
+	std::size_t m_part;
+	std::vector<SampleFrame> m_buffer;
+};
+
+
 Instrument::Instrument(InstrumentTrack * _instrument_track,
 			const Descriptor * _descriptor,
 			const Descriptor::SubPluginFeatures::Key *key,
@@ -46,6 +93,11 @@ Instrument::Instrument(InstrumentTrack * _instrument_track,
 {
 }
 
+
+
+
+Instrument::~Instrument() = default;
+
 void Instrument::play( SampleFrame* )
 {
 }
@@ -89,6 +141,42 @@ bool Instrument::isFromTrack( const Track * _track ) const
 	return( m_instrumentTrack == _track );
 }
 
+
+
+
+void Instrument::renderParts( SampleFrame* _working_buffer, std::size_t _parts )
+{
+	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+	zeroSampleFrames( _working_buffer, frames );
+
+	if( _parts <= 1 )
+	{
+		renderPart( 0, _working_buffer );
+		return;
+	}
+
+	_parts = std::min( _parts, MaxParts );
+
+	// jobs are kept across periods, so this only allocates when the
+	// number of parts grows
+	while( m_partJobs.size() < _parts )
+	{
+		m_partJobs.push_back( std::make_unique<PartJob>( this, m_partJobs.size() ) );
+	}
+
+	ThreadableJob* jobs[MaxParts];
+	for( std::size_t part = 0; part < _parts; ++part )
+	{
+		jobs[part] = m_partJobs[part].get();
+	}
+	AudioEngineWorkerThread::processSubJobs( jobs, _parts );
+
+	for( std::size_t part = 0; part < _parts; ++part )
+	{
+		MixHelpers::add( _working_buffer, m_partJobs[part]->buffer(), frames );
+	}
+}
+
 // helper function for Instrument::applyFadeIn
 static int countZeroCrossings(SampleFrame* buf, fpp_t start, fpp_t frames)
 {
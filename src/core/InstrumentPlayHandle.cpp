@@ -74,5 +74,10 @@ bool InstrumentPlayHandle::isFromTrack(const Track* track) const
 	return m_instrument->isFromTrack(track);
 }
 
+LoadMeter* InstrumentPlayHandle::loadMeter()
+{
+	return &m_instrument->loadMeter();
+}
+
 
 } // namespace lmms
@@ -24,6 +24,7 @@
 
 #include <QVarLengthArray>
 #include <QDomElement>
+#include <algorithm>
 
 #include "InstrumentSoundShaping.h"
 #include "AudioEngine.h"
@@ -33,6 +34,7 @@
 #include "EnvelopeAndLfoParameters.h"
 #include "Instrument.h"
 #include "InstrumentTrack.h"
+#include "NotePlayHandle.h"
 
 namespace lmms
 {
@@ -40,7 +42,6 @@ namespace lmms
 
 const float CUT_FREQ_MULTIPLIER = 6000.0f;
 const float RES_MULTIPLIER = 2.0f;
-const float RES_PRECISION = 1000.0f;
 
 
 // names for env- and lfo-targets - first is name being displayed to user
@@ -127,9 +128,8 @@ float InstrumentSoundShaping::volumeLevel( NotePlayHandle* n, const f_cnt_t fram
 
 
 
-void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
-							const fpp_t frames,
-							NotePlayHandle* n )
+InstrumentSoundShaping::VoiceEnvelope InstrumentSoundShaping::voiceEnvelope( const NotePlayHandle* n,
+											const fpp_t frames )
 {
 	const f_cnt_t envTotalFrames = n->totalFramesPlayed();
 	f_cnt_t envReleaseBegin = envTotalFrames - n->releaseFramesDone() + n->framesBeforeRelease();
@@ -140,111 +140,155 @@ void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
 		envReleaseBegin += frames;
 	}
 
-	// because of optimizations, there's special code for several cases:
-	// 	- cut- and res-lfo/envelope active
-	// 	- cut-lfo/envelope active
-	// 	- res-lfo/envelope active
-	//	- no lfo/envelope active but filter is used
+	return { n, envTotalFrames, envReleaseBegin, frames };
+}
 
-	// only use filter, if it is really needed
 
-	if( m_filterEnabledModel.value() )
-	{
-		QVarLengthArray<float> cutBuffer(frames);
-		QVarLengthArray<float> resBuffer(frames);
 
-		int old_filter_cut = 0;
-		int old_filter_res = 0;
 
-		if( n->m_filter == nullptr )
+void InstrumentSoundShaping::fillLevel( Target target, const VoiceEnvelope& voice, float* buffer )
+{
+	const auto t = static_cast<std::size_t>(target);
+	{
+		QMutexLocker lock( &m_voiceLevelsMutex );
+		if( m_voiceLevelsPeriod != EnvelopeAndLfoParameters::instances()->period() )
 		{
-			n->m_filter = std::make_unique<BasicFilters<>>( Engine::audioEngine()->outputSampleRate() );
+			fillVoiceLevels( voice );
 		}
-		n->m_filter->setFilterType( static_cast<BasicFilters<>::FilterType>(m_filterModel.value()) );
 
-		if( m_envLfoParameters[static_cast<std::size_t>(Target::Cut)]->isUsed() )
+		const auto it = std::find( m_voices.begin(), m_voices.end(), voice );
+		if( m_voiceLevelTargets[t] && it != m_voices.end() )
 		{
-			m_envLfoParameters[static_cast<std::size_t>(Target::Cut)]->fillLevel( cutBuffer.data(), envTotalFrames, envReleaseBegin, frames );
+			const std::size_t index = t * m_voices.size() + ( it - m_voices.begin() );
+			const float* levels = m_voiceLevelData.data() + index * m_voiceLevelStride;
+			std::copy( levels, levels + voice.frames, buffer );
+			return;
 		}
-		if( m_envLfoParameters[static_cast<std::size_t>(Target::Resonance)]->isUsed() )
+	}
+
+	// the voice was playing or has been released since the levels were filled
+	m_envLfoParameters[t]->fillLevel( buffer, voice.frame, voice.releaseBegin, voice.frames );
+}
+
+
+
+
+void InstrumentSoundShaping::fillVoiceLevels( const VoiceEnvelope& current )
+{
+	const fpp_t stride = Engine::audioEngine()->framesPerPeriod();
+
+	// the voice asking first is exact, the others are predicted from their
+	// state before they play and only used if they still match then
+	m_voices.clear();
+	m_voices.push_back( current );
+	for( PlayHandle* handle : Engine::audioEngine()->playHandles() )
+	{
+		auto note = dynamic_cast<NotePlayHandle*>( handle );
+		if( note == nullptr || note == current.note || note->instrumentTrack() != m_instrumentTrack ||
+			note->isMasterNote() || !note->usesBuffer() || note->isMuted() )
+		{
+			continue;
+		}
+		// voices being played by other threads right now are left to themselves
+		if( !note->tryLock() )
+		{
+			continue;
+		}
+		const fpp_t frames = note->framesLeftForCurrentPeriod();
+		if( frames > 0 && frames <= stride )
 		{
-			m_envLfoParameters[static_cast<std::size_t>(Target::Resonance)]->fillLevel( resBuffer.data(), envTotalFrames, envReleaseBegin, frames );
+			m_voices.push_back( voiceEnvelope( note, frames ) );
 		}
+		note->unlock();
+	}
 
-		const float fcv = m_filterCutModel.value();
-		const float frv = m_filterResModel.value();
+	m_voiceLevelStride = stride;
+	m_voiceLevelData.resize( NumTargets * m_voices.size() * stride );
+	m_voiceLevelRequests.resize( m_voices.size() );
 
-		if( m_envLfoParameters[static_cast<std::size_t>(Target::Cut)]->isUsed() &&
-			m_envLfoParameters[static_cast<std::size_t>(Target::Resonance)]->isUsed() )
+	for( auto t = std::size_t{0}; t < NumTargets; ++t )
+	{
+		// only fill what processAudioBuffer() is going to use
+		m_voiceLevelTargets[t] = m_envLfoParameters[t]->isUsed() &&
+			( static_cast<Target>(t) == Target::Volume || m_filterEnabledModel.value() );
+		if( !m_voiceLevelTargets[t] )
 		{
-			for( fpp_t frame = 0; frame < frames; ++frame )
-			{
-				const float new_cut_val = EnvelopeAndLfoParameters::expKnobVal( cutBuffer[frame] ) *
-								CUT_FREQ_MULTIPLIER + fcv;
+			continue;
+		}
 
-				const float new_res_val = frv + RES_MULTIPLIER * resBuffer[frame];
+		for( std::size_t v = 0; v < m_voices.size(); ++v )
+		{
+			m_voiceLevelRequests[v] = { m_voiceLevelData.data() + ( t * m_voices.size() + v ) * stride,
+				m_voices[v].frame, m_voices[v].releaseBegin, m_voices[v].frames };
+		}
+		m_envLfoParameters[t]->fillLevels( m_voiceLevelRequests.data(), m_voiceLevelRequests.size() );
+	}
 
-				if( static_cast<int>( new_cut_val ) != old_filter_cut ||
-					static_cast<int>( new_res_val*RES_PRECISION ) != old_filter_res )
-				{
-					n->m_filter->calcFilterCoeffs( new_cut_val, new_res_val );
-					old_filter_cut = static_cast<int>( new_cut_val );
-					old_filter_res = static_cast<int>( new_res_val*RES_PRECISION );
-				}
+	m_voiceLevelsPeriod = EnvelopeAndLfoParameters::instances()->period();
+}
 
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
-			}
-		}
-		else if( m_envLfoParameters[static_cast<std::size_t>(Target::Cut)]->isUsed() )
-		{
-			for( fpp_t frame = 0; frame < frames; ++frame )
-			{
-				float new_cut_val = EnvelopeAndLfoParameters::expKnobVal( cutBuffer[frame] ) *
-								CUT_FREQ_MULTIPLIER + fcv;
 
-				if( static_cast<int>( new_cut_val ) != old_filter_cut )
-				{
-					n->m_filter->calcFilterCoeffs( new_cut_val, frv );
-					old_filter_cut = static_cast<int>( new_cut_val );
-				}
 
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
-			}
+
+void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
+							const fpp_t frames,
+							NotePlayHandle* n )
+{
+	const VoiceEnvelope voice = voiceEnvelope( n, frames );
+
+	// only use filter, if it is really needed
+
+	if( m_filterEnabledModel.value() )
+	{
+		if( n->m_filter == nullptr )
+		{
+			n->m_filter = std::make_unique<BasicFilters<>>( Engine::audioEngine()->outputSampleRate() );
 		}
-		else if( m_envLfoParameters[static_cast<std::size_t>(Target::Resonance)]->isUsed() )
+		n->m_filter->setFilterType( static_cast<BasicFilters<>::FilterType>(m_filterModel.value()) );
+
+		const float fcv = m_filterCutModel.value();
+		const float frv = m_filterResModel.value();
+
+		// envelopes and LFOs which are not used leave their parameter constant
+		// over the whole period, so the filter does not need a buffer for it
+		QVarLengthArray<float> cutBuffer;
+		QVarLengthArray<float> resBuffer;
+		const float* cut = &fcv;
+		const float* res = &frv;
+		int cutInc = 0;
+		int resInc = 0;
+
+		if( m_envLfoParameters[static_cast<std::size_t>(Target::Cut)]->isUsed() )
 		{
+			cutBuffer.resize( frames );
+			fillLevel( Target::Cut, voice, cutBuffer.data() );
 			for( fpp_t frame = 0; frame < frames; ++frame )
 			{
-				float new_res_val = frv + RES_MULTIPLIER * resBuffer[frame];
-
-				if( static_cast<int>( new_res_val*RES_PRECISION ) != old_filter_res )
-				{
-					n->m_filter->calcFilterCoeffs( fcv, new_res_val );
-					old_filter_res = static_cast<int>( new_res_val*RES_PRECISION );
-				}
-
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
+				cutBuffer[frame] = EnvelopeAndLfoParameters::expKnobVal( cutBuffer[frame] ) *
+								CUT_FREQ_MULTIPLIER + fcv;
 			}
+			cut = cutBuffer.data();
+			cutInc = 1;
 		}
-		else
+		if( m_envLfoParameters[static_cast<std::size_t>(Target::Resonance)]->isUsed() )
 		{
-			n->m_filter->calcFilterCoeffs( fcv, frv );
-
+			resBuffer.resize( frames );
+			fillLevel( Target::Resonance, voice, resBuffer.data() );
 			for( fpp_t frame = 0; frame < frames; ++frame )
 			{
-				buffer[frame][0] = n->m_filter->update( buffer[frame][0], 0 );
-				buffer[frame][1] = n->m_filter->update( buffer[frame][1], 1 );
+				resBuffer[frame] = frv + RES_MULTIPLIER * resBuffer[frame];
 			}
+			res = resBuffer.data();
+			resInc = 1;
 		}
+
+		n->m_filter->processBlock( buffer, frames, cut, cutInc, res, resInc );
 	}
 
 	if( m_envLfoParameters[static_cast<std::size_t>(Target::Volume)]->isUsed() )
 	{
 		QVarLengthArray<float> volBuffer(frames);
-		m_envLfoParameters[static_cast<std::size_t>(Target::Volume)]->fillLevel( volBuffer.data(), envTotalFrames, envReleaseBegin, frames );
+		fillLevel( Target::Volume, voice, volBuffer.data() );
 
 		for( fpp_t frame = 0; frame < frames; ++frame )
 		{
@@ -0,0 +1,154 @@
+/*
+ * LoadMeter.cpp - CPU load of single mixer channels, effects and instruments
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "LoadMeter.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace lmms
+{
+
+namespace
+{
+
+// Meters are created and destroyed by the GUI and while loading projects,
+// finishPeriod() only tries to lock it so that it never waits on the render thread
+std::mutex s_metersMutex;
+LoadMeter* s_firstMeter = nullptr;
+
+thread_local LoadMeter::JobProbe* t_jobProbe = nullptr;
+
+} // namespace
+
+
+
+
+LoadMeter::LoadMeter()
+{
+	const auto lock = std::lock_guard{s_metersMutex};
+	m_next = s_firstMeter;
+	if (m_next) { m_next->m_previous = this; }
+	s_firstMeter = this;
+}
+
+
+
+
+LoadMeter::~LoadMeter()
+{
+	const auto lock = std::lock_guard{s_metersMutex};
+	if (m_previous) { m_previous->m_next = m_next; }
+	else { s_firstMeter = m_next; }
+	if (m_next) { m_next->m_previous = m_previous; }
+}
+
+
+
+
+float LoadMeter::meanLoad() const
+{
+	const auto periods = m_periods.load(std::memory_order_relaxed);
+	return periods > 0 ? static_cast<float>(m_loadSum.load(std::memory_order_relaxed) / periods) : 0.f;
+}
+
+
+
+
+void LoadMeter::reset()
+{
+	m_worstLoad.store(0.f, std::memory_order_relaxed);
+	m_loadSum.store(0., std::memory_order_relaxed);
+	m_periods.store(0, std::memory_order_relaxed);
+}
+
+
+
+
+void LoadMeter::resetAll()
+{
+	const auto lock = std::lock_guard{s_metersMutex};
+	for (LoadMeter* meter = s_firstMeter; meter; meter = meter->m_next)
+	{
+		meter->reset();
+	}
+}
+
+
+
+
+LoadMeter::JobProbe::JobProbe(LoadMeter* meter) :
+	m_meter(meter),
+	m_parent(t_jobProbe)
+{
+	t_jobProbe = this;
+	if (!m_meter && !m_parent) { return; }
+
+	m_start = Clock::now();
+	if (m_parent && m_parent->m_meter)
+	{
+		m_parent->m_meter->addTime(m_start - m_parent->m_start);
+	}
+}
+
+
+
+
+LoadMeter::JobProbe::~JobProbe()
+{
+	t_jobProbe = m_parent;
+	if (!m_meter && !m_parent) { return; }
+
+	const auto end = Clock::now();
+	if (m_meter) { m_meter->addTime(end - m_start); }
+	// the outer job continues from here
+	if (m_parent) { m_parent->m_start = end; }
+}
+
+
+
+
+void LoadMeter::finishPeriod(std::uint64_t periodMicroseconds)
+{
+	auto lock = std::unique_lock{s_metersMutex, std::try_to_lock};
+	// the time stays with the meters and counts for the next period
+	if (!lock.owns_lock()) { return; }
+
+	const float nanosecondsToPercent = 100.f / (periodMicroseconds * 1000.f);
+	for (LoadMeter* meter = s_firstMeter; meter; meter = meter->m_next)
+	{
+		const auto time = meter->m_periodTime.exchange(0, std::memory_order_relaxed);
+		const float load = time * nanosecondsToPercent;
+
+		// averaged like the detail loads of the AudioEngineProfiler
+		const float average = meter->m_averageLoad.load(std::memory_order_relaxed);
+		meter->m_averageLoad.store(load * 0.05f + average * 0.95f, std::memory_order_relaxed);
+		meter->m_worstLoad.store(std::max(load, meter->m_worstLoad.load(std::memory_order_relaxed)),
+			std::memory_order_relaxed);
+		meter->m_loadSum.store(meter->m_loadSum.load(std::memory_order_relaxed) + load,
+			std::memory_order_relaxed);
+		meter->m_periods.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+
+} // namespace lmms
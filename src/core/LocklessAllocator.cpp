@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <new>
 
 #include "lmmsconfig.h"
 
@@ -52,11 +53,14 @@ static size_t align( size_t size, size_t alignment )
 
 
 
-LocklessAllocator::LocklessAllocator( size_t nmemb, size_t size )
+LocklessAllocator::LocklessAllocator( size_t nmemb, size_t size,
+							size_t alignment )
 {
+	m_alignment = std::max( alignment, sizeof( void * ) );
 	m_capacity = align( nmemb, SIZEOF_SET );
-	m_elementSize = align( size, sizeof( void * ) );
-	m_pool = new char[m_capacity * m_elementSize];
+	m_elementSize = align( size, m_alignment );
+	m_pool = static_cast<char *>( ::operator new[](
+		m_capacity * m_elementSize, std::align_val_t( m_alignment ) ) );
 
 	m_freeStateSets = m_capacity / SIZEOF_SET;
 	m_freeState = new std::atomic_int[m_freeStateSets];
@@ -77,7 +81,7 @@ LocklessAllocator::~LocklessAllocator()
 				"Destroying with elements still allocated\n" );
 	}
 
-	delete[] m_pool;
+	::operator delete[]( m_pool, std::align_val_t( m_alignment ) );
 	delete[] m_freeState;
 }
 
@@ -105,6 +109,19 @@ static int ffs( int i )
 
 
 void * LocklessAllocator::alloc()
+{
+	void * ptr = tryAlloc();
+	if( !ptr )
+	{
+		fprintf( stderr, "LocklessAllocator: No free space\n" );
+	}
+	return ptr;
+}
+
+
+
+
+void * LocklessAllocator::tryAlloc()
 {
 	// Some of these CAS loops could probably use relaxed atomics, as discussed
 	// in http://en.cppreference.com/w/cpp/atomic/atomic/compare_exchange.
@@ -114,7 +131,6 @@ void * LocklessAllocator::alloc()
 	{
 		if( !available )
 		{
-			fprintf( stderr, "LocklessAllocator: No free space\n" );
 			return nullptr;
 		}
 	}
@@ -23,6 +23,7 @@
  */
 
 #include <QDomElement>
+#include <algorithm>
 
 #include "AudioEngine.h"
 #include "AudioEngineWorkerThread.h"
@@ -62,14 +63,13 @@ MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_fxChain( nullptr ),
 	m_hasInput( false ),
 	m_stillRunning( false ),
-	m_peakLeft( 0.0f ),
-	m_peakRight( 0.0f ),
+	m_bufferSilent( true ),
+	m_tap(),
 	m_buffer( new SampleFrame[Engine::audioEngine()->framesPerPeriod()] ),
 	m_muteModel( false, _parent ),
 	m_soloModel( false, _parent ),
 	m_volumeModel(1.f, 0.f, 2.f, 0.001f, _parent),
 	m_name(),
-	m_lock(),
 	m_channelIndex( idx ),
 	m_queued( false ),
 	m_dependenciesMet(0)
@@ -99,8 +99,9 @@ inline void MixerChannel::processed()
 
 void MixerChannel::incrementDeps()
 {
+	// only the last sender to finish sees the full count
 	const auto i = m_dependenciesMet++ + 1;
-	if( i >= m_receives.size() && ! m_queued )
+	if( i == m_receives.size() && ! m_queued )
 	{
 		m_queued = true;
 		AudioEngineWorkerThread::addJob( this );
@@ -121,13 +122,27 @@ void MixerChannel::doProcessing()
 
 	if( m_muted == false )
 	{
+		// the first input is copied, silent buffers are not cleared before
+		for( const SampleFrame* input : m_inputs )
+		{
+			if( m_bufferSilent )
+			{
+				std::copy( input, input + fpp, m_buffer );
+				m_bufferSilent = false;
+			}
+			else
+			{
+				MixHelpers::add( m_buffer, input, fpp );
+			}
+		}
+
 		for( MixerRoute * senderRoute : m_receives )
 		{
 			MixerChannel * sender = senderRoute->sender();
 			FloatModel * sendModel = senderRoute->amount();
 			if( ! sendModel ) qFatal( "Error: no send model found from %d to %d", senderRoute->senderIndex(), m_channelIndex );
 
-			if( sender->m_hasInput || sender->m_stillRunning )
+			if( !sender->m_bufferSilent )
 			{
 				// figure out if we're getting sample-exact input
 				ValueBuffer * sendBuf = sendModel->valueBuffer();
@@ -157,6 +172,7 @@ void MixerChannel::doProcessing()
 					MixHelpers::addSanitizedMultipliedByBuffer( m_buffer, ch_buf, v, sendBuf, fpp );
 				}
 				m_hasInput = true;
+				m_bufferSilent = false;
 			}
 		}
 
@@ -169,15 +185,29 @@ void MixerChannel::doProcessing()
 			m_fxChain.startRunning();
 		}
 
-		m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
+		// without input, the effects only have to run until they decayed
+		if( m_hasInput || m_fxChain.isRunning() )
+		{
+			m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
+			m_bufferSilent = false;
+		}
+		else
+		{
+			m_stillRunning = false;
+		}
 
-		SampleFrame peakSamples = getAbsPeakValues(m_buffer, fpp);
-		m_peakLeft = std::max(m_peakLeft, peakSamples[0] * v);
-		m_peakRight = std::max(m_peakRight, peakSamples[1] * v);
+		if( m_bufferSilent )
+		{
+			m_tap.writeSilence(fpp);
+		}
+		else
+		{
+			m_tap.write(m_buffer, fpp, v);
+		}
 	}
 	else
 	{
-		m_peakLeft = m_peakRight = 0.0f;
+		m_tap.writeSilence(fpp);
 	}
 
 	// increment dependency counter of all receivers
@@ -194,6 +224,7 @@ Mixer::Mixer() :
 {
 	// create master channel
 	createChannel();
+	updateExecutionPlan();
 }
 
 
@@ -373,6 +404,7 @@ void Mixer::deleteChannel( int index )
 		}
 	}
 
+	updateExecutionPlan();
 	Engine::audioEngine()->doneChangeInModel();
 }
 
@@ -486,6 +518,7 @@ MixerRoute * Mixer::createRoute( MixerChannel * from, MixerChannel * to, float a
 
 	// add us to mixer's list
 	Engine::mixer()->m_mixerRoutes.push_back(route);
+	updateExecutionPlan();
 	Engine::audioEngine()->doneChangeInModel();
 
 	return route;
@@ -531,6 +564,7 @@ void Mixer::deleteChannelSend( MixerRoute * route )
 	removeFromMixerRoute(Engine::mixer()->m_mixerRoutes);
 
 	delete route;
+	updateExecutionPlan();
 	Engine::audioEngine()->doneChangeInModel();
 }
 
@@ -600,10 +634,9 @@ void Mixer::mixToChannel( const SampleFrame* _buf, mix_ch_t _ch )
 {
 	if( m_mixerChannels[_ch]->m_muteModel.value() == false )
 	{
-		m_mixerChannels[_ch]->m_lock.lock();
-		MixHelpers::add( m_mixerChannels[_ch]->m_buffer, _buf, Engine::audioEngine()->framesPerPeriod() );
-		m_mixerChannels[_ch]->m_hasInput = true;
-		m_mixerChannels[_ch]->m_lock.unlock();
+		MixerChannel * ch = m_mixerChannels[_ch];
+		ch->m_inputs.push_back( _buf );
+		ch->m_hasInput = true;
 	}
 }
 
@@ -612,7 +645,12 @@ void Mixer::mixToChannel( const SampleFrame* _buf, mix_ch_t _ch )
 
 void Mixer::prepareMasterMix()
 {
-	zeroSampleFrames(m_mixerChannels[0]->m_buffer, Engine::audioEngine()->framesPerPeriod());
+	MixerChannel * master = m_mixerChannels[0];
+	if( !master->m_bufferSilent )
+	{
+		zeroSampleFrames(master->m_buffer, Engine::audioEngine()->framesPerPeriod());
+		master->m_bufferSilent = true;
+	}
 }
 
 
@@ -621,17 +659,23 @@ void Mixer::masterMix( SampleFrame* _buf )
 {
 	const int fpp = Engine::audioEngine()->framesPerPeriod();
 
+	// the mute state decides whether a channel counts as dependency of its
+	// receivers, so it is updated for all channels before any gets processed
+	for( MixerChannel * ch : m_executionOrder )
+	{
+		ch->m_muted = ch->m_muteModel.value();
+	}
+
 	// add the channels that have no dependencies (no incoming senders, ie.
 	// no receives) to the jobqueue. The channels that have receives get
-	// added when their senders get processed, which is detected by
-	// dependency counting.
+	// added by the last of their senders to finish, which is detected by
+	// dependency counting, so one dispatch processes the whole graph.
 	// also instantly add all muted channels as they don't need to care
 	// about their senders, and can just increment the deps of their
 	// recipients right away.
 	AudioEngineWorkerThread::resetJobQueue( AudioEngineWorkerThread::JobQueue::OperationMode::Dynamic );
-	for( MixerChannel * ch : m_mixerChannels )
+	for( MixerChannel * ch : m_executionOrder )
 	{
-		ch->m_muted = ch->m_muteModel.value();
 		if( ch->m_muted ) // instantly "process" muted channels
 		{
 			ch->processed();
@@ -643,50 +687,42 @@ void Mixer::masterMix( SampleFrame* _buf )
 			AudioEngineWorkerThread::addJob( ch );
 		}
 	}
-	while (m_mixerChannels[0]->state() != ThreadableJob::ProcessingState::Done)
+	AudioEngineWorkerThread::startAndWaitForJobs();
+
+	// the output buffer is already cleared, so a silent master can be skipped
+	if( !m_mixerChannels[0]->m_bufferSilent )
 	{
-		bool found = false;
-		for( MixerChannel * ch : m_mixerChannels )
+		// handle sample-exact data in master volume fader
+		ValueBuffer * volBuf = m_mixerChannels[0]->m_volumeModel.valueBuffer();
+
+		if( volBuf )
 		{
-			const auto s = ch->state();
-			if (s == ThreadableJob::ProcessingState::Queued
-				|| s == ThreadableJob::ProcessingState::InProgress)
+			for( int f = 0; f < fpp; f++ )
 			{
-				found = true;
-				break;
+				m_mixerChannels[0]->m_buffer[f][0] *= volBuf->values()[f];
+				m_mixerChannels[0]->m_buffer[f][1] *= volBuf->values()[f];
 			}
 		}
-		if( !found )
-		{
-			break;
-		}
-		AudioEngineWorkerThread::startAndWaitForJobs();
-	}
-
-	// handle sample-exact data in master volume fader
-	ValueBuffer * volBuf = m_mixerChannels[0]->m_volumeModel.valueBuffer();
 
-	if( volBuf )
-	{
-		for( int f = 0; f < fpp; f++ )
-		{
-			m_mixerChannels[0]->m_buffer[f][0] *= volBuf->values()[f];
-			m_mixerChannels[0]->m_buffer[f][1] *= volBuf->values()[f];
-		}
+		const float v = volBuf
+			? 1.0f
+			: m_mixerChannels[0]->m_volumeModel.value();
+		MixHelpers::addSanitizedMultiplied( _buf, m_mixerChannels[0]->m_buffer, v, fpp );
 	}
 
-	const float v = volBuf
-		? 1.0f
-		: m_mixerChannels[0]->m_volumeModel.value();
-	MixHelpers::addSanitizedMultiplied( _buf, m_mixerChannels[0]->m_buffer, v, fpp );
-
-	// clear all channel buffers and
+	// clear the channel buffers which were used and
 	// reset channel process state
 	for( int i = 0; i < numChannels(); ++i)
 	{
-		zeroSampleFrames(m_mixerChannels[i]->m_buffer, Engine::audioEngine()->framesPerPeriod());
+		if( !m_mixerChannels[i]->m_bufferSilent )
+		{
+			zeroSampleFrames(m_mixerChannels[i]->m_buffer, Engine::audioEngine()->framesPerPeriod());
+			m_mixerChannels[i]->m_bufferSilent = true;
+		}
 		m_mixerChannels[i]->reset();
 		m_mixerChannels[i]->m_queued = false;
+		// keeps the capacity, so that mixToChannel() doesn't allocate
+		m_mixerChannels[i]->m_inputs.clear();
 		// also reset hasInput
 		m_mixerChannels[i]->m_hasInput = false;
 		m_mixerChannels[i]->m_dependenciesMet = 0;
@@ -771,6 +807,34 @@ void Mixer::saveSettings( QDomDocument & _doc, QDomElement & _this )
 	}
 }
 
+void Mixer::updateExecutionPlan()
+{
+	// Kahn's algorithm: a channel is appended once all its senders are
+	m_executionOrder.clear();
+	m_executionOrder.reserve( m_mixerChannels.size() );
+
+	auto pendingSenders = std::vector<std::size_t>( m_mixerChannels.size() );
+	for( MixerChannel * ch : m_mixerChannels )
+	{
+		pendingSenders[ch->m_channelIndex] = ch->m_receives.size();
+		if( ch->m_receives.empty() )
+		{
+			m_executionOrder.push_back( ch );
+		}
+	}
+
+	for( std::size_t i = 0; i < m_executionOrder.size(); ++i )
+	{
+		for( const MixerRoute * route : m_executionOrder[i]->m_sends )
+		{
+			if( --pendingSenders[route->receiverIndex()] == 0 )
+			{
+				m_executionOrder.push_back( route->receiver() );
+			}
+		}
+	}
+}
+
 // make sure we have at least num channels
 void Mixer::allocateChannelsTo(int num)
 {
@@ -27,6 +27,8 @@
 namespace lmms
 {
 
+std::atomic<unsigned> Model::s_totalChangeCount = 0;
+
 Model::Model(Model* parent, QString displayName, bool defaultConstructed) :
 	QObject(parent),
 	m_displayName(displayName),
@@ -183,6 +183,15 @@ int NotePlayHandle::midiKey() const
 
 
 
+LoadMeter* NotePlayHandle::loadMeter()
+{
+	Instrument* instrument = m_instrumentTrack->instrument();
+	return instrument ? &instrument->loadMeter() : nullptr;
+}
+
+
+
+
 void NotePlayHandle::play( SampleFrame* _working_buffer )
 {
 	if (m_muted)
@@ -0,0 +1,192 @@
+/*
+ * ProjectLoader.cpp - decodes the resources of a project in the background
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ProjectLoader.h"
+
+#include <QDomNamedNodeMap>
+#include <QFileInfo>
+
+#include "AutomationClip.h"
+#include "PathUtil.h"
+#include "SampleBuffer.h"
+#include "SampleDecoder.h"
+#include "ThreadPool.h"
+
+namespace lmms
+{
+
+
+ProjectLoader* ProjectLoader::s_current = nullptr;
+
+namespace
+{
+
+// Filled while the plugin libraries are loaded, before any project
+std::map<QString, ProjectLoader::BankLoader>& bankLoaders()
+{
+	static std::map<QString, ProjectLoader::BankLoader> loaders;
+	return loaders;
+}
+
+} // namespace
+
+
+
+
+ProjectLoader::ProjectLoader(const QDomElement& content) :
+	m_finishedTasks(std::make_shared<std::atomic<std::size_t>>(0))
+{
+	for (const auto& audioType : SampleDecoder::supportedAudioTypes())
+	{
+		// DrumSynth renders into global state and can't run concurrently
+		if (audioType.extension == "ds") { continue; }
+		m_extensions.insert(QString::fromStdString(audioType.extension));
+	}
+
+	scan(content);
+
+	s_current = this;
+}
+
+
+
+
+ProjectLoader::~ProjectLoader()
+{
+	// tasks which are still running only hold on to their own results
+	s_current = nullptr;
+}
+
+
+
+
+std::shared_ptr<const SampleBuffer> ProjectLoader::sample(const QString& audioFile) const
+{
+	const auto it = m_samples.find(PathUtil::toAbsolute(audioFile));
+	return it != m_samples.end() ? it->second.get() : nullptr;
+}
+
+
+
+
+void ProjectLoader::scan(const QDomElement& element)
+{
+	if (element.tagName() == "object" && element.parentNode().nodeName() == AutomationClip::classNodeName())
+	{
+		m_automatedIds.insert(element.attribute("id"));
+	}
+
+	const QDomNamedNodeMap attributes = element.attributes();
+	for (int i = 0; i < attributes.count(); ++i)
+	{
+		const QDomAttr attribute = attributes.item(i).toAttr();
+		if (attribute.name() == "src" || attribute.name().startsWith("userwavefile"))
+		{
+			prefetchSample(attribute.value());
+		}
+	}
+
+	for (auto child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement())
+	{
+		scan(child);
+	}
+}
+
+
+
+
+void ProjectLoader::registerBankLoader(const QString& extension, BankLoader loader)
+{
+	bankLoaders()[extension] = std::move(loader);
+}
+
+
+
+
+void ProjectLoader::prefetchSample(const QString& audioFile)
+{
+	if (audioFile.isEmpty()) { return; }
+
+	const QString absolutePath = PathUtil::toAbsolute(audioFile);
+	const QString extension = QFileInfo(absolutePath).suffix().toLower();
+	if (const auto bankLoader = bankLoaders().find(extension); bankLoader != bankLoaders().end())
+	{
+		prefetchBank(absolutePath, bankLoader->second);
+		return;
+	}
+
+	if (m_samples.count(absolutePath) > 0 || m_extensions.count(extension) == 0)
+	{
+		return;
+	}
+
+	auto task = [absolutePath, finishedTasks = m_finishedTasks]() -> std::shared_ptr<const SampleBuffer>
+	{
+		std::shared_ptr<const SampleBuffer> buffer;
+		if (QFileInfo::exists(absolutePath))
+		{
+			try
+			{
+				buffer = std::make_shared<SampleBuffer>(absolutePath);
+			}
+			catch (const std::exception&)
+			{
+				// decoded again and reported on the main thread when the project asks for it
+			}
+		}
+		finishedTasks->fetch_add(1, std::memory_order_relaxed);
+		return buffer;
+	};
+
+	m_samples.emplace(absolutePath, ThreadPool::instance().enqueue(std::move(task)).share());
+}
+
+
+
+
+void ProjectLoader::prefetchBank(const QString& absolutePath, const BankLoader& loader)
+{
+	if (m_banks.count(absolutePath) > 0) { return; }
+
+	auto task = [absolutePath, loader, finishedTasks = m_finishedTasks]() -> std::shared_ptr<void>
+	{
+		std::shared_ptr<void> bank;
+		if (QFileInfo::exists(absolutePath))
+		{
+			try
+			{
+				bank = loader(absolutePath);
+			}
+			catch (...)
+			{
+				// the instrument opens it again and reports the error
+			}
+		}
+		finishedTasks->fetch_add(1, std::memory_order_relaxed);
+		return bank;
+	};
+
+	m_banks.emplace(absolutePath, ThreadPool::instance().enqueue(std::move(task)).share());
+}
+
+
+} // namespace lmms
@@ -0,0 +1,84 @@
+/*
+ * RandomStream.cpp - seeded random number streams of the render jobs
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "RandomStream.h"
+
+#include <atomic>
+#include <random>
+
+namespace lmms
+{
+
+namespace
+{
+
+std::uint64_t randomSeed()
+{
+	std::random_device device;
+	return (static_cast<std::uint64_t>(device()) << 32) | device();
+}
+
+std::atomic<std::uint64_t> s_seed{randomSeed()};
+// Incremented by setSeed(), so that the threads reseed their default streams
+std::atomic<unsigned> s_generation{0};
+
+} // namespace
+
+
+
+
+#ifdef LMMS_BUILD_WIN32
+RandomStream*& RandomStream::currentStream()
+{
+	thread_local RandomStream* stream = nullptr;
+	return stream;
+}
+#endif
+
+
+
+
+RandomStream& RandomStream::defaultStream()
+{
+	thread_local unsigned generation = s_generation.load(std::memory_order_acquire);
+	thread_local RandomStream stream(s_seed.load(std::memory_order_relaxed));
+
+	const unsigned currentGeneration = s_generation.load(std::memory_order_acquire);
+	if (generation != currentGeneration)
+	{
+		generation = currentGeneration;
+		stream = RandomStream(s_seed.load(std::memory_order_relaxed));
+	}
+	return stream;
+}
+
+
+
+
+void RandomStream::setSeed(std::uint64_t seed)
+{
+	s_seed.store(seed, std::memory_order_relaxed);
+	s_generation.fetch_add(1, std::memory_order_release);
+}
+
+
+} // namespace lmms
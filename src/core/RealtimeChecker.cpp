@@ -0,0 +1,288 @@
+/*
+ * RealtimeChecker.cpp - detects allocations and locks on the render threads
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "RealtimeChecker.h"
+
+#ifdef LMMS_DEBUG_REALTIME
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <QMutex>
+#endif
+
+
+#ifdef LMMS_DEBUG_REALTIME
+
+namespace lmms
+{
+
+namespace
+{
+
+enum class Violation
+{
+	Allocation,
+	Deallocation,
+	Lock
+};
+
+// Accessed from within malloc(), so they must not need any allocation themselves
+__attribute__((tls_model("initial-exec"))) thread_local bool t_rendering = false;
+// Set while a violation is being recorded, so that the allocations and locks
+// of backtrace() don't count
+__attribute__((tls_model("initial-exec"))) thread_local bool t_recording = false;
+
+std::atomic<std::uint64_t> s_allocations{0};
+std::atomic<std::uint64_t> s_deallocations{0};
+std::atomic<std::uint64_t> s_locks{0};
+
+constexpr std::size_t MaxTraces = 512;
+constexpr int MaxFrames = 32;
+// recordTrace() and record() themselves
+constexpr int SkippedFrames = 2;
+
+struct Trace
+{
+	std::atomic<std::size_t> hash{0};
+	std::atomic<bool> ready{false};
+	std::atomic<std::uint64_t> count{0};
+	Violation violation;
+	int frameCount;
+	void* frames[MaxFrames];
+};
+
+// Distinct stack traces of all violations, as a fixed-size hash table so
+// that recording them doesn't allocate
+std::array<Trace, MaxTraces> s_traces;
+std::atomic<std::uint64_t> s_droppedTraces{0};
+
+
+void recordTrace(Violation violation)
+{
+	void* frames[MaxFrames];
+	const int frameCount = backtrace(frames, MaxFrames);
+
+	std::size_t hash = static_cast<std::size_t>(violation) + 1;
+	for (int i = 0; i < frameCount; ++i)
+	{
+		hash = hash * 31 + reinterpret_cast<std::size_t>(frames[i]);
+	}
+	hash = std::max<std::size_t>(hash, 1);
+
+	for (std::size_t i = 0; i < MaxTraces; ++i)
+	{
+		Trace& trace = s_traces[(hash + i) % MaxTraces];
+
+		std::size_t expected = 0;
+		if (trace.hash.compare_exchange_strong(expected, hash, std::memory_order_acq_rel))
+		{
+			trace.violation = violation;
+			trace.frameCount = frameCount;
+			std::copy_n(frames, frameCount, trace.frames);
+			trace.ready.store(true, std::memory_order_release);
+		}
+		else if (expected != hash)
+		{
+			continue;
+		}
+
+		trace.count.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	s_droppedTraces.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void record(Violation violation)
+{
+	if (!t_rendering || t_recording) { return; }
+	t_recording = true;
+
+	switch (violation)
+	{
+		case Violation::Allocation: s_allocations.fetch_add(1, std::memory_order_relaxed); break;
+		case Violation::Deallocation: s_deallocations.fetch_add(1, std::memory_order_relaxed); break;
+		case Violation::Lock: s_locks.fetch_add(1, std::memory_order_relaxed); break;
+	}
+	recordTrace(violation);
+
+	t_recording = false;
+}
+
+
+template<typename F>
+F realFunction(std::atomic<F>& cache, const char* name)
+{
+	F function = cache.load(std::memory_order_relaxed);
+	if (!function)
+	{
+		function = reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+		cache.store(function, std::memory_order_relaxed);
+	}
+	return function;
+}
+
+
+//! Writes the recorded traces to stderr when LMMS exits
+struct TraceReporter
+{
+	~TraceReporter()
+	{
+		static const char* const names[] = {"Allocation", "Deallocation", "Lock"};
+
+		for (const auto& trace : s_traces)
+		{
+			if (!trace.ready.load(std::memory_order_acquire)) { continue; }
+
+			std::fprintf(stderr, "\n%s on render thread, %llu times:\n",
+				names[static_cast<int>(trace.violation)],
+				static_cast<unsigned long long>(trace.count.load(std::memory_order_relaxed)));
+			std::fflush(stderr);
+			const int skipped = std::min(trace.frameCount, SkippedFrames);
+			backtrace_symbols_fd(trace.frames + skipped, trace.frameCount - skipped, STDERR_FILENO);
+		}
+
+		if (const auto dropped = s_droppedTraces.load(std::memory_order_relaxed))
+		{
+			std::fprintf(stderr, "\n%llu violations with further stack traces not shown\n",
+				static_cast<unsigned long long>(dropped));
+		}
+	}
+} s_traceReporter;
+
+} // namespace
+
+
+
+
+RealtimeChecker::Scope::Scope() :
+	m_wasRendering(t_rendering)
+{
+	t_rendering = true;
+}
+
+
+
+
+RealtimeChecker::Scope::~Scope()
+{
+	t_rendering = m_wasRendering;
+}
+
+
+
+
+RealtimeChecker::Counts RealtimeChecker::takeCounts()
+{
+	Counts counts;
+	counts.allocations = s_allocations.exchange(0, std::memory_order_relaxed);
+	counts.deallocations = s_deallocations.exchange(0, std::memory_order_relaxed);
+	counts.locks = s_locks.exchange(0, std::memory_order_relaxed);
+	return counts;
+}
+
+
+} // namespace lmms
+
+
+
+
+// These replace the functions of glibc for the whole process. The hooks only
+// do something on threads inside a RealtimeChecker::Scope.
+extern "C"
+{
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(std::size_t size) noexcept
+{
+	lmms::record(lmms::Violation::Allocation);
+	return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept
+{
+	lmms::record(lmms::Violation::Allocation);
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, std::size_t size) noexcept
+{
+	lmms::record(lmms::Violation::Allocation);
+	return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept
+{
+	if (ptr) { lmms::record(lmms::Violation::Deallocation); }
+	__libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+{
+	static std::atomic<int (*)(pthread_mutex_t*)> real{nullptr};
+
+	lmms::record(lmms::Violation::Lock);
+	return lmms::realFunction(real, "pthread_mutex_lock")(mutex);
+}
+
+} // extern "C"
+
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+// Qt 5 mutexes are futex based and don't go through pthread_mutex_lock(). Their
+// lock() isn't inline though (QMutexLocker calls it as well), so this definition
+// takes the place of the one of QtCore for LMMS and its plugins.
+void QMutex::lock() QT_MUTEX_LOCK_NOEXCEPT
+{
+	static std::atomic<void (*)(QMutex*)> real{nullptr};
+
+	lmms::record(lmms::Violation::Lock);
+	lmms::realFunction(real, "_ZN6QMutex4lockEv")(this);
+}
+#endif
+
+
+#else // LMMS_DEBUG_REALTIME
+
+namespace lmms
+{
+
+RealtimeChecker::Counts RealtimeChecker::takeCounts()
+{
+	return {};
+}
+
+} // namespace lmms
+
+#endif // LMMS_DEBUG_REALTIME
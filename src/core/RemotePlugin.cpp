@@ -35,6 +35,7 @@
 
 #include "BufferManager.h"
 #include "AudioEngine.h"
+#include "ConfigManager.h"
 #include "Engine.h"
 #include "Song.h"
 
@@ -142,8 +143,12 @@ RemotePlugin::RemotePlugin() :
 #if (QT_VERSION < QT_VERSION_CHECK(5,14,0))
 	m_commMutex(QMutex::Recursive),
 #endif
-	m_splitChannels( false ),
 	m_audioBufferSize( 0 ),
+	m_audioSyncEnabled( false ),
+	m_pipelined( ConfigManager::inst()->value( "audioengine", "pipelinedremoteplugins" ).toInt() ),
+	m_wasPipelined( false ),
+	m_pipelineStart( 0 ),
+	m_periodsRequested( 0 ),
 	m_inputCount( DEFAULT_CHANNELS ),
 	m_outputCount( DEFAULT_CHANNELS )
 {
@@ -184,6 +189,15 @@ RemotePlugin::RemotePlugin() :
 		Qt::DirectConnection );
 	connect( &m_process, SIGNAL(finished(int,QProcess::ExitStatus)),
 		&m_watcher, SLOT(quit()), Qt::DirectConnection );
+
+	connect( ConfigManager::inst(), &ConfigManager::valueChanged, this,
+		[this]( const QString & cls, const QString & attribute, const QString & value )
+		{
+			if( cls == "audioengine" && attribute == "pipelinedremoteplugins" )
+			{
+				setPipelined( value.toInt() );
+			}
+		}, Qt::DirectConnection );
 }
 
 
@@ -312,6 +326,7 @@ bool RemotePlugin::init(const QString &pluginExecutable,
 
 	sendMessage(message(IdSyncKey).addString(Engine::getSong()->syncKey()));
 	resizeSharedProcessingMemory();
+	setupAudioSync();
 
 	if( waitForInitDoneMsg )
 	{
@@ -357,43 +372,95 @@ bool RemotePlugin::process( const SampleFrame* _in_buf, SampleFrame* _out_buf )
 		return false;
 	}
 
-	memset( m_audioBuffer.get(), 0, m_audioBufferSize );
-
-	ch_cnt_t inputs = std::min<ch_cnt_t>(m_inputCount, DEFAULT_CHANNELS);
-
-	if( _in_buf != nullptr && inputs > 0 )
+	const bool pipelined = isPipelined();
+	if( pipelined )
 	{
-		if( m_splitChannels )
+		// other threads keep the lock while they wait for replies of the
+		// remote process, so rather drop this period than wait for them
+		if( !tryLock() )
 		{
-			for( ch_cnt_t ch = 0; ch < inputs; ++ch )
+			if( _out_buf != nullptr )
 			{
-				for( fpp_t frame = 0; frame < frames; ++frame )
-				{
-					m_audioBuffer[ch * frames + frame] =
-							_in_buf[frame][ch];
-				}
+				zeroSampleFrames(_out_buf, frames);
 			}
+			return true;
+		}
+	}
+	else
+	{
+		lock();
+	}
+
+	// without the shared counter, messages are handled while waiting for
+	// IdProcessingDone; otherwise handle e.g. changed channel counts here
+	// before touching the buffers, but only if the remote process sent some
+	if( m_audioSyncEnabled && m_audioSync->takeMessagesSent() )
+	{
+		fetchAndProcessAllMessages();
+	}
+
+	if( m_failed || !m_audioBuffer )
+	{
+		unlock();
+		if( _out_buf != nullptr )
+		{
+			zeroSampleFrames(_out_buf, frames);
+		}
+		return false;
+	}
+
+	if( pipelined != m_wasPipelined )
+	{
+		m_wasPipelined = pipelined;
+		m_pipelineStart = m_periodsRequested;
+	}
+
+	if( pipelined && static_cast<std::int32_t>( m_periodsRequested - m_audioSync->completedPeriods() ) >= 2 )
+	{
+		// the remote process is still busy with both buffers, so
+		// drop this period instead of blocking the audio engine
+		unlock();
+		if( _out_buf != nullptr )
+		{
+			zeroSampleFrames(_out_buf, frames);
 		}
-		else if( inputs == DEFAULT_CHANNELS )
+		return true;
+	}
+
+	// with the shared counter, consecutive periods alternate between two
+	// buffers, so that a pipelined period is never overwritten by the next one
+	const std::size_t slotSize = audioSlotSize( m_inputCount, m_outputCount, frames );
+	const std::size_t outputOffset = m_inputCount > 0 ? DEFAULT_CHANNELS * frames : 0;
+	const int slot = m_periodsRequested % 2;
+	float* const buffer = m_audioBuffer.get() + slot * slotSize;
+
+	if( m_inputCount > 0 )
+	{
+		if( _in_buf != nullptr )
 		{
-			auto target = m_audioBuffer.get();
-			copyFromSampleFrames(target, _in_buf, frames);
+			copyFromSampleFrames(buffer, _in_buf, frames);
 		}
 		else
 		{
-			auto o = (SampleFrame*)m_audioBuffer.get();
-			for( ch_cnt_t ch = 0; ch < inputs; ++ch )
-			{
-				for( fpp_t frame = 0; frame < frames; ++frame )
-				{
-					o[frame][ch] = _in_buf[frame][ch];
-				}
-			}
+			memset( buffer, 0, DEFAULT_CHANNELS * frames * sizeof( float ) );
 		}
 	}
 
-	lock();
-	sendMessage( IdStartProcessing );
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+	if( m_audioSyncEnabled )
+	{
+		// the remote process waits on the doorbell in the sync block, so
+		// starting a period doesn't go through the message channel
+		m_audioSync->startPeriod();
+		++m_periodsRequested;
+	}
+	else
+#endif
+	{
+		sendMessage( message( IdStartProcessing )
+				.addInt( slot )
+				.addInt( false ) );
+	}
 
 	if( m_failed || _out_buf == nullptr || m_outputCount == 0 )
 	{
@@ -401,44 +468,54 @@ bool RemotePlugin::process( const SampleFrame* _in_buf, SampleFrame* _out_buf )
 		return false;
 	}
 
-	waitForMessage( IdProcessingDone );
-	unlock();
-
-	const ch_cnt_t outputs = std::min<ch_cnt_t>(m_outputCount,
-							DEFAULT_CHANNELS);
-	if( m_splitChannels )
+	const float* output = buffer + outputOffset;
+	if( pipelined )
 	{
-		for( ch_cnt_t ch = 0; ch < outputs; ++ch )
+		// output of the previous period, if the remote process finished it in time
+		const auto pending = static_cast<std::int32_t>( m_periodsRequested - m_audioSync->completedPeriods() );
+		if( m_periodsRequested - m_pipelineStart < 2 || pending > 1 )
 		{
-			for( fpp_t frame = 0; frame < frames; ++frame )
-			{
-				_out_buf[frame][ch] = m_audioBuffer[( m_inputCount+ch )*
-								frames + frame];
-			}
+			unlock();
+			zeroSampleFrames(_out_buf, frames);
+			return true;
 		}
+		output = m_audioBuffer.get() + ( 1 - slot ) * slotSize + outputOffset;
 	}
-	else if( outputs == DEFAULT_CHANNELS )
-	{
-		auto source = m_audioBuffer.get() + m_inputCount * frames;
-		copyToSampleFrames(_out_buf, source, frames);
-	}
-	else
+	else if( !waitForProcessingDone() )
 	{
-		auto o = (SampleFrame*)(m_audioBuffer.get() + m_inputCount * frames);
-		// clear buffer, if plugin didn't fill up both channels
+		unlock();
 		zeroSampleFrames(_out_buf, frames);
+		return false;
+	}
+
+	// messages handled by other threads may replace the buffer, so only
+	// release it after reading the output
+	copyToSampleFrames(_out_buf, output, frames);
+	unlock();
+
+	return true;
+}
+
 
-		for (ch_cnt_t ch = 0; ch <
-				std::min<int>(DEFAULT_CHANNELS, outputs); ++ch)
+
+
+bool RemotePlugin::waitForProcessingDone()
+{
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+	if( m_audioSyncEnabled )
+	{
+		// wake up regularly to notice a crashed remote process
+		while( !m_audioSync->waitForCompleted( m_periodsRequested, 100 ) )
 		{
-			for( fpp_t frame = 0; frame < frames; ++frame )
+			if( isInvalid() || !isRunning() )
 			{
-				_out_buf[frame][ch] = o[frame][ch];
+				return false;
 			}
 		}
+		return true;
 	}
-
-	return true;
+#endif
+	return waitForMessage( IdProcessingDone ).id == IdProcessingDone;
 }
 
 
@@ -477,10 +554,11 @@ void RemotePlugin::hideUI()
 
 void RemotePlugin::resizeSharedProcessingMemory()
 {
-	const size_t s = (m_inputCount + m_outputCount) * Engine::audioEngine()->framesPerPeriod();
+	const size_t s = audioSlotSize(m_inputCount, m_outputCount, Engine::audioEngine()->framesPerPeriod());
 	try
 	{
-		m_audioBuffer.create(QUuid::createUuid().toString().toStdString(), s);
+		// two periods for double buffering in pipelined mode
+		m_audioBuffer.create(QUuid::createUuid().toString().toStdString(), 2 * s);
 	}
 	catch (const std::runtime_error& error)
 	{
@@ -495,6 +573,47 @@ void RemotePlugin::resizeSharedProcessingMemory()
 
 
 
+void RemotePlugin::setupAudioSync()
+{
+	m_audioSyncEnabled = false;
+	m_wasPipelined = false;
+	m_periodsRequested = 0;
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+	try
+	{
+		m_audioSync.create(QUuid::createUuid().toString().toStdString());
+	}
+	catch (const std::runtime_error& error)
+	{
+		qWarning() << "Failed to allocate shared audio sync data:" << error.what();
+		m_audioSync.detach();
+		return;
+	}
+	*m_audioSync = RemotePluginAudioSync{};
+	// the remote process answers if it supports the sync block, otherwise we
+	// stick to IdStartProcessing and IdProcessingDone messages. This is the
+	// first message counted in the block, the remote process counts from it.
+	sendMessage(message(IdChangeAudioSyncKey).addString(m_audioSync.key()));
+#endif
+}
+
+
+
+
+void RemotePlugin::messageSent()
+{
+#ifdef LMMS_HAVE_REMOTE_AUDIO_SYNC
+	// the remote process waits on the doorbell instead of the message channel
+	if( m_audioSync )
+	{
+		m_audioSync->signalHostMessage();
+	}
+#endif
+}
+
+
+
+
 void RemotePlugin::processFinished( int exitCode,
 					QProcess::ExitStatus exitStatus )
 {
@@ -560,6 +679,10 @@ bool RemotePlugin::processMessage( const message & _m )
 			resizeSharedProcessingMemory();
 			break;
 
+		case IdChangeAudioSyncKey:
+			m_audioSyncEnabled = static_cast<bool>(m_audioSync);
+			break;
+
 		case IdDebugMessage:
 			fprintf( stderr, "RemotePlugin::DebugMessage: %s",
 						_m.getString( 0 ).c_str() );
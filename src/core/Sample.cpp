@@ -26,10 +26,68 @@
 
 #include "lmms_math.h"
 
+#include <array>
 #include <cassert>
 
 namespace lmms {
 
+//! Walks through the frames of the buffer in playback order, with the
+//! playback points read once for a whole period
+struct Sample::Cursor
+{
+	Cursor(const Sample& sample, Loop loopMode)
+		: data(sample.m_buffer->data())
+		, size(static_cast<int>(sample.m_buffer->size()))
+		, endFrame(std::min(sample.endFrame(), size))
+		, loopStartFrame(std::max(sample.loopStartFrame(), 0))
+		, loopEndFrame(std::min(sample.loopEndFrame(), size))
+		, reversed(sample.reversed())
+		, loopMode(loopEndFrame > loopStartFrame ? loopMode : Loop::Off)
+	{
+	}
+
+	//! Moves the index back into the loop. Returns false when it is past the end of a sample that doesn't loop.
+	auto wrap() -> bool
+	{
+		switch (loopMode)
+		{
+		case Loop::Off:
+			return index >= 0 && index < endFrame;
+		case Loop::On:
+			if (index < loopStartFrame && backwards) { index = loopEndFrame - 1; }
+			else if (index >= loopEndFrame) { index = loopStartFrame; }
+			break;
+		case Loop::PingPong:
+			if (index < loopStartFrame && backwards)
+			{
+				index = loopStartFrame;
+				backwards = false;
+			}
+			else if (index >= loopEndFrame)
+			{
+				index = loopEndFrame - 1;
+				backwards = true;
+			}
+			break;
+		}
+		return index >= 0 && index < size;
+	}
+
+	void step() { backwards ? --index : ++index; }
+
+	auto frame() const -> const SampleFrame& { return data[reversed ? size - index - 1 : index]; }
+
+	const SampleFrame* data;
+	int size;
+	int endFrame;
+	int loopStartFrame;
+	int loopEndFrame;
+	bool reversed;
+	Loop loopMode;
+	int index = 0;
+	bool backwards = false;
+};
+
 Sample::Sample(const QString& audioFile)
 	: m_buffer(std::make_shared<SampleBuffer>(audioFile))
 	, m_startFrame(0)
@@ -123,35 +181,28 @@ bool Sample::play(SampleFrame* dst, PlaybackState* state, size_t numFrames, floa
 	assert(numFrames > 0);
 	assert(desiredFrequency > 0);
 
-	const auto pastBounds = state->m_frameIndex >= m_endFrame || (state->m_frameIndex < 0 && state->m_backwards);
-	if (loopMode == Loop::Off && pastBounds) { return false; }
+	auto cursor = Cursor{*this, loopMode};
+	const auto pastBounds = state->m_frameIndex >= cursor.endFrame || (state->m_frameIndex < 0 && state->m_backwards);
+	if (cursor.loopMode == Loop::Off && pastBounds) { return false; }
 
 	const auto outputSampleRate = Engine::audioEngine()->outputSampleRate() * m_frequency / desiredFrequency;
 	const auto inputSampleRate = m_buffer->sampleRate();
-	const auto resampleRatio = outputSampleRate / inputSampleRate;
-	const auto marginSize = s_interpolationMargins[state->resampler().interpolationMode()];
+	auto resampleRatio = static_cast<double>(outputSampleRate) / inputSampleRate;
+	if (approximatelyEqual(resampleRatio, 1.0f)) { resampleRatio = 1.0; }
 
 	state->m_frameIndex = std::max<int>(m_startFrame, state->m_frameIndex);
+	cursor.index = state->m_frameIndex;
+	cursor.backwards = state->m_backwards;
 
-	auto playBuffer = std::vector<SampleFrame>(numFrames / resampleRatio + marginSize);
-	playRaw(playBuffer.data(), playBuffer.size(), state, loopMode);
-
-	state->resampler().setRatio(resampleRatio);
-
-	const auto resampleResult
-		= state->resampler().resample(&playBuffer[0][0], playBuffer.size(), &dst[0][0], numFrames, resampleRatio);
-	advance(state, resampleResult.inputFramesUsed, loopMode);
-
-	const auto outputFrames = static_cast<f_cnt_t>(resampleResult.outputFramesGenerated);
-	if (outputFrames < numFrames) { std::fill_n(dst + outputFrames, numFrames - outputFrames, SampleFrame{}); }
-
-	if (!approximatelyEqual(m_amplification, 1.0f))
+	// libsamplerate is only used for the sinc modes, and once it has been fed it holds back some
+	// input, so playback has to stay with it
+	if (state->m_resampler && (resampleRatio != 1.0 || state->m_resamplerActive))
 	{
-		for (auto i = std::size_t{0}; i < numFrames; ++i)
-		{
-			dst[i][0] *= m_amplification;
-			dst[i][1] *= m_amplification;
-		}
+		playResampled(dst, state, cursor, numFrames, resampleRatio);
+	}
+	else
+	{
+		playNative(dst, state, cursor, numFrames, 1.0 / resampleRatio);
 	}
 
 	return true;
@@ -172,81 +223,98 @@ void Sample::setAllPointFrames(int startFrame, int endFrame, int loopStartFrame,
 	setLoopEndFrame(loopEndFrame);
 }
 
-void Sample::playRaw(SampleFrame* dst, size_t numFrames, const PlaybackState* state, Loop loopMode) const
+void Sample::playNative(SampleFrame* dst, PlaybackState* state, Cursor& cursor, size_t numFrames, double step) const
 {
-	if (m_buffer->size() < 1) { return; }
+	const auto gain = amplification();
+	const auto interpolate = state->m_interpolationMode == SRC_LINEAR && (step != 1.0 || state->m_fraction != 0.0);
+	auto fraction = state->m_fraction;
 
-	auto index = state->m_frameIndex;
-	auto backwards = state->m_backwards;
-
-	for (size_t i = 0; i < numFrames; ++i)
+	auto i = size_t{0};
+	for (; i < numFrames && cursor.wrap(); ++i)
 	{
-		switch (loopMode)
+		if (interpolate)
 		{
-		case Loop::Off:
-			if (index < 0 || index >= m_endFrame) { return; }
-			break;
-		case Loop::On:
-			if (index < m_loopStartFrame && backwards) { index = m_loopEndFrame - 1; }
-			else if (index >= m_loopEndFrame) { index = m_loopStartFrame; }
-			break;
-		case Loop::PingPong:
-			if (index < m_loopStartFrame && backwards)
-			{
-				index = m_loopStartFrame;
-				backwards = false;
-			}
-			else if (index >= m_loopEndFrame)
-			{
-				index = m_loopEndFrame - 1;
-				backwards = true;
-			}
-			break;
-		default:
-			break;
+			auto next = cursor;
+			next.step();
+			const auto nextFrame = next.wrap() ? next.frame() : SampleFrame{};
+			dst[i] = (cursor.frame() * static_cast<float>(1.0 - fraction) + nextFrame * static_cast<float>(fraction))
+				* gain;
 		}
+		else { dst[i] = cursor.frame() * gain; }
 
-		dst[i] = m_buffer->data()[m_reversed ? m_buffer->size() - index - 1 : index];
-		backwards ? --index : ++index;
+		fraction += step;
+		const auto wholeFrames = static_cast<int>(fraction);
+		fraction -= wholeFrames;
+		for (auto frame = 0; frame < wholeFrames; ++frame)
+		{
+			// The index is wrapped again at the beginning of the next output frame
+			if (frame > 0 && !cursor.wrap()) { break; }
+			cursor.step();
+		}
 	}
+	std::fill(dst + i, dst + numFrames, SampleFrame{});
+
+	state->m_frameIndex = cursor.index;
+	state->m_backwards = cursor.backwards;
+	state->m_fraction = fraction;
 }
 
-void Sample::advance(PlaybackState* state, size_t advanceAmount, Loop loopMode) const
+void Sample::playResampled(
+	SampleFrame* dst, PlaybackState* state, Cursor& cursor, size_t numFrames, double resampleRatio) const
 {
-	state->m_frameIndex += (state->m_backwards ? -1 : 1) * advanceAmount;
-	if (loopMode == Loop::Off) { return; }
+	const auto marginSize = static_cast<size_t>(s_interpolationMargins[state->m_interpolationMode]);
+	auto& resampler = *state->m_resampler;
+	resampler.setRatio(resampleRatio);
+	state->m_resamplerActive = true;
 
-	const auto distanceFromLoopStart = std::abs(state->m_frameIndex - m_loopStartFrame);
-	const auto distanceFromLoopEnd = std::abs(state->m_frameIndex - m_loopEndFrame);
-	const auto loopSize = m_loopEndFrame - m_loopStartFrame;
-	if (loopSize == 0) { return; }
+	// The input is fed to libsamplerate in chunks, so that playing doesn't need any allocation
+	std::array<SampleFrame, 256> input;
 
-	switch (loopMode)
+	auto outputFrames = size_t{0};
+	while (outputFrames < numFrames)
 	{
-	case Loop::On:
-		if (state->m_frameIndex < m_loopStartFrame && state->m_backwards)
-		{
-			state->m_frameIndex = m_loopEndFrame - 1 - distanceFromLoopStart % loopSize;
-		}
-		else if (state->m_frameIndex >= m_loopEndFrame)
+		const auto wanted = static_cast<size_t>((numFrames - outputFrames) / resampleRatio) + marginSize;
+		const auto inputFrames = std::min(wanted, input.size());
+
+		playRaw(input.data(), inputFrames, cursor);
+
+		const auto result = resampler.resample(&input[0][0], inputFrames, &dst[outputFrames][0],
+			numFrames - outputFrames, resampleRatio);
+		for (auto frame = long{0}; frame < result.inputFramesUsed && cursor.wrap(); ++frame)
 		{
-			state->m_frameIndex = m_loopStartFrame + distanceFromLoopEnd % loopSize;
+			cursor.step();
 		}
-		break;
-	case Loop::PingPong:
-		if (state->m_frameIndex < m_loopStartFrame && state->m_backwards)
+		outputFrames += result.outputFramesGenerated;
+
+		if (result.error != 0 || (result.inputFramesUsed == 0 && result.outputFramesGenerated == 0)) { break; }
+	}
+	std::fill(dst + outputFrames, dst + numFrames, SampleFrame{});
+
+	state->m_frameIndex = cursor.index;
+	state->m_backwards = cursor.backwards;
+
+	const auto gain = amplification();
+	if (!approximatelyEqual(gain, 1.0f))
+	{
+		for (auto i = std::size_t{0}; i < outputFrames; ++i)
 		{
-			state->m_frameIndex = m_loopStartFrame + distanceFromLoopStart % loopSize;
-			state->m_backwards = false;
+			dst[i] *= gain;
 		}
-		else if (state->m_frameIndex >= m_loopEndFrame)
+	}
+}
+
+void Sample::playRaw(SampleFrame* dst, size_t numFrames, Cursor cursor) const
+{
+	for (size_t i = 0; i < numFrames; ++i)
+	{
+		if (!cursor.wrap())
 		{
-			state->m_frameIndex = m_loopEndFrame - 1 - distanceFromLoopEnd % loopSize;
-			state->m_backwards = true;
+			std::fill(dst + i, dst + numFrames, SampleFrame{});
+			return;
 		}
-		break;
-	default:
-		break;
+
+		dst[i] = cursor.frame();
+		cursor.step();
 	}
 }
 
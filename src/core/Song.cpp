@@ -32,6 +32,12 @@
 #include <algorithm>
 #include <cmath>
 
+#include "lmmsconfig.h"
+
+#ifdef LMMS_BUILD_LINUX
+#include <unistd.h>
+#endif
+
 #include "AutomationTrack.h"
 #include "AutomationEditor.h"
 #include "ConfigManager.h"
@@ -51,6 +57,7 @@
 #include "PatternTrack.h"
 #include "PianoRoll.h"
 #include "ProjectJournal.h"
+#include "ProjectLoader.h"
 #include "ProjectNotes.h"
 #include "Scale.h"
 #include "SongEditor.h"
@@ -63,6 +70,33 @@ namespace lmms
 
 tick_t TimePos::s_ticksPerBar = DefaultTicksPerBar;
 
+namespace
+{
+
+//! How far ahead of the play position deferred instruments are instantiated
+constexpr int DeferredInstrumentLookaheadBars = 2;
+//! How long a track must have been muted before its instrument may be deferred again
+constexpr qint64 DeferredInstrumentIdleTime = 30000;
+
+//! Resident memory of the process in bytes, 0 if unknown
+qint64 residentMemory()
+{
+#ifdef LMMS_BUILD_LINUX
+	QFile statm("/proc/self/statm");
+	if (statm.open(QIODevice::ReadOnly))
+	{
+		const QList<QByteArray> fields = statm.readAll().split(' ');
+		if (fields.size() > 1)
+		{
+			return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+		}
+	}
+#endif
+	return 0;
+}
+
+} // namespace
+
 
 
 Song::Song() :
@@ -113,6 +147,9 @@ Song::Song() :
 
 	connect( &m_masterVolumeModel, SIGNAL(dataChanged()),
 			this, SLOT(masterVolumeChanged()), Qt::DirectConnection );
+
+	m_deferredInstrumentsTimer.setInterval(250);
+	connect(&m_deferredInstrumentsTimer, SIGNAL(timeout()), this, SLOT(updateDeferredInstruments()));
 /*	connect( &m_masterPitchModel, SIGNAL(dataChanged()),
 			this, SLOT(masterPitchChanged()));*/
 
@@ -1069,6 +1106,9 @@ void Song::loadProject( const QString & fileName )
 
 	clearErrors();
 
+	// start decoding samples while the tracks are being created
+	ProjectLoader loader( dataFile.content() );
+
 	Engine::audioEngine()->requestChangeInModel();
 
 	// get the header information from the DOM
@@ -1221,6 +1261,15 @@ void Song::loadProject( const QString & fileName )
 	updateLength();
 	setModified(false);
 	m_loadOnLaunch = false;
+
+	if (ConfigManager::inst()->value("app", "lazyinstruments").toInt())
+	{
+		m_deferredInstrumentsTimer.start();
+	}
+	else
+	{
+		m_deferredInstrumentsTimer.stop();
+	}
 }
 
 
@@ -1421,6 +1470,42 @@ void Song::updateFramesPerTick()
 
 
 
+void Song::updateDeferredInstruments()
+{
+	const TimePos begin = getPlayPos(PlayMode::Song);
+	const TimePos end = begin + ticksPerBar() * DeferredInstrumentLookaheadBars;
+
+	const qint64 memoryCap = ConfigManager::inst()->value("app", "lazyinstrumentsmemorycap").toLongLong() * 1024 * 1024;
+	bool overMemoryCap = memoryCap > 0 && residentMemory() > memoryCap;
+
+	for (Track* track : tracks())
+	{
+		auto instrumentTrack = dynamic_cast<InstrumentTrack*>(track);
+		if (!instrumentTrack) { continue; }
+
+		if (instrumentTrack->isInstrumentDeferred())
+		{
+			if (instrumentTrack->isMuted()) { continue; }
+
+			Track::clipVector clips;
+			instrumentTrack->getClipsInRange(clips, begin, end);
+			if (std::any_of(clips.begin(), clips.end(), [](const Clip* clip) { return !clip->isMuted(); }))
+			{
+				instrumentTrack->instantiateDeferredInstrument();
+			}
+		}
+		else if (overMemoryCap && instrumentTrack->mutedFor() >= DeferredInstrumentIdleTime
+			&& instrumentTrack->deferInstrument())
+		{
+			// one at a time, the memory is measured again on the next update
+			overMemoryCap = false;
+		}
+	}
+}
+
+
+
+
 void Song::setModified()
 {
 	setModified(true);
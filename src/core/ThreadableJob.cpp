@@ -0,0 +1,37 @@
+/*
+ * ThreadableJob.cpp - creation order of the render jobs
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ThreadableJob.h"
+
+namespace lmms
+{
+
+
+std::uint64_t ThreadableJob::nextCreationIndex()
+{
+	// kept out of the header, so that jobs created by plugins count here too
+	static std::atomic<std::uint64_t> s_creationIndex{0};
+	return s_creationIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+} // namespace lmms
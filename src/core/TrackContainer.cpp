@@ -35,6 +35,7 @@
 #include "PatternClip.h"
 #include "PatternStore.h"
 #include "PatternTrack.h"
+#include "ProjectLoader.h"
 #include "Song.h"
 
 #include "GuiApplication.h"
@@ -135,8 +136,15 @@ void TrackContainer::loadSettings( const QDomElement & _this )
 						node.firstChild().toElement().attribute( "name" );
 			if( pd != nullptr )
 			{
-				pd->setLabelText( tr("Loading Track %1 (%2/Total %3)").arg( trackName ).
-						  arg( pd->value() + 1 ).arg( Engine::getSong()->getLoadingTrackCount() ) );
+				QString label = tr("Loading Track %1 (%2/Total %3)").arg( trackName ).
+						  arg( pd->value() + 1 ).arg( Engine::getSong()->getLoadingTrackCount() );
+				const ProjectLoader* loader = ProjectLoader::current();
+				if( loader != nullptr && loader->taskCount() > 0 )
+				{
+					label += "\n" + tr( "Loaded %1 of %2 files" ).
+						arg( loader->finishedTaskCount() ).arg( loader->taskCount() );
+				}
+				pd->setLabelText( label );
 			}
 			Track::create( node.toElement(), this );
 		}
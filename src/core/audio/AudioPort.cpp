@@ -23,6 +23,9 @@
  */
 
 #include "AudioPort.h"
+
+#include <algorithm>
+
 #include "AudioDevice.h"
 #include "AudioEngine.h"
 #include "EffectChain.h"
@@ -39,6 +42,8 @@ AudioPort::AudioPort( const QString & _name, bool _has_effect_chain,
 		BoolModel * mutedModel ) :
 	m_bufferUsage( false ),
 	m_portBuffer( BufferManager::acquire() ),
+	m_portBufferSilent( true ),
+	m_hasOutput( false ),
 	m_extOutputEnabled( false ),
 	m_nextMixerChannel( 0 ),
 	m_name( "unnamed port" ),
@@ -105,16 +110,17 @@ bool AudioPort::processEffects()
 
 void AudioPort::doProcessing()
 {
+	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
+
 	if( m_mutedModel && m_mutedModel->value() )
 	{
+		// the output of the previous period must not reach the mixer again
+		m_hasOutput = false;
+		m_bufferUsage = false;
+		m_tap.writeSilence( fpp );
 		return;
 	}
 
-	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
-
-	// clear the buffer
-	zeroSampleFrames(m_portBuffer, fpp);
-
 	//qDebug( "Playhandles: %d", m_playHandles.size() );
 	for( PlayHandle * ph : m_playHandles ) // now we mix all playhandle buffers into the audioport buffer
 	{
@@ -124,8 +130,17 @@ void AudioPort::doProcessing()
 				&& ( ph->type() == PlayHandle::Type::NotePlayHandle
 					|| !MixHelpers::isSilent( ph->buffer(), fpp ) ) )
 			{
-				m_bufferUsage = true;
-				MixHelpers::add( m_portBuffer, ph->buffer(), fpp );
+				// the first buffer is copied, so the port buffer never has to be cleared before
+				if( m_bufferUsage )
+				{
+					MixHelpers::add( m_portBuffer, ph->buffer(), fpp );
+				}
+				else
+				{
+					std::copy( ph->buffer(), ph->buffer() + fpp, m_portBuffer );
+					m_bufferUsage = true;
+					m_portBufferSilent = false;
+				}
 			}
 			ph->releaseBuffer(); 	// gets rid of playhandle's buffer and sets
 									// pointer to null, so if it doesn't get re-acquired we know to skip it next time
@@ -220,21 +235,41 @@ void AudioPort::doProcessing()
 	// as of now there's no situation where we only have panning model but no volume model
 	// if we have neither, we don't have to do anything here - just pass the audio as is
 
-	// handle effects
-	const bool me = processEffects();
-	if( me || m_bufferUsage )
+	// handle effects - without input they only have to run while some
+	// effect has not yet decayed, and then on a silent buffer
+	bool me = false;
+	if( m_bufferUsage || ( m_effects && m_effects->isRunning() ) )
 	{
-		Engine::mixer()->mixToChannel( m_portBuffer, m_nextMixerChannel ); 	// send output to mixer
-																			// TODO: improve the flow here - convert to pull model
-		m_bufferUsage = false;
+		if( !m_bufferUsage && !m_portBufferSilent )
+		{
+			zeroSampleFrames( m_portBuffer, fpp );
+		}
+		me = processEffects();
+		m_portBufferSilent = false;
+	}
+
+	// the AudioEngine hands the output to the mixer after all ports are done
+	m_hasOutput = me || m_bufferUsage;
+	if( m_hasOutput )
+	{
+		m_tap.write( m_portBuffer, fpp );
+	}
+	else
+	{
+		m_tap.writeSilence( fpp );
 	}
+	m_bufferUsage = false;
 }
 
 
 void AudioPort::addPlayHandle( PlayHandle * handle )
 {
+	// Play handles can be added from several worker threads at once, so they
+	// are kept sorted to mix them in the same order in every render
 	m_playHandleLock.lock();
-		m_playHandles.append( handle );
+		const auto it = std::upper_bound( m_playHandles.begin(), m_playHandles.end(), handle,
+			[]( const PlayHandle* a, const PlayHandle* b ) { return a->orderKey() < b->orderKey(); } );
+		m_playHandles.insert( it, handle );
 	m_playHandleLock.unlock();
 }
 
@@ -27,12 +27,100 @@
 #include "fft_helpers.h"
 
 #include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "ConfigManager.h"
 #include "lmms_constants.h"
 
 namespace lmms
 {
 
 
+namespace
+{
+
+struct PlanKey
+{
+	bool inverse;
+	unsigned int size;
+	unsigned int channels;
+	int inAlignment;
+	int outAlignment;
+
+	bool operator<(const PlanKey& other) const
+	{
+		return std::tie(inverse, size, channels, inAlignment, outAlignment)
+			< std::tie(other.inverse, other.size, other.channels, other.inAlignment, other.outAlignment);
+	}
+};
+
+// the FFTW planner is not thread-safe, so all planning goes through here
+std::mutex s_plannerMutex;
+std::map<PlanKey, fftwf_plan> s_plans;
+std::string s_wisdomFile;
+
+// enough to reproduce any SIMD alignment FFTW cares about
+constexpr std::size_t MaxAlignment = 64;
+
+fftwf_plan cachedPlan(const PlanKey& key)
+{
+	const auto lock = std::lock_guard{s_plannerMutex};
+
+	const auto it = s_plans.find(key);
+	if (it != s_plans.end()) { return it->second; }
+
+	if (s_wisdomFile.empty())
+	{
+		s_wisdomFile = ConfigManager::inst()->fftwWisdomFile().toStdString();
+		fftwf_import_wisdom_from_filename(s_wisdomFile.c_str());
+	}
+
+	// measuring overwrites the buffers, so plan on scratch buffers that are
+	// aligned like the caller's ones
+	const int n = static_cast<int>(key.size);
+	const int bins = n / 2 + 1;
+	const std::size_t realBytes = key.size * key.channels * sizeof(float);
+	const std::size_t complexBytes = bins * key.channels * sizeof(fftwf_complex);
+	auto realScratch = static_cast<char*>(fftwf_malloc(realBytes + MaxAlignment));
+	auto complexScratch = static_cast<char*>(fftwf_malloc(complexBytes + MaxAlignment));
+	auto real = reinterpret_cast<float*>(realScratch + (key.inverse ? key.outAlignment : key.inAlignment));
+	auto complex = reinterpret_cast<fftwf_complex*>(complexScratch + (key.inverse ? key.inAlignment : key.outAlignment));
+
+	const auto channels = static_cast<int>(key.channels);
+	const fftwf_plan plan = key.inverse
+		? fftwf_plan_many_dft_c2r(1, &n, channels, complex, nullptr, 1, bins, real, nullptr, 1, n, FFTW_MEASURE)
+		: fftwf_plan_many_dft_r2c(1, &n, channels, real, nullptr, 1, n, complex, nullptr, 1, bins, FFTW_MEASURE);
+
+	fftwf_free(realScratch);
+	fftwf_free(complexScratch);
+
+	s_plans.emplace(key, plan);
+	// new wisdom is rare, so just save it right away
+	fftwf_export_wisdom_to_filename(s_wisdomFile.c_str());
+	return plan;
+}
+
+} // namespace
+
+
+fftwf_plan fftPlanR2C(unsigned int size, const float* in, const fftwf_complex* out, unsigned int channels)
+{
+	return cachedPlan({false, size, channels,
+		fftwf_alignment_of(const_cast<float*>(in)),
+		fftwf_alignment_of(reinterpret_cast<float*>(const_cast<fftwf_complex*>(out)))});
+}
+
+
+fftwf_plan fftPlanC2R(unsigned int size, const fftwf_complex* in, const float* out, unsigned int channels)
+{
+	return cachedPlan({true, size, channels,
+		fftwf_alignment_of(reinterpret_cast<float*>(const_cast<fftwf_complex*>(in))),
+		fftwf_alignment_of(const_cast<float*>(out))});
+}
+
+
 /* Returns biggest value from abs_spectrum[spec_size] array.
  *
  * return -1 on error, otherwise the maximum value
@@ -29,6 +29,7 @@
 
 #include "denormals.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QFileInfo>
 #include <QLocale>
@@ -56,20 +57,32 @@
 #endif
 
 #include <csignal>
+#include <optional>
+#include <sndfile.h>
+#include <vector>
 
 #include "MainApplication.h"
 #include "ConfigManager.h"
 #include "DataFile.h"
+#include "Effect.h"
+#include "EffectChain.h"
 #include "NotePlayHandle.h"
 #include "embed.h"
 #include "Engine.h"
 #include "GuiApplication.h"
 #include "ImportFilter.h"
+#include "Instrument.h"
+#include "InstrumentTrack.h"
+#include "LoadMeter.h"
 #include "MainWindow.h"
+#include "Mixer.h"
 #include "MixHelpers.h"
 #include "OutputSettings.h"
+#include "PatternStore.h"
 #include "ProjectRenderer.h"
+#include "RandomStream.h"
 #include "RenderManager.h"
+#include "SampleTrack.h"
 #include "Song.h"
 
 #ifdef LMMS_DEBUG_FPE
@@ -211,7 +224,15 @@ void printHelp()
 		"  -s, --samplerate <samplerate>  Specify output samplerate in Hz\n"
 		"          Range: 44100 (default) to 192000\n"
 		"          Possible values: 1, 2, 4, 8\n"
-		"          Default: 2\n\n",
+		"          Default: 2\n"
+		"      --load-report              Print the CPU load of every instrument,\n"
+		"          effect and mixer channel after rendering\n"
+		"      --seed <seed>              Seed the random number generators, so that\n"
+		"          rendering the project again gives the same output\n"
+		"      --verify <file>            Compare the render of \"render\" with <file>\n"
+		"          and fail if they differ. <file> is either an audio file or\n"
+		"          contains the hash of one, and is created with the hash if it\n"
+		"          doesn't exist. Implies --seed 0 if no seed is given.\n\n",
 		LMMS_VERSION, LMMS_PROJECT_COPYRIGHT );
 }
 
@@ -249,6 +270,123 @@ int noInputFileError()
 }
 
 
+//! Return the SHA-256 of the samples of an audio file as hex string, or an
+//! empty one if it can't be read. Only the samples are hashed, as headers
+//! may contain timestamps.
+QByteArray audioHash( const QString& file )
+{
+	SF_INFO info{};
+	SNDFILE* sndFile = sf_open( file.toLocal8Bit().constData(), SFM_READ, &info );
+	if( !sndFile )
+	{
+		return {};
+	}
+
+	constexpr sf_count_t FramesPerRead = 4096;
+	auto buffer = std::vector<float>( FramesPerRead * info.channels );
+	QCryptographicHash hash( QCryptographicHash::Sha256 );
+	sf_count_t frames;
+	while( ( frames = sf_readf_float( sndFile, buffer.data(), FramesPerRead ) ) > 0 )
+	{
+		hash.addData( reinterpret_cast<const char*>( buffer.data() ),
+				static_cast<int>( frames * info.channels * sizeof( float ) ) );
+	}
+	sf_close( sndFile );
+
+	return hash.result().toHex();
+}
+
+
+//! Print the load of the instruments, effects and mixer channels during the
+//! render, see --load-report
+void printLoadReport()
+{
+	using namespace lmms;
+
+	const auto printLoad = []( const QString& name, const LoadMeter& meter )
+	{
+		printf( "%7.2f %7.2f  %s\n", meter.meanLoad(), meter.worstLoad(), name.toUtf8().constData() );
+	};
+	const auto printEffects = [&printLoad]( const QString& owner, const EffectChain* chain )
+	{
+		for( Effect* effect : chain->effects() )
+		{
+			printLoad( owner + " > " + effect->displayName(), effect->loadMeter() );
+		}
+	};
+
+	printf( "\nCPU load in %% of the period:\n   mean   worst\n" );
+	for( const auto& tracks : { Engine::getSong()->tracks(), Engine::patternStore()->tracks() } )
+	{
+		for( Track* track : tracks )
+		{
+			if( auto instrumentTrack = dynamic_cast<InstrumentTrack*>( track ) )
+			{
+				if( Instrument* instrument = instrumentTrack->instrument() )
+				{
+					printLoad( track->name() + " > " + instrument->displayName(), instrument->loadMeter() );
+				}
+				printEffects( track->name(), instrumentTrack->audioPort()->effects() );
+			}
+			else if( auto sampleTrack = dynamic_cast<SampleTrack*>( track ) )
+			{
+				printEffects( track->name(), sampleTrack->audioPort()->effects() );
+			}
+		}
+	}
+
+	for( mix_ch_t i = 0; i < Engine::mixer()->numChannels(); ++i )
+	{
+		MixerChannel* channel = Engine::mixer()->mixerChannel( i );
+		const QString name = QString( "Mixer %1: %2" ).arg( i ).arg( channel->m_name );
+		printLoad( name, channel->m_loadMeter );
+		printEffects( name, &channel->m_fxChain );
+	}
+}
+
+
+//! Compare a render with a golden audio file or a file with its hash, see --verify
+bool verifyRender( const QString& renderOut, const QString& reference )
+{
+	const QByteArray renderHash = audioHash( renderOut );
+	if( renderHash.isEmpty() )
+	{
+		printf( "Could not read the render %s\n", renderOut.toUtf8().constData() );
+		return false;
+	}
+	printf( "Render hash: %s\n", renderHash.constData() );
+
+	QFile referenceFile( reference );
+	if( !referenceFile.exists() )
+	{
+		if( !referenceFile.open( QIODevice::WriteOnly ) )
+		{
+			printf( "Could not create %s\n", reference.toUtf8().constData() );
+			return false;
+		}
+		referenceFile.write( renderHash + '\n' );
+		printf( "Stored the hash in %s\n", reference.toUtf8().constData() );
+		return true;
+	}
+
+	// A golden render, or a file with its hash
+	QByteArray referenceHash = audioHash( reference );
+	if( referenceHash.isEmpty() && referenceFile.open( QIODevice::ReadOnly ) )
+	{
+		referenceHash = referenceFile.readAll().trimmed().split( ' ' ).first().toLower();
+	}
+
+	if( referenceHash != renderHash )
+	{
+		printf( "The render differs from %s (hash %s)\n", reference.toUtf8().constData(),
+				referenceHash.constData() );
+		return false;
+	}
+	printf( "The render matches %s\n", reference.toUtf8().constData() );
+	return true;
+}
+
+
 int main( int argc, char * * argv )
 {
 	using namespace lmms;
@@ -259,7 +397,9 @@ int main( int argc, char * * argv )
 	bool allowRoot = false;
 	bool renderLoop = false;
 	bool renderTracks = false;
-	QString fileToLoad, fileToImport, renderOut, profilerOutputFile, configFile;
+	bool loadReport = false;
+	QString fileToLoad, fileToImport, renderOut, profilerOutputFile, configFile, verifyFile;
+	std::optional<std::uint64_t> seed;
 
 	// first of two command-line parsing stages
 	for (int i = 1; i < argc; ++i)
@@ -682,6 +822,37 @@ int main( int argc, char * * argv )
 
 			profilerOutputFile = QString::fromLocal8Bit( argv[i] );
 		}
+		else if( arg == "--load-report" )
+		{
+			loadReport = true;
+		}
+		else if( arg == "--seed" )
+		{
+			++i;
+
+			if( i == argc )
+			{
+				return usageError( "No seed specified" );
+			}
+
+			bool ok;
+			seed = QString( argv[i] ).toULongLong( &ok );
+			if( !ok )
+			{
+				return usageError( QString( "Invalid seed %1" ).arg( argv[i] ) );
+			}
+		}
+		else if( arg == "--verify" )
+		{
+			++i;
+
+			if( i == argc )
+			{
+				return usageError( "No file to verify against specified" );
+			}
+
+			verifyFile = QString::fromLocal8Bit( argv[i] );
+		}
 		else if( arg == "--config" || arg == "-c" )
 		{
 			++i;
@@ -703,6 +874,26 @@ int main( int argc, char * * argv )
 		}
 	}
 
+	if( !verifyFile.isEmpty() )
+	{
+		if( !coreOnly || renderTracks )
+		{
+			return usageError( "--verify can only be used with \"render\"" );
+		}
+		if( !seed )
+		{
+			seed = 0;
+		}
+	}
+
+	if( seed )
+	{
+		// Noise of plugins which still use rand() is only reproducible
+		// as long as their jobs aren't processed in parallel
+		RandomStream::setSeed( *seed );
+		srand( static_cast<unsigned>( *seed ) );
+	}
+
 	// Test file argument before continuing
 	if( !fileToLoad.isEmpty() )
 	{
@@ -781,6 +972,8 @@ int main( int argc, char * * argv )
 
 		// create renderer
 		auto r = new RenderManager(qs, os, eff, renderOut);
+		// only count the periods of the render
+		LoadMeter::resetAll();
 		QCoreApplication::instance()->connect( r,
 				SIGNAL(finished()), SLOT(quit()));
 
@@ -960,9 +1153,14 @@ int main( int argc, char * * argv )
 		}
 	}
 
-	const int ret = app->exec();
+	int ret = app->exec();
 	delete app;
 
+	if( loadReport && coreOnly )
+	{
+		printLoadReport();
+	}
+
 	if( destroyEngine )
 	{
 		Engine::destroy();
@@ -974,6 +1172,11 @@ int main( int argc, char * * argv )
 		printf( "\n" );
 	}
 
+	if( !verifyFile.isEmpty() && ret == EXIT_SUCCESS && !verifyRender( renderOut, verifyFile ) )
+	{
+		ret = EXIT_FAILURE;
+	}
+
 #ifdef LMMS_BUILD_WIN32
 	// Cleanup console
 	HWND hConsole = GetConsoleWindow();
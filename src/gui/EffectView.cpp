@@ -37,6 +37,7 @@
 #include "gui_templates.h"
 #include "Knob.h"
 #include "LedCheckBox.h"
+#include "LoadIndicator.h"
 #include "MainWindow.h"
 #include "SubWindow.h"
 #include "TempoSyncKnob.h"
@@ -85,6 +86,10 @@ EffectView::EffectView( Effect * _model, QWidget * _parent ) :
 	m_gate->setHintText( tr( "Gate:" ), "" );
 
 
+	m_loadIndicator = new LoadIndicator( &_model->loadMeter(), this );
+	m_loadIndicator->setGeometry( 150, 2, 50, 11 );
+
+
 	setModel( _model );
 
 	if( effect()->controls()->controlCount() > 0 )
@@ -279,6 +284,7 @@ void EffectView::modelChanged()
 	m_wetDry->setModel( &effect()->m_wetDryModel );
 	m_autoQuit->setModel( &effect()->m_autoQuitModel );
 	m_gate->setModel( &effect()->m_gateModel );
+	m_loadIndicator->setMeter( &effect()->loadMeter() );
 }
 
 } // namespace lmms::gui
@@ -45,6 +45,7 @@
 #include "FileDialog.h"
 #include "Metronome.h"
 #include "MixerView.h"
+#include "ModelView.h"
 #include "GuiApplication.h"
 #include "ImportFilter.h"
 #include "InstrumentTrackView.h"
@@ -1354,6 +1355,7 @@ void MainWindow::keyReleaseEvent( QKeyEvent * _ke )
 
 void MainWindow::timerEvent( QTimerEvent * _te)
 {
+	ModelView::updateChangedViews();
 	emit periodicUpdate();
 }
 
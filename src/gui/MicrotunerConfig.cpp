@@ -94,7 +94,7 @@ MicrotunerConfig::MicrotunerConfig() :
 	auto scaleCombo = new ComboBox();
 	scaleCombo->setModel(&m_scaleComboModel);
 	microtunerLayout->addWidget(scaleCombo, 1, 0, 1, 2);
-	connect(&m_scaleComboModel, &ComboBoxModel::dataChanged, [=] {updateScaleForm();});
+	ModelView::connectChanges(&m_scaleComboModel, this, [this] { updateScaleForm(); });
 
 	m_scaleNameEdit = new QLineEdit("12-TET");
 	m_scaleNameEdit->setToolTip(tr("Scale description. Cannot start with \"!\" and cannot contain a newline character."));
@@ -132,7 +132,7 @@ MicrotunerConfig::MicrotunerConfig() :
 	auto keymapCombo = new ComboBox();
 	keymapCombo->setModel(&m_keymapComboModel);
 	microtunerLayout->addWidget(keymapCombo, 1, 2, 1, 2);
-	connect(&m_keymapComboModel, &ComboBoxModel::dataChanged, [=] {updateKeymapForm();});
+	ModelView::connectChanges(&m_keymapComboModel, this, [this] { updateKeymapForm(); });
 
 	m_keymapNameEdit = new QLineEdit("default");
 	m_keymapNameEdit->setToolTip(tr("Keymap description. Cannot start with \"!\" and cannot contain a newline character."));
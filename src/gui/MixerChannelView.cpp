@@ -25,6 +25,7 @@
 #include "CaptionMenu.h"
 #include "ColorChooser.h"
 #include "GuiApplication.h"
+#include "LoadIndicator.h"
 #include "Mixer.h"
 #include "MixerChannelView.h"
 #include "MixerView.h"
@@ -125,6 +126,8 @@ namespace lmms::gui
         m_peakIndicator = new PeakIndicator(this);
         connect(m_fader, &Fader::peakChanged, m_peakIndicator, &PeakIndicator::updatePeak);
 
+        m_loadIndicator = new LoadIndicator(&mixerChannel->m_loadMeter, this);
+
         m_effectRackView = new EffectRackView{&mixerChannel->m_fxChain, mixerView->m_racksWidget};
         m_effectRackView->setFixedWidth(EffectRackView::DEFAULT_WIDTH);
 
@@ -138,6 +141,7 @@ namespace lmms::gui
         mainLayout->addWidget(m_renameLineEditView, 0, Qt::AlignHCenter);
         mainLayout->addLayout(soloMuteLayout, 0);
         mainLayout->addWidget(m_peakIndicator);
+        mainLayout->addWidget(m_loadIndicator);
         mainLayout->addWidget(m_fader, 1, Qt::AlignHCenter);
 
         connect(m_renameLineEdit, &QLineEdit::editingFinished, this, &MixerChannelView::renameFinished);
@@ -279,6 +283,7 @@ namespace lmms::gui
         m_muteButton->setModel(&mixerChannel->m_muteModel);
         m_soloButton->setModel(&mixerChannel->m_soloModel);
         m_effectRackView->setModel(&mixerChannel->m_fxChain);
+        m_loadIndicator->setMeter(&mixerChannel->m_loadMeter);
         m_channelNumberLcd->setValue(index);
         m_channelIndex = index;
     }
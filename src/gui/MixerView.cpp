@@ -314,7 +314,8 @@ void MixerView::connectToSoloAndMute(int channelIndex)
 {
 	auto * mixerChannel = getMixer()->mixerChannel(channelIndex);
 
-	connect(&mixerChannel->m_muteModel, &BoolModel::dataChanged, this, &MixerView::toggledMute, Qt::DirectConnection);
+	// solo changes the mute state of other channels right away, muting only needs a repaint
+	connectChanges(&mixerChannel->m_muteModel, this, [this] { toggledMute(); });
 	connect(&mixerChannel->m_soloModel, &BoolModel::dataChanged, this, &MixerView::toggledSolo, Qt::DirectConnection);
 }
 
@@ -322,7 +323,7 @@ void MixerView::disconnectFromSoloAndMute(int channelIndex)
 {
 	auto * mixerChannel = getMixer()->mixerChannel(channelIndex);
 
-	disconnect(&mixerChannel->m_muteModel, &BoolModel::dataChanged, this, &MixerView::toggledMute);
+	mixerChannel->m_muteModel.disconnect(this);
 	disconnect(&mixerChannel->m_soloModel, &BoolModel::dataChanged, this, &MixerView::toggledSolo);
 }
 
@@ -561,27 +562,14 @@ void MixerView::updateFaders()
 		const float opl = m_mixerChannelViews[i]->m_fader->getPeak_L();
 		const float opr = m_mixerChannelViews[i]->m_fader->getPeak_R();
 		const float fallOff = 1.25;
-		if (m->mixerChannel(i)->m_peakLeft >= opl/fallOff)
-		{
-			m_mixerChannelViews[i]->m_fader->setPeak_L(m->mixerChannel(i)->m_peakLeft);
-			// Set to -1 so later we'll know if this value has been refreshed yet.
-			m->mixerChannel(i)->m_peakLeft = -1;
-		}
-		else if (m->mixerChannel(i)->m_peakLeft != -1)
-		{
-			m_mixerChannelViews[i]->m_fader->setPeak_L(opl/fallOff);
-		}
 
-		if (m->mixerChannel(i)->m_peakRight >= opr/fallOff)
-		{
-			m_mixerChannelViews[i]->m_fader->setPeak_R(m->mixerChannel(i)->m_peakRight);
-			// Set to -1 so later we'll know if this value has been refreshed yet.
-			m->mixerChannel(i)->m_peakRight = -1;
-		}
-		else if (m->mixerChannel(i)->m_peakRight != -1)
-		{
-			m_mixerChannelViews[i]->m_fader->setPeak_R(opr/fallOff);
-		}
+		// the tap holds the peak of the last ~20 ms, so reading it never races with the audio thread
+		const AudioTap& tap = m->mixerChannel(i)->m_tap;
+		const float peakLeft = tap.peak(0);
+		const float peakRight = tap.peak(1);
+
+		m_mixerChannelViews[i]->m_fader->setPeak_L(std::max(peakLeft, opl / fallOff));
+		m_mixerChannelViews[i]->m_fader->setPeak_R(std::max(peakRight, opr / fallOff));
 	}
 }
 
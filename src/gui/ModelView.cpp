@@ -22,6 +22,13 @@
  *
  */
 
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QThread>
 #include <QWidget>
 
 #include "ModelView.h"
@@ -29,11 +36,41 @@
 namespace lmms::gui
 {
 
+namespace
+{
+
+std::unordered_set<ModelView*> s_views;
+unsigned s_totalChangeCount = 0;
+
+struct PolledConnection
+{
+	Model* model;
+	std::function<void()> slot;
+	unsigned changeCount;
+};
+
+// The Qt connection owns the only strong reference, so an entry expires when
+// the connection is gone
+std::vector<std::weak_ptr<PolledConnection>> s_polledConnections;
+std::size_t s_polledConnectionsPruneSize = 64;
+
+void pruneExpiredConnections()
+{
+	s_polledConnections.erase( std::remove_if( s_polledConnections.begin(), s_polledConnections.end(),
+		[]( const std::weak_ptr<PolledConnection>& connection ) { return connection.expired(); } ),
+		s_polledConnections.end() );
+}
+
+} // namespace
+
+
 
 ModelView::ModelView( Model* model, QWidget* widget ) :
 	m_widget( widget ),
-	m_model( model )
+	m_model( model ),
+	m_changeCount( model != nullptr ? model->changeCount() : 0 )
 {
+	s_views.insert( this );
 }
 
 
@@ -41,6 +78,8 @@ ModelView::ModelView( Model* model, QWidget* widget ) :
 
 ModelView::~ModelView()
 {
+	s_views.erase( this );
+
 	if( m_model != nullptr && m_model->isDefaultConstructed() )
 	{
 		delete m_model;
@@ -65,6 +104,7 @@ void ModelView::setModel( Model* model, bool isOldModelValid )
 	}
 
 	m_model = model;
+	m_changeCount = model != nullptr ? model->changeCount() : 0;
 
 	doConnections();
 
@@ -90,10 +130,106 @@ void ModelView::doConnections()
 {
 	if( m_model != nullptr )
 	{
-		QObject::connect( m_model, SIGNAL(dataChanged()), widget(), SLOT(update()));
+		// Automation and controllers change models on the render threads. Rather
+		// than queueing a repaint for each change, updateChangedViews() picks
+		// them up at display rate.
+		QObject::connect( m_model, &Model::dataChanged, widget(),
+			[model = m_model.data(), target = widget()]
+			{
+				if( QThread::currentThread() == QCoreApplication::instance()->thread() )
+				{
+					target->update();
+				}
+				else
+				{
+					model->markChanged();
+				}
+			}, Qt::DirectConnection );
 		QObject::connect( m_model, SIGNAL(propertiesChanged()), widget(), SLOT(update()));
 	}
 }
 
 
+
+
+void ModelView::updateChangedViews()
+{
+	const auto totalChangeCount = Model::totalChangeCount();
+	if( totalChangeCount == s_totalChangeCount )
+	{
+		return;
+	}
+	s_totalChangeCount = totalChangeCount;
+
+	for( ModelView* view : s_views )
+	{
+		if( view->m_model == nullptr )
+		{
+			continue;
+		}
+
+		const auto changeCount = view->m_model->changeCount();
+		if( changeCount != view->m_changeCount )
+		{
+			view->m_changeCount = changeCount;
+			view->widget()->update();
+		}
+	}
+
+	pruneExpiredConnections();
+
+	// slots may connect or disconnect, so they are called after the loop
+	std::vector<std::shared_ptr<PolledConnection>> changed;
+	for( const auto& weakConnection : s_polledConnections )
+	{
+		auto connection = weakConnection.lock();
+		if( connection == nullptr )
+		{
+			continue;
+		}
+
+		const auto changeCount = connection->model->changeCount();
+		if( changeCount != connection->changeCount )
+		{
+			connection->changeCount = changeCount;
+			changed.push_back( std::move( connection ) );
+		}
+	}
+
+	for( const auto& connection : changed )
+	{
+		connection->slot();
+	}
+}
+
+
+
+
+void ModelView::connectChanges( Model* model, QObject* receiver, std::function<void()> slot )
+{
+	if( s_polledConnections.size() >= s_polledConnectionsPruneSize )
+	{
+		pruneExpiredConnections();
+		s_polledConnectionsPruneSize = std::max<std::size_t>( 64, 2 * s_polledConnections.size() );
+	}
+
+	auto connection = std::make_shared<PolledConnection>(
+		PolledConnection{ model, std::move( slot ), model->changeCount() } );
+	s_polledConnections.push_back( connection );
+
+	QObject::connect( model, &Model::dataChanged, receiver,
+		[connection = std::move( connection )]
+		{
+			if( QThread::currentThread() == QCoreApplication::instance()->thread() )
+			{
+				connection->slot();
+			}
+			else
+			{
+				connection->model->markChanged();
+			}
+		}, Qt::DirectConnection );
+}
+
+
 } // namespace lmms::gui
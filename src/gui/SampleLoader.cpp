@@ -32,6 +32,7 @@
 #include "FileDialog.h"
 #include "GuiApplication.h"
 #include "PathUtil.h"
+#include "ProjectLoader.h"
 #include "SampleDecoder.h"
 #include "Song.h"
 
@@ -92,6 +93,11 @@ std::shared_ptr<const SampleBuffer> SampleLoader::createBufferFromFile(const QSt
 {
 	if (filePath.isEmpty()) { return SampleBuffer::emptyBuffer(); }
 
+	if (const auto loader = ProjectLoader::current())
+	{
+		if (auto buffer = loader->sample(filePath)) { return buffer; }
+	}
+
 	try
 	{
 		return std::make_shared<SampleBuffer>(filePath);
@@ -47,11 +47,9 @@ namespace lmms::gui
 AutomationClipView::AutomationClipView( AutomationClip * _clip,
 						TrackView * _parent ) :
 	ClipView( _clip, _parent ),
-	m_clip( _clip ),
-	m_paintPixmap()
+	m_clip( _clip )
 {
-	connect( m_clip, SIGNAL(dataChanged()),
-			this, SLOT(update()));
+	connectChanges( m_clip, this, [this] { update(); } );
 	connect( getGUI()->automationEditor(), SIGNAL(currentClipChanged()),
 			this, SLOT(update()));
 
@@ -220,27 +218,10 @@ void AutomationClipView::mouseDoubleClickEvent( QMouseEvent * me )
 
 
 
-void AutomationClipView::paintEvent( QPaintEvent * )
+void AutomationClipView::paintClip(QPainter& p)
 {
-	QPainter painter( this );
-
-	if( !needsUpdate() )
-	{
-		painter.drawPixmap( 0, 0, m_paintPixmap );
-		return;
-	}
-
-	setNeedsUpdate( false );
-
-	if (m_paintPixmap.isNull() || m_paintPixmap.size() != size())
-	{
-		m_paintPixmap = QPixmap(size());
-	}
-
-	QPainter p( &m_paintPixmap );
-
 	QLinearGradient lingrad( 0, 0, 0, height() );
-	QColor c = getColorForDisplay( painter.background().color() );
+	QColor c = getColorForDisplay( palette().color(backgroundRole()) );
 	bool muted = m_clip->getTrack()->isMuted() || m_clip->isMuted();
 	bool current = getGUI()->automationEditor()->currentClip() == m_clip;
 
@@ -278,7 +259,7 @@ void AutomationClipView::paintEvent( QPaintEvent * )
 	QLinearGradient lin2grad( 0, min, 0, max );
 	QColor col;
 
-	col = !muted ? painter.pen().brush().color() : mutedColor();
+	col = !muted ? palette().color(foregroundRole()) : mutedColor();
 
 	lin2grad.setColorAt( 1, col.lighter( 150 ) );
 	lin2grad.setColorAt( 0.5, col );
@@ -390,10 +371,6 @@ void AutomationClipView::paintEvent( QPaintEvent * )
 		p.drawPixmap( spacing, height() - ( size + spacing ),
 			embed::getIconPixmap( "muted", size, size ) );
 	}
-
-	p.end();
-
-	painter.drawPixmap( 0, 0, m_paintPixmap );
 }
 
 
@@ -186,6 +186,11 @@ void ClipView::update()
 	}
 	m_needsUpdate = true;
 	selectableObject::update();
+	// clips that aren't shown as widgets are drawn by the track content widget
+	if( isHidden() )
+	{
+		m_trackView->getTrackContentWidget()->updateClipView( this );
+	}
 }
 
 
@@ -265,6 +270,37 @@ bool ClipView::needsUpdate()
 void ClipView::setNeedsUpdate( bool b )
 { m_needsUpdate = b; }
 
+
+
+
+const QPixmap & ClipView::pixmap()
+{
+	if( m_needsUpdate || m_paintPixmap.size() != size() )
+	{
+		m_needsUpdate = false;
+		if( m_paintPixmap.size() != size() )
+		{
+			m_paintPixmap = QPixmap( size() );
+		}
+		// the theme colors are only set when polishing, which hidden
+		// clip views may not have gone through yet
+		ensurePolished();
+		QPainter p( &m_paintPixmap );
+		paintClip( p );
+	}
+	return m_paintPixmap;
+}
+
+
+
+
+void ClipView::paintEvent( QPaintEvent * )
+{
+	QPainter painter( this );
+	painter.drawPixmap( 0, 0, pixmap() );
+}
+
+
 /*! \brief Close a ClipView
  *
  *  Closes a ClipView by asking the track
@@ -330,6 +366,7 @@ void ClipView::updateLength()
 		// 3 is the minimun width needed to make a clip visible
 		setFixedWidth(std::max(static_cast<int>(m_clip->length() * pixelsPerBar() / TimePos::ticksPerBar() + 1), 3));
 	}
+	m_trackView->getTrackContentWidget()->invalidateClipIndex();
 	m_trackView->trackContainerView()->update();
 }
 
@@ -345,6 +382,7 @@ void ClipView::updateLength()
  */
 void ClipView::updatePosition()
 {
+	m_trackView->getTrackContentWidget()->invalidateClipIndex();
 	m_trackView->getTrackContentWidget()->changePosition();
 	// moving a Clip can result in change of song-length etc.,
 	// therefore we update the track-container
@@ -1303,12 +1341,14 @@ void ClipView::mergeClips(QVector<ClipView*> clipvs)
 		const NoteVector& currentClipNotes = mcView->getMidiClip()->notes();
 		TimePos mcViewPos = mcView->getMidiClip()->startPosition();
 
+		auto newNotes = std::vector<Note>{};
+		newNotes.reserve(currentClipNotes.size());
 		for (Note* note: currentClipNotes)
 		{
-			Note* newNote = newMidiClip->addNote(*note, false);
-			TimePos originalNotePos = newNote->pos();
-			newNote->setPos(originalNotePos + (mcViewPos - earliestPos));
+			newNotes.push_back(*note);
+			newNotes.back().setPos(note->pos() + (mcViewPos - earliestPos));
 		}
+		newMidiClip->addNotes(newNotes, false);
 
 		// We disable the journalling system before removing, so the
 		// removal doesn't get added to the undo/redo history
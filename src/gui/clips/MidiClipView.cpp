@@ -51,7 +51,6 @@ constexpr int BeatStepButtonOffset = 4;
 MidiClipView::MidiClipView( MidiClip* clip, TrackView* parent ) :
 	ClipView( clip, parent ),
 	m_clip( clip ),
-	m_paintPixmap(),
 	m_noteFillColor(255, 255, 255, 220),
 	m_noteBorderColor(255, 255, 255, 220),
 	m_mutedNoteFillColor(100, 100, 100, 220),
@@ -371,25 +370,8 @@ static int computeNoteRange(int minKey, int maxKey)
 	return (maxKey - minKey) + 1;
 }
 
-void MidiClipView::paintEvent( QPaintEvent * )
+void MidiClipView::paintClip(QPainter& p)
 {
-	QPainter painter( this );
-
-	if( !needsUpdate() )
-	{
-		painter.drawPixmap( 0, 0, m_paintPixmap );
-		return;
-	}
-
-	setNeedsUpdate( false );
-
-	if (m_paintPixmap.isNull() || m_paintPixmap.size() != size())
-	{
-		m_paintPixmap = QPixmap(size());
-	}
-
-	QPainter p( &m_paintPixmap );
-
 	QColor c;
 	bool const muted = m_clip->getTrack()->isMuted() || m_clip->isMuted();
 	bool current = getGUI()->pianoRoll()->currentMidiClip() == m_clip;
@@ -402,7 +384,7 @@ void MidiClipView::paintEvent( QPaintEvent * )
 	}
 	else
 	{
-		c = getColorForDisplay( painter.background().color() );
+		c = getColorForDisplay( palette().color(backgroundRole()) );
 	}
 
 	// invert the gradient for the background in the B&B editor
@@ -670,8 +652,6 @@ void MidiClipView::paintEvent( QPaintEvent * )
 		p.drawPixmap( spacing, height() - ( size + spacing ),
 			embed::getIconPixmap( "muted", size, size ) );
 	}
-
-	painter.drawPixmap( 0, 0, m_paintPixmap );
 }
 
 
@@ -41,11 +41,9 @@ namespace lmms::gui
 
 PatternClipView::PatternClipView(Clip* _clip, TrackView* _tv) :
 	ClipView( _clip, _tv ),
-	m_patternClip(dynamic_cast<PatternClip*>(_clip)),
-	m_paintPixmap()
+	m_patternClip(dynamic_cast<PatternClip*>(_clip))
 {
-	connect( _clip->getTrack(), SIGNAL(dataChanged()), 
-			this, SLOT(update()));
+	connectChanges( _clip->getTrack(), this, [this] { update(); } );
 
 	setStyle( QApplication::style() );
 }
@@ -76,27 +74,10 @@ void PatternClipView::mouseDoubleClickEvent(QMouseEvent*)
 
 
 
-void PatternClipView::paintEvent(QPaintEvent*)
+void PatternClipView::paintClip(QPainter& p)
 {
-	QPainter painter( this );
-
-	if( !needsUpdate() )
-	{
-		painter.drawPixmap( 0, 0, m_paintPixmap );
-		return;
-	}
-
-	setNeedsUpdate( false );
-
-	if (m_paintPixmap.isNull() || m_paintPixmap.size() != size())
-	{
-		m_paintPixmap = QPixmap(size());
-	}
-
-	QPainter p( &m_paintPixmap );
-
 	QLinearGradient lingrad( 0, 0, 0, height() );
-	QColor c = getColorForDisplay( painter.background().color() );
+	QColor c = getColorForDisplay( palette().color(backgroundRole()) );
 	
 	lingrad.setColorAt( 0, c.lighter( 130 ) );
 	lingrad.setColorAt( 1, c.lighter( 70 ) );
@@ -154,10 +135,6 @@ void PatternClipView::paintEvent(QPaintEvent*)
 		p.drawPixmap( spacing, height() - ( size + spacing ),
 			embed::getIconPixmap( "muted", size, size ) );
 	}
-	
-	p.end();
-	
-	painter.drawPixmap( 0, 0, m_paintPixmap );
 }
 
 
@@ -44,8 +44,7 @@ namespace lmms::gui
 
 SampleClipView::SampleClipView( SampleClip * _clip, TrackView * _tv ) :
 	ClipView( _clip, _tv ),
-	m_clip( _clip ),
-	m_paintPixmap()
+	m_clip( _clip )
 {
 	// update UI and tooltip
 	updateSample();
@@ -201,30 +200,13 @@ void SampleClipView::mouseDoubleClickEvent( QMouseEvent * )
 
 
 
-void SampleClipView::paintEvent( QPaintEvent * pe )
+void SampleClipView::paintClip(QPainter& p)
 {
-	QPainter painter( this );
-
-	if( !needsUpdate() )
-	{
-		painter.drawPixmap( 0, 0, m_paintPixmap );
-		return;
-	}
-
-	setNeedsUpdate( false );
-
-	if (m_paintPixmap.isNull() || m_paintPixmap.size() != size())
-	{
-		m_paintPixmap = QPixmap(size());
-	}
-
-	QPainter p( &m_paintPixmap );
-
 	bool muted = m_clip->getTrack()->isMuted() || m_clip->isMuted();
 	bool selected = isSelected();
 
 	QLinearGradient lingrad(0, 0, 0, height());
-	QColor c = painter.background().color();
+	QColor c = palette().color(backgroundRole());
 	if (muted) { c = c.darker(150); }
 	if (selected) { c = c.darker(150); }
 
@@ -243,7 +225,7 @@ void SampleClipView::paintEvent( QPaintEvent * pe )
 		p.fillRect( rect(), c );
 	}
 
-	auto clipColor = m_clip->color().value_or(m_clip->getTrack()->color().value_or(painter.pen().brush().color()));
+	auto clipColor = m_clip->color().value_or(m_clip->getTrack()->color().value_or(palette().color(foregroundRole())));
 
 	p.setPen(clipColor);
 
@@ -318,10 +300,6 @@ void SampleClipView::paintEvent( QPaintEvent * pe )
 		p.setBrush( QBrush( textColor() ) );
 		p.drawEllipse( 4, 5, 4, 4 );
 	}*/
-
-	p.end();
-
-	painter.drawPixmap( 0, 0, m_paintPixmap );
 }
 
 
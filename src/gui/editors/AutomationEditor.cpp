@@ -55,6 +55,7 @@
 #include "Knob.h"
 #include "MainWindow.h"
 #include "MidiClip.h"
+#include "ModelView.h"
 #include "PatternStore.h"
 #include "PianoRoll.h"
 #include "ProjectJournal.h"
@@ -121,15 +122,13 @@ AutomationEditor::AutomationEditor() :
 	setLayoutDirection( Qt::LeftToRight );
 
 	m_tensionModel = new FloatModel(1.f, 0.f, 1.f, 0.01f);
-	connect( m_tensionModel, SIGNAL(dataChanged()),
-				this, SLOT(setTension()));
+	ModelView::connectChanges( m_tensionModel, this, [this] { setTension(); } );
 
 	for (auto q : Quantizations) {
 		m_quantizeModel.addItem(QString("1/%1").arg(q));
 	}
 
-	connect( &m_quantizeModel, SIGNAL(dataChanged()),
-					this, SLOT(setQuantization()));
+	ModelView::connectChanges( &m_quantizeModel, this, [this] { setQuantization(); } );
 	m_quantizeModel.setValue( m_quantizeModel.findText( "1/8" ) );
 
 	// add time-line
@@ -188,7 +187,8 @@ void AutomationEditor::setCurrentClip(AutomationClip * new_clip )
 
 	if (m_clip != nullptr)
 	{
-		connect(m_clip, SIGNAL(dataChanged()), this, SLOT(update()));
+		// the clip changes while automation is recorded, see ModelView::connectChanges()
+		ModelView::connectChanges(m_clip, this, [this] { update(); });
 	}
 
 	emit currentClipChanged();
@@ -2113,8 +2113,7 @@ AutomationEditorWindow::AutomationEditorWindow() :
 
 	m_zoomingXComboBox->setModel( &m_editor->m_zoomingXModel );
 
-	connect( &m_editor->m_zoomingXModel, SIGNAL(dataChanged()),
-			m_editor, SLOT(zoomingXChanged()));
+	ModelView::connectChanges( &m_editor->m_zoomingXModel, m_editor, [this] { m_editor->zoomingXChanged(); } );
 
 	auto zoom_y_label = new QLabel(zoomToolBar);
 	zoom_y_label->setPixmap( embed::getIconPixmap( "zoom_y" ) );
@@ -2132,8 +2131,7 @@ AutomationEditorWindow::AutomationEditorWindow() :
 
 	m_zoomingYComboBox->setModel( &m_editor->m_zoomingYModel );
 
-	connect( &m_editor->m_zoomingYModel, SIGNAL(dataChanged()),
-			m_editor, SLOT(zoomingYChanged()));
+	ModelView::connectChanges( &m_editor->m_zoomingYModel, m_editor, [this] { m_editor->zoomingYChanged(); } );
 
 	zoomToolBar->addWidget( zoom_x_label );
 	zoomToolBar->addWidget( m_zoomingXComboBox );
@@ -2216,8 +2214,11 @@ void AutomationEditorWindow::setCurrentClip(AutomationClip* clip)
 	// Connect new clip
 	if (clip)
 	{
-		connect(clip, SIGNAL(dataChanged()), this, SLOT(update()));
-		connect( clip, SIGNAL(dataChanged()), this, SLOT(updateWindowTitle()));
+		ModelView::connectChanges(clip, this, [this]
+		{
+			update();
+			updateWindowTitle();
+		});
 		connect(clip, SIGNAL(destroyed()), this, SLOT(clearCurrentClip()));
 
 		connect(m_flipXAction, SIGNAL(triggered()), clip, SLOT(flipX()));
@@ -283,8 +283,7 @@ PatternEditorWindow::PatternEditorWindow(PatternStore* ps) :
 	trackAndStepActionsToolBar->addAction( embed::getIconPixmap("step_btn_duplicate"), tr("Clone Steps"),
 						m_editor, SLOT(cloneSteps()));
 
-	connect(&ps->m_patternComboBoxModel, SIGNAL(dataChanged()),
-			m_editor, SLOT(updatePosition()));
+	ModelView::connectChanges(&ps->m_patternComboBoxModel, m_editor, [this] { m_editor->updatePosition(); });
 
 	auto viewNext = new QAction(this);
 	connect(viewNext, SIGNAL(triggered()), m_patternComboBox, SLOT(selectNext()));
@@ -46,6 +46,7 @@
 #endif
 
 #include <cmath>
+#include <numeric>
 #include <utility>
 
 #include "AutomationEditor.h"
@@ -62,6 +63,7 @@
 #include "InstrumentTrack.h"
 #include "MainWindow.h"
 #include "MidiClip.h"
+#include "ModelView.h"
 #include "PatternStore.h"
 #include "PianoView.h"
 #include "PositionLine.h"
@@ -111,6 +113,9 @@ const int RESIZE_AREA_WIDTH = 9;
 // width of line for setting volume/panning of note
 const int NOTE_EDIT_LINE_WIDTH = 3;
 
+// width of the tiles the grid is cached in
+const int GRID_TILE_WIDTH = 256;
+
 // key where to start
 const int INITIAL_START_KEY = Octave::Octave_4 + Key::C;
 
@@ -317,8 +322,7 @@ PianoRoll::PianoRoll() :
 		m_zoomingModel.addItem(QString("%1%").arg(zoomLevel * 100));
 	}
 	m_zoomingModel.setValue( m_zoomingModel.findText( "100%" ) );
-	connect( &m_zoomingModel, SIGNAL(dataChanged()),
-					this, SLOT(zoomingChanged()));
+	ModelView::connectChanges( &m_zoomingModel, this, [this] { zoomingChanged(); } );
 
 	// zoom y
 	for (float const & zoomLevel : m_zoomYLevels)
@@ -326,8 +330,7 @@ PianoRoll::PianoRoll() :
 		m_zoomingYModel.addItem(QString("%1%").arg(zoomLevel * 100));
 	}
 	m_zoomingYModel.setValue(m_zoomingYModel.findText("100%"));
-	connect(&m_zoomingYModel, SIGNAL(dataChanged()),
-					this, SLOT(zoomingYChanged()));
+	ModelView::connectChanges(&m_zoomingYModel, this, [this] { zoomingYChanged(); });
 
 	// Set up quantization model
 	m_quantizeModel.addItem( tr( "Note lock" ) );
@@ -336,8 +339,7 @@ PianoRoll::PianoRoll() :
 	}
 	m_quantizeModel.setValue( m_quantizeModel.findText( "1/16" ) );
 
-	connect( &m_quantizeModel, SIGNAL(dataChanged()),
-					this, SLOT(quantizeChanged()));
+	ModelView::connectChanges( &m_quantizeModel, this, [this] { quantizeChanged(); } );
 
 	// Set up note length model
 	m_noteLenModel.addItem( tr( "Last note" ),
@@ -360,8 +362,7 @@ PianoRoll::PianoRoll() :
 	m_noteLenModel.setValue( 0 );
 
 	// Note length change can cause a redraw if Q is set to lock
-	connect( &m_noteLenModel, SIGNAL(dataChanged()),
-					this, SLOT(noteLengthChanged()));
+	ModelView::connectChanges( &m_noteLenModel, this, [this] { noteLengthChanged(); } );
 
 	// Set up key selection dropdown
 	m_keyModel.addItem(tr("No key"));
@@ -371,7 +372,7 @@ PianoRoll::PianoRoll() :
 		m_keyModel.addItem(noteString);
 	}
 	m_keyModel.setValue(0); // start with "No key"
-	connect(&m_keyModel, &ComboBoxModel::dataChanged, this, &PianoRoll::keyChanged);
+	ModelView::connectChanges(&m_keyModel, this, [this] { keyChanged(); });
 
 	// Set up scale model
 	const InstrumentFunctionNoteStacking::ChordTable& chord_table =
@@ -388,10 +389,9 @@ PianoRoll::PianoRoll() :
 
 	m_scaleModel.setValue( 0 );
 	// connect scale change to key change so it auto-highlights with scale as well
-	connect(&m_scaleModel, &ComboBoxModel::dataChanged, this, &PianoRoll::keyChanged);
+	ModelView::connectChanges(&m_scaleModel, this, [this] { keyChanged(); });
 	// change can update m_semiToneMarkerMenu
-	connect( &m_scaleModel, SIGNAL(dataChanged()),
-						this, SLOT(updateSemiToneMarkerMenu()));
+	ModelView::connectChanges( &m_scaleModel, this, [this] { updateSemiToneMarkerMenu(); } );
 
 	// Set up chord model
 	m_chordModel.addItem( tr("No chord") );
@@ -406,15 +406,13 @@ PianoRoll::PianoRoll() :
 	m_chordModel.setValue( 0 );
 
 	// change can update m_semiToneMarkerMenu
-	connect( &m_chordModel, SIGNAL(dataChanged()),
-					this, SLOT(updateSemiToneMarkerMenu()));
+	ModelView::connectChanges( &m_chordModel, this, [this] { updateSemiToneMarkerMenu(); } );
 
 	setFocusPolicy( Qt::StrongFocus );
 	setFocus();
 	setMouseTracking( true );
 
-	connect( &m_scaleModel, SIGNAL(dataChanged()),
-					this, SLOT(updateSemiToneMarkerMenu()));
+	ModelView::connectChanges( &m_scaleModel, this, [this] { updateSemiToneMarkerMenu(); } );
 
 	connect( Engine::getSong(), SIGNAL(timeSignatureChanged(int,int)),
 						this, SLOT(update()));
@@ -428,8 +426,7 @@ PianoRoll::PianoRoll() :
 	m_snapModel.addItem(tr("Snap"));
 	m_snapModel.setValue(0);
 	changeSnapMode();
-	connect(&m_snapModel, SIGNAL(dataChanged()),
-		this, SLOT(changeSnapMode()));
+	ModelView::connectChanges(&m_snapModel, this, [this] { changeSnapMode(); });
 
 	m_stepRecorder.initialize();
 
@@ -672,7 +669,7 @@ void PianoRoll::glueNotes()
 				return note->key() < compareNote->key();
 			});
 
-		QList<Note *> noteToRemove;
+		NoteVector noteToRemove;
 
 		NoteVector::iterator note = selectedNotes.begin();
 		auto nextNote = note+1;
@@ -701,10 +698,7 @@ void PianoRoll::glueNotes()
 		}
 
 		// Remove old notes
-		for (int i = 0; i < noteToRemove.count(); ++i)
-		{
-			m_midiClip->removeNote(noteToRemove[i]);
-		}
+		m_midiClip->removeNotes(noteToRemove);
 
 		update();
 	}
@@ -816,6 +810,8 @@ void PianoRoll::loadMarkedSemiTones(const QDomElement & de)
 
 void PianoRoll::setCurrentMidiClip( MidiClip* newMidiClip )
 {
+	finishNoteDrag();
+
 	if( hasValidMidiClip() )
 	{
 		m_midiClip->instrumentTrack()->pianoModel()->disconnect(this);
@@ -884,14 +880,18 @@ void PianoRoll::setCurrentMidiClip( MidiClip* newMidiClip )
 
 	connect( m_midiClip->instrumentTrack(), SIGNAL( midiNoteOn( const lmms::Note& ) ), this, SLOT( startRecordNote( const lmms::Note& ) ) );
 	connect( m_midiClip->instrumentTrack(), SIGNAL( midiNoteOff( const lmms::Note& ) ), this, SLOT( finishRecordNote( const lmms::Note& ) ) );
-	connect( m_midiClip, SIGNAL(dataChanged()), this, SLOT(update()));
-	connect( m_midiClip->instrumentTrack()->pianoModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-
-	connect(m_midiClip->instrumentTrack()->firstKeyModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-	connect(m_midiClip->instrumentTrack()->lastKeyModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-	connect(m_midiClip->instrumentTrack()->microtuner()->keymapModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-	connect(m_midiClip->instrumentTrack()->microtuner()->keyRangeImportModel(), SIGNAL(dataChanged()),
-		this, SLOT(update()));
+	// the clip changes while notes are recorded, the keys and key range can
+	// be automated, see ModelView::connectChanges()
+	const auto repaint = [this] { update(); };
+	ModelView::connectChanges(m_midiClip, this, repaint);
+	// pressed keys only change the piano keys, not the grid or the notes
+	ModelView::connectChanges(m_midiClip->instrumentTrack()->pianoModel(), this, [this] {
+		update(0, keyAreaTop(), m_whiteKeyWidth + 1, keyAreaBottom() - keyAreaTop());
+	});
+	ModelView::connectChanges(m_midiClip->instrumentTrack()->firstKeyModel(), this, repaint);
+	ModelView::connectChanges(m_midiClip->instrumentTrack()->lastKeyModel(), this, repaint);
+	ModelView::connectChanges(m_midiClip->instrumentTrack()->microtuner()->keymapModel(), this, repaint);
+	ModelView::connectChanges(m_midiClip->instrumentTrack()->microtuner()->keyRangeImportModel(), this, repaint);
 
 	update();
 	emit currentMidiClipChanged();
@@ -1639,7 +1639,7 @@ void PianoRoll::mousePressEvent(QMouseEvent * me )
 			n->createDetuning();
 		}
 		detuningClip = n->detuning()->automationClip();
-		connect(detuningClip.data(), SIGNAL(dataChanged()), this, SLOT(update()));
+		ModelView::connectChanges(detuningClip.data(), this, [this] { update(); });
 		getGUI()->automationEditor()->setGhostMidiClip(m_midiClip);
 		getGUI()->automationEditor()->open(detuningClip);
 		return;
@@ -1880,11 +1880,14 @@ void PianoRoll::mousePressEvent(QMouseEvent * me )
 					// if they're holding shift, copy all selected notes
 					if( ! is_new_note && me->modifiers() & Qt::ShiftModifier )
 					{
+						auto copies = std::vector<Note>{};
+						copies.reserve(selectedNotes.size());
 						for (Note *note: selectedNotes)
 						{
-							Note *newNote = m_midiClip->addNote(*note, false);
-							newNote->setSelected(false);
+							copies.push_back(*note);
+							copies.back().setSelected(false);
 						}
+						m_midiClip->addNotes(copies, false);
 
 						if (!selectedNotes.empty())
 						{
@@ -2136,6 +2139,7 @@ void PianoRoll::setKnifeAction()
 {
 	if (m_editMode != EditMode::Knife)
 	{
+		finishNoteDrag();
 		m_knifeMode = m_editMode;
 		m_editMode = EditMode::Knife;
 		m_action = Action::Knife;
@@ -2144,6 +2148,23 @@ void PianoRoll::setKnifeAction()
 	}
 }
 
+void PianoRoll::finishNoteDrag()
+{
+	if( m_action != Action::MoveNote && m_action != Action::ResizeNote )
+	{
+		return;
+	}
+
+	if( hasValidMidiClip() )
+	{
+		// we moved one or more notes (or their start when
+		// resizing) so they have to be moved properly according
+		// to new starting-time in the note-array of clip
+		m_midiClip->rearrangeAllNotes();
+	}
+	m_action = Action::None;
+}
+
 void PianoRoll::cancelKnifeAction()
 {
 	m_editMode = m_knifeMode;
@@ -2268,14 +2289,6 @@ void PianoRoll::mouseReleaseEvent( QMouseEvent * me )
 			computeSelectedNotes(
 					me->modifiers() & Qt::ShiftModifier );
 		}
-		else if( m_action == Action::MoveNote )
-		{
-			// we moved one or more notes so they have to be
-			// moved properly according to new starting-
-			// time in the note-array of clip
-			m_midiClip->rearrangeAllNotes();
-
-		}
 
 		if( m_action == Action::MoveNote || m_action == Action::ResizeNote )
 		{
@@ -2318,6 +2331,8 @@ void PianoRoll::mouseReleaseEvent( QMouseEvent * me )
 
 	if (m_action != Action::Knife)
 	{
+		// any button ends a drag, e.g. a right click while moving notes
+		finishNoteDrag();
 		m_action = Action::None;
 	}
 
@@ -3001,6 +3016,315 @@ void PianoRoll::dragNotes(int x, int y, bool alt, bool shift, bool ctrl)
 
 
 
+bool PianoRoll::KeysState::operator==(const KeysState& other) const
+{
+	return height == other.height
+		&& topKey == other.topKey
+		&& startKey == other.startKey
+		&& keysVisible == other.keysVisible
+		&& notesEditHeight == other.notesEditHeight
+		&& keyLineHeight == other.keyLineHeight
+		&& pixelRatio == other.pixelRatio
+		&& noteNames == other.noteNames
+		&& mappedKeys == other.mappedKeys
+		&& pressedKeys == other.pressedKeys;
+}
+
+
+
+
+bool PianoRoll::GridState::operator==(const GridState& other) const
+{
+	return height == other.height
+		&& origin == other.origin
+		&& topKey == other.topKey
+		&& startKey == other.startKey
+		&& keysVisible == other.keysVisible
+		&& notesEditHeight == other.notesEditHeight
+		&& ppb == other.ppb
+		&& keyLineHeight == other.keyLineHeight
+		&& quantization == other.quantization
+		&& timeSigNumerator == other.timeSigNumerator
+		&& timeSigDenominator == other.timeSigDenominator
+		&& pixelRatio == other.pixelRatio
+		&& markedSemiTones == other.markedSemiTones;
+}
+
+
+
+
+//! Draws the piano keys, which paintEvent() caches in m_keysCache
+void PianoRoll::drawKeys(QPainter& p, int topKey, bool drawNoteNames)
+{
+	QFontMetrics fontMetrics(p.font());
+	// G-1 is one of the widest; plus one pixel margin for the shadow
+	QRect const boundingRect = fontMetrics.boundingRect(QString("G-1")) + QMargins(0, 0, 1, 0);
+
+	int topNote = topKey % KeysPerOctave;
+
+	p.setClipRect(0, keyAreaTop(), width(), keyAreaBottom() - keyAreaTop());
+	// the first grid line from the top Y position
+	int grid_line_y = keyAreaTop() + m_keyLineHeight - 1;
+
+	// lambda function for returning the height of a key
+	auto keyHeight = [&](
+		const int key
+	) -> int
+	{
+		switch (prKeyOrder[key % KeysPerOctave])
+		{
+		case KeyType::WhiteBig:
+			return m_whiteKeyBigHeight;
+		case KeyType::WhiteSmall:
+			return m_whiteKeySmallHeight;
+		case KeyType::Black:
+			return m_blackKeyHeight;
+		}
+		return 0; // should never happen
+	};
+	// lambda function for returning the distance to the top of a key
+	auto gridCorrection = [&](
+		const int key
+	) -> int
+	{
+		const int keyCode = key % KeysPerOctave;
+		switch (prKeyOrder[keyCode])
+		{
+		case KeyType::WhiteBig:
+			return m_whiteKeySmallHeight;
+		case KeyType::WhiteSmall:
+			// These two keys need to adjust up small height instead of only key line height
+			if (static_cast<Key>(keyCode) == Key::C || static_cast<Key>(keyCode) == Key::F)
+			{
+				return m_whiteKeySmallHeight;
+			}
+		case KeyType::Black:
+			return m_blackKeyHeight;
+		}
+		return 0; // should never happen
+	};
+	auto keyWidth = [&](
+		const int key
+	) -> int
+	{
+		switch (prKeyOrder[key % KeysPerOctave])
+		{
+		case KeyType::WhiteSmall:
+		case KeyType::WhiteBig:
+			return m_whiteKeyWidth;
+		case KeyType::Black:
+			return m_blackKeyWidth;
+		}
+		return 0; // should never happen
+	};
+	// lambda function to draw a key
+	auto drawKey = [&](
+		const int key,
+		const int yb)
+	{
+		const bool mapped = m_midiClip->instrumentTrack()->isKeyMapped(key);
+		const bool pressed = m_midiClip->instrumentTrack()->pianoModel()->isKeyPressed(key);
+		const int keyCode = key % KeysPerOctave;
+		const int yt = yb - gridCorrection(key);
+		const int kh = keyHeight(key);
+		const int kw = keyWidth(key);
+		// set key colors
+		p.setPen(QColor(0, 0, 0));
+		switch (prKeyOrder[keyCode])
+		{
+		case KeyType::WhiteSmall:
+		case KeyType::WhiteBig:
+			if (mapped)
+			{
+				if (pressed) { p.setBrush(m_whiteKeyActiveBackground); }
+				else { p.setBrush(m_whiteKeyInactiveBackground); }
+			}
+			else
+			{
+				p.setBrush(m_whiteKeyDisabledBackground);
+			}
+			break;
+		case KeyType::Black:
+			if (mapped)
+			{
+				if (pressed) { p.setBrush(m_blackKeyActiveBackground); }
+				else { p.setBrush(m_blackKeyInactiveBackground); }
+			}
+			else
+			{
+				p.setBrush(m_blackKeyDisabledBackground);
+			}
+		}
+		// draw key
+		p.drawRect(PIANO_X, yt, kw, kh);
+		// draw note name
+		if (static_cast<Key>(keyCode) == Key::C || (drawNoteNames && Piano::isWhiteKey(key)))
+		{
+			// small font sizes have 1 pixel offset instead of 2
+			auto zoomOffset = m_zoomYLevels[m_zoomingYModel.value()] > 1.0f ? 2 : 1;
+			QString noteString = getNoteString(key);
+			QRect textRect(
+				m_whiteKeyWidth - boundingRect.width() - 2,
+				yb - m_keyLineHeight + zoomOffset,
+				boundingRect.width(),
+				boundingRect.height()
+			);
+			p.setPen(pressed ? m_whiteKeyActiveTextShadow : m_whiteKeyInactiveTextShadow);
+			p.drawText(textRect.adjusted(0, 1, 1, 0), Qt::AlignRight | Qt::AlignHCenter, noteString);
+			p.setPen(pressed ? m_whiteKeyActiveTextColor : m_whiteKeyInactiveTextColor);
+			// if (static_cast<Key>(keyCode) == Key::C) { p.setPen(textColor()); }
+			// else { p.setPen(textColorLight()); }
+			p.drawText(textRect, Qt::AlignRight | Qt::AlignHCenter, noteString);
+		}
+	};
+	// correct y offset of the top key
+	switch (prKeyOrder[topNote])
+	{
+	case KeyType::WhiteSmall:
+	case KeyType::WhiteBig:
+		break;
+	case KeyType::Black:
+		// draw extra white key
+		drawKey(topKey + 1, grid_line_y - m_keyLineHeight);
+	}
+	// loop through visible keys
+	const int lastKey = qMax(0, topKey - m_pianoKeysVisible);
+	for (int key = topKey; key > lastKey; --key)
+	{
+		bool whiteKey = Piano::isWhiteKey(key);
+		if (whiteKey)
+		{
+			drawKey(key, grid_line_y);
+			grid_line_y += m_keyLineHeight;
+		}
+		else
+		{
+			// draw next white key
+			drawKey(key - 1, grid_line_y + m_keyLineHeight);
+			// draw black key over previous and next white key
+			drawKey(key, grid_line_y);
+			// drew two grid keys so skip ahead properly
+			grid_line_y += m_keyLineHeight + m_keyLineHeight;
+			// capture double key draw
+			--key;
+		}
+	}
+}
+
+
+
+
+/*! \brief Draws the part of the grid between the x coordinates left and right
+ *
+ *  The grid is drawn as it is when the view starts at the given position.
+ *  paintEvent() draws it into tiles of GRID_TILE_WIDTH pixels, which it can
+ *  keep while scrolling, so all positions are rounded down here, also left
+ *  of the view, to line up the tiles.
+ */
+void PianoRoll::drawGrid(QPainter& p, int position, int left, int right, int topKey, int q)
+{
+	const int ticksPerBar = TimePos::ticksPerBar();
+	auto floorDiv = [](int a, int b) { return a / b - (a % b != 0 && (a < 0) != (b < 0)); };
+	auto xCoordOfTick = [=](int tick) {
+		return m_whiteKeyWidth + floorDiv((tick - position) * m_ppb, ticksPerBar);
+	};
+	// the tick at the left border, the lines to draw start at or before it
+	const int leftTick = std::max(0, position + floorDiv((left - m_whiteKeyWidth) * ticksPerBar, m_ppb));
+	int x, tick;
+
+	// draw vertical quantization lines
+	p.setPen(m_lineColor);
+	for (tick = leftTick - leftTick % q, x = xCoordOfTick(tick);
+		x < right;
+		tick += q, x = xCoordOfTick(tick))
+	{
+		p.drawLine(x, keyAreaTop(), x, noteEditBottom());
+	}
+
+	// draw horizontal grid lines
+	p.setClipRect(left, keyAreaTop(), right - left, keyAreaBottom() - keyAreaTop());
+	// the first grid line from the top Y position
+	int grid_line_y = keyAreaTop() + m_keyLineHeight - 1;
+	auto drawHorizontalLine = [&](
+		const int key,
+		const int y
+	)
+	{
+		if (static_cast<Key>(key % KeysPerOctave) == Key::C) { p.setPen(m_beatLineColor); }
+		else { p.setPen(m_lineColor); }
+		p.drawLine(left, y, right, y);
+	};
+	// loop through visible keys like drawKeys()
+	const int lastKey = qMax(0, topKey - m_pianoKeysVisible);
+	for (int key = topKey; key > lastKey; --key)
+	{
+		if (Piano::isWhiteKey(key))
+		{
+			drawHorizontalLine(key, grid_line_y);
+			grid_line_y += m_keyLineHeight;
+		}
+		else
+		{
+			drawHorizontalLine(key - 1, grid_line_y + m_keyLineHeight);
+			drawHorizontalLine(key, grid_line_y);
+			grid_line_y += m_keyLineHeight + m_keyLineHeight;
+			--key;
+		}
+	}
+
+	p.setClipRect(left, keyAreaTop(), right - left, noteEditBottom() - keyAreaTop());
+
+	// draw alternating shading on bars
+	for (int bar = leftTick / ticksPerBar; (x = xCoordOfTick(bar * ticksPerBar)) < right; ++bar)
+	{
+		if (bar % 2 != 0)
+		{
+			p.fillRect(x,
+				PR_TOP_MARGIN,
+				m_ppb,
+				height() - (PR_BOTTOM_MARGIN + PR_TOP_MARGIN),
+				m_backgroundShade);
+		}
+	}
+
+	// draw vertical beat lines
+	int ticksPerBeat = DefaultTicksPerBar /
+		Engine::getSong()->getTimeSigModel().getDenominator();
+	p.setPen(m_beatLineColor);
+	for (tick = leftTick - leftTick % ticksPerBeat, x = xCoordOfTick(tick);
+		x < right;
+		tick += ticksPerBeat, x = xCoordOfTick(tick))
+	{
+		p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
+	}
+
+	// draw vertical bar lines
+	p.setPen(m_barLineColor);
+	for (tick = leftTick - leftTick % ticksPerBar, x = xCoordOfTick(tick);
+		x < right;
+		tick += ticksPerBar, x = xCoordOfTick(tick))
+	{
+		p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
+	}
+
+	// draw marked semitones after the grid
+	const int semiToneLeft = std::max(left, m_whiteKeyWidth + 1);
+	for (const int key_num : m_markedSemiTones)
+	{
+		const int y = keyAreaBottom() - 1 - m_keyLineHeight *
+			(key_num - m_startKey + 1);
+		if (y >= keyAreaBottom() - 1) { break; }
+		p.fillRect(semiToneLeft,
+			y,
+			right - semiToneLeft,
+			m_keyLineHeight + 1,
+			m_markedSemitoneColor);
+	}
+}
+
+
+
+
 void PianoRoll::paintEvent(QPaintEvent * pe )
 {
 	bool drawNoteNames = ConfigManager::inst()->value( "ui", "printnotelabels").toInt();
@@ -3019,9 +3343,6 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 	QFont f = p.font();
 	f.setPixelSize(m_keyLineHeight * 0.8);
 	p.setFont(f); // font size doesn't change without this for some reason
-	QFontMetrics fontMetrics(p.font());
-	// G-1 is one of the widest; plus one pixel margin for the shadow
-	QRect const boundingRect = fontMetrics.boundingRect(QString("G-1")) + QMargins(0, 0, 1, 0);
 
 	// Order of drawing
 	// - vertical quantization lines
@@ -3067,7 +3388,6 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			partialKeyVisible = 0;
 		}
 		int topKey = std::clamp(m_startKey + m_pianoKeysVisible - 1, 0, NumKeys - 1);
-		int topNote = topKey % KeysPerOctave;
 		// if not resizing the note edit area, we can change m_notesEditHeight
 		if (m_action != Action::ResizeNoteEditArea && partialKeyVisible != 0)
 		{
@@ -3085,9 +3405,8 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			// otherwise we add height
 			else { m_notesEditHeight += partialKeyVisible; }
 		}
-		int x, q = quantization(), tick;
+		int q = quantization();
 
-		// draw vertical quantization lines
 		// If we're over 100% zoom, we allow all quantization level grids
 		if (m_zoomingModel.value() <= 3)
 		{
@@ -3097,242 +3416,93 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			// allow quantization grid up to 1/32 for normal notes
 			else if (q < 6) { q = 6; }
 		}
-		auto xCoordOfTick = [=](int tick) {
-			return m_whiteKeyWidth + (
-				(tick - m_currentPosition) * m_ppb / TimePos::ticksPerBar()
-			);
-		};
-		p.setPen(m_lineColor);
-		for (tick = m_currentPosition - m_currentPosition % q,
-			x = xCoordOfTick(tick);
-			x <= width();
-			tick += q, x = xCoordOfTick(tick))
-		{
-			p.drawLine(x, keyAreaTop(), x, noteEditBottom());
-		}
-
-		// draw horizontal grid lines and piano notes
-		p.setClipRect(0, keyAreaTop(), width(), keyAreaBottom() - keyAreaTop());
-		// the first grid line from the top Y position
-		int grid_line_y = keyAreaTop() + m_keyLineHeight - 1;
 
-		// lambda function for returning the height of a key
-		auto keyHeight = [&](
-			const int key
-		) -> int
-		{
-			switch (prKeyOrder[key % KeysPerOctave])
-			{
-			case KeyType::WhiteBig:
-				return m_whiteKeyBigHeight;
-			case KeyType::WhiteSmall:
-				return m_whiteKeySmallHeight;
-			case KeyType::Black:
-				return m_blackKeyHeight;
-			}
-			return 0; // should never happen
-		};
-		// lambda function for returning the distance to the top of a key
-		auto gridCorrection = [&](
-			const int key
-		) -> int
-		{
-			const int keyCode = key % KeysPerOctave;
-			switch (prKeyOrder[keyCode])
-			{
-			case KeyType::WhiteBig:
-				return m_whiteKeySmallHeight;
-			case KeyType::WhiteSmall:
-				// These two keys need to adjust up small height instead of only key line height
-				if (static_cast<Key>(keyCode) == Key::C || static_cast<Key>(keyCode) == Key::F)
-				{
-					return m_whiteKeySmallHeight;
-				}
-			case KeyType::Black:
-				return m_blackKeyHeight;
-			}
-			return 0; // should never happen
-		};
-		auto keyWidth = [&](
-			const int key
-		) -> int
-		{
-			switch (prKeyOrder[key % KeysPerOctave])
-			{
-			case KeyType::WhiteSmall:
-			case KeyType::WhiteBig:
-				return m_whiteKeyWidth;
-			case KeyType::Black:
-				return m_blackKeyWidth;
-			}
-			return 0; // should never happen
-		};
-		// lambda function to draw a key
-		auto drawKey = [&](
-			const int key,
-			const int yb)
-		{
-			const bool mapped = m_midiClip->instrumentTrack()->isKeyMapped(key);
-			const bool pressed = m_midiClip->instrumentTrack()->pianoModel()->isKeyPressed(key);
-			const int keyCode = key % KeysPerOctave;
-			const int yt = yb - gridCorrection(key);
-			const int kh = keyHeight(key);
-			const int kw = keyWidth(key);
-			// set key colors
-			p.setPen(QColor(0, 0, 0));
-			switch (prKeyOrder[keyCode])
-			{
-			case KeyType::WhiteSmall:
-			case KeyType::WhiteBig:
-				if (mapped)
-				{
-					if (pressed) { p.setBrush(m_whiteKeyActiveBackground); }
-					else { p.setBrush(m_whiteKeyInactiveBackground); }
-				}
-				else
-				{
-					p.setBrush(m_whiteKeyDisabledBackground);
-				}
-				break;
-			case KeyType::Black:
-				if (mapped)
-				{
-					if (pressed) { p.setBrush(m_blackKeyActiveBackground); }
-					else { p.setBrush(m_blackKeyInactiveBackground); }
-				}
-				else
-				{
-					p.setBrush(m_blackKeyDisabledBackground);
-				}
-			}
-			// draw key
-			p.drawRect(PIANO_X, yt, kw, kh);
-			// draw note name
-			if (static_cast<Key>(keyCode) == Key::C || (drawNoteNames && Piano::isWhiteKey(key)))
-			{
-				// small font sizes have 1 pixel offset instead of 2
-				auto zoomOffset = m_zoomYLevels[m_zoomingYModel.value()] > 1.0f ? 2 : 1;
-				QString noteString = getNoteString(key);
-				QRect textRect(
-					m_whiteKeyWidth - boundingRect.width() - 2,
-					yb - m_keyLineHeight + zoomOffset,
-					boundingRect.width(),
-					boundingRect.height()
-				);
-				p.setPen(pressed ? m_whiteKeyActiveTextShadow : m_whiteKeyInactiveTextShadow);
-				p.drawText(textRect.adjusted(0, 1, 1, 0), Qt::AlignRight | Qt::AlignHCenter, noteString);
-				p.setPen(pressed ? m_whiteKeyActiveTextColor : m_whiteKeyInactiveTextColor);
-				// if (static_cast<Key>(keyCode) == Key::C) { p.setPen(textColor()); }
-				// else { p.setPen(textColorLight()); }
-				p.drawText(textRect, Qt::AlignRight | Qt::AlignHCenter, noteString);
-			}
-		};
-		// lambda for drawing the horizontal grid line
-		auto drawHorizontalLine = [&](
-			const int key,
-			const int y
-		)
-		{
-			if (static_cast<Key>(key % KeysPerOctave) == Key::C) { p.setPen(m_beatLineColor); }
-			else { p.setPen(m_lineColor); }
-			p.drawLine(m_whiteKeyWidth, y, width(), y);
-		};
-		// correct y offset of the top key
-		switch (prKeyOrder[topNote])
+		// The keys only change when scrolling vertically, zooming or playing
+		// notes, and the grid only when scrolling or zooming. Both are cached
+		// in pixmaps which are only drawn again when anything they depend on
+		// changed, so that repaints for the notes, the selection, the hovered
+		// note or the position line don't have to draw them again.
+		const qreal pixelRatio = devicePixelRatioF();
+		auto keys = KeysState{};
+		keys.height = height();
+		keys.topKey = topKey;
+		keys.startKey = m_startKey;
+		keys.keysVisible = m_pianoKeysVisible;
+		keys.notesEditHeight = m_notesEditHeight;
+		keys.keyLineHeight = m_keyLineHeight;
+		keys.pixelRatio = pixelRatio;
+		keys.noteNames = drawNoteNames;
+		for (int key = 0; key < NumKeys; ++key)
 		{
-		case KeyType::WhiteSmall:
-		case KeyType::WhiteBig:
-			break;
-		case KeyType::Black:
-			// draw extra white key
-			drawKey(topKey + 1, grid_line_y - m_keyLineHeight);
+			keys.mappedKeys[key] = m_midiClip->instrumentTrack()->isKeyMapped(key);
+			keys.pressedKeys[key] = m_midiClip->instrumentTrack()->pianoModel()->isKeyPressed(key);
 		}
-		// loop through visible keys
-		const int lastKey = qMax(0, topKey - m_pianoKeysVisible);
-		for (int key = topKey; key > lastKey; --key)
+		if (m_keysCache.isNull() || !(keys == m_keysState))
 		{
-			bool whiteKey = Piano::isWhiteKey(key);
-			if (whiteKey)
-			{
-				drawKey(key, grid_line_y);
-				drawHorizontalLine(key, grid_line_y);
-				grid_line_y += m_keyLineHeight;
-			}
-			else
-			{
-				// draw next white key
-				drawKey(key - 1, grid_line_y + m_keyLineHeight);
-				drawHorizontalLine(key - 1, grid_line_y + m_keyLineHeight);
-				// draw black key over previous and next white key
-				drawKey(key, grid_line_y);
-				drawHorizontalLine(key, grid_line_y);
-				// drew two grid keys so skip ahead properly
-				grid_line_y += m_keyLineHeight + m_keyLineHeight;
-				// capture double key draw
-				--key;
-			}
-		}
-
-		// don't draw over keys
-		p.setClipRect(m_whiteKeyWidth, keyAreaTop(), width(), noteEditBottom() - keyAreaTop());
-
-		// draw alternating shading on bars
-		float timeSignature =
-			static_cast<float>(Engine::getSong()->getTimeSigModel().getNumerator()) /
-			static_cast<float>(Engine::getSong()->getTimeSigModel().getDenominator());
-		float zoomFactor = m_zoomLevels[m_zoomingModel.value()];
-		//the bars which disappears at the left side by scrolling
-		int leftBars = m_currentPosition * zoomFactor / TimePos::ticksPerBar();
-		//iterates the visible bars and draw the shading on uneven bars
-		for (int x = m_whiteKeyWidth, barCount = leftBars;
-			x < width() + m_currentPosition * zoomFactor / timeSignature;
-			x += m_ppb, ++barCount)
-		{
-			if ((barCount + leftBars) % 2 != 0)
-			{
-				p.fillRect(x - m_currentPosition * zoomFactor / timeSignature,
-					PR_TOP_MARGIN,
-					m_ppb,
-					height() - (PR_BOTTOM_MARGIN + PR_TOP_MARGIN),
-					m_backgroundShade);
-			}
+			m_keysState = keys;
+			m_keysCache = QPixmap(QSize(m_whiteKeyWidth + 1, height()) * pixelRatio);
+			m_keysCache.setDevicePixelRatio(pixelRatio);
+			m_keysCache.fill(Qt::transparent);
+			QPainter keysPainter(&m_keysCache);
+			keysPainter.setFont(p.font());
+			drawKeys(keysPainter, topKey, drawNoteNames);
 		}
-
-		// draw vertical beat lines
-		int ticksPerBeat = DefaultTicksPerBar /
-			Engine::getSong()->getTimeSigModel().getDenominator();
-		p.setPen(m_beatLineColor);
-		for(tick = m_currentPosition - m_currentPosition % ticksPerBeat,
-			x = xCoordOfTick( tick );
-			x <= width();
-			tick += ticksPerBeat, x = xCoordOfTick(tick))
+		p.drawPixmap(0, 0, m_keysCache);
+
+		// The grid is cached in tiles, counted in pixels from the origin
+		// position, so that only the tiles which scroll into view have to be
+		// drawn. The origin is the first position that is scrolled by whole
+		// pixels from the current one, so that the tiles line up exactly.
+		const int ticksPerBar = TimePos::ticksPerBar();
+		const int ticksPerPixel = ticksPerBar / std::gcd(m_ppb, ticksPerBar);
+		auto grid = GridState{};
+		grid.height = height();
+		grid.origin = m_currentPosition % ticksPerPixel;
+		grid.topKey = topKey;
+		grid.startKey = m_startKey;
+		grid.keysVisible = m_pianoKeysVisible;
+		grid.notesEditHeight = m_notesEditHeight;
+		grid.ppb = m_ppb;
+		grid.keyLineHeight = m_keyLineHeight;
+		grid.quantization = q;
+		grid.timeSigNumerator = Engine::getSong()->getTimeSigModel().getNumerator();
+		grid.timeSigDenominator = Engine::getSong()->getTimeSigModel().getDenominator();
+		grid.pixelRatio = pixelRatio;
+		grid.markedSemiTones = m_markedSemiTones;
+		if (!(grid == m_gridState))
 		{
-			p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
+			m_gridState = std::move(grid);
+			m_gridTiles.clear();
 		}
 
-		// draw vertical bar lines
-		p.setPen(m_barLineColor);
-		for(tick = m_currentPosition - m_currentPosition % TimePos::ticksPerBar(),
-			x = xCoordOfTick( tick );
-			x <= width();
-			tick += TimePos::ticksPerBar(), x = xCoordOfTick(tick))
+		const int scrolled = (m_currentPosition - m_gridState.origin) * m_ppb / ticksPerBar;
+		const int firstTile = scrolled / GRID_TILE_WIDTH;
+		const int lastTile = (scrolled + std::max(width() - m_whiteKeyWidth, 1) - 1) / GRID_TILE_WIDTH;
+		// forget the tiles which are out of view, except for the neighbours
+		for (auto it = m_gridTiles.begin(); it != m_gridTiles.end();)
 		{
-			p.drawLine(x, PR_TOP_MARGIN, x, noteEditBottom());
+			if (it->first < firstTile - 1 || it->first > lastTile + 1) { it = m_gridTiles.erase(it); }
+			else { ++it; }
 		}
 
-		// draw marked semitones after the grid
-		for(x = 0; x < m_markedSemiTones.size(); ++x)
+		p.save();
+		p.setClipRect(m_whiteKeyWidth, 0, width() - m_whiteKeyWidth, height());
+		for (int index = firstTile; index <= lastTile; ++index)
 		{
-			const int key_num = m_markedSemiTones.at(x);
-			const int y = keyAreaBottom() - 1 - m_keyLineHeight *
-				(key_num - m_startKey + 1);
-			if(y >= keyAreaBottom() - 1) { break; }
-			p.fillRect(m_whiteKeyWidth + 1,
-				y,
-				width() - 10,
-				m_keyLineHeight + 1,
-				m_markedSemitoneColor);
+			const int tileLeft = m_whiteKeyWidth + index * GRID_TILE_WIDTH;
+			QPixmap& tile = m_gridTiles[index];
+			if (tile.isNull())
+			{
+				tile = QPixmap(QSize(GRID_TILE_WIDTH, height()) * pixelRatio);
+				tile.setDevicePixelRatio(pixelRatio);
+				tile.fill(Qt::transparent);
+				QPainter tilePainter(&tile);
+				tilePainter.translate(-tileLeft, 0);
+				drawGrid(tilePainter, m_gridState.origin, tileLeft, tileLeft + GRID_TILE_WIDTH, topKey, q);
+			}
+			p.drawPixmap(tileLeft - scrolled, 0, tile);
 		}
+		p.restore();
 	}
 
 	// reset MIDI clip
@@ -3399,6 +3569,14 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			return (topKey - key) * m_keyLineHeight + keyAreaTop() - 1;
 		};
 
+		// Only the notes in the area to repaint have to be drawn, which is a
+		// narrow strip when just the position line moved. The margin covers
+		// the note edit handles, which are wider than the note's first pixel.
+		const int editHandleMargin = NOTE_EDIT_LINE_WIDTH + 2;
+		const int repaintLeft = std::max(pe->rect().left() - m_whiteKeyWidth - editHandleMargin, 0);
+		const int repaintRight = std::min(pe->rect().right() - m_whiteKeyWidth + editHandleMargin,
+			width() - m_whiteKeyWidth);
+
 		// -- Begin ghost MIDI clip
 		if( !m_ghostNotes.empty() )
 		{
@@ -3420,8 +3598,11 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 				int note_width = len_ticks * m_ppb / TimePos::ticksPerBar();
 				const int x = ( pos_ticks - m_currentPosition ) *
 						m_ppb / TimePos::ticksPerBar();
-				// skip this note if not in visible area at all
-				if (!(x + note_width >= 0 && x <= width() - m_whiteKeyWidth))
+				// the ghost notes are sorted by position, so the
+				// following ones are right of the repainted area too
+				if (x > repaintRight) { break; }
+				// skip this note if not in repainted area at all
+				if (x + note_width < repaintLeft)
 				{
 					continue;
 				}
@@ -3441,6 +3622,10 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 		}
 		// -- End ghost MIDI clip
 
+		// The notes of the clip are sorted by position, except while they are
+		// moved or resized, and rearranged when that ends
+		const bool notesSorted = m_action != Action::MoveNote && m_action != Action::ResizeNote;
+
 		for( const Note *note : m_midiClip->notes() )
 		{
 			int len_ticks = note->length();
@@ -3459,8 +3644,10 @@ void PianoRoll::paintEvent(QPaintEvent * pe )
 			int note_width = len_ticks * m_ppb / TimePos::ticksPerBar();
 			const int x = ( pos_ticks - m_currentPosition ) *
 					m_ppb / TimePos::ticksPerBar();
-			// skip this note if not in visible area at all
-			if (!(x + note_width >= 0 && x <= width() - m_whiteKeyWidth))
+			// none of the following notes are repainted either
+			if (notesSorted && x > repaintRight) { break; }
+			// skip this note if not in repainted area at all
+			if (!(x + note_width >= repaintLeft && x <= repaintRight))
 			{
 				continue;
 			}
@@ -4373,12 +4560,9 @@ void PianoRoll::cutSelectedNotes()
 
 		Engine::getSong()->setModified();
 
-		for( Note *note : selected_notes )
-		{
-			// note (the memory of it) is also deleted by
-			// MidiClip::removeNote(...) so we don't have to do that
-			m_midiClip->removeNote( note );
-		}
+		// the notes (the memory of them) are also deleted by
+		// MidiClip::removeNotes(...) so we don't have to do that
+		m_midiClip->removeNotes( selected_notes );
 	}
 
 	update();
@@ -4414,6 +4598,8 @@ void PianoRoll::pasteNotes()
 			m_midiClip->addJournalCheckPoint();
 		}
 
+		auto notes = std::vector<Note>{};
+		notes.reserve( list.count() );
 		for( int i = 0; ! list.item( i ).isNull(); ++i )
 		{
 			// create the note
@@ -4424,10 +4610,12 @@ void PianoRoll::pasteNotes()
 			// select it
 			cur_note.setSelected( true );
 
-			// add to MIDI clip
-			m_midiClip->addNote( cur_note, false );
+			notes.push_back( cur_note );
 		}
 
+		// add to MIDI clip
+		m_midiClip->addNotes( notes, false );
+
 		// we only have to do the following lines if we pasted at
 		// least one note...
 		Engine::getSong()->setModified();
@@ -4449,7 +4637,7 @@ bool PianoRoll::deleteSelectedNotes()
 
 	m_midiClip->addJournalCheckPoint();
 
-	for (Note* note: selectedNotes) { m_midiClip->removeNote( note ); }
+	m_midiClip->removeNotes(selectedNotes);
 
 	Engine::getSong()->setModified();
 	update();
@@ -4629,6 +4817,8 @@ void PianoRoll::quantizeNotes(QuantizeAction mode)
 		}
 	}
 
+	NoteVector quantizedNotes;
+	std::vector<Note> copies;
 	for( Note* n : notes )
 	{
 		if( n->length() == TimePos( 0 ) )
@@ -4637,7 +4827,6 @@ void PianoRoll::quantizeNotes(QuantizeAction mode)
 		}
 
 		Note copy(*n);
-		m_midiClip->removeNote( n );
 		if (mode == QuantizeAction::Both || mode == QuantizeAction::Pos)
 		{
 			copy.quantizePos(quantization());
@@ -4646,9 +4835,13 @@ void PianoRoll::quantizeNotes(QuantizeAction mode)
 		{
 			copy.quantizeLength(quantization());
 		}
-		m_midiClip->addNote(copy, false);
+		quantizedNotes.push_back(n);
+		copies.push_back(copy);
 	}
 
+	m_midiClip->removeNotes(quantizedNotes);
+	m_midiClip->addNotes(copies, false);
+
 	update();
 	getGUI()->songEditor()->update();
 	Engine::getSong()->setModified();
@@ -5061,7 +5254,7 @@ void PianoRollWindow::setCurrentMidiClip( MidiClip* clip )
 		setWindowTitle( tr( "Piano-Roll - %1" ).arg( clip->name() ) );
 		m_fileToolsButton->setEnabled(true);
 		connect( clip->instrumentTrack(), SIGNAL(nameChanged()), this, SLOT(updateAfterMidiClipChange()));
-		connect( clip, SIGNAL(dataChanged()), this, SLOT(updateAfterMidiClipChange()));
+		ModelView::connectChanges( clip, this, [this] { updateAfterMidiClipChange(); } );
 	}
 	else
 	{
@@ -126,8 +126,7 @@ SongEditor::SongEditor( Song * song ) :
 
 	// Ensure loop markers snap to same increments as clips. Zoom & proportional
 	// snap changes are handled in zoomingChanged() and toggleProportionalSnap()
-	connect(m_snappingModel, &ComboBoxModel::dataChanged,
-		[this]() { m_timeLine->setSnapSize(getSnapSize()); });
+	connectChanges(m_snappingModel, this, [this]() { m_timeLine->setSnapSize(getSnapSize()); });
 
 
 	// add some essential widgets to global tool-bar
@@ -245,7 +244,7 @@ SongEditor::SongEditor( Song * song ) :
 	connect(m_timeLine, SIGNAL(selectionFinished()), this, SLOT(stopSelectRegion()));
 
 	//zoom connects
-	connect(m_zoomingModel, SIGNAL(dataChanged()), this, SLOT(zoomingChanged()));
+	connectChanges(m_zoomingModel, this, [this] { zoomingChanged(); });
 
 	// Set up snapping model
 	for (float bars : SNAP_SIZES)
@@ -992,7 +991,7 @@ SongEditorWindow::SongEditorWindow(Song* song) :
 	m_zoomingSlider->setFixedSize(100, 26);
 	m_zoomingSlider->setToolTip(tr("Zoom"));
 	m_zoomingSlider->setContextMenuPolicy(Qt::NoContextMenu);
-	connect(m_editor->m_zoomingModel, SIGNAL(dataChanged()), this, SLOT(updateSnapLabel()));
+	ModelView::connectChanges(m_editor->m_zoomingModel, this, [this] { updateSnapLabel(); });
 
 	zoomToolBar->addWidget( zoom_lbl );
 	zoomToolBar->addWidget(m_zoomingSlider);
@@ -1006,7 +1005,7 @@ SongEditorWindow::SongEditorWindow(Song* song) :
 	m_snappingComboBox->setFixedSize( 80, ComboBox::DEFAULT_HEIGHT );
 	m_snappingComboBox->setModel(m_editor->m_snappingModel);
 	m_snappingComboBox->setToolTip(tr("Clip snapping size"));
-	connect(m_editor->snappingModel(), SIGNAL(dataChanged()), this, SLOT(updateSnapLabel()));
+	ModelView::connectChanges(m_editor->snappingModel(), this, [this] { updateSnapLabel(); });
 
 	m_setProportionalSnapAction = new QAction(embed::getIconPixmap("proportional_snap"),
 											 tr("Toggle proportional snap on/off"), this);
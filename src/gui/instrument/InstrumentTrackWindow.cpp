@@ -56,6 +56,7 @@
 #include "LcdSpinBox.h"
 #include "LedCheckBox.h"
 #include "LeftRightNav.h"
+#include "LoadIndicator.h"
 #include "MainWindow.h"
 #include "PianoView.h"
 #include "PluginFactory.h"
@@ -224,6 +225,17 @@ InstrumentTrackWindow::InstrumentTrackWindow( InstrumentTrackView * _itv ) :
 	basicControlsLayout->addWidget( label, 1, 7);
 	basicControlsLayout->setAlignment( label, labelAlignment );
 
+	// set up the load indicator of the instrument, see modelChanged()
+	m_loadIndicator = new LoadIndicator( nullptr, this );
+	m_loadIndicator->setMinimumWidth( 32 );
+	basicControlsLayout->addWidget( m_loadIndicator, 0, 8 );
+	basicControlsLayout->setAlignment( m_loadIndicator, widgetAlignment );
+
+	label = new QLabel( tr( "CPU" ), this );
+	label->setStyleSheet( labelStyleSheet );
+	basicControlsLayout->addWidget( label, 1, 8);
+	basicControlsLayout->setAlignment( label, labelAlignment );
+
 	generalSettingsLayout->addLayout( basicControlsLayout );
 
 
@@ -349,6 +361,7 @@ void InstrumentTrackWindow::modelChanged()
 	m_panningKnob->setModel( &m_track->m_panningModel );
 	m_mixerChannelNumber->setModel( &m_track->m_mixerChannelModel );
 	m_pianoView->setModel( &m_track->m_piano );
+	m_loadIndicator->setMeter( m_track->instrument() ? &m_track->instrument()->loadMeter() : nullptr );
 
 	if (m_track->instrument() && m_track->instrument()->isBendable())
 	{
@@ -276,13 +276,13 @@ void PianoView::modelChanged()
 	m_piano = castModel<Piano>();
 	if (m_piano != nullptr)
 	{
-		connect(m_piano->instrumentTrack()->baseNoteModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-		connect(m_piano->instrumentTrack()->firstKeyModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-		connect(m_piano->instrumentTrack()->lastKeyModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-		connect(m_piano->instrumentTrack()->microtuner()->enabledModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-		connect(m_piano->instrumentTrack()->microtuner()->keymapModel(), SIGNAL(dataChanged()), this, SLOT(update()));
-		connect(m_piano->instrumentTrack()->microtuner()->keyRangeImportModel(), SIGNAL(dataChanged()),
-				this, SLOT(update()));
+		const auto repaint = [this] { update(); };
+		connectChanges(m_piano->instrumentTrack()->baseNoteModel(), this, repaint);
+		connectChanges(m_piano->instrumentTrack()->firstKeyModel(), this, repaint);
+		connectChanges(m_piano->instrumentTrack()->lastKeyModel(), this, repaint);
+		connectChanges(m_piano->instrumentTrack()->microtuner()->enabledModel(), this, repaint);
+		connectChanges(m_piano->instrumentTrack()->microtuner()->keymapModel(), this, repaint);
+		connectChanges(m_piano->instrumentTrack()->microtuner()->keyRangeImportModel(), this, repaint);
 	}
 }
 
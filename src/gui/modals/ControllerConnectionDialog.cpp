@@ -34,6 +34,7 @@
 #include "MidiController.h"
 #include "MidiClient.h"
 #include "MidiPortMenu.h"
+#include "ModelView.h"
 #include "LcdSpinBox.h"
 #include "LedCheckBox.h"
 #include "ComboBox.h"
@@ -141,8 +142,7 @@ ControllerConnectionDialog::ControllerConnectionDialog( QWidget * _parent,
 	// Midi stuff
 	m_midiGroupBox = new GroupBox( tr( "MIDI CONTROLLER" ), this );
 	m_midiGroupBox->setGeometry( 8, 10, 240, 80 );
-	connect( m_midiGroupBox->model(), SIGNAL(dataChanged()),
-			this, SLOT(midiToggled()));
+	ModelView::connectChanges( m_midiGroupBox->model(), this, [this] { midiToggled(); } );
 	
 	m_midiChannelSpinBox = new LcdSpinBox( 2, m_midiGroupBox,
 			tr( "Input channel" ) );
@@ -162,8 +162,7 @@ ControllerConnectionDialog::ControllerConnectionDialog( QWidget * _parent,
 				m_midiGroupBox, tr("Auto Detect") );
 	m_midiAutoDetectCheckBox->setModel( &m_midiAutoDetect );
 	m_midiAutoDetectCheckBox->move( 8, 60 );
-	connect( &m_midiAutoDetect, SIGNAL(dataChanged()),
-			this, SLOT(autoDetectToggled()));
+	ModelView::connectChanges( &m_midiAutoDetect, this, [this] { autoDetectToggled(); } );
 
 	// when using with non-raw-clients we can provide buttons showing
 	// our port-menus when being clicked
@@ -185,8 +184,7 @@ ControllerConnectionDialog::ControllerConnectionDialog( QWidget * _parent,
 	// User stuff
 	m_userGroupBox = new GroupBox( tr( "USER CONTROLLER" ), this );
 	m_userGroupBox->setGeometry( 8, 100, 240, 60 );
-	connect( m_userGroupBox->model(), SIGNAL(dataChanged()),
-			this, SLOT(userToggled()));
+	ModelView::connectChanges( m_userGroupBox->model(), this, [this] { userToggled(); } );
 
 	m_userController = new ComboBox( m_userGroupBox, "Controller" );
 	m_userController->setGeometry( 10, 24, 200, ComboBox::DEFAULT_HEIGHT );
@@ -196,8 +194,7 @@ ControllerConnectionDialog::ControllerConnectionDialog( QWidget * _parent,
 	}
 	connect( m_userController->model(), SIGNAL(dataUnchanged()),
 			this, SLOT(userSelected()));
-	connect( m_userController->model(), SIGNAL(dataChanged()),
-			this, SLOT(userSelected()));
+	ModelView::connectChanges( m_userController->model(), this, [this] { userSelected(); } );
 
 
 	// Mapping functions
@@ -119,6 +119,8 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 			"app", "disablebackup").toInt()),
 	m_openLastProject(ConfigManager::inst()->value(
 			"app", "openlastproject").toInt()),
+	m_lazyInstruments(ConfigManager::inst()->value(
+			"app", "lazyinstruments").toInt()),
 	m_loopMarkerMode{ConfigManager::inst()->value("app", "loopmarkermode", "dual")},
 	m_lang(ConfigManager::inst()->value(
 			"app", "language")),
@@ -140,6 +142,8 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 			"ui", "vstalwaysontop").toInt()),
 	m_disableAutoQuit(ConfigManager::inst()->value(
 			"ui", "disableautoquit", "1").toInt()),
+	m_pipelinedRemotePlugins(ConfigManager::inst()->value(
+			"audioengine", "pipelinedremoteplugins").toInt()),
 	m_NaNHandler(ConfigManager::inst()->value(
 			"app", "nanhandler", "1").toInt()),
 	m_bufferSize(ConfigManager::inst()->value(
@@ -281,6 +285,8 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 		m_disableBackup, SLOT(toggleDisableBackup(bool)), false);
 	addCheckBox(tr("Reopen last project on startup"), projectsGroupBox, projectsGroupLayout,
 		m_openLastProject, SLOT(toggleOpenLastProject(bool)), false);
+	addCheckBox(tr("Load instruments of muted and unused tracks on demand"), projectsGroupBox, projectsGroupLayout,
+		m_lazyInstruments, SLOT(toggleLazyInstruments(bool)), false);
 
 	generalControlsLayout->addWidget(projectsGroupBox);
 
@@ -448,6 +454,9 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 	addCheckBox(tr("Keep effects running even without input"), pluginsBox, pluginsLayout,
 		m_disableAutoQuit, SLOT(toggleDisableAutoQuit(bool)), false);
 
+	addCheckBox(tr("Run out-of-process plugins one buffer ahead (adds latency)"), pluginsBox, pluginsLayout,
+		m_pipelinedRemotePlugins, SLOT(togglePipelinedRemotePlugins(bool)), false);
+
 
 	// Performance layout ordering.
 	performance_layout->addWidget(autoSaveBox);
@@ -941,6 +950,8 @@ void SetupDialog::accept()
 					QString::number(!m_disableBackup));
 	ConfigManager::inst()->setValue("app", "openlastproject",
 					QString::number(m_openLastProject));
+	ConfigManager::inst()->setValue("app", "lazyinstruments",
+					QString::number(m_lazyInstruments));
 	ConfigManager::inst()->setValue("app", "loopmarkermode", m_loopMarkerMode);
 	ConfigManager::inst()->setValue("app", "language", m_lang);
 	ConfigManager::inst()->setValue("ui", "saveinterval",
@@ -959,6 +970,8 @@ void SetupDialog::accept()
 					QString::number(m_vstAlwaysOnTop));
 	ConfigManager::inst()->setValue("ui", "disableautoquit",
 					QString::number(m_disableAutoQuit));
+	ConfigManager::inst()->setValue("audioengine", "pipelinedremoteplugins",
+					QString::number(m_pipelinedRemotePlugins));
 	ConfigManager::inst()->setValue("audioengine", "audiodev",
 					m_audioIfaceNames[m_audioInterfaces->currentText()]);
 	ConfigManager::inst()->setValue("app", "nanhandler",
@@ -1080,6 +1093,12 @@ void SetupDialog::toggleOpenLastProject(bool enabled)
 }
 
 
+void SetupDialog::toggleLazyInstruments(bool enabled)
+{
+	m_lazyInstruments = enabled;
+}
+
+
 void SetupDialog::loopMarkerModeChanged()
 {
 	m_loopMarkerMode = m_loopMarkerComboBox->currentData().toString();
@@ -1165,6 +1184,12 @@ void SetupDialog::toggleDisableAutoQuit(bool enabled)
 	m_disableAutoQuit = enabled;
 }
 
+
+void SetupDialog::togglePipelinedRemotePlugins(bool enabled)
+{
+	m_pipelinedRemotePlugins = enabled;
+}
+
 void SetupDialog::audioInterfaceChanged(const QString & iface)
 {
 	for(AswMap::iterator it = m_audioIfaceSetupWidgets.begin();
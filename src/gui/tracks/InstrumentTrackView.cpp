@@ -299,6 +299,12 @@ void InstrumentTrackView::dropEvent( QDropEvent * _de )
 
 void InstrumentTrackView::toggleInstrumentWindow( bool _on )
 {
+	if (_on)
+	{
+		// the user wants to see the real instrument
+		model()->instantiateDeferredInstrument();
+	}
+
 	if (_on && ConfigManager::inst()->value("ui", "oneinstrumenttrackwindow").toInt())
 	{
 		if (topLevelInstrumentTrackWindow())
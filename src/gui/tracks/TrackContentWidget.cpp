@@ -24,8 +24,11 @@
 
 #include "TrackContentWidget.h"
 
+#include <algorithm>
+
 #include <QApplication>
 #include <QContextMenuEvent>
+#include <QCursor>
 #include <QMenu>
 #include <QPainter>
 
@@ -64,6 +67,9 @@ const int MIN_PIXELS_BETWEEN_LINES = 4;
 TrackContentWidget::TrackContentWidget( TrackView * parent ) :
 	QWidget( parent ),
 	m_trackView( parent ),
+	m_longestClip( 0 ),
+	m_clipIndexValid( false ),
+	m_activeClipView( nullptr ),
 	m_darkerColor( Qt::SolidPattern ),
 	m_lighterColor( Qt::SolidPattern ),
 	m_coarseGridColor( Qt::SolidPattern ),
@@ -77,14 +83,16 @@ TrackContentWidget::TrackContentWidget( TrackView * parent ) :
 	m_embossOffset(0)
 {
 	setAcceptDrops( true );
+	// to show the clip under the mouse as a widget, see setActiveClipView()
+	setMouseTracking( true );
 
 	connect( parent->trackContainerView(),
 			SIGNAL( positionChanged( const lmms::TimePos& ) ),
 			this, SLOT( changePosition( const lmms::TimePos& ) ) );
 
 	// Update background if snap size changes
-	connect(getGUI()->songEditor()->m_editor->snappingModel(), &Model::dataChanged,
-			this, &TrackContentWidget::updateBackground);
+	ModelView::connectChanges(getGUI()->songEditor()->m_editor->snappingModel(), this,
+			[this] { updateBackground(); });
 
 	// Also update background if proportional snap is enabled/disabled
 	connect(getGUI()->songEditor()->m_editor, &SongEditor::proportionalSnapChanged,
@@ -157,8 +165,8 @@ void TrackContentWidget::updateBackground()
 
 	pmp.end();
 
-	// Force redraw
-	update();
+	// Force redraw, the clips don't depend on the background
+	QWidget::update();
 }
 
 
@@ -176,6 +184,12 @@ void TrackContentWidget::addClipView( ClipView * clipv )
 	Clip * clip = clipv->getClip();
 
 	m_clipViews.push_back( clipv );
+	// in the Song Editor, we draw the clip until the mouse gets to it
+	if( !m_trackView->trackContainerView()->fixedClips() )
+	{
+		clipv->hide();
+	}
+	invalidateClipIndex();
 
 	clip->saveJournallingState( false );
 	changePosition();
@@ -199,6 +213,12 @@ void TrackContentWidget::removeClipView( ClipView * clipv )
 	if( it != m_clipViews.end() )
 	{
 		m_clipViews.erase( it );
+		m_visibleClipViews.removeOne( clipv );
+		if( m_activeClipView == clipv )
+		{
+			m_activeClipView = nullptr;
+		}
+		invalidateClipIndex();
 		Engine::getSong()->setModified();
 	}
 }
@@ -265,12 +285,21 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 	const int end = endPosition( pos );
 	const float ppb = m_trackView->trackContainerView()->pixelsPerBar();
 
+	// The clips are sorted by their start, so only those between the start
+	// of the longest clip before the visible range and its end are looked at
+	updateClipIndex();
+	auto clipView = std::lower_bound( m_clipIndex.begin(), m_clipIndex.end(),
+		begin - m_longestClip, []( ClipView * clipv, int tick )
+		{
+			return clipv->getClip()->startPosition() < tick;
+		} );
+
 	setUpdatesEnabled( false );
-	for (const auto& clipView : m_clipViews)
+	m_visibleClipViews.clear();
+	for( ; clipView != m_clipIndex.end() &&
+		( *clipView )->getClip()->startPosition() <= end; ++clipView )
 	{
-		Clip* clip = clipView->getClip();
-
-		clip->changeLength( clip->length() );
+		Clip* clip = ( *clipView )->getClip();
 
 		const int ts = clip->startPosition();
 		const int te = clip->endPosition()-3;
@@ -278,19 +307,28 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 			( te >= begin && te <= end ) ||
 			( ts <= begin && te >= end ) )
 		{
-			clipView->move(static_cast<int>((ts - begin) * ppb / TimePos::ticksPerBar()), clipView->y());
-			if (!clipView->isVisible())
-			{
-				clipView->show();
-			}
+			( *clipView )->move(static_cast<int>((ts - begin) * ppb / TimePos::ticksPerBar()), ( *clipView )->y());
+			m_visibleClipViews.push_back( *clipView );
+		}
+	}
+
+	if( m_activeClipView && !m_visibleClipViews.contains( m_activeClipView ) )
+	{
+		// keep a clip that is being dragged, out of sight
+		if( QWidget::mouseGrabber() == m_activeClipView )
+		{
+			m_activeClipView->move( -m_activeClipView->width() - 10, m_activeClipView->y() );
 		}
 		else
 		{
-			clipView->move(-clipView->width() - 10, clipView->y());
+			setActiveClipView( nullptr );
 		}
 	}
 	setUpdatesEnabled( true );
 
+	// a clip may have moved under the mouse
+	updateActiveClipView();
+
 	// redraw background
 	updateBackground();
 //	update();
@@ -299,6 +337,122 @@ void TrackContentWidget::changePosition( const TimePos & newPos )
 
 
 
+//! Sorts the clip views by their start again after clips moved or were added
+void TrackContentWidget::updateClipIndex()
+{
+	if( m_clipIndexValid )
+	{
+		return;
+	}
+
+	m_clipIndex = m_clipViews;
+	std::stable_sort( m_clipIndex.begin(), m_clipIndex.end(), []( ClipView * a, ClipView * b )
+	{
+		return a->getClip()->startPosition() < b->getClip()->startPosition();
+	} );
+
+	m_longestClip = 0;
+	for( const auto& clipView : m_clipIndex )
+	{
+		m_longestClip = std::max( m_longestClip, clipView->getClip()->length().getTicks() );
+	}
+	m_clipIndexValid = true;
+}
+
+
+
+
+void TrackContentWidget::invalidateClipIndex()
+{
+	m_clipIndexValid = false;
+	QWidget::update();
+}
+
+
+
+
+void TrackContentWidget::updateClipView( ClipView * clipv )
+{
+	if( !m_trackView->trackContainerView()->fixedClips() )
+	{
+		QWidget::update( clipv->geometry() );
+	}
+}
+
+
+
+
+/*! \brief Returns the topmost clip view in the visible range at pos
+ *
+ *  The clips are drawn in the order of m_visibleClipViews, so the last one
+ *  at pos is on top.
+ */
+ClipView * TrackContentWidget::clipViewAt( const QPoint & pos ) const
+{
+	for( auto it = m_visibleClipViews.rbegin(); it != m_visibleClipViews.rend(); ++it )
+	{
+		if( ( *it )->geometry().contains( pos ) )
+		{
+			return *it;
+		}
+	}
+	return nullptr;
+}
+
+
+
+
+/*! \brief Shows the given clip view as a widget and hides the previous one
+ *
+ *  Only the clip under the mouse is a widget, so that it gets the mouse
+ *  events, the cursor, its tool tip and the drops. paintEvent() draws all
+ *  other clips in the visible range from their pixmaps, which saves the
+ *  window system from stacking hundreds of widgets when scrolling.
+ *
+ * \param clipv The clip view to show, or nullptr to only hide the previous.
+ */
+void TrackContentWidget::setActiveClipView( ClipView * clipv )
+{
+	if( clipv == m_activeClipView )
+	{
+		return;
+	}
+
+	if( m_activeClipView )
+	{
+		// don't let the focus go to the track's buttons, see ~ClipView()
+		if( m_activeClipView->hasFocus() )
+		{
+			m_trackView->trackContainerView()->setFocus();
+		}
+		m_activeClipView->hide();
+	}
+	m_activeClipView = clipv;
+	if( m_activeClipView )
+	{
+		m_activeClipView->show();
+	}
+}
+
+
+
+
+//! Shows the clip under the mouse as a widget unless a button is held
+void TrackContentWidget::updateActiveClipView()
+{
+	if( m_trackView->trackContainerView()->fixedClips() ||
+		QApplication::mouseButtons() != Qt::NoButton )
+	{
+		return;
+	}
+
+	const QPoint pos = mapFromGlobal( QCursor::pos() );
+	setActiveClipView( rect().contains( pos ) ? clipViewAt( pos ) : nullptr );
+}
+
+
+
+
 /*! \brief Return the position of the trackContentWidget in bars.
  *
  * \param mouseX the mouse's current X position in pixels.
@@ -321,6 +475,12 @@ TimePos TrackContentWidget::getPosition( int mouseX )
  */
 void TrackContentWidget::dragEnterEvent( QDragEnterEvent * dee )
 {
+	// show the clip under the mouse, which then gets the drag events itself
+	if( !m_trackView->trackContainerView()->fixedClips() )
+	{
+		setActiveClipView( clipViewAt( dee->pos() ) );
+	}
+
 	TimePos clipPos = getPosition( dee->pos().x() );
 	if( canPasteSelection( clipPos, dee ) == false )
 	{
@@ -336,6 +496,22 @@ void TrackContentWidget::dragEnterEvent( QDragEnterEvent * dee )
 
 
 
+/*! \brief Respond to a drag move event on the trackContentWidget
+ *
+ * \param dme the Drag Move Event to respond to
+ */
+void TrackContentWidget::dragMoveEvent( QDragMoveEvent * dme )
+{
+	if( !m_trackView->trackContainerView()->fixedClips() )
+	{
+		setActiveClipView( clipViewAt( dme->pos() ) );
+	}
+	QWidget::dragMoveEvent( dme );
+}
+
+
+
+
 /*! \brief Returns whether a selection of Clips can be pasted into this
  *
  * \param clipPos the position of the Clip slot being pasted on
@@ -573,6 +749,17 @@ void TrackContentWidget::dropEvent( QDropEvent * de )
  */
 void TrackContentWidget::mousePressEvent( QMouseEvent * me )
 {
+	// A clip that got under the mouse without it moving is still drawn by
+	// us, so show it and let it have the click
+	if( ClipView * clipView = clipViewAt( me->pos() ) )
+	{
+		setActiveClipView( clipView );
+		QMouseEvent event( me->type(), clipView->mapFromParent( me->pos() ), me->windowPos(),
+			me->screenPos(), me->button(), me->buttons(), me->modifiers() );
+		QApplication::sendEvent( clipView, &event );
+		return;
+	}
+
 	// Enable box select if control is held when clicking an empty space
 	// (If we had clicked a Clip it would have intercepted the mouse event)
 	if( me->modifiers() & Qt::ControlModifier ){
@@ -607,6 +794,18 @@ void TrackContentWidget::mousePressEvent( QMouseEvent * me )
 
 
 
+void TrackContentWidget::mouseMoveEvent( QMouseEvent * me )
+{
+	if( me->buttons() == Qt::NoButton && !m_trackView->trackContainerView()->fixedClips() )
+	{
+		setActiveClipView( clipViewAt( me->pos() ) );
+	}
+	QWidget::mouseMoveEvent( me );
+}
+
+
+
+
 void TrackContentWidget::mouseReleaseEvent( QMouseEvent * me )
 {
 	getGUI()->songEditor()->syncEditMode();
@@ -632,6 +831,15 @@ void TrackContentWidget::paintEvent( QPaintEvent * pe )
 		p.drawTiledPixmap(rect(), m_background, QPoint(
 				tcv->currentPosition().getTicks() * ppb / TimePos::ticksPerBar(), 0));
 	}
+
+	// the clips which aren't shown as widgets, see setActiveClipView()
+	for (const auto& clipView : m_visibleClipViews)
+	{
+		if (clipView->isHidden() && clipView->geometry().intersects(pe->rect()))
+		{
+			p.drawPixmap(clipView->pos(), clipView->pixmap());
+		}
+	}
 }
 
 
@@ -645,7 +853,8 @@ void TrackContentWidget::resizeEvent( QResizeEvent * resizeEvent )
 {
 	// Update backgroud
 	updateBackground();
-	// Force redraw
+	// Force redraw and adjust the height of the clips
+	update();
 	QWidget::resizeEvent( resizeEvent );
 }
 
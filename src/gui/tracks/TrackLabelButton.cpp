@@ -66,7 +66,7 @@ TrackLabelButton::TrackLabelButton( TrackView * _tv, QWidget * _parent ) :
 	}
 	
 	setIconSize( QSize( 24, 24 ) );
-	connect( m_trackView->getTrack(), SIGNAL(dataChanged()), this, SLOT(update()));
+	ModelView::connectChanges( m_trackView->getTrack(), this, [this] { update(); } );
 	connect( m_trackView->getTrack(), SIGNAL(nameChanged()), this, SLOT(nameChanged()));
 }
 
@@ -109,8 +109,7 @@ TrackOperationsWidget::TrackOperationsWidget( TrackView * parent ) :
 				SLOT(deleteTrackView(lmms::gui::TrackView*)),
 							Qt::QueuedConnection );
 
-	connect( m_trackView->getTrack()->getMutedModel(), SIGNAL(dataChanged()),
-			this, SLOT(update()));
+	ModelView::connectChanges( m_trackView->getTrack()->getMutedModel(), this, [this] { update(); } );
 
 	connect(m_trackView->getTrack(), SIGNAL(colorChanged()), this, SLOT(update()));
 }
@@ -94,12 +94,13 @@ TrackView::TrackView( Track * track, TrackContainerView * tcv ) :
 			this, SLOT(createClipView(lmms::Clip*)),
 			Qt::QueuedConnection );
 
-	connect( &m_track->m_mutedModel, SIGNAL(dataChanged()),
-			&m_trackContentWidget, SLOT(update()));
-
-	connect(&m_track->m_mutedModel, SIGNAL(dataChanged()),
-			this, SLOT(muteChanged()));
+	connectChanges( &m_track->m_mutedModel, this, [this]
+	{
+		m_trackContentWidget.update();
+		muteChanged();
+	} );
 
+	// solo mutes the other tracks right away, so it isn't polled like the mute state
 	connect( &m_track->m_soloModel, SIGNAL(dataChanged()),
 			m_track, SLOT(toggleSolo()), Qt::DirectConnection );
 
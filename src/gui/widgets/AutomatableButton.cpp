@@ -245,8 +245,7 @@ void automatableButtonGroup::activateButton( AutomatableButton * _btn )
 
 void automatableButtonGroup::modelChanged()
 {
-	connect( model(), SIGNAL(dataChanged()),
-			this, SLOT(updateButtons()));
+	connectChanges( model(), this, [this] { updateButtons(); } );
 	IntModelView::modelChanged();
 	updateButtons();
 }
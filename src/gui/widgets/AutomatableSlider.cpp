@@ -105,8 +105,7 @@ void AutomatableSlider::modelChanged()
 {
 	QSlider::setRange( model()->minValue(), model()->maxValue() );
 	updateSlider();
-	connect( model(), SIGNAL(dataChanged()),
-				this, SLOT(updateSlider()));
+	connectChanges( model(), this, [this] { updateSlider(); } );
 }
 
 
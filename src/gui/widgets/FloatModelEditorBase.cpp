@@ -431,17 +431,6 @@ void FloatModelEditorBase::enterValue()
 }
 
 
-void FloatModelEditorBase::friendlyUpdate()
-{
-	if (model() && (model()->controllerConnection() == nullptr ||
-		model()->controllerConnection()->getController()->frequentUpdates() == false ||
-				Controller::runningFrames() % (256*4) == 0))
-	{
-		update();
-	}
-}
-
-
 QString FloatModelEditorBase::displayValue() const
 {
 	if (isVolumeKnob() &&
@@ -460,16 +449,4 @@ QString FloatModelEditorBase::displayValue() const
 }
 
 
-void FloatModelEditorBase::doConnections()
-{
-	if (model() != nullptr)
-	{
-		QObject::connect(model(), SIGNAL(dataChanged()),
-					this, SLOT(friendlyUpdate()));
-
-		QObject::connect(model(), SIGNAL(propertiesChanged()),
-						this, SLOT(update()));
-	}
-}
-
 } // namespace lmms::gui
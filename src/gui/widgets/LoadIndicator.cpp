@@ -0,0 +1,79 @@
+/*
+ * LoadIndicator.cpp - shows the CPU load of a mixer channel, effect or instrument
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "LoadIndicator.h"
+
+#include <cmath>
+#include <QMouseEvent>
+
+#include "GuiApplication.h"
+#include "LoadMeter.h"
+#include "MainWindow.h"
+
+
+namespace lmms::gui
+{
+
+LoadIndicator::LoadIndicator(LoadMeter* meter, QWidget* parent) :
+	QLabel(parent),
+	m_meter(meter)
+{
+	setAlignment(Qt::AlignCenter);
+
+	if (getGUI() && getGUI()->mainWindow())
+	{
+		connect(getGUI()->mainWindow(), &MainWindow::periodicUpdate, this, &LoadIndicator::updateLoad);
+	}
+	updateLoad();
+}
+
+void LoadIndicator::setMeter(LoadMeter* meter)
+{
+	m_meter = meter;
+	updateLoad();
+}
+
+void LoadIndicator::mousePressEvent(QMouseEvent* e)
+{
+	if (m_meter && (e->buttons() & Qt::LeftButton))
+	{
+		m_meter->reset();
+		updateLoad();
+	}
+}
+
+void LoadIndicator::updateLoad()
+{
+	if (!isVisible() && m_averageLoad >= 0) { return; }
+
+	const int averageLoad = m_meter ? static_cast<int>(std::round(m_meter->averageLoad() * 10)) : 0;
+	const int worstLoad = m_meter ? static_cast<int>(std::round(m_meter->worstLoad() * 10)) : 0;
+	if (averageLoad == m_averageLoad && worstLoad == m_worstLoad) { return; }
+
+	m_averageLoad = averageLoad;
+	m_worstLoad = worstLoad;
+	setText(QString("%1%").arg(averageLoad / 10., 0, 'f', 1));
+	setToolTip(tr("CPU load: %1% on average, %2% in the worst period\nClick to reset")
+		.arg(averageLoad / 10., 0, 'f', 1).arg(worstLoad / 10., 0, 'f', 1));
+}
+
+} // namespace lmms::gui
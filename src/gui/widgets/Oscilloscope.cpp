@@ -31,6 +31,7 @@
 #include "gui_templates.h"
 #include "MainWindow.h"
 #include "AudioEngine.h"
+#include "AudioTap.h"
 #include "Engine.h"
 #include "Song.h"
 #include "embed.h"
@@ -75,13 +76,13 @@ Oscilloscope::~Oscilloscope()
 
 
 
-void Oscilloscope::updateAudioBuffer(const SampleFrame* buffer)
+void Oscilloscope::updateAudioBuffer()
 {
-	if( !Engine::getSong()->isExporting() )
+	if( m_tapReader && !Engine::getSong()->isExporting() )
 	{
-		const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
-		memcpy(m_buffer, buffer, sizeof(SampleFrame) * fpp);
+		m_tapReader->fetchLatest( m_buffer, Engine::audioEngine()->framesPerPeriod() );
 	}
+	update();
 }
 
 
@@ -92,21 +93,17 @@ void Oscilloscope::setActive( bool _active )
 	m_active = _active;
 	if( m_active )
 	{
+		m_tapReader = std::make_unique<AudioTapReader>( Engine::audioEngine()->masterTap() );
 		connect( getGUI()->mainWindow(),
 					SIGNAL(periodicUpdate()),
-					this, SLOT(update()));
-		connect( Engine::audioEngine(),
-			SIGNAL(nextAudioBuffer(const lmms::SampleFrame*)),
-			this, SLOT(updateAudioBuffer(const lmms::SampleFrame*)));
+					this, SLOT(updateAudioBuffer()));
 	}
 	else
 	{
 		disconnect( getGUI()->mainWindow(),
 					SIGNAL(periodicUpdate()),
-					this, SLOT(update()));
-		disconnect( Engine::audioEngine(),
-			SIGNAL(nextAudioBuffer(const lmms::SampleFrame*)),
-			this, SLOT(updateAudioBuffer(const lmms::SampleFrame*)));
+					this, SLOT(updateAudioBuffer()));
+		m_tapReader.reset();
 		// we have to update (remove last waves),
 		// because timer doesn't do that anymore
 		update();
@@ -23,11 +23,14 @@
  */
 #include "InstrumentTrack.h"
 
+#include <algorithm>
+
 #include "AudioEngine.h"
 #include "AutomationClip.h"
 #include "ConfigManager.h"
 #include "ControllerConnection.h"
 #include "DataFile.h"
+#include "DummyInstrument.h"
 #include "GuiApplication.h"
 #include "Mixer.h"
 #include "InstrumentTrackView.h"
@@ -40,6 +43,8 @@
 #include "PatternTrack.h"
 #include "PianoRoll.h"
 #include "Pitch.h"
+#include "ProjectJournal.h"
+#include "ProjectLoader.h"
 #include "Song.h"
 
 namespace lmms
@@ -67,6 +72,8 @@ InstrumentTrack::InstrumentTrack( TrackContainer* tc ) :
 	m_mixerChannelModel( 0, 0, 0, this, tr( "Mixer channel" ) ),
 	m_useMasterPitchModel( true, this, tr( "Master pitch") ),
 	m_instrument( nullptr ),
+	m_instrumentDeferred(false),
+	m_instrumentRequested(false),
 	m_soundShaping( this ),
 	m_arpeggio( this ),
 	m_noteStacking( this ),
@@ -110,6 +117,10 @@ InstrumentTrack::InstrumentTrack( TrackContainer* tc ) :
 	connect(&m_pitchModel, SIGNAL(dataChanged()), this, SLOT(updatePitch()), Qt::DirectConnection);
 	connect(&m_pitchRangeModel, SIGNAL(dataChanged()), this, SLOT(updatePitchRange()), Qt::DirectConnection);
 	connect(&m_mixerChannelModel, SIGNAL(dataChanged()), this, SLOT(updateMixerChannel()), Qt::DirectConnection);
+	// queued, as automation may change the mute state from the audio threads
+	connect(&m_mutedModel, SIGNAL(dataChanged()), this, SLOT(updateMuted()), Qt::QueuedConnection);
+
+	m_mutedTimer.start();
 }
 
 
@@ -578,6 +589,12 @@ void InstrumentTrack::playNote( NotePlayHandle* n, SampleFrame* workingBuffer )
 	m_noteStacking.processNote( n );
 	m_arpeggio.processNote( n );
 
+	if (m_instrumentDeferred)
+	{
+		// the note stays silent, but the instrument will be there for the next ones
+		requestDeferredInstrument();
+	}
+
 	if( n->isMasterNote() == false && m_instrument != nullptr )
 	{
 		// all is done, so now lets play the note!
@@ -678,6 +695,27 @@ void InstrumentTrack::updateMixerChannel()
 
 
 
+void InstrumentTrack::updateMuted()
+{
+	m_mutedTimer.restart();
+
+	if (!isMuted())
+	{
+		instantiateDeferredInstrument();
+	}
+}
+
+
+
+
+qint64 InstrumentTrack::mutedFor() const
+{
+	return isMuted() ? m_mutedTimer.elapsed() : 0;
+}
+
+
+
+
 int InstrumentTrack::masterKey( int _midi_key ) const
 {
 
@@ -755,21 +793,11 @@ bool InstrumentTrack::play( const TimePos & _start, const fpp_t _frames,
 
 		// get all notes from the given clip...
 		const NoteVector & notes = c->notes();
-		// ...and set our index to zero
-		auto nit = notes.begin();
 
-		// very effective algorithm for playing notes that are
-		// posated within the current sample-frame
-
-
-		if( cur_start > 0 )
-		{
-			// skip notes which are posated before start-bar
-			while( nit != notes.end() && ( *nit )->pos() < cur_start )
-			{
-				++nit;
-			}
-		}
+		// ...and skip the ones before the current position. The notes are
+		// sorted by position, so a binary search finds the first one.
+		auto nit = std::lower_bound(notes.begin(), notes.end(), cur_start,
+			[](const Note* note, const TimePos& pos) { return note->pos() < pos; });
 
 		while (nit != notes.end() && (*nit)->pos() == cur_start)
 		{
@@ -844,16 +872,7 @@ void InstrumentTrack::saveTrackSpecificSettings(QDomDocument& doc, QDomElement&
 		m_midiCCModel[i]->saveSettings(doc, midiCC, "cc" + QString::number(i));
 	}
 
-	if( m_instrument != nullptr )
-	{
-		QDomElement i = doc.createElement( "instrument" );
-		i.setAttribute( "name", m_instrument->descriptor()->name );
-		QDomElement ins = m_instrument->saveState( doc, i );
-		if(m_instrument->key().isValid()) {
-			ins.appendChild( m_instrument->key().saveXML( doc ) );
-		}
-		thisElement.appendChild( i );
-	}
+	saveInstrument(doc, thisElement);
 	m_soundShaping.saveState( doc, thisElement );
 	m_noteStacking.saveState( doc, thisElement );
 	m_arpeggio.saveState( doc, thisElement );
@@ -883,6 +902,28 @@ void InstrumentTrack::saveTrackSpecificSettings(QDomDocument& doc, QDomElement&
 
 
 
+void InstrumentTrack::saveInstrument(QDomDocument& doc, QDomElement& parent)
+{
+	if (m_instrumentDeferred)
+	{
+		// write back what we loaded
+		parent.appendChild(doc.importNode(m_deferredInstrument.documentElement(), true));
+	}
+	else if( m_instrument != nullptr )
+	{
+		QDomElement i = doc.createElement( "instrument" );
+		i.setAttribute( "name", m_instrument->descriptor()->name );
+		QDomElement ins = m_instrument->saveState( doc, i );
+		if(m_instrument->key().isValid()) {
+			ins.appendChild( m_instrument->key().saveXML( doc ) );
+		}
+		parent.appendChild( i );
+	}
+}
+
+
+
+
 void InstrumentTrack::loadTrackSpecificSettings( const QDomElement & thisElement )
 {
 	// don't delete instrument in preview mode if it's the same
@@ -949,8 +990,19 @@ void InstrumentTrack::loadTrackSpecificSettings( const QDomElement & thisElement
 				{
 					m_instrument->restoreState(node.firstChildElement());
 				}
+				else if (shouldDeferInstrument(thisElement))
+				{
+					delete m_instrument;
+					m_instrument = new DummyInstrument(this);
+					m_deferredInstrument = QDomDocument();
+					m_deferredInstrument.appendChild(m_deferredInstrument.importNode(node, true));
+					m_instrumentRequested = false;
+					m_instrumentDeferred = true;
+					emit instrumentChanged();
+				}
 				else
 				{
+					clearDeferredInstrument();
 					delete m_instrument;
 					m_instrument = nullptr;
 					m_instrument = Instrument::instantiate(
@@ -973,6 +1025,7 @@ void InstrumentTrack::loadTrackSpecificSettings( const QDomElement & thisElement
 					ControllerConnection::classNodeName() != node.nodeName() &&
 					!node.toElement().hasAttribute( "id" ))
 			{
+				clearDeferredInstrument();
 				delete m_instrument;
 				m_instrument = nullptr;
 				m_instrument = Instrument::instantiate(
@@ -1052,6 +1105,7 @@ Instrument * InstrumentTrack::loadInstrument(const QString & _plugin_name,
 	silenceAllNotes( true );
 
 	lock();
+	clearDeferredInstrument();
 	delete m_instrument;
 	m_instrument = Instrument::instantiate(_plugin_name, this,
 					key, keyFromDnd);
@@ -1065,6 +1119,168 @@ Instrument * InstrumentTrack::loadInstrument(const QString & _plugin_name,
 
 
 
+void InstrumentTrack::instantiateDeferredInstrument()
+{
+	if (!m_instrumentDeferred)
+	{
+		return;
+	}
+
+	// like when loading the project, restoring the instrument must not be undoable
+	const bool journalling = Engine::projectJournal()->isJournalling();
+	Engine::projectJournal()->setJournalling(false);
+
+	silenceAllNotes(true);
+
+	lock();
+	const QDomElement element = m_deferredInstrument.documentElement();
+	using PluginKey = Plugin::Descriptor::SubPluginFeatures::Key;
+	PluginKey key(element.elementsByTagName("key").item(0).toElement());
+
+	delete m_instrument;
+	m_instrument = nullptr;
+	m_instrument = Instrument::instantiate(element.attribute("name"), this, &key);
+	m_instrument->restoreState(element.firstChildElement());
+	clearDeferredInstrument();
+	unlock();
+
+	Engine::projectJournal()->setJournalling(journalling);
+
+	emit instrumentChanged();
+}
+
+
+
+
+bool InstrumentTrack::deferInstrument()
+{
+	if (m_instrumentDeferred || m_previewMode || m_instrument == nullptr)
+	{
+		return false;
+	}
+
+	QDomDocument doc;
+	QDomElement parent = doc.createElement(nodeName());
+	saveInstrument(doc, parent);
+	const QDomElement element = parent.firstChildElement("instrument");
+	if (element.isNull() || !canDeferInstrument(element, nullptr))
+	{
+		return false;
+	}
+
+	silenceAllNotes(true);
+
+	lock();
+	delete m_instrument;
+	m_instrument = new DummyInstrument(this);
+	m_deferredInstrument = QDomDocument();
+	m_deferredInstrument.appendChild(m_deferredInstrument.importNode(element, true));
+	m_instrumentRequested = false;
+	m_instrumentDeferred = true;
+	unlock();
+
+	emit instrumentChanged();
+
+	return true;
+}
+
+
+
+
+bool InstrumentTrack::shouldDeferInstrument(const QDomElement& thisElement) const
+{
+	const ProjectLoader* loader = ProjectLoader::current();
+	if (m_previewMode || loader == nullptr || !ConfigManager::inst()->value("app", "lazyinstruments").toInt())
+	{
+		return false;
+	}
+
+	if (!canDeferInstrument(thisElement.firstChildElement("instrument"), loader))
+	{
+		return false;
+	}
+
+	// the mute state and the clips are saved in the track element around us
+	const QDomElement trackElement = thisElement.parentNode().toElement();
+	const QDomElement mutedElement = trackElement.firstChildElement("muted");
+	if (!mutedElement.isNull() && loader->isAutomated(mutedElement.attribute("id")))
+	{
+		return false;
+	}
+
+	if (isMuted())
+	{
+		return true;
+	}
+
+	// tracks in the pattern editor are played through pattern tracks, which we don't look at
+	if (trackContainer() != Engine::getSong())
+	{
+		return false;
+	}
+
+	for (auto clip = trackElement.firstChildElement("midiclip"); !clip.isNull();
+		clip = clip.nextSiblingElement("midiclip"))
+	{
+		if (!clip.attribute("muted").toInt())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+
+bool InstrumentTrack::canDeferInstrument(const QDomElement& element, const ProjectLoader* loader)
+{
+	if (element.tagName() == ControllerConnection::classNodeName())
+	{
+		return false;
+	}
+
+	if (element.hasAttribute("id") && (loader == nullptr || loader->isAutomated(element.attribute("id"))))
+	{
+		return false;
+	}
+
+	for (auto child = element.firstChildElement(); !child.isNull(); child = child.nextSiblingElement())
+	{
+		if (!canDeferInstrument(child, loader))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+
+void InstrumentTrack::requestDeferredInstrument()
+{
+	if (!m_instrumentRequested.exchange(true))
+	{
+		QMetaObject::invokeMethod(this, "instantiateDeferredInstrument", Qt::QueuedConnection);
+	}
+}
+
+
+
+
+void InstrumentTrack::clearDeferredInstrument()
+{
+	m_instrumentDeferred = false;
+	m_instrumentRequested = false;
+	m_deferredInstrument.clear();
+}
+
+
+
+
 InstrumentTrack *InstrumentTrack::s_autoAssignedTrack = nullptr;
 
 /*! \brief Automatically assign a midi controller to this track, based on the midiautoassign setting
@@ -26,6 +26,8 @@
 #include "MidiClip.h"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <QDomElement>
 
 #include "GuiApplication.h"
@@ -208,6 +210,48 @@ Note * MidiClip::addNote( const Note & _new_note, const bool _quant_pos )
 
 
 
+NoteVector MidiClip::addNotes(const std::vector<Note>& newNotes, bool quantPos)
+{
+	auto addedNotes = NoteVector{};
+	if (newNotes.empty()) { return addedNotes; }
+
+	const auto quantize = quantPos && gui::getGUI() && gui::getGUI()->pianoRoll();
+	addedNotes.reserve(newNotes.size());
+	for (const auto& note : newNotes)
+	{
+		auto newNote = new Note(note);
+		if (quantize)
+		{
+			newNote->quantizePos(gui::getGUI()->pianoRoll()->quantization());
+		}
+		addedNotes.push_back(newNote);
+	}
+
+	auto sortedNotes = addedNotes;
+	std::stable_sort(sortedNotes.begin(), sortedNotes.end(), Note::lessThan);
+
+	// Only the GUI thread changes the notes, so the merged vector can be built
+	// without holding the track's lock. New notes go behind equal ones, like in addNote().
+	auto notes = NoteVector{};
+	notes.reserve(m_notes.size() + sortedNotes.size());
+	std::merge(m_notes.begin(), m_notes.end(), sortedNotes.begin(), sortedNotes.end(),
+		std::back_inserter(notes), Note::lessThan);
+
+	instrumentTrack()->lock();
+	m_notes.swap(notes);
+	instrumentTrack()->unlock();
+
+	checkType();
+	updateLength();
+
+	emit dataChanged();
+
+	return addedNotes;
+}
+
+
+
+
 NoteVector::const_iterator MidiClip::removeNote(NoteVector::const_iterator it)
 {
 	instrumentTrack()->lock();
@@ -243,6 +287,39 @@ NoteVector::const_iterator MidiClip::removeNote(Note* note)
 }
 
 
+void MidiClip::removeNotes(const NoteVector& notes)
+{
+	if (notes.empty()) { return; }
+
+	// std::less gives a total order even for pointers to unrelated notes
+	auto removedNotes = notes;
+	std::sort(removedNotes.begin(), removedNotes.end(), std::less<Note*>{});
+	const auto isRemoved = [&removedNotes](Note* note)
+	{
+		return std::binary_search(removedNotes.begin(), removedNotes.end(), note, std::less<Note*>{});
+	};
+
+	auto remainingNotes = NoteVector{};
+	remainingNotes.reserve(m_notes.size());
+	std::remove_copy_if(m_notes.begin(), m_notes.end(), std::back_inserter(remainingNotes), isRemoved);
+
+	instrumentTrack()->lock();
+	m_notes.swap(remainingNotes);
+	instrumentTrack()->unlock();
+
+	// remainingNotes holds the previous notes now, each of them only once
+	for (const auto& note : remainingNotes)
+	{
+		if (isRemoved(note)) { delete note; }
+	}
+
+	checkType();
+	updateLength();
+
+	emit dataChanged();
+}
+
+
 // Returns a pointer to the note at specified step, or nullptr if note doesn't exist
 Note * MidiClip::noteAtStep(int step)
 {
@@ -321,6 +398,7 @@ void MidiClip::splitNotes(const NoteVector& notes, TimePos pos)
 
 	addJournalCheckPoint();
 
+	auto newNotes = std::vector<Note>{};
 	for (const auto& note : notes)
 	{
 		int leftLength = pos.getTicks() - note->pos();
@@ -340,8 +418,10 @@ void MidiClip::splitNotes(const NoteVector& notes, TimePos pos)
 		newNote.setLength(rightLength);
 		newNote.setPos(note->pos() + leftLength);
 
-		addNote(newNote, false);
+		newNotes.push_back(newNote);
 	}
+
+	addNotes(newNotes, false);
 }
 
 
@@ -0,0 +1,172 @@
+/*
+ * MixerTest.cpp
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest/QtTest>
+
+#include <algorithm>
+#include <iterator>
+
+#include "Engine.h"
+#include "Mixer.h"
+
+class MixerTest : public QObject
+{
+	Q_OBJECT
+private:
+	static lmms::Mixer* mixer()
+	{
+		return lmms::Engine::mixer();
+	}
+
+	//! Position of a channel in the execution order, or -1
+	static int position(int channel)
+	{
+		const auto& order = mixer()->executionOrder();
+		const auto it = std::find(order.begin(), order.end(), mixer()->mixerChannel(channel));
+		return it == order.end() ? -1 : static_cast<int>(std::distance(order.begin(), it));
+	}
+
+	//! Every channel is in the plan once, after all channels sending to it
+	static void verifyPlan()
+	{
+		using namespace lmms;
+
+		QCOMPARE(mixer()->executionOrder().size(), static_cast<std::size_t>(mixer()->numChannels()));
+		for (int ch = 0; ch < mixer()->numChannels(); ++ch)
+		{
+			QVERIFY(position(ch) >= 0);
+		}
+		for (const MixerRoute* route : mixer()->m_mixerRoutes)
+		{
+			QVERIFY(position(route->senderIndex()) < position(route->receiverIndex()));
+		}
+	}
+
+	//! Add a channel that doesn't send anywhere
+	static int createUnroutedChannel()
+	{
+		const int ch = mixer()->createChannel();
+		mixer()->deleteChannelSend(ch, 0);
+		return ch;
+	}
+
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		Engine::destroy();
+	}
+
+	void init()
+	{
+		mixer()->clear();
+	}
+
+	void testMasterOnly()
+	{
+		verifyPlan();
+		QCOMPARE(position(0), 0);
+	}
+
+	void testSendChain()
+	{
+		const int a = createUnroutedChannel();
+		const int b = createUnroutedChannel();
+		const int c = createUnroutedChannel();
+		mixer()->createChannelSend(a, b);
+		mixer()->createChannelSend(b, c);
+		mixer()->createChannelSend(c, 0);
+
+		verifyPlan();
+		QVERIFY(position(a) < position(b));
+		QVERIFY(position(b) < position(c));
+		QVERIFY(position(c) < position(0));
+	}
+
+	void testFanIn()
+	{
+		const int bus = mixer()->createChannel();
+		const int a = createUnroutedChannel();
+		const int b = createUnroutedChannel();
+		const int c = createUnroutedChannel();
+		for (const int ch : {a, b, c})
+		{
+			mixer()->createChannelSend(ch, bus);
+		}
+		// also send one of them to master directly
+		mixer()->createChannelSend(a, 0);
+
+		verifyPlan();
+		for (const int ch : {a, b, c})
+		{
+			QVERIFY(position(ch) < position(bus));
+		}
+		QCOMPARE(position(0), mixer()->numChannels() - 1);
+	}
+
+	void testChannelDeleted()
+	{
+		const int a = createUnroutedChannel();
+		const int b = createUnroutedChannel();
+		const int c = createUnroutedChannel();
+		mixer()->createChannelSend(a, b);
+		mixer()->createChannelSend(b, c);
+		mixer()->createChannelSend(c, 0);
+		mixer()->createChannelSend(a, 0);
+
+		mixer()->deleteChannel(b);
+
+		// a and c moved one to the left
+		QCOMPARE(mixer()->numChannels(), 3);
+		verifyPlan();
+		QVERIFY(position(1) < position(0));
+		QVERIFY(position(2) < position(0));
+	}
+
+	void testRouteRemoved()
+	{
+		const int a = createUnroutedChannel();
+		const int b = createUnroutedChannel();
+		mixer()->createChannelSend(a, b);
+		mixer()->createChannelSend(b, 0);
+		QVERIFY(position(a) < position(b));
+
+		// a sends to master directly now, and is still dispatched
+		mixer()->deleteChannelSend(a, b);
+		mixer()->createChannelSend(a, 0);
+		verifyPlan();
+
+		// b sends nowhere anymore
+		mixer()->deleteChannelSend(b, 0);
+		verifyPlan();
+		QVERIFY(mixer()->mixerChannel(b)->m_sends.empty());
+	}
+};
+
+QTEST_GUILESS_MAIN(MixerTest)
+#include "MixerTest.moc"
@@ -0,0 +1,150 @@
+/*
+ * VoicePoolTest.cpp
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "VoicePool.h"
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using lmms::VoicePool;
+
+namespace
+{
+
+int s_alive = 0;
+
+struct alignas(64) Voice
+{
+	explicit Voice(int value, bool fail = false) :
+		value{value}
+	{
+		if (fail) { throw std::runtime_error{"voice failed"}; }
+		++s_alive;
+	}
+
+	~Voice() { --s_alive; }
+
+	int value;
+};
+
+// The pool rounds its capacity up to a multiple of this
+constexpr std::size_t Capacity = 32;
+
+} // namespace
+
+class VoicePoolTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void init()
+	{
+		s_alive = 0;
+	}
+
+	void allocation()
+	{
+		VoicePool<Voice> pool{Capacity};
+
+		Voice* voice = pool.acquire(42);
+		QVERIFY(voice != nullptr);
+		QVERIFY(pool.owns(voice));
+		QCOMPARE(voice->value, 42);
+		QCOMPARE(reinterpret_cast<std::uintptr_t>(voice) % alignof(Voice), std::uintptr_t{0});
+		QCOMPARE(s_alive, 1);
+
+		pool.release(voice);
+		QCOMPARE(s_alive, 0);
+
+		pool.release(nullptr);
+		QCOMPARE(s_alive, 0);
+	}
+
+	void reuse()
+	{
+		VoicePool<Voice> pool{Capacity};
+
+		Voice* first = pool.acquire(1);
+		pool.release(first);
+
+		Voice* second = pool.acquire(2);
+		QCOMPARE(second, first);
+		QCOMPARE(second->value, 2);
+		pool.release(second);
+		QCOMPARE(s_alive, 0);
+	}
+
+	void exhaustion()
+	{
+		VoicePool<Voice> pool{Capacity};
+
+		auto voices = std::vector<Voice*>{};
+		for (std::size_t i = 0; i < Capacity; ++i)
+		{
+			voices.push_back(pool.acquire(static_cast<int>(i)));
+			QVERIFY(pool.owns(voices.back()));
+		}
+
+		// falls back to the heap once all preallocated voices are in use
+		Voice* extra = pool.acquire(-1);
+		QVERIFY(extra != nullptr);
+		QVERIFY(!pool.owns(extra));
+		QCOMPARE(extra->value, -1);
+		QCOMPARE(s_alive, static_cast<int>(Capacity) + 1);
+
+		pool.release(extra);
+		pool.release(voices.back());
+		voices.pop_back();
+
+		// a released voice is available again
+		voices.push_back(pool.acquire(0));
+		QVERIFY(pool.owns(voices.back()));
+
+		for (Voice* voice : voices) { pool.release(voice); }
+		QCOMPARE(s_alive, 0);
+	}
+
+	void failedConstruction()
+	{
+		VoicePool<Voice> pool{Capacity};
+
+		auto voices = std::vector<Voice*>{};
+		for (std::size_t i = 0; i + 1 < Capacity; ++i)
+		{
+			voices.push_back(pool.acquire(0));
+		}
+
+		QVERIFY_EXCEPTION_THROWN(pool.acquire(0, true), std::runtime_error);
+
+		// the storage of the failed voice went back to the pool
+		voices.push_back(pool.acquire(0));
+		QVERIFY(pool.owns(voices.back()));
+
+		for (Voice* voice : voices) { pool.release(voice); }
+		QCOMPARE(s_alive, 0);
+	}
+};
+
+QTEST_GUILESS_MAIN(VoicePoolTest)
+#include "VoicePoolTest.moc"
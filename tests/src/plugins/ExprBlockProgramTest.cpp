@@ -0,0 +1,211 @@
+/*
+ * ExprBlockProgramTest.cpp
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ExprBlockProgram.h"
+
+#include <QObject>
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <cmath>
+#include <exprtk.hpp>
+#include <string>
+
+using lmms::ExprBlockProgram;
+
+namespace
+{
+
+constexpr float Pi = 3.14159265358979323846f;
+
+//! Stands in for Xpressive's last(), which only ExprTk can evaluate
+struct LastFunction : public exprtk::ifunction<float>
+{
+	LastFunction() : exprtk::ifunction<float>(1) {}
+	float operator()(const float& x) override
+	{
+		const float result = m_last;
+		m_last = x;
+		return result;
+	}
+	float m_last = 0;
+};
+
+//! Both evaluators with the same symbols, set up like ExprFront does
+class Evaluators
+{
+public:
+	Evaluators()
+	{
+		m_symbols.add_variable("t", m_t);
+		m_symbols.add_variable("f", m_f);
+		m_symbols.add_pi();
+		m_symbols.add_function("last", m_last);
+		m_expression.register_symbol_table(m_symbols);
+
+		m_block.addVector("t", m_times);
+		m_block.addVariable("f", &m_f);
+		m_block.addConstant("pi", Pi);
+		m_block.addFunction("sin", [](void*, float x) { return std::sin(x); });
+		m_block.addFunction("abs", [](void*, float x) { return std::abs(x); });
+		m_block.addFunction("exp", [](void*, float x) { return std::exp(x); });
+		m_block.addFunction("log", [](void*, float x) { return std::log(x); });
+		m_block.addFunction("sqrt", [](void*, float x) { return std::sqrt(x); });
+		m_block.addFunction("floor", [](void*, float x) { return std::floor(x); });
+		m_block.addFunction("pow", [](float x, float y) { return std::pow(x, y); });
+		m_block.addFunction("mod", [](float x, float y) { return std::fmod(x, y); });
+		m_block.addFunction("min", [](float x, float y) { return std::min(x, y); });
+		m_block.addFunction("max", [](float x, float y) { return std::max(x, y); });
+	}
+
+	bool compileExprTk(const std::string& expression)
+	{
+		// the same restrictions as in ExprFront::compile()
+		exprtk::parser<float>::settings_store settings;
+		settings.disable_all_logic_ops();
+		settings.disable_all_assignment_ops();
+		settings.disable_all_control_structures();
+		exprtk::parser<float> parser(settings);
+		return parser.compile(expression, m_expression);
+	}
+
+	ExprBlockProgram& block() { return m_block; }
+
+	//! Evaluates a block with both evaluators and compares the results
+	void compare(const std::string& expression, std::size_t frames, float start, float f)
+	{
+		m_f = f;
+		for (std::size_t i = 0; i < frames; ++i)
+		{
+			m_times[i] = start + static_cast<float>(i) / ExprBlockProgram::BlockSize;
+		}
+
+		float out[ExprBlockProgram::BlockSize];
+		m_block.evaluate(out, frames);
+
+		for (std::size_t i = 0; i < frames; ++i)
+		{
+			m_t = m_times[i];
+			const float expected = m_expression.value();
+			const float tolerance = 1e-4f * std::max(1.0f, std::abs(expected));
+			QVERIFY2(std::abs(out[i] - expected) <= tolerance,
+				qPrintable(QString("%1 at t = %2: block %3, ExprTk %4")
+					.arg(QString::fromStdString(expression)).arg(m_t).arg(out[i]).arg(expected)));
+		}
+	}
+
+private:
+	float m_t = 0;
+	float m_f = 0;
+	float m_times[ExprBlockProgram::BlockSize] = {};
+	LastFunction m_last;
+	exprtk::symbol_table<float> m_symbols;
+	exprtk::expression<float> m_expression;
+	ExprBlockProgram m_block;
+};
+
+} // namespace
+
+class ExprBlockProgramTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void evaluate_data()
+	{
+		QTest::addColumn<QString>("expression");
+
+		QTest::newRow("sine") << "sin(2*pi*f*t)";
+		QTest::newRow("polynomial") << "0.5*t^2 - 3*t + 1";
+		QTest::newRow("comparison") << "t < 0.5";
+		QTest::newRow("window") << "(t > 0.3) * (t <= 0.7)";
+		QTest::newRow("modulo") << "t % 0.3 - mod(t, 0.2)";
+		QTest::newRow("nested calls") << "abs(sin(t*10)) * max(t, 0.25)";
+		QTest::newRow("power") << "pow(t, 1.5) - min(t, 1 - t)";
+		QTest::newRow("quantized") << "floor(t * 8) / 8";
+		QTest::newRow("signs") << "exp(-t) / (1 + t) - -f/1000";
+		QTest::newRow("case insensitive") << "SQRT(T) - Log(t + 1)";
+		QTest::newRow("constant") << "pi / 4";
+		QTest::newRow("variable only") << "f";
+	}
+
+	void evaluate()
+	{
+		QFETCH(QString, expression);
+		const std::string source = expression.toStdString();
+
+		Evaluators evaluators;
+		QVERIFY(evaluators.compileExprTk(source));
+		QVERIFY(evaluators.block().compile(source));
+		QVERIFY(evaluators.block().isValid());
+
+		// full blocks with changing variables, then a partial block
+		evaluators.compare(source, ExprBlockProgram::BlockSize, 0.0f, 440.0f);
+		evaluators.compare(source, ExprBlockProgram::BlockSize, 1.0f, 220.0f);
+		evaluators.compare(source, 37, 2.0f, 110.0f);
+	}
+
+	void fallback_data()
+	{
+		QTest::addColumn<QString>("expression");
+
+		QTest::newRow("stateful function") << "last(t) + t";
+		QTest::newRow("implicit multiplication") << "2t";
+		QTest::newRow("equality") << "t == 0.5";
+		QTest::newRow("inequality") << "t != 0.5";
+		QTest::newRow("negated power") << "-t^2";
+		QTest::newRow("signed exponent") << "2^-t";
+		QTest::newRow("chained power") << "t^2^3";
+		QTest::newRow("variadic min") << "min(t, 0.5, 0.25)";
+	}
+
+	//! Valid Xpressive expressions that only ExprTk may evaluate
+	void fallback()
+	{
+		QFETCH(QString, expression);
+		const std::string source = expression.toStdString();
+
+		Evaluators evaluators;
+		QVERIFY(evaluators.compileExprTk(source));
+		QVERIFY(!evaluators.block().compile(source));
+		QVERIFY(!evaluators.block().isValid());
+	}
+
+	void invalid()
+	{
+		Evaluators evaluators;
+		QVERIFY(!evaluators.block().compile("sin(t"));
+		QVERIFY(!evaluators.block().compile("t +"));
+		QVERIFY(!evaluators.block().compile("unknown(t)"));
+		QVERIFY(!evaluators.block().isValid());
+	}
+
+	void recompile()
+	{
+		Evaluators evaluators;
+		QVERIFY(!evaluators.block().compile("2t"));
+		QVERIFY(evaluators.compileExprTk("2*t"));
+		QVERIFY(evaluators.block().compile("2*t"));
+		evaluators.compare("2*t", ExprBlockProgram::BlockSize, 0.0f, 440.0f);
+	}
+};
+
+QTEST_GUILESS_MAIN(ExprBlockProgramTest)
+#include "ExprBlockProgramTest.moc"
@@ -24,6 +24,9 @@
 
 #include <QtTest/QtTest>
 
+#include <utility>
+#include <vector>
+
 #include "QCoreApplication"
 
 #include "AutomationClip.h"
@@ -87,6 +90,125 @@ private slots:
 		QCOMPARE(c.valueAt(150), 1.0f);
 	}
 
+	void testSegmentLookup()
+	{
+		using namespace lmms;
+
+		AutomationClip c(nullptr);
+		c.setProgressionType(AutomationClip::ProgressionType::Linear);
+		for (int i = 0; i <= 10; ++i)
+		{
+			c.putValue(i * 10, i * 0.1f, false);
+		}
+
+		// forward in small steps, as during playback
+		for (int t = 0; t <= 100; t += 5)
+		{
+			QCOMPARE(c.valueAt(t), t / 100.f);
+		}
+
+		// backward seeks, e.g. when a loop starts over
+		QCOMPARE(c.valueAt(95), 0.95f);
+		QCOMPARE(c.valueAt(15), 0.15f);
+		QCOMPARE(c.valueAt(10), 0.1f);
+		QCOMPARE(c.valueAt(85), 0.85f);
+		QCOMPARE(c.valueAt(84), 0.84f);
+
+		// forward jumps over more segments than the cursor steps through
+		QCOMPARE(c.valueAt(0), 0.f);
+		QCOMPARE(c.valueAt(75), 0.75f);
+		QCOMPARE(c.valueAt(150), 1.f);
+	}
+
+	void testSegmentLookupOrder()
+	{
+		using namespace lmms;
+
+		// The values must not depend on the previous lookups
+		AutomationClip forward(nullptr);
+		AutomationClip backward(nullptr);
+		for (AutomationClip* c : {&forward, &backward})
+		{
+			c->setProgressionType(AutomationClip::ProgressionType::CubicHermite);
+			c->putValue(0, 0.2f, false);
+			c->putValue(24, 0.9f, false);
+			c->putValue(31, 0.4f, false);
+			c->putValue(80, 0.6f, false);
+			c->putValue(96, 0.1f, false);
+		}
+
+		std::vector<float> values;
+		for (int t = 0; t <= 100; ++t)
+		{
+			values.push_back(forward.valueAt(t));
+		}
+		for (int t = 100; t >= 0; --t)
+		{
+			QCOMPARE(backward.valueAt(t), values[t]);
+		}
+	}
+
+	void testRemoveNodes()
+	{
+		using namespace lmms;
+
+		AutomationClip c(nullptr);
+		c.setProgressionType(AutomationClip::ProgressionType::Linear);
+		for (int i = 0; i <= 10; ++i)
+		{
+			c.putValue(i * 10, i % 2, false);
+		}
+		QCOMPARE(c.valueAt(35), 0.5f);
+
+		// removes the nodes at 30, 40, 50 and 60
+		c.removeNodes(65, 25);
+		QCOMPARE(c.getTimeMap().size(), 7);
+		QVERIFY(c.getTimeMap().contains(20));
+		QVERIFY(c.getTimeMap().contains(70));
+
+		// the segments on both sides of the gap are joined
+		QCOMPARE(c.valueAt(20), 0.f);
+		QCOMPARE(c.valueAt(35), 0.3f);
+		QCOMPARE(c.valueAt(70), 1.f);
+		QCOMPARE(c.valueAt(75), 0.5f);
+
+		// a single tick removes the node there
+		c.removeNodes(70, 70);
+		QCOMPARE(c.getTimeMap().size(), 6);
+		QCOMPARE(c.valueAt(50), 0.f);
+		QCOMPARE(c.valueAt(85), 0.5f);
+	}
+
+	void testPutValueBatch()
+	{
+		using namespace lmms;
+
+		const auto values = std::vector<std::pair<TimePos, float>>{
+			{0, 0.5f}, {12, 0.1f}, {40, 0.8f}, {41, 0.3f}, {90, 0.7f}, {12, 0.2f}
+		};
+
+		AutomationClip single(nullptr);
+		AutomationClip batch(nullptr);
+		for (AutomationClip* c : {&single, &batch})
+		{
+			c->setProgressionType(AutomationClip::ProgressionType::CubicHermite);
+			c->putValue(60, 0.9f, false);
+		}
+
+		for (const auto& [time, value] : values)
+		{
+			single.putValue(time, value, false);
+		}
+		batch.putValueBatch(values, false);
+
+		QCOMPARE(batch.getTimeMap().size(), single.getTimeMap().size());
+		QCOMPARE(batch.length(), single.length());
+		for (int t = 0; t <= 100; ++t)
+		{
+			QCOMPARE(batch.valueAt(t), single.valueAt(t));
+		}
+	}
+
 	void testClips()
 	{
 		using namespace lmms;